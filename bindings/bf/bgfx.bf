@@ -574,6 +574,20 @@ public static class bgfx
 		All                    = 0x000000ff,
 	}
 	
+	[AllowDuplicates]
+	public enum WeldFlags : uint32
+	{
+		/// <summary>
+		/// Compare vertex position only.
+		/// </summary>
+		None                   = 0x00000000,
+	
+		/// <summary>
+		/// Compare all vertex attributes, not only position.
+		/// </summary>
+		AllAttributes          = 0x00000001,
+	}
+	
 	[AllowDuplicates]
 	public enum DebugFlags : uint32
 	{
@@ -2085,6 +2099,8 @@ public static class bgfx
 			public uint32 minResourceCbSize;
 			public uint32 transientVbSize;
 			public uint32 transientIbSize;
+			public uint32 maxSortThreads;
+			public uint32 maxFramesInFlight;
 		}
 	
 		public RendererType rendererType;
@@ -2139,6 +2155,12 @@ public static class bgfx
 			public uint32 minResourceCbSize;
 			public uint32 transientVbSize;
 			public uint32 transientIbSize;
+			public uint32 transientMaxVbSize;
+			public uint32 transientMaxIbSize;
+			public uint32 uploadBudgetSize;
+			public uint32 uploadBudgetTime;
+			public uint16 maxSortThreads;
+			public uint16 maxFramesInFlight;
 		}
 	
 		public RendererType type;
@@ -2233,6 +2255,16 @@ public static class bgfx
 		public uint16 num;
 	}
 	
+	[CRepr]
+	public struct BatchDraw
+	{
+		public uint32 transform;
+		public uint16 numMatrices;
+		public uint32 start;
+		public uint32 num;
+		public uint32 depth;
+	}
+	
 	[CRepr]
 	public struct ViewStats
 	{
@@ -2250,6 +2282,16 @@ public static class bgfx
 	{
 		public int64 cpuTimeBegin;
 		public int64 cpuTimeEnd;
+		public int64 waitBeginTime;
+		public uint32 numRetries;
+	}
+	
+	[CRepr]
+	public struct PipelineStats
+	{
+		public uint64 id;
+		public int64 cpuTimeCreate;
+		public uint8 prewarm;
 	}
 	
 	[CRepr]
@@ -2269,6 +2311,8 @@ public static class bgfx
 		public uint32 numBlit;
 		public uint32 maxGpuLatency;
 		public uint32 gpuFrameNum;
+		public uint32 numSortedItems;
+		public uint32 numUniformDedup;
 		public uint16 numDynamicIndexBuffers;
 		public uint16 numDynamicVertexBuffers;
 		public uint16 numFrameBuffers;
@@ -2284,6 +2328,21 @@ public static class bgfx
 		public int64 rtMemoryUsed;
 		public int transientVbUsed;
 		public int transientIbUsed;
+		public int transientVbSize;
+		public int transientIbSize;
+		public int transientVbOverflow;
+		public int transientIbOverflow;
+		public int transientVbWasted;
+		public int transientIbWasted;
+		public int64 dynamicIbFree;
+		public int64 dynamicVbFree;
+		public uint32 dynamicIbFreeMax;
+		public uint32 dynamicVbFreeMax;
+		public uint32 dynamicIbFreeBlocks;
+		public uint32 dynamicVbFreeBlocks;
+		public uint32 uploadPending;
+		public uint32 uploadPendingSize;
+		public uint32 uploadSize;
 		public uint32[5] numPrims;
 		public int64 gpuMemoryMax;
 		public int64 gpuMemoryUsed;
@@ -2295,6 +2354,8 @@ public static class bgfx
 		public ViewStats* viewStats;
 		public uint8 numEncoders;
 		public EncoderStats* encoderStats;
+		public uint16 numPipelines;
+		public PipelineStats* pipelineStats;
 	}
 	
 	[CRepr]
@@ -2311,6 +2372,12 @@ public static class bgfx
 	{
 	}
 	
+	[CRepr]
+	public struct DrawListHandle {
+	    public uint16 idx;
+	    public bool Valid => idx != uint16.MaxValue;
+	}
+	
 	[CRepr]
 	public struct DynamicIndexBufferHandle {
 	    public uint16 idx;
@@ -2504,6 +2571,22 @@ public static class bgfx
 	[LinkName("bgfx_weld_vertices")]
 	public static extern uint32 weld_vertices(void* _output, VertexLayout* _layout, void* _data, uint32 _num, bool _index32, float _epsilon);
 	
+	/// <summary>
+	/// Weld vertices, and write unique vertices into compacted vertex stream.
+	/// </summary>
+	///
+	/// <param name="_output">Welded vertices remapping table. The size of buffer must be the same as number of vertices. Each entry is index of vertex in compacted vertex stream.</param>
+	/// <param name="_dstData">Compacted vertex stream. The size of buffer must be large enough to hold all vertices of input vertex stream. Unique vertices are written in order of their first occurrence.</param>
+	/// <param name="_layout">Vertex stream layout.</param>
+	/// <param name="_data">Vertex stream.</param>
+	/// <param name="_num">Number of vertices in vertex stream.</param>
+	/// <param name="_index32">Set to `true` if input indices are 32-bit.</param>
+	/// <param name="_epsilon">Error tolerance for vertex comparison.</param>
+	/// <param name="_flags">Weld flags, see `BGFX_WELD_*`.</param>
+	///
+	[LinkName("bgfx_weld_vertices_compact")]
+	public static extern uint32 weld_vertices_compact(void* _output, void* _dstData, VertexLayout* _layout, void* _data, uint32 _num, bool _index32, float _epsilon, uint8 _flags);
+	
 	/// <summary>
 	/// Convert index buffer for use with different primitive topologies.
 	/// </summary>
@@ -2654,10 +2737,11 @@ public static class bgfx
 	/// Make reference to data to pass to bgfx. Unlike `bgfx::alloc`, this call
 	/// doesn't allocate memory for data. It just copies the _data pointer. You
 	/// can pass `ReleaseFn` function pointer to release this memory after it's
-	/// consumed, otherwise you must make sure _data is available for at least 2
-	/// `bgfx::frame` calls. `ReleaseFn` function must be able to be called
+	/// consumed, otherwise you must make sure _data is available for at least
+	/// `Init::Limits::maxFramesInFlight` + 1 `bgfx::frame` calls. `ReleaseFn` function must be able to be called
 	/// from any thread.
-	/// @attention Data passed must be available for at least 2 `bgfx::frame` calls.
+	/// @attention Data passed must be available for at least `Init::Limits::maxFramesInFlight` + 1
+	/// `bgfx::frame` calls.
 	/// </summary>
 	///
 	/// <param name="_data">Pointer to data.</param>
@@ -2670,10 +2754,11 @@ public static class bgfx
 	/// Make reference to data to pass to bgfx. Unlike `bgfx::alloc`, this call
 	/// doesn't allocate memory for data. It just copies the _data pointer. You
 	/// can pass `ReleaseFn` function pointer to release this memory after it's
-	/// consumed, otherwise you must make sure _data is available for at least 2
-	/// `bgfx::frame` calls. `ReleaseFn` function must be able to be called
+	/// consumed, otherwise you must make sure _data is available for at least
+	/// `Init::Limits::maxFramesInFlight` + 1 `bgfx::frame` calls. `ReleaseFn` function must be able to be called
 	/// from any thread.
-	/// @attention Data passed must be available for at least 2 `bgfx::frame` calls.
+	/// @attention Data passed must be available for at least `Init::Limits::maxFramesInFlight` + 1
+	/// `bgfx::frame` calls.
 	/// </summary>
 	///
 	/// <param name="_data">Pointer to data.</param>
@@ -2894,6 +2979,19 @@ public static class bgfx
 	[LinkName("bgfx_update_dynamic_vertex_buffer")]
 	public static extern void update_dynamic_vertex_buffer(DynamicVertexBufferHandle _handle, uint32 _startVertex, Memory* _mem);
 	
+	/// <summary>
+	/// Update dynamic vertex buffer asynchronously. Update is queued, and issued
+	///   over one or more frames within upload budget. See `Init::Limits`.
+	/// @attention Asynchronous updates are not ordered with immediate updates.
+	/// </summary>
+	///
+	/// <param name="_handle">Dynamic vertex buffer handle.</param>
+	/// <param name="_startVertex">Start vertex.</param>
+	/// <param name="_mem">Vertex buffer data.</param>
+	///
+	[LinkName("bgfx_update_dynamic_vertex_buffer_async")]
+	public static extern uint32 update_dynamic_vertex_buffer_async(DynamicVertexBufferHandle _handle, uint32 _startVertex, Memory* _mem);
+	
 	/// <summary>
 	/// Destroy dynamic vertex buffer.
 	/// </summary>
@@ -3203,6 +3301,36 @@ public static class bgfx
 	[LinkName("bgfx_update_texture_2d")]
 	public static extern void update_texture_2d(TextureHandle _handle, uint16 _layer, uint8 _mip, uint16 _x, uint16 _y, uint16 _width, uint16 _height, Memory* _mem, uint16 _pitch);
 	
+	/// <summary>
+	/// Update 2D texture asynchronously. Update is queued, and issued over one
+	///   or more frames within upload budget. See `Init::Limits`.
+	/// @attention It's valid to update only mutable texture. See `bgfx::createTexture2D` for more info.
+	/// @attention Asynchronous updates are not ordered with immediate updates.
+	/// </summary>
+	///
+	/// <param name="_handle">Texture handle.</param>
+	/// <param name="_layer">Layer in texture array.</param>
+	/// <param name="_mip">Mip level.</param>
+	/// <param name="_x">X offset in texture.</param>
+	/// <param name="_y">Y offset in texture.</param>
+	/// <param name="_width">Width of texture block.</param>
+	/// <param name="_height">Height of texture block.</param>
+	/// <param name="_mem">Texture update data.</param>
+	/// <param name="_pitch">Pitch of input image (bytes). When _pitch is set to UINT16_MAX, it will be calculated internally based on _width.</param>
+	///
+	[LinkName("bgfx_update_texture_2d_async")]
+	public static extern uint32 update_texture_2d_async(TextureHandle _handle, uint16 _layer, uint8 _mip, uint16 _x, uint16 _y, uint16 _width, uint16 _height, Memory* _mem, uint16 _pitch);
+	
+	/// <summary>
+	/// Returns true when asynchronous upload was consumed by render thread, and its
+	///   memory is released. Upload might still be in flight on GPU.
+	/// </summary>
+	///
+	/// <param name="_fence">Upload fence returned by asynchronous update function.</param>
+	///
+	[LinkName("bgfx_is_upload_complete")]
+	public static extern bool is_upload_complete(uint32 _fence);
+	
 	/// <summary>
 	/// Update 3D texture.
 	/// @attention It's valid to update only mutable texture. See `bgfx::createTexture3D` for more info.
@@ -3454,6 +3582,23 @@ public static class bgfx
 	[LinkName("bgfx_destroy_occlusion_query")]
 	public static extern void destroy_occlusion_query(OcclusionQueryHandle _handle);
 	
+	/// <summary>
+	/// Create retained draw list. Draw calls recorded into draw list can be
+	/// submitted every frame without encoding them again.
+	/// </summary>
+	///
+	[LinkName("bgfx_create_draw_list")]
+	public static extern DrawListHandle create_draw_list();
+	
+	/// <summary>
+	/// Destroy retained draw list.
+	/// </summary>
+	///
+	/// <param name="_handle">Handle to draw list object.</param>
+	///
+	[LinkName("bgfx_destroy_draw_list")]
+	public static extern void destroy_draw_list(DrawListHandle _handle);
+	
 	/// <summary>
 	/// Set palette color value.
 	/// </summary>
@@ -4008,6 +4153,90 @@ public static class bgfx
 	[LinkName("bgfx_encoder_submit_indirect_count")]
 	public static extern void encoder_submit_indirect_count(Encoder* _this, ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint32 _start, IndexBufferHandle _numHandle, uint32 _numIndex, uint32 _numMax, uint32 _depth, uint8 _flags);
 	
+	/// <summary>
+	/// Submit batch of draw calls sharing all state set on encoder. Only
+	/// transform, index (or vertex) range, and depth differ between draw calls.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_program">Program.</param>
+	/// <param name="_draws">Array of per draw call data.</param>
+	/// <param name="_num">Number of draw calls in array.</param>
+	/// <param name="_flags">Discard or preserve states. See `BGFX_DISCARD_*`.</param>
+	///
+	[LinkName("bgfx_encoder_submit_batch")]
+	public static extern void encoder_submit_batch(Encoder* _this, ViewId _id, ProgramHandle _program, BatchDraw* _draws, uint32 _num, uint8 _flags);
+	
+	/// <summary>
+	/// Begin recording draw calls into retained draw list. Until `endDrawList`
+	/// is called, draw calls submitted with this encoder are recorded into draw
+	/// list instead of being submitted into frame, and view id passed to `submit`
+	/// is ignored. Previous content of draw list is discarded.
+	/// @remarks
+	///   Recorded draw calls must not use transient buffers, instance data
+	///   buffers allocated with `allocInstanceDataBuffer`, or occlusion queries.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw list handle.</param>
+	///
+	[LinkName("bgfx_encoder_begin_draw_list")]
+	public static extern void encoder_begin_draw_list(Encoder* _this, DrawListHandle _handle);
+	
+	/// <summary>
+	/// End recording draw calls into retained draw list.
+	/// </summary>
+	///
+	[LinkName("bgfx_encoder_end_draw_list")]
+	public static extern void encoder_end_draw_list(Encoder* _this);
+	
+	/// <summary>
+	/// Submit draw calls recorded in retained draw list.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Draw list handle.</param>
+	/// <param name="_mtx">Pointer to transform matrices replacing transforms recorded in draw list, or `NULL` to use recorded transforms.</param>
+	/// <param name="_num">Number of matrices in array. Must be equal to number of matrices recorded in draw list.</param>
+	///
+	[LinkName("bgfx_encoder_submit_draw_list")]
+	public static extern void encoder_submit_draw_list(Encoder* _this, ViewId _id, DrawListHandle _handle, void* _mtx, uint16 _num);
+	
+	/// <summary>
+	/// Allocate transient index buffer. Encoder reserves chunks of frame's
+	/// transient index buffer, and sub-allocates from them without locking.
+	/// </summary>
+	///
+	/// <param name="_tib">TransientIndexBuffer structure will be filled, and will be valid for the duration of frame, and can be reused for multiple draw calls.</param>
+	/// <param name="_num">Number of indices to allocate.</param>
+	/// <param name="_index32">Set to `true` if input indices will be 32-bit.</param>
+	///
+	[LinkName("bgfx_encoder_alloc_transient_index_buffer")]
+	public static extern void encoder_alloc_transient_index_buffer(Encoder* _this, TransientIndexBuffer* _tib, uint32 _num, bool _index32);
+	
+	/// <summary>
+	/// Allocate transient vertex buffer. Encoder reserves chunks of frame's
+	/// transient vertex buffer, and sub-allocates from them without locking.
+	/// </summary>
+	///
+	/// <param name="_tvb">TransientVertexBuffer structure will be filled, and will be valid for the duration of frame, and can be reused for multiple draw calls.</param>
+	/// <param name="_num">Number of vertices to allocate.</param>
+	/// <param name="_layout">Vertex layout.</param>
+	///
+	[LinkName("bgfx_encoder_alloc_transient_vertex_buffer")]
+	public static extern void encoder_alloc_transient_vertex_buffer(Encoder* _this, TransientVertexBuffer* _tvb, uint32 _num, VertexLayout* _layout);
+	
+	/// <summary>
+	/// Allocate instance data buffer from encoder's transient vertex buffer
+	/// chunk.
+	/// </summary>
+	///
+	/// <param name="_idb">InstanceDataBuffer structure will be filled, and will be valid for duration of frame, and can be reused for multiple draw calls.</param>
+	/// <param name="_num">Number of instances.</param>
+	/// <param name="_stride">Instance stride. Must be multiple of 16.</param>
+	///
+	[LinkName("bgfx_encoder_alloc_instance_data_buffer")]
+	public static extern void encoder_alloc_instance_data_buffer(Encoder* _this, InstanceDataBuffer* _idb, uint32 _num, uint16 _stride);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -4150,6 +4379,21 @@ public static class bgfx
 	[LinkName("bgfx_request_screen_shot")]
 	public static extern void request_screen_shot(FrameBufferHandle _handle, char8* _filePath);
 	
+	/// <summary>
+	/// Replay pipeline manifest recorded in previous runs, and prewarm pipelines listed in it
+	/// before next frame is rendered.
+	/// @remarks
+	///   Manifest is recorded by renderer for every unique pipeline it creates, and it's stored
+	///   with `bgfx::CallbackI::cacheWrite`. Pipelines depending on programs created after this
+	///   call, but before next `bgfx::frame` are prewarmed too. Creation time of each pipeline
+	///   is reported in `bgfx::Stats::pipelineStats`.
+	/// @attention Only Vulkan and OpenGL (with program binary support) renderers record
+	///   pipeline manifest.
+	/// </summary>
+	///
+	[LinkName("bgfx_replay_pipeline_manifest")]
+	public static extern void replay_pipeline_manifest();
+	
 	/// <summary>
 	/// Render frame.
 	/// @attention `bgfx::renderFrame` is blocking call. It waits for
@@ -4585,6 +4829,54 @@ public static class bgfx
 	[LinkName("bgfx_submit_indirect_count")]
 	public static extern void submit_indirect_count(ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint32 _start, IndexBufferHandle _numHandle, uint32 _numIndex, uint32 _numMax, uint32 _depth, uint8 _flags);
 	
+	/// <summary>
+	/// Submit batch of draw calls sharing all state set for draw call. Only
+	/// transform, index (or vertex) range, and depth differ between draw calls.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_program">Program.</param>
+	/// <param name="_draws">Array of per draw call data.</param>
+	/// <param name="_num">Number of draw calls in array.</param>
+	/// <param name="_flags">Discard or preserve states. See `BGFX_DISCARD_*`.</param>
+	///
+	[LinkName("bgfx_submit_batch")]
+	public static extern void submit_batch(ViewId _id, ProgramHandle _program, BatchDraw* _draws, uint32 _num, uint8 _flags);
+	
+	/// <summary>
+	/// Begin recording draw calls into retained draw list. Until `endDrawList`
+	/// is called, draw calls are recorded into draw list instead of being
+	/// submitted into frame, and view id passed to `submit` is ignored.
+	/// Previous content of draw list is discarded.
+	/// @remarks
+	///   Recorded draw calls must not use transient buffers, instance data
+	///   buffers allocated with `allocInstanceDataBuffer`, or occlusion queries.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw list handle.</param>
+	///
+	[LinkName("bgfx_begin_draw_list")]
+	public static extern void begin_draw_list(DrawListHandle _handle);
+	
+	/// <summary>
+	/// End recording draw calls into retained draw list.
+	/// </summary>
+	///
+	[LinkName("bgfx_end_draw_list")]
+	public static extern void end_draw_list();
+	
+	/// <summary>
+	/// Submit draw calls recorded in retained draw list.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Draw list handle.</param>
+	/// <param name="_mtx">Pointer to transform matrices replacing transforms recorded in draw list, or `NULL` to use recorded transforms.</param>
+	/// <param name="_num">Number of matrices in array. Must be equal to number of matrices recorded in draw list.</param>
+	///
+	[LinkName("bgfx_submit_draw_list")]
+	public static extern void submit_draw_list(ViewId _id, DrawListHandle _handle, void* _mtx, uint16 _num);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -573,6 +573,20 @@ public static partial class bgfx
 		All                    = 0x000000ff,
 	}
 	
+	[Flags]
+	public enum WeldFlags : uint
+	{
+		/// <summary>
+		/// Compare vertex position only.
+		/// </summary>
+		None                   = 0x00000000,
+	
+		/// <summary>
+		/// Compare all vertex attributes, not only position.
+		/// </summary>
+		AllAttributes          = 0x00000001,
+	}
+	
 	[Flags]
 	public enum DebugFlags : uint
 	{
@@ -2066,6 +2080,8 @@ public static partial class bgfx
 			public uint minResourceCbSize;
 			public uint transientVbSize;
 			public uint transientIbSize;
+			public uint maxSortThreads;
+			public uint maxFramesInFlight;
 		}
 	
 		public RendererType rendererType;
@@ -2115,6 +2131,12 @@ public static partial class bgfx
 			public uint minResourceCbSize;
 			public uint transientVbSize;
 			public uint transientIbSize;
+			public uint transientMaxVbSize;
+			public uint transientMaxIbSize;
+			public uint uploadBudgetSize;
+			public uint uploadBudgetTime;
+			public ushort maxSortThreads;
+			public ushort maxFramesInFlight;
 		}
 	
 		public RendererType type;
@@ -2201,6 +2223,15 @@ public static partial class bgfx
 		public ushort num;
 	}
 	
+	public unsafe struct BatchDraw
+	{
+		public uint transform;
+		public ushort numMatrices;
+		public uint start;
+		public uint num;
+		public uint depth;
+	}
+	
 	public unsafe struct ViewStats
 	{
 		public fixed byte name[256];
@@ -2216,6 +2247,15 @@ public static partial class bgfx
 	{
 		public long cpuTimeBegin;
 		public long cpuTimeEnd;
+		public long waitBeginTime;
+		public uint numRetries;
+	}
+	
+	public unsafe struct PipelineStats
+	{
+		public ulong id;
+		public long cpuTimeCreate;
+		public byte prewarm;
 	}
 	
 	public unsafe struct Stats
@@ -2234,6 +2274,8 @@ public static partial class bgfx
 		public uint numBlit;
 		public uint maxGpuLatency;
 		public uint gpuFrameNum;
+		public uint numSortedItems;
+		public uint numUniformDedup;
 		public ushort numDynamicIndexBuffers;
 		public ushort numDynamicVertexBuffers;
 		public ushort numFrameBuffers;
@@ -2249,6 +2291,21 @@ public static partial class bgfx
 		public long rtMemoryUsed;
 		public int transientVbUsed;
 		public int transientIbUsed;
+		public int transientVbSize;
+		public int transientIbSize;
+		public int transientVbOverflow;
+		public int transientIbOverflow;
+		public int transientVbWasted;
+		public int transientIbWasted;
+		public long dynamicIbFree;
+		public long dynamicVbFree;
+		public uint dynamicIbFreeMax;
+		public uint dynamicVbFreeMax;
+		public uint dynamicIbFreeBlocks;
+		public uint dynamicVbFreeBlocks;
+		public uint uploadPending;
+		public uint uploadPendingSize;
+		public uint uploadSize;
 		public fixed uint numPrims[5];
 		public long gpuMemoryMax;
 		public long gpuMemoryUsed;
@@ -2260,6 +2317,8 @@ public static partial class bgfx
 		public ViewStats* viewStats;
 		public byte numEncoders;
 		public EncoderStats* encoderStats;
+		public ushort numPipelines;
+		public PipelineStats* pipelineStats;
 	}
 	
 	public unsafe struct VertexLayout
@@ -2274,6 +2333,11 @@ public static partial class bgfx
 	{
 	}
 	
+	public struct DrawListHandle {
+	    public ushort idx;
+	    public bool Valid => idx != UInt16.MaxValue;
+	}
+	
 	public struct DynamicIndexBufferHandle {
 	    public ushort idx;
 	    public bool Valid => idx != UInt16.MaxValue;
@@ -2455,6 +2519,22 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_weld_vertices", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe uint weld_vertices(void* _output, VertexLayout* _layout, void* _data, uint _num, bool _index32, float _epsilon);
 	
+	/// <summary>
+	/// Weld vertices, and write unique vertices into compacted vertex stream.
+	/// </summary>
+	///
+	/// <param name="_output">Welded vertices remapping table. The size of buffer must be the same as number of vertices. Each entry is index of vertex in compacted vertex stream.</param>
+	/// <param name="_dstData">Compacted vertex stream. The size of buffer must be large enough to hold all vertices of input vertex stream. Unique vertices are written in order of their first occurrence.</param>
+	/// <param name="_layout">Vertex stream layout.</param>
+	/// <param name="_data">Vertex stream.</param>
+	/// <param name="_num">Number of vertices in vertex stream.</param>
+	/// <param name="_index32">Set to `true` if input indices are 32-bit.</param>
+	/// <param name="_epsilon">Error tolerance for vertex comparison.</param>
+	/// <param name="_flags">Weld flags, see `BGFX_WELD_*`.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_weld_vertices_compact", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe uint weld_vertices_compact(void* _output, void* _dstData, VertexLayout* _layout, void* _data, uint _num, bool _index32, float _epsilon, byte _flags);
+	
 	/// <summary>
 	/// Convert index buffer for use with different primitive topologies.
 	/// </summary>
@@ -2606,10 +2686,11 @@ public static partial class bgfx
 	/// Make reference to data to pass to bgfx. Unlike `bgfx::alloc`, this call
 	/// doesn't allocate memory for data. It just copies the _data pointer. You
 	/// can pass `ReleaseFn` function pointer to release this memory after it's
-	/// consumed, otherwise you must make sure _data is available for at least 2
-	/// `bgfx::frame` calls. `ReleaseFn` function must be able to be called
+	/// consumed, otherwise you must make sure _data is available for at least
+	/// `Init::Limits::maxFramesInFlight` + 1 `bgfx::frame` calls. `ReleaseFn` function must be able to be called
 	/// from any thread.
-	/// @attention Data passed must be available for at least 2 `bgfx::frame` calls.
+	/// @attention Data passed must be available for at least `Init::Limits::maxFramesInFlight` + 1
+	/// `bgfx::frame` calls.
 	/// </summary>
 	///
 	/// <param name="_data">Pointer to data.</param>
@@ -2622,10 +2703,11 @@ public static partial class bgfx
 	/// Make reference to data to pass to bgfx. Unlike `bgfx::alloc`, this call
 	/// doesn't allocate memory for data. It just copies the _data pointer. You
 	/// can pass `ReleaseFn` function pointer to release this memory after it's
-	/// consumed, otherwise you must make sure _data is available for at least 2
-	/// `bgfx::frame` calls. `ReleaseFn` function must be able to be called
+	/// consumed, otherwise you must make sure _data is available for at least
+	/// `Init::Limits::maxFramesInFlight` + 1 `bgfx::frame` calls. `ReleaseFn` function must be able to be called
 	/// from any thread.
-	/// @attention Data passed must be available for at least 2 `bgfx::frame` calls.
+	/// @attention Data passed must be available for at least `Init::Limits::maxFramesInFlight` + 1
+	/// `bgfx::frame` calls.
 	/// </summary>
 	///
 	/// <param name="_data">Pointer to data.</param>
@@ -2846,6 +2928,19 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_update_dynamic_vertex_buffer", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void update_dynamic_vertex_buffer(DynamicVertexBufferHandle _handle, uint _startVertex, Memory* _mem);
 	
+	/// <summary>
+	/// Update dynamic vertex buffer asynchronously. Update is queued, and issued
+	///   over one or more frames within upload budget. See `Init::Limits`.
+	/// @attention Asynchronous updates are not ordered with immediate updates.
+	/// </summary>
+	///
+	/// <param name="_handle">Dynamic vertex buffer handle.</param>
+	/// <param name="_startVertex">Start vertex.</param>
+	/// <param name="_mem">Vertex buffer data.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_update_dynamic_vertex_buffer_async", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe uint update_dynamic_vertex_buffer_async(DynamicVertexBufferHandle _handle, uint _startVertex, Memory* _mem);
+	
 	/// <summary>
 	/// Destroy dynamic vertex buffer.
 	/// </summary>
@@ -3158,6 +3253,37 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_update_texture_2d", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void update_texture_2d(TextureHandle _handle, ushort _layer, byte _mip, ushort _x, ushort _y, ushort _width, ushort _height, Memory* _mem, ushort _pitch);
 	
+	/// <summary>
+	/// Update 2D texture asynchronously. Update is queued, and issued over one
+	///   or more frames within upload budget. See `Init::Limits`.
+	/// @attention It's valid to update only mutable texture. See `bgfx::createTexture2D` for more info.
+	/// @attention Asynchronous updates are not ordered with immediate updates.
+	/// </summary>
+	///
+	/// <param name="_handle">Texture handle.</param>
+	/// <param name="_layer">Layer in texture array.</param>
+	/// <param name="_mip">Mip level.</param>
+	/// <param name="_x">X offset in texture.</param>
+	/// <param name="_y">Y offset in texture.</param>
+	/// <param name="_width">Width of texture block.</param>
+	/// <param name="_height">Height of texture block.</param>
+	/// <param name="_mem">Texture update data.</param>
+	/// <param name="_pitch">Pitch of input image (bytes). When _pitch is set to UINT16_MAX, it will be calculated internally based on _width.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_update_texture_2d_async", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe uint update_texture_2d_async(TextureHandle _handle, ushort _layer, byte _mip, ushort _x, ushort _y, ushort _width, ushort _height, Memory* _mem, ushort _pitch);
+	
+	/// <summary>
+	/// Returns true when asynchronous upload was consumed by render thread, and its
+	///   memory is released. Upload might still be in flight on GPU.
+	/// </summary>
+	///
+	/// <param name="_fence">Upload fence returned by asynchronous update function.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_is_upload_complete", CallingConvention = CallingConvention.Cdecl)]
+	[return: MarshalAs(UnmanagedType.I1)]
+	public static extern unsafe bool is_upload_complete(uint _fence);
+	
 	/// <summary>
 	/// Update 3D texture.
 	/// @attention It's valid to update only mutable texture. See `bgfx::createTexture3D` for more info.
@@ -3409,6 +3535,23 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_destroy_occlusion_query", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void destroy_occlusion_query(OcclusionQueryHandle _handle);
 	
+	/// <summary>
+	/// Create retained draw list. Draw calls recorded into draw list can be
+	/// submitted every frame without encoding them again.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_create_draw_list", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe DrawListHandle create_draw_list();
+	
+	/// <summary>
+	/// Destroy retained draw list.
+	/// </summary>
+	///
+	/// <param name="_handle">Handle to draw list object.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_destroy_draw_list", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void destroy_draw_list(DrawListHandle _handle);
+	
 	/// <summary>
 	/// Set palette color value.
 	/// </summary>
@@ -3963,6 +4106,90 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_encoder_submit_indirect_count", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void encoder_submit_indirect_count(Encoder* _this, ushort _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint _start, IndexBufferHandle _numHandle, uint _numIndex, uint _numMax, uint _depth, byte _flags);
 	
+	/// <summary>
+	/// Submit batch of draw calls sharing all state set on encoder. Only
+	/// transform, index (or vertex) range, and depth differ between draw calls.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_program">Program.</param>
+	/// <param name="_draws">Array of per draw call data.</param>
+	/// <param name="_num">Number of draw calls in array.</param>
+	/// <param name="_flags">Discard or preserve states. See `BGFX_DISCARD_*`.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_submit_batch", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_submit_batch(Encoder* _this, ushort _id, ProgramHandle _program, BatchDraw* _draws, uint _num, byte _flags);
+	
+	/// <summary>
+	/// Begin recording draw calls into retained draw list. Until `endDrawList`
+	/// is called, draw calls submitted with this encoder are recorded into draw
+	/// list instead of being submitted into frame, and view id passed to `submit`
+	/// is ignored. Previous content of draw list is discarded.
+	/// @remarks
+	///   Recorded draw calls must not use transient buffers, instance data
+	///   buffers allocated with `allocInstanceDataBuffer`, or occlusion queries.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw list handle.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_begin_draw_list", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_begin_draw_list(Encoder* _this, DrawListHandle _handle);
+	
+	/// <summary>
+	/// End recording draw calls into retained draw list.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_end_draw_list", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_end_draw_list(Encoder* _this);
+	
+	/// <summary>
+	/// Submit draw calls recorded in retained draw list.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Draw list handle.</param>
+	/// <param name="_mtx">Pointer to transform matrices replacing transforms recorded in draw list, or `NULL` to use recorded transforms.</param>
+	/// <param name="_num">Number of matrices in array. Must be equal to number of matrices recorded in draw list.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_submit_draw_list", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_submit_draw_list(Encoder* _this, ushort _id, DrawListHandle _handle, void* _mtx, ushort _num);
+	
+	/// <summary>
+	/// Allocate transient index buffer. Encoder reserves chunks of frame's
+	/// transient index buffer, and sub-allocates from them without locking.
+	/// </summary>
+	///
+	/// <param name="_tib">TransientIndexBuffer structure will be filled, and will be valid for the duration of frame, and can be reused for multiple draw calls.</param>
+	/// <param name="_num">Number of indices to allocate.</param>
+	/// <param name="_index32">Set to `true` if input indices will be 32-bit.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_alloc_transient_index_buffer", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_alloc_transient_index_buffer(Encoder* _this, TransientIndexBuffer* _tib, uint _num, bool _index32);
+	
+	/// <summary>
+	/// Allocate transient vertex buffer. Encoder reserves chunks of frame's
+	/// transient vertex buffer, and sub-allocates from them without locking.
+	/// </summary>
+	///
+	/// <param name="_tvb">TransientVertexBuffer structure will be filled, and will be valid for the duration of frame, and can be reused for multiple draw calls.</param>
+	/// <param name="_num">Number of vertices to allocate.</param>
+	/// <param name="_layout">Vertex layout.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_alloc_transient_vertex_buffer", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_alloc_transient_vertex_buffer(Encoder* _this, TransientVertexBuffer* _tvb, uint _num, VertexLayout* _layout);
+	
+	/// <summary>
+	/// Allocate instance data buffer from encoder's transient vertex buffer
+	/// chunk.
+	/// </summary>
+	///
+	/// <param name="_idb">InstanceDataBuffer structure will be filled, and will be valid for duration of frame, and can be reused for multiple draw calls.</param>
+	/// <param name="_num">Number of instances.</param>
+	/// <param name="_stride">Instance stride. Must be multiple of 16.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_alloc_instance_data_buffer", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_alloc_instance_data_buffer(Encoder* _this, InstanceDataBuffer* _idb, uint _num, ushort _stride);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -4105,6 +4332,21 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_request_screen_shot", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void request_screen_shot(FrameBufferHandle _handle, [MarshalAs(UnmanagedType.LPStr)] string _filePath);
 	
+	/// <summary>
+	/// Replay pipeline manifest recorded in previous runs, and prewarm pipelines listed in it
+	/// before next frame is rendered.
+	/// @remarks
+	///   Manifest is recorded by renderer for every unique pipeline it creates, and it's stored
+	///   with `bgfx::CallbackI::cacheWrite`. Pipelines depending on programs created after this
+	///   call, but before next `bgfx::frame` are prewarmed too. Creation time of each pipeline
+	///   is reported in `bgfx::Stats::pipelineStats`.
+	/// @attention Only Vulkan and OpenGL (with program binary support) renderers record
+	///   pipeline manifest.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_replay_pipeline_manifest", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void replay_pipeline_manifest();
+	
 	/// <summary>
 	/// Render frame.
 	/// @attention `bgfx::renderFrame` is blocking call. It waits for
@@ -4540,6 +4782,54 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_submit_indirect_count", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void submit_indirect_count(ushort _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint _start, IndexBufferHandle _numHandle, uint _numIndex, uint _numMax, uint _depth, byte _flags);
 	
+	/// <summary>
+	/// Submit batch of draw calls sharing all state set for draw call. Only
+	/// transform, index (or vertex) range, and depth differ between draw calls.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_program">Program.</param>
+	/// <param name="_draws">Array of per draw call data.</param>
+	/// <param name="_num">Number of draw calls in array.</param>
+	/// <param name="_flags">Discard or preserve states. See `BGFX_DISCARD_*`.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_submit_batch", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void submit_batch(ushort _id, ProgramHandle _program, BatchDraw* _draws, uint _num, byte _flags);
+	
+	/// <summary>
+	/// Begin recording draw calls into retained draw list. Until `endDrawList`
+	/// is called, draw calls are recorded into draw list instead of being
+	/// submitted into frame, and view id passed to `submit` is ignored.
+	/// Previous content of draw list is discarded.
+	/// @remarks
+	///   Recorded draw calls must not use transient buffers, instance data
+	///   buffers allocated with `allocInstanceDataBuffer`, or occlusion queries.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw list handle.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_begin_draw_list", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void begin_draw_list(DrawListHandle _handle);
+	
+	/// <summary>
+	/// End recording draw calls into retained draw list.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_end_draw_list", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void end_draw_list();
+	
+	/// <summary>
+	/// Submit draw calls recorded in retained draw list.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Draw list handle.</param>
+	/// <param name="_mtx">Pointer to transform matrices replacing transforms recorded in draw list, or `NULL` to use recorded transforms.</param>
+	/// <param name="_num">Number of matrices in array. Must be equal to number of matrices recorded in draw list.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_submit_draw_list", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void submit_draw_list(ushort _id, DrawListHandle _handle, void* _mtx, ushort _num);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -354,6 +354,13 @@ pub const DiscardFlags_VertexStreams: DiscardFlags          = 0x00000020;
 /// Discard all states.
 pub const DiscardFlags_All: DiscardFlags                    = 0x000000ff;
 
+pub const WeldFlags = u32;
+/// Compare vertex position only.
+pub const WeldFlags_None: WeldFlags                   = 0x00000000;
+
+/// Compare all vertex attributes, not only position.
+pub const WeldFlags_AllAttributes: WeldFlags          = 0x00000001;
+
 pub const DebugFlags = u32;
 /// No debug.
 pub const DebugFlags_None: DebugFlags                   = 0x00000000;
@@ -1311,6 +1318,8 @@ pub const Caps = extern struct {
         minResourceCbSize: u32,
         transientVbSize: u32,
         transientIbSize: u32,
+        maxSortThreads: u32,
+        maxFramesInFlight: u32,
     };
 
         rendererType: RendererType,
@@ -1355,6 +1364,12 @@ pub const Init = extern struct {
         minResourceCbSize: u32,
         transientVbSize: u32,
         transientIbSize: u32,
+        transientMaxVbSize: u32,
+        transientMaxIbSize: u32,
+        uploadBudgetSize: u32,
+        uploadBudgetTime: u32,
+        maxSortThreads: u16,
+        maxFramesInFlight: u16,
     };
 
         type: RendererType,
@@ -1443,6 +1458,14 @@ pub const Init = extern struct {
         num: u16,
     };
 
+    pub const BatchDraw = extern struct {
+        transform: u32,
+        numMatrices: u16,
+        start: u32,
+        num: u32,
+        depth: u32,
+    };
+
     pub const ViewStats = extern struct {
         name: [256]u8,
         view: ViewId,
@@ -1456,6 +1479,14 @@ pub const Init = extern struct {
     pub const EncoderStats = extern struct {
         cpuTimeBegin: i64,
         cpuTimeEnd: i64,
+        waitBeginTime: i64,
+        numRetries: u32,
+    };
+
+    pub const PipelineStats = extern struct {
+        id: u64,
+        cpuTimeCreate: i64,
+        prewarm: bool,
     };
 
     pub const Stats = extern struct {
@@ -1473,6 +1504,8 @@ pub const Init = extern struct {
         numBlit: u32,
         maxGpuLatency: u32,
         gpuFrameNum: u32,
+        numSortedItems: u32,
+        numUniformDedup: u32,
         numDynamicIndexBuffers: u16,
         numDynamicVertexBuffers: u16,
         numFrameBuffers: u16,
@@ -1488,6 +1521,21 @@ pub const Init = extern struct {
         rtMemoryUsed: i64,
         transientVbUsed: i32,
         transientIbUsed: i32,
+        transientVbSize: i32,
+        transientIbSize: i32,
+        transientVbOverflow: i32,
+        transientIbOverflow: i32,
+        transientVbWasted: i32,
+        transientIbWasted: i32,
+        dynamicIbFree: i64,
+        dynamicVbFree: i64,
+        dynamicIbFreeMax: u32,
+        dynamicVbFreeMax: u32,
+        dynamicIbFreeBlocks: u32,
+        dynamicVbFreeBlocks: u32,
+        uploadPending: u32,
+        uploadPendingSize: u32,
+        uploadSize: u32,
         numPrims: [5]u32,
         gpuMemoryMax: i64,
         gpuMemoryUsed: i64,
@@ -1499,6 +1547,8 @@ pub const Init = extern struct {
         viewStats: [*c]ViewStats,
         numEncoders: u8,
         encoderStats: [*c]EncoderStats,
+        numPipelines: u16,
+        pipelineStats: [*c]PipelineStats,
     };
 
     pub const VertexLayout = extern struct {
@@ -1784,6 +1834,63 @@ pub const Init = extern struct {
         pub inline fn submitIndirectCount(self: ?*Encoder, _id: ViewId, _program: ProgramHandle, _indirectHandle: IndirectBufferHandle, _start: u32, _numHandle: IndexBufferHandle, _numIndex: u32, _numMax: u32, _depth: u32, _flags: u8) void {
             return bgfx_encoder_submit_indirect_count(self, _id, _program, _indirectHandle, _start, _numHandle, _numIndex, _numMax, _depth, _flags);
         }
+        /// Submit batch of draw calls sharing all state set on encoder. Only
+        /// transform, index (or vertex) range, and depth differ between draw calls.
+        /// <param name="_id">View id.</param>
+        /// <param name="_program">Program.</param>
+        /// <param name="_draws">Array of per draw call data.</param>
+        /// <param name="_num">Number of draw calls in array.</param>
+        /// <param name="_flags">Discard or preserve states. See `BGFX_DISCARD_*`.</param>
+        pub inline fn submitBatch(self: ?*Encoder, _id: ViewId, _program: ProgramHandle, _draws: [*c]const BatchDraw, _num: u32, _flags: u8) void {
+            return bgfx_encoder_submit_batch(self, _id, _program, _draws, _num, _flags);
+        }
+        /// Begin recording draw calls into retained draw list. Until `endDrawList`
+        /// is called, draw calls submitted with this encoder are recorded into draw
+        /// list instead of being submitted into frame, and view id passed to `submit`
+        /// is ignored. Previous content of draw list is discarded.
+        /// @remarks
+        ///   Recorded draw calls must not use transient buffers, instance data
+        ///   buffers allocated with `allocInstanceDataBuffer`, or occlusion queries.
+        /// <param name="_handle">Draw list handle.</param>
+        pub inline fn beginDrawList(self: ?*Encoder, _handle: DrawListHandle) void {
+            return bgfx_encoder_begin_draw_list(self, _handle);
+        }
+        /// End recording draw calls into retained draw list.
+        pub inline fn endDrawList(self: ?*Encoder) void {
+            return bgfx_encoder_end_draw_list(self);
+        }
+        /// Submit draw calls recorded in retained draw list.
+        /// <param name="_id">View id.</param>
+        /// <param name="_handle">Draw list handle.</param>
+        /// <param name="_mtx">Pointer to transform matrices replacing transforms recorded in draw list, or `NULL` to use recorded transforms.</param>
+        /// <param name="_num">Number of matrices in array. Must be equal to number of matrices recorded in draw list.</param>
+        pub inline fn submitDrawList(self: ?*Encoder, _id: ViewId, _handle: DrawListHandle, _mtx: ?*const anyopaque, _num: u16) void {
+            return bgfx_encoder_submit_draw_list(self, _id, _handle, _mtx, _num);
+        }
+        /// Allocate transient index buffer. Encoder reserves chunks of frame's
+        /// transient index buffer, and sub-allocates from them without locking.
+        /// <param name="_tib">TransientIndexBuffer structure will be filled, and will be valid for the duration of frame, and can be reused for multiple draw calls.</param>
+        /// <param name="_num">Number of indices to allocate.</param>
+        /// <param name="_index32">Set to `true` if input indices will be 32-bit.</param>
+        pub inline fn allocTransientIndexBuffer(self: ?*Encoder, _tib: [*c]TransientIndexBuffer, _num: u32, _index32: bool) void {
+            return bgfx_encoder_alloc_transient_index_buffer(self, _tib, _num, _index32);
+        }
+        /// Allocate transient vertex buffer. Encoder reserves chunks of frame's
+        /// transient vertex buffer, and sub-allocates from them without locking.
+        /// <param name="_tvb">TransientVertexBuffer structure will be filled, and will be valid for the duration of frame, and can be reused for multiple draw calls.</param>
+        /// <param name="_num">Number of vertices to allocate.</param>
+        /// <param name="_layout">Vertex layout.</param>
+        pub inline fn allocTransientVertexBuffer(self: ?*Encoder, _tvb: [*c]TransientVertexBuffer, _num: u32, _layout: [*c]const VertexLayout) void {
+            return bgfx_encoder_alloc_transient_vertex_buffer(self, _tvb, _num, _layout);
+        }
+        /// Allocate instance data buffer from encoder's transient vertex buffer
+        /// chunk.
+        /// <param name="_idb">InstanceDataBuffer structure will be filled, and will be valid for duration of frame, and can be reused for multiple draw calls.</param>
+        /// <param name="_num">Number of instances.</param>
+        /// <param name="_stride">Instance stride. Must be multiple of 16.</param>
+        pub inline fn allocInstanceDataBuffer(self: ?*Encoder, _idb: [*c]InstanceDataBuffer, _num: u32, _stride: u16) void {
+            return bgfx_encoder_alloc_instance_data_buffer(self, _idb, _num, _stride);
+        }
         /// Set compute index buffer.
         /// <param name="_stage">Compute stage.</param>
         /// <param name="_handle">Index buffer handle.</param>
@@ -1875,6 +1982,10 @@ pub const Init = extern struct {
         }
     };
 
+pub const DrawListHandle = extern struct {
+    idx: c_ushort,
+};
+
 pub const DynamicIndexBufferHandle = extern struct {
     idx: c_ushort,
 };
@@ -2007,6 +2118,20 @@ pub inline fn weldVertices(_output: ?*anyopaque, _layout: [*c]const VertexLayout
 }
 extern fn bgfx_weld_vertices(_output: ?*anyopaque, _layout: [*c]const VertexLayout, _data: ?*const anyopaque, _num: u32, _index32: bool, _epsilon: f32) u32;
 
+/// Weld vertices, and write unique vertices into compacted vertex stream.
+/// <param name="_output">Welded vertices remapping table. The size of buffer must be the same as number of vertices. Each entry is index of vertex in compacted vertex stream.</param>
+/// <param name="_dstData">Compacted vertex stream. The size of buffer must be large enough to hold all vertices of input vertex stream. Unique vertices are written in order of their first occurrence.</param>
+/// <param name="_layout">Vertex stream layout.</param>
+/// <param name="_data">Vertex stream.</param>
+/// <param name="_num">Number of vertices in vertex stream.</param>
+/// <param name="_index32">Set to `true` if input indices are 32-bit.</param>
+/// <param name="_epsilon">Error tolerance for vertex comparison.</param>
+/// <param name="_flags">Weld flags, see `BGFX_WELD_*`.</param>
+pub inline fn weldVerticesCompact(_output: ?*anyopaque, _dstData: ?*anyopaque, _layout: [*c]const VertexLayout, _data: ?*const anyopaque, _num: u32, _index32: bool, _epsilon: f32, _flags: u8) u32 {
+    return bgfx_weld_vertices_compact(_output, _dstData, _layout, _data, _num, _index32, _epsilon, _flags);
+}
+extern fn bgfx_weld_vertices_compact(_output: ?*anyopaque, _dstData: ?*anyopaque, _layout: [*c]const VertexLayout, _data: ?*const anyopaque, _num: u32, _index32: bool, _epsilon: f32, _flags: u8) u32;
+
 /// Convert index buffer for use with different primitive topologies.
 /// <param name="_conversion">Conversion type, see `TopologyConvert::Enum`.</param>
 /// <param name="_dst">Destination index buffer. If this argument is NULL function will return number of indices after conversion.</param>
@@ -2132,10 +2257,11 @@ extern fn bgfx_copy(_data: ?*const anyopaque, _size: u32) [*c]const Memory;
 /// Make reference to data to pass to bgfx. Unlike `bgfx::alloc`, this call
 /// doesn't allocate memory for data. It just copies the _data pointer. You
 /// can pass `ReleaseFn` function pointer to release this memory after it's
-/// consumed, otherwise you must make sure _data is available for at least 2
-/// `bgfx::frame` calls. `ReleaseFn` function must be able to be called
+/// consumed, otherwise you must make sure _data is available for at least
+/// `Init::Limits::maxFramesInFlight` + 1 `bgfx::frame` calls. `ReleaseFn` function must be able to be called
 /// from any thread.
-/// @attention Data passed must be available for at least 2 `bgfx::frame` calls.
+/// @attention Data passed must be available for at least `Init::Limits::maxFramesInFlight` + 1
+/// `bgfx::frame` calls.
 /// <param name="_data">Pointer to data.</param>
 /// <param name="_size">Size of data.</param>
 pub inline fn makeRef(_data: ?*const anyopaque, _size: u32) [*c]const Memory {
@@ -2146,10 +2272,11 @@ extern fn bgfx_make_ref(_data: ?*const anyopaque, _size: u32) [*c]const Memory;
 /// Make reference to data to pass to bgfx. Unlike `bgfx::alloc`, this call
 /// doesn't allocate memory for data. It just copies the _data pointer. You
 /// can pass `ReleaseFn` function pointer to release this memory after it's
-/// consumed, otherwise you must make sure _data is available for at least 2
-/// `bgfx::frame` calls. `ReleaseFn` function must be able to be called
+/// consumed, otherwise you must make sure _data is available for at least
+/// `Init::Limits::maxFramesInFlight` + 1 `bgfx::frame` calls. `ReleaseFn` function must be able to be called
 /// from any thread.
-/// @attention Data passed must be available for at least 2 `bgfx::frame` calls.
+/// @attention Data passed must be available for at least `Init::Limits::maxFramesInFlight` + 1
+/// `bgfx::frame` calls.
 /// <param name="_data">Pointer to data.</param>
 /// <param name="_size">Size of data.</param>
 /// <param name="_releaseFn">Callback function to release memory after use.</param>
@@ -2308,6 +2435,17 @@ pub inline fn updateDynamicVertexBuffer(_handle: DynamicVertexBufferHandle, _sta
 }
 extern fn bgfx_update_dynamic_vertex_buffer(_handle: DynamicVertexBufferHandle, _startVertex: u32, _mem: [*c]const Memory) void;
 
+/// Update dynamic vertex buffer asynchronously. Update is queued, and issued
+///   over one or more frames within upload budget. See `Init::Limits`.
+/// @attention Asynchronous updates are not ordered with immediate updates.
+/// <param name="_handle">Dynamic vertex buffer handle.</param>
+/// <param name="_startVertex">Start vertex.</param>
+/// <param name="_mem">Vertex buffer data.</param>
+pub inline fn updateDynamicVertexBufferAsync(_handle: DynamicVertexBufferHandle, _startVertex: u32, _mem: [*c]const Memory) u32 {
+    return bgfx_update_dynamic_vertex_buffer_async(_handle, _startVertex, _mem);
+}
+extern fn bgfx_update_dynamic_vertex_buffer_async(_handle: DynamicVertexBufferHandle, _startVertex: u32, _mem: [*c]const Memory) u32;
+
 /// Destroy dynamic vertex buffer.
 /// <param name="_handle">Dynamic vertex buffer handle.</param>
 pub inline fn destroyDynamicVertexBuffer(_handle: DynamicVertexBufferHandle) void {
@@ -2565,6 +2703,32 @@ pub inline fn updateTexture2D(_handle: TextureHandle, _layer: u16, _mip: u8, _x:
 }
 extern fn bgfx_update_texture_2d(_handle: TextureHandle, _layer: u16, _mip: u8, _x: u16, _y: u16, _width: u16, _height: u16, _mem: [*c]const Memory, _pitch: u16) void;
 
+/// Update 2D texture asynchronously. Update is queued, and issued over one
+///   or more frames within upload budget. See `Init::Limits`.
+/// @attention It's valid to update only mutable texture. See `bgfx::createTexture2D` for more info.
+/// @attention Asynchronous updates are not ordered with immediate updates.
+/// <param name="_handle">Texture handle.</param>
+/// <param name="_layer">Layer in texture array.</param>
+/// <param name="_mip">Mip level.</param>
+/// <param name="_x">X offset in texture.</param>
+/// <param name="_y">Y offset in texture.</param>
+/// <param name="_width">Width of texture block.</param>
+/// <param name="_height">Height of texture block.</param>
+/// <param name="_mem">Texture update data.</param>
+/// <param name="_pitch">Pitch of input image (bytes). When _pitch is set to UINT16_MAX, it will be calculated internally based on _width.</param>
+pub inline fn updateTexture2DAsync(_handle: TextureHandle, _layer: u16, _mip: u8, _x: u16, _y: u16, _width: u16, _height: u16, _mem: [*c]const Memory, _pitch: u16) u32 {
+    return bgfx_update_texture_2d_async(_handle, _layer, _mip, _x, _y, _width, _height, _mem, _pitch);
+}
+extern fn bgfx_update_texture_2d_async(_handle: TextureHandle, _layer: u16, _mip: u8, _x: u16, _y: u16, _width: u16, _height: u16, _mem: [*c]const Memory, _pitch: u16) u32;
+
+/// Returns true when asynchronous upload was consumed by render thread, and its
+///   memory is released. Upload might still be in flight on GPU.
+/// <param name="_fence">Upload fence returned by asynchronous update function.</param>
+pub inline fn isUploadComplete(_fence: u32) bool {
+    return bgfx_is_upload_complete(_fence);
+}
+extern fn bgfx_is_upload_complete(_fence: u32) bool;
+
 /// Update 3D texture.
 /// @attention It's valid to update only mutable texture. See `bgfx::createTexture3D` for more info.
 /// <param name="_handle">Texture handle.</param>
@@ -2777,6 +2941,20 @@ pub inline fn destroyOcclusionQuery(_handle: OcclusionQueryHandle) void {
 }
 extern fn bgfx_destroy_occlusion_query(_handle: OcclusionQueryHandle) void;
 
+/// Create retained draw list. Draw calls recorded into draw list can be
+/// submitted every frame without encoding them again.
+pub inline fn createDrawList() DrawListHandle {
+    return bgfx_create_draw_list();
+}
+extern fn bgfx_create_draw_list() DrawListHandle;
+
+/// Destroy retained draw list.
+/// <param name="_handle">Handle to draw list object.</param>
+pub inline fn destroyDrawList(_handle: DrawListHandle) void {
+    return bgfx_destroy_draw_list(_handle);
+}
+extern fn bgfx_destroy_draw_list(_handle: DrawListHandle) void;
+
 /// Set palette color value.
 /// <param name="_index">Index into palette.</param>
 /// <param name="_rgba">RGBA floating point values.</param>
@@ -3155,6 +3333,56 @@ extern fn bgfx_encoder_submit_indirect(self: ?*Encoder, _id: ViewId, _program: P
 /// <param name="_flags">Discard or preserve states. See `BGFX_DISCARD_*`.</param>
 extern fn bgfx_encoder_submit_indirect_count(self: ?*Encoder, _id: ViewId, _program: ProgramHandle, _indirectHandle: IndirectBufferHandle, _start: u32, _numHandle: IndexBufferHandle, _numIndex: u32, _numMax: u32, _depth: u32, _flags: u8) void;
 
+/// Submit batch of draw calls sharing all state set on encoder. Only
+/// transform, index (or vertex) range, and depth differ between draw calls.
+/// <param name="_id">View id.</param>
+/// <param name="_program">Program.</param>
+/// <param name="_draws">Array of per draw call data.</param>
+/// <param name="_num">Number of draw calls in array.</param>
+/// <param name="_flags">Discard or preserve states. See `BGFX_DISCARD_*`.</param>
+extern fn bgfx_encoder_submit_batch(self: ?*Encoder, _id: ViewId, _program: ProgramHandle, _draws: [*c]const BatchDraw, _num: u32, _flags: u8) void;
+
+/// Begin recording draw calls into retained draw list. Until `endDrawList`
+/// is called, draw calls submitted with this encoder are recorded into draw
+/// list instead of being submitted into frame, and view id passed to `submit`
+/// is ignored. Previous content of draw list is discarded.
+/// @remarks
+///   Recorded draw calls must not use transient buffers, instance data
+///   buffers allocated with `allocInstanceDataBuffer`, or occlusion queries.
+/// <param name="_handle">Draw list handle.</param>
+extern fn bgfx_encoder_begin_draw_list(self: ?*Encoder, _handle: DrawListHandle) void;
+
+/// End recording draw calls into retained draw list.
+extern fn bgfx_encoder_end_draw_list(self: ?*Encoder) void;
+
+/// Submit draw calls recorded in retained draw list.
+/// <param name="_id">View id.</param>
+/// <param name="_handle">Draw list handle.</param>
+/// <param name="_mtx">Pointer to transform matrices replacing transforms recorded in draw list, or `NULL` to use recorded transforms.</param>
+/// <param name="_num">Number of matrices in array. Must be equal to number of matrices recorded in draw list.</param>
+extern fn bgfx_encoder_submit_draw_list(self: ?*Encoder, _id: ViewId, _handle: DrawListHandle, _mtx: ?*const anyopaque, _num: u16) void;
+
+/// Allocate transient index buffer. Encoder reserves chunks of frame's
+/// transient index buffer, and sub-allocates from them without locking.
+/// <param name="_tib">TransientIndexBuffer structure will be filled, and will be valid for the duration of frame, and can be reused for multiple draw calls.</param>
+/// <param name="_num">Number of indices to allocate.</param>
+/// <param name="_index32">Set to `true` if input indices will be 32-bit.</param>
+extern fn bgfx_encoder_alloc_transient_index_buffer(self: ?*Encoder, _tib: [*c]TransientIndexBuffer, _num: u32, _index32: bool) void;
+
+/// Allocate transient vertex buffer. Encoder reserves chunks of frame's
+/// transient vertex buffer, and sub-allocates from them without locking.
+/// <param name="_tvb">TransientVertexBuffer structure will be filled, and will be valid for the duration of frame, and can be reused for multiple draw calls.</param>
+/// <param name="_num">Number of vertices to allocate.</param>
+/// <param name="_layout">Vertex layout.</param>
+extern fn bgfx_encoder_alloc_transient_vertex_buffer(self: ?*Encoder, _tvb: [*c]TransientVertexBuffer, _num: u32, _layout: [*c]const VertexLayout) void;
+
+/// Allocate instance data buffer from encoder's transient vertex buffer
+/// chunk.
+/// <param name="_idb">InstanceDataBuffer structure will be filled, and will be valid for duration of frame, and can be reused for multiple draw calls.</param>
+/// <param name="_num">Number of instances.</param>
+/// <param name="_stride">Instance stride. Must be multiple of 16.</param>
+extern fn bgfx_encoder_alloc_instance_data_buffer(self: ?*Encoder, _idb: [*c]InstanceDataBuffer, _num: u32, _stride: u16) void;
+
 /// Set compute index buffer.
 /// <param name="_stage">Compute stage.</param>
 /// <param name="_handle">Index buffer handle.</param>
@@ -3245,6 +3473,20 @@ pub inline fn requestScreenShot(_handle: FrameBufferHandle, _filePath: [*c]const
 }
 extern fn bgfx_request_screen_shot(_handle: FrameBufferHandle, _filePath: [*c]const u8) void;
 
+/// Replay pipeline manifest recorded in previous runs, and prewarm pipelines listed in it
+/// before next frame is rendered.
+/// @remarks
+///   Manifest is recorded by renderer for every unique pipeline it creates, and it's stored
+///   with `bgfx::CallbackI::cacheWrite`. Pipelines depending on programs created after this
+///   call, but before next `bgfx::frame` are prewarmed too. Creation time of each pipeline
+///   is reported in `bgfx::Stats::pipelineStats`.
+/// @attention Only Vulkan and OpenGL (with program binary support) renderers record
+///   pipeline manifest.
+pub inline fn replayPipelineManifest() void {
+    return bgfx_replay_pipeline_manifest();
+}
+extern fn bgfx_replay_pipeline_manifest() void;
+
 /// Render frame.
 /// @attention `bgfx::renderFrame` is blocking call. It waits for
 ///   `bgfx::frame` to be called from API thread to process frame.
@@ -3612,6 +3854,47 @@ pub inline fn submitIndirectCount(_id: ViewId, _program: ProgramHandle, _indirec
 }
 extern fn bgfx_submit_indirect_count(_id: ViewId, _program: ProgramHandle, _indirectHandle: IndirectBufferHandle, _start: u32, _numHandle: IndexBufferHandle, _numIndex: u32, _numMax: u32, _depth: u32, _flags: u8) void;
 
+/// Submit batch of draw calls sharing all state set for draw call. Only
+/// transform, index (or vertex) range, and depth differ between draw calls.
+/// <param name="_id">View id.</param>
+/// <param name="_program">Program.</param>
+/// <param name="_draws">Array of per draw call data.</param>
+/// <param name="_num">Number of draw calls in array.</param>
+/// <param name="_flags">Discard or preserve states. See `BGFX_DISCARD_*`.</param>
+pub inline fn submitBatch(_id: ViewId, _program: ProgramHandle, _draws: [*c]const BatchDraw, _num: u32, _flags: u8) void {
+    return bgfx_submit_batch(_id, _program, _draws, _num, _flags);
+}
+extern fn bgfx_submit_batch(_id: ViewId, _program: ProgramHandle, _draws: [*c]const BatchDraw, _num: u32, _flags: u8) void;
+
+/// Begin recording draw calls into retained draw list. Until `endDrawList`
+/// is called, draw calls are recorded into draw list instead of being
+/// submitted into frame, and view id passed to `submit` is ignored.
+/// Previous content of draw list is discarded.
+/// @remarks
+///   Recorded draw calls must not use transient buffers, instance data
+///   buffers allocated with `allocInstanceDataBuffer`, or occlusion queries.
+/// <param name="_handle">Draw list handle.</param>
+pub inline fn beginDrawList(_handle: DrawListHandle) void {
+    return bgfx_begin_draw_list(_handle);
+}
+extern fn bgfx_begin_draw_list(_handle: DrawListHandle) void;
+
+/// End recording draw calls into retained draw list.
+pub inline fn endDrawList() void {
+    return bgfx_end_draw_list();
+}
+extern fn bgfx_end_draw_list() void;
+
+/// Submit draw calls recorded in retained draw list.
+/// <param name="_id">View id.</param>
+/// <param name="_handle">Draw list handle.</param>
+/// <param name="_mtx">Pointer to transform matrices replacing transforms recorded in draw list, or `NULL` to use recorded transforms.</param>
+/// <param name="_num">Number of matrices in array. Must be equal to number of matrices recorded in draw list.</param>
+pub inline fn submitDrawList(_id: ViewId, _handle: DrawListHandle, _mtx: ?*const anyopaque, _num: u16) void {
+    return bgfx_submit_draw_list(_id, _handle, _mtx, _num);
+}
+extern fn bgfx_submit_draw_list(_id: ViewId, _handle: DrawListHandle, _mtx: ?*const anyopaque, _num: u16) void;
+
 /// Set compute index buffer.
 /// <param name="_stage">Compute stage.</param>
 /// <param name="_handle">Index buffer handle.</param>
@@ -174,8 +174,8 @@ public:
 		bgfx::destroy(m_vt_unlit);
 		bgfx::destroy(m_vt_mip);
 
-		delete m_vti;
 		delete m_vt;
+		delete m_vti;
 		delete m_feedbackBuffer;
 
 		// Shutdown bgfx.
@@ -256,6 +256,12 @@ public:
 					m_vt->setUploadsPerFrame(uploadsperframe);
 				}
 
+				const vt::PageLoader::Stats& loaderStats = m_vt->getLoaderStats();
+				ImGui::Text("Pages loaded: %d (%.1f/s)", loaderStats.m_completed, loaderStats.m_pagesPerSec);
+				ImGui::Text("Load latency: %.2f [ms]", loaderStats.m_latencyMs);
+				ImGui::Text("Queue: %d pending, %d loading", loaderStats.m_pending, loaderStats.m_loading);
+				ImGui::Text("Cancelled: %d, rejected: %d", loaderStats.m_cancelled, loaderStats.m_rejected);
+
 				ImGui::ImageButton(m_vt->getAtlastTexture(), ImVec2(m_width / 5.0f - 16.0f, m_width / 5.0f - 16.0f));
 				ImGui::ImageButton(bgfx::getTexture(m_feedbackBuffer->getFrameBuffer()), ImVec2(m_width / 5.0f - 16.0f, m_width / 5.0f - 16.0f));
 
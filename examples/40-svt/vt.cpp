@@ -13,17 +13,32 @@
   *   http://web.archive.org/web/20190103162730/http://www.celestiamotherlode.net/catalog/mars.php
   */
 
+#include <bx/cpu.h>
 #include <bx/file.h>
 #include <bx/sort.h>
+#include <bx/timer.h>
 
 #include "vt.h"
 
+#if BX_PLATFORM_WINDOWS
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif // NOMINMAX
+#	include <windows.h>
+#elif BX_PLATFORM_POSIX
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif // BX_PLATFORM_*
+
 namespace vt
 {
 
 // Constants
 static const int s_channelCount = 4;
-static const int s_tileFileDataOffset = sizeof(VirtualTextureInfo);
+static const int s_generatorThreadCount = 4;
+static const uint32_t s_tileFileMagic = BX_MAKEFOURCC('V', 'T', 'C', 1);
 
 // Page
 Page::operator size_t() const
@@ -61,6 +76,13 @@ int VirtualTextureInfo::GetPageSize() const
 	return m_tileSize + 2 * m_borderSize;
 }
 
+// Pages are padded to multiple of 4 pixels for block compression, staging
+// memory uses the same row stride so that pages can be decoded directly into it
+int VirtualTextureInfo::GetPageStride() const
+{
+	return bx::alignUp(GetPageSize(), 4);
+}
+
 int VirtualTextureInfo::GetPageTableSize() const
 {
 	return m_virtualTextureSize / m_tileSize;
@@ -499,29 +521,280 @@ bgfx::TextureHandle PageTable::getTexture()
 }
 
 // PageLoader
-PageLoader::PageLoader(TileDataFile* _tileDataFile, PageIndexer* _indexer, VirtualTextureInfo* _info)
+PageLoader::PageLoader(TileDataFile* _tileDataFile, PageIndexer* _indexer, VirtualTextureInfo* _info, int _queueSize, int _numThreads)
 	: m_colorMipLevels(false)
 	, m_showBorders(false)
 	, m_tileDataFile(_tileDataFile)
 	, m_indexer(_indexer)
 	, m_info(_info)
+	, m_shutdown(false)
+	, m_frame(0)
+	, m_generation(0)
+	, m_statsTime(bx::getHPCounter())
+	, m_statsCompleted(0)
+	, m_statsLatency(0)
 {
+	bx::memSet(&m_stats, 0, sizeof(m_stats));
+
+	int size = m_info->GetPageStride() * m_info->GetPageStride() * s_channelCount;
+
+	m_queue.resize(_queueSize);
+	for (auto& state : m_queue)
+	{
+		state.m_state = ReadState::Free;
+		state.m_data.resize(size);
+	}
+
+	for (int i = 0; i < _numThreads; ++i)
+	{
+		auto thread = BX_NEW(VirtualTexture::getAllocator(), bx::Thread);
+		thread->init(threadFunc, this, 0, "vt page loader");
+		m_threads.push_back(thread);
+	}
 }
 
-void PageLoader::submit(Page request)
+PageLoader::~PageLoader()
 {
-	ReadState state;
-	state.m_page = request;
-	loadPage(state);
-	onPageLoadComplete(state);
+	{
+		bx::MutexScope lock(m_mutex);
+		m_shutdown = true;
+	}
+
+	for (int i = 0; i < (int)m_threads.size(); ++i)
+	{
+		m_sem.post();
+	}
+
+	for (auto thread : m_threads)
+	{
+		thread->shutdown();
+		bx::deleteObject(VirtualTexture::getAllocator(), thread);
+	}
 }
 
-void PageLoader::loadPage(ReadState& state)
+// Queue page for loading, returns false if queue is full
+bool PageLoader::submit(const PageCount& request)
+{
+	{
+		bx::MutexScope lock(m_mutex);
+
+		ReadState* state = nullptr;
+		for (auto& it : m_queue)
+		{
+			if (it.m_state == ReadState::Free)
+			{
+				state = &it;
+				break;
+			}
+		}
+
+		if (state == nullptr)
+		{
+			++m_stats.m_rejected;
+			return false;
+		}
+
+		state->m_page           = request.m_page;
+		state->m_count          = request.m_count;
+		state->m_frame          = m_frame;
+		state->m_generation     = m_generation;
+		state->m_state          = ReadState::Pending;
+		state->m_submitTime     = bx::getHPCounter();
+		state->m_colorMipLevels = m_colorMipLevels;
+		state->m_showBorders    = m_showBorders;
+		++m_stats.m_submitted;
+	}
+
+	m_sem.post();
+	return true;
+}
+
+// Page is still requested by feedback, keep it in queue and update its priority
+bool PageLoader::touch(const PageCount& request)
+{
+	bx::MutexScope lock(m_mutex);
+
+	for (auto& state : m_queue)
+	{
+		if (state.m_state != ReadState::Free
+		&&  state.m_page == request.m_page)
+		{
+			state.m_count = request.m_count;
+			state.m_frame = m_frame;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Called once per frame from main thread, hands loaded pages to cache and drops stale requests
+void PageLoader::update(int maxCompletions)
+{
+	tinystl::vector<ReadState*> complete;
+	tinystl::vector<Page> cancelled;
+
+	{
+		bx::MutexScope lock(m_mutex);
+
+		for (auto& state : m_queue)
+		{
+			if (state.m_state == ReadState::Pending
+			&&  state.m_frame != m_frame)
+			{
+				// Page wasn't requested by feedback this frame
+				state.m_state = ReadState::Free;
+				cancelled.push_back(state.m_page);
+				++m_stats.m_cancelled;
+			}
+			else if (state.m_state == ReadState::Complete)
+			{
+				if (state.m_generation != m_generation)
+				{
+					// Loaded with settings from before clear
+					state.m_state = ReadState::Free;
+				}
+				else
+				{
+					complete.push_back(&state);
+				}
+			}
+		}
+
+		++m_frame;
+	}
+
+	// Most requested pages first, completed pages stay in queue until next frame
+	bx::quickSort(
+		complete.begin()
+		, uint32_t(complete.size())
+		, sizeof(ReadState*)
+		, [](const void* _a, const void* _b) -> int32_t {
+		const ReadState& lhs = **(ReadState* const*)(_a);
+		const ReadState& rhs = **(ReadState* const*)(_b);
+		return PageCount(lhs.m_page, lhs.m_count).compareTo(PageCount(rhs.m_page, rhs.m_count));
+	});
+
+	for (auto page : cancelled)
+	{
+		loadCancelled(page);
+	}
+
+	const int64_t now = bx::getHPCounter();
+	int count = bx::min((int)complete.size(), maxCompletions);
+
+	for (int i = 0; i < count; ++i)
+	{
+		ReadState* state = complete[i];
+		loadComplete(state->m_page, &state->m_data[0]);
+
+		m_statsLatency += now - state->m_submitTime;
+		++m_statsCompleted;
+
+		bx::MutexScope lock(m_mutex);
+		state->m_state = ReadState::Free;
+		++m_stats.m_completed;
+	}
+
+	{
+		bx::MutexScope lock(m_mutex);
+
+		m_stats.m_pending = 0;
+		m_stats.m_loading = 0;
+		for (const auto& state : m_queue)
+		{
+			m_stats.m_pending += state.m_state == ReadState::Pending;
+			m_stats.m_loading += state.m_state == ReadState::Loading;
+		}
+	}
+
+	const double freq = double(bx::getHPFrequency());
+	const double elapsed = double(now - m_statsTime) / freq;
+	if (elapsed >= 1.0)
+	{
+		m_stats.m_pagesPerSec = float(m_statsCompleted / elapsed);
+		m_stats.m_latencyMs = 0 < m_statsCompleted ? float(double(m_statsLatency) * 1000.0 / freq / m_statsCompleted) : 0.0f;
+		m_statsTime = now;
+		m_statsCompleted = 0;
+		m_statsLatency = 0;
+	}
+}
+
+// Drop all requests, pages being loaded are discarded when they complete
+void PageLoader::clear()
+{
+	bx::MutexScope lock(m_mutex);
+
+	for (auto& state : m_queue)
+	{
+		if (state.m_state == ReadState::Pending
+		||  state.m_state == ReadState::Complete)
+		{
+			state.m_state = ReadState::Free;
+		}
+	}
+
+	++m_generation;
+}
+
+const PageLoader::Stats& PageLoader::getStats() const
+{
+	return m_stats;
+}
+
+int32_t PageLoader::threadFunc(bx::Thread* _thread, void* _userData)
+{
+	BX_UNUSED(_thread);
+	return ((PageLoader*)_userData)->worker();
+}
+
+int32_t PageLoader::worker()
 {
-	int size = m_info->GetPageSize() * m_info->GetPageSize() * s_channelCount;
-	state.m_data.resize(size);
+	for (;;)
+	{
+		m_sem.wait();
+
+		ReadState* state = nullptr;
+
+		{
+			bx::MutexScope lock(m_mutex);
+
+			if (m_shutdown)
+			{
+				break;
+			}
+
+			// Pick the request with highest priority, requests cancelled
+			// before they were picked leave semaphore signaled without work
+			for (auto& it : m_queue)
+			{
+				if (it.m_state == ReadState::Pending
+				&& (state == nullptr || 0 > PageCount(it.m_page, it.m_count).compareTo(PageCount(state->m_page, state->m_count))))
+				{
+					state = &it;
+				}
+			}
+
+			if (state == nullptr)
+			{
+				continue;
+			}
+
+			state->m_state = ReadState::Loading;
+		}
+
+		loadPage(*state);
+
+		bx::MutexScope lock(m_mutex);
+		state->m_state = ReadState::Complete;
+	}
+
+	return 0;
+}
 
-	if (m_colorMipLevels)
+void PageLoader::loadPage(ReadState& state)
+{
+	if (state.m_colorMipLevels)
 	{
 		copyColor(&state.m_data[0], state.m_page);
 	}
@@ -530,31 +803,27 @@ void PageLoader::loadPage(ReadState& state)
 		m_tileDataFile->readPage(m_indexer->getIndexFromPage(state.m_page), &state.m_data[0]);
 	}
 
-	if (m_showBorders)
+	if (state.m_showBorders)
 	{
 		copyBorder(&state.m_data[0]);
 	}
 }
 
-void PageLoader::onPageLoadComplete(ReadState& state)
-{
-	loadComplete(state.m_page, &state.m_data[0]);
-}
-
 void PageLoader::copyBorder(uint8_t* image)
 {
 	int pagesize = m_info->GetPageSize();
+	int stride = m_info->GetPageStride();
 	int bordersize = m_info->m_borderSize;
 
 	for (int i = 0; i < pagesize; ++i)
 	{
-		int xindex = bordersize * pagesize + i;
+		int xindex = bordersize * stride + i;
 		image[xindex * s_channelCount + 0] = 0;
 		image[xindex * s_channelCount + 1] = 255;
 		image[xindex * s_channelCount + 2] = 0;
 		image[xindex * s_channelCount + 3] = 255;
 
-		int yindex = i * pagesize + bordersize;
+		int yindex = i * stride + bordersize;
 		image[yindex * s_channelCount + 0] = 0;
 		image[yindex * s_channelCount + 1] = 255;
 		image[yindex * s_channelCount + 2] = 0;
@@ -581,15 +850,16 @@ void PageLoader::copyColor(uint8_t* image, Page request)
 	};
 
 	int pagesize = m_info->GetPageSize();
+	int stride = m_info->GetPageStride();
 
 	for (int y = 0; y < pagesize; ++y)
 	{
 		for (int x = 0; x < pagesize; ++x)
 		{
-			image[(y * pagesize + x) * s_channelCount + 0] = colors[request.m_mip].m_b;
-			image[(y * pagesize + x) * s_channelCount + 1] = colors[request.m_mip].m_g;
-			image[(y * pagesize + x) * s_channelCount + 2] = colors[request.m_mip].m_r;
-			image[(y * pagesize + x) * s_channelCount + 3] = colors[request.m_mip].m_a;
+			image[(y * stride + x) * s_channelCount + 0] = colors[request.m_mip].m_b;
+			image[(y * stride + x) * s_channelCount + 1] = colors[request.m_mip].m_g;
+			image[(y * stride + x) * s_channelCount + 2] = colors[request.m_mip].m_r;
+			image[(y * stride + x) * s_channelCount + 3] = colors[request.m_mip].m_a;
 		}
 	}
 }
@@ -601,6 +871,7 @@ PageCache::PageCache(TextureAtlas* _atlas, PageLoader* _loader, int _count)
 {
 	clear();
 	m_loader->loadComplete = [&](Page page, uint8_t* data) { loadComplete(page, data); };
+	m_loader->loadCancelled = [&](Page page) { loadCancelled(page); };
 }
 
 // Update the pages's position in the lru
@@ -629,18 +900,23 @@ bool PageCache::touch(Page page)
 }
 
 // Schedule a load if not already loaded or loading
-bool PageCache::request(Page request, bgfx::ViewId blitViewId)
+bool PageCache::request(const PageCount& request, bgfx::ViewId blitViewId)
 {
 	m_blitViewId = blitViewId;
-	if (m_loading.find(request) == m_loading.end())
+	if (m_loading.find(request.m_page) == m_loading.end())
 	{
-		if (m_lru_used.find(request) == m_lru_used.end())
+		if (m_lru_used.find(request.m_page) == m_lru_used.end()
+		&&  m_loader->submit(request))
 		{
-			m_loading.insert(request);
-			m_loader->submit(request);
+			m_loading.insert(request.m_page);
 			return true;
 		}
 	}
+	else
+	{
+		// Keep the pending request alive
+		m_loader->touch(request);
+	}
 
 	return false;
 }
@@ -658,6 +934,8 @@ void PageCache::clear()
 	m_lru.clear();
 	m_lru.reserve(m_count * m_count);
 	m_current = 0;
+	m_loading.clear();
+	m_loader->clear();
 }
 
 void PageCache::loadComplete(Page page, uint8_t* data)
@@ -697,6 +975,11 @@ void PageCache::loadComplete(Page page, uint8_t* data)
 	added(page, pt);
 }
 
+void PageCache::loadCancelled(Page page)
+{
+	m_loading.erase(page);
+}
+
 // TextureAtlas
 TextureAtlas::TextureAtlas(VirtualTextureInfo* _info, int _count, int _uploadsperframe)
 	: m_info(_info)
@@ -734,6 +1017,7 @@ void TextureAtlas::uploadPage(Point pt, uint8_t* data, bgfx::ViewId blitViewId)
 
 	// Update texture with new atlas data
 	auto   pagesize = uint16_t(m_info->GetPageSize());
+	auto   pitch    = uint16_t(m_info->GetPageStride() * s_channelCount);
 	bgfx::updateTexture2D(
 		  writer
 		, 0
@@ -742,7 +1026,8 @@ void TextureAtlas::uploadPage(Point pt, uint8_t* data, bgfx::ViewId blitViewId)
 		, 0
 		, pagesize
 		, pagesize
-		, bgfx::copy(data, pagesize * pagesize * s_channelCount)
+		, bgfx::copy(data, pitch * pagesize)
+		, pitch
 		);
 
 	// Copy the texture part to the actual atlas texture
@@ -906,9 +1191,11 @@ VirtualTexture::VirtualTexture(TileDataFile* _tileDataFile, VirtualTextureInfo*
 VirtualTexture::~VirtualTexture()
 {
 	// Destroy
+	// Loader first, its worker threads use the indexer and loadComplete
+	// callbacks write into the atlas.
+	bx::deleteObject(VirtualTexture::getAllocator(), m_loader);
 	bx::deleteObject(VirtualTexture::getAllocator(), m_indexer);
 	bx::deleteObject(VirtualTexture::getAllocator(), m_atlas);
-	bx::deleteObject(VirtualTexture::getAllocator(), m_loader);
 	bx::deleteObject(VirtualTexture::getAllocator(), m_cache);
 	bx::deleteObject(VirtualTexture::getAllocator(), m_pageTable);
 	// Destroy all uniforms and textures
@@ -1063,10 +1350,11 @@ void VirtualTexture::update(const tinystl::vector<int>& requests, bgfx::ViewId b
 			return lhs.compareTo(rhs);
 		});
 
-		// if more pages than will fit in memory or more than update per frame drop high res pages with lowest use count
-		int loadcount = bx::min(bx::min((int)m_pagesToLoad.size(), m_uploadsPerFrame), m_atlasCount * m_atlasCount);
+		// if more pages than will fit in memory drop high res pages with lowest use count, loader
+		// rejects requests once its queue is full, pending requests that are not renewed here are cancelled
+		int loadcount = bx::min((int)m_pagesToLoad.size(), m_atlasCount * m_atlasCount);
 		for (int i = 0; i < loadcount; ++i)
-			m_cache->request(m_pagesToLoad[i].m_page, blitViewId);
+			m_cache->request(m_pagesToLoad[i], blitViewId);
 	}
 	else
 	{
@@ -1075,10 +1363,18 @@ void VirtualTexture::update(const tinystl::vector<int>& requests, bgfx::ViewId b
 		--m_mipBias;
 	}
 
+	// Hand loaded pages to cache, bounded by number of staging textures
+	m_loader->update(m_uploadsPerFrame);
+
 	// Update the page table
 	m_pageTable->update(blitViewId);
 }
 
+const PageLoader::Stats& VirtualTexture::getLoaderStats() const
+{
+	return m_loader->getStats();
+}
+
 bx::AllocatorI* VirtualTexture::s_allocator = nullptr;
 
 void VirtualTexture::setAllocator(bx::AllocatorI* allocator)
@@ -1091,58 +1387,290 @@ bx::AllocatorI* VirtualTexture::getAllocator()
 	return s_allocator;
 }
 
-TileDataFile::TileDataFile(const bx::FilePath& filename, VirtualTextureInfo* _info, bool _readWrite) : m_info(_info)
+// BC1 block encoder, endpoints are inset bounding box of block colors
+// Reference: Real-Time DXT Compression by J.M.P. van Waveren
+static void encodeBlockBc1(uint8_t* _dst, const uint8_t* _bgra)
+{
+	uint8_t minColor[3] = { 255, 255, 255 };
+	uint8_t maxColor[3] = {   0,   0,   0 };
+
+	for (int i = 0; i < 16; ++i)
+	{
+		for (int c = 0; c < 3; ++c)
+		{
+			minColor[c] = bx::min(minColor[c], _bgra[i * 4 + c]);
+			maxColor[c] = bx::max(maxColor[c], _bgra[i * 4 + c]);
+		}
+	}
+
+	for (int c = 0; c < 3; ++c)
+	{
+		int inset = (maxColor[c] - minColor[c]) >> 4;
+		minColor[c] = uint8_t(minColor[c] + inset);
+		maxColor[c] = uint8_t(maxColor[c] - inset);
+	}
+
+	auto to565 = [](const uint8_t* _color) -> uint16_t
+	{
+		return uint16_t( ( (_color[2] >> 3) << 11) | ( (_color[1] >> 2) << 5) | (_color[0] >> 3) );
+	};
+
+	uint16_t color0 = to565(maxColor);
+	uint16_t color1 = to565(minColor);
+
+	if (color0 < color1)
+	{
+		bx::swap(color0, color1);
+	}
+
+	// Palette from quantized endpoints in BGR order
+	int palette[4][3];
+	palette[0][0] = ( (color0 << 3) & 0xf8) | ( (color0 >>  2) & 0x07);
+	palette[0][1] = ( (color0 >> 3) & 0xfc) | ( (color0 >>  9) & 0x03);
+	palette[0][2] = ( (color0 >> 8) & 0xf8) | ( (color0 >> 13) & 0x07);
+	palette[1][0] = ( (color1 << 3) & 0xf8) | ( (color1 >>  2) & 0x07);
+	palette[1][1] = ( (color1 >> 3) & 0xfc) | ( (color1 >>  9) & 0x03);
+	palette[1][2] = ( (color1 >> 8) & 0xf8) | ( (color1 >> 13) & 0x07);
+
+	for (int c = 0; c < 3; ++c)
+	{
+		palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+		palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+	}
+
+	uint32_t indices = 0;
+
+	if (color0 != color1)
+	{
+		for (int i = 0; i < 16; ++i)
+		{
+			int best = 0;
+			int bestDist = INT32_MAX;
+
+			for (int p = 0; p < 4; ++p)
+			{
+				int dist = 0;
+				for (int c = 0; c < 3; ++c)
+				{
+					int d = int(_bgra[i * 4 + c]) - palette[p][c];
+					dist += d * d;
+				}
+
+				if (dist < bestDist)
+				{
+					best = p;
+					bestDist = dist;
+				}
+			}
+
+			indices |= uint32_t(best) << (i * 2);
+		}
+	}
+
+	_dst[0] = uint8_t(color0);
+	_dst[1] = uint8_t(color0 >> 8);
+	_dst[2] = uint8_t(color1);
+	_dst[3] = uint8_t(color1 >> 8);
+	_dst[4] = uint8_t(indices);
+	_dst[5] = uint8_t(indices >> 8);
+	_dst[6] = uint8_t(indices >> 16);
+	_dst[7] = uint8_t(indices >> 24);
+}
+
+// Encode page to BC1, page edge is repeated into padding
+static void encodePageBc1(uint8_t* _dst, const uint8_t* _bgra, int _pagesize, int _stride)
 {
-	const char* access = _readWrite ? "w+b" : "rb";
-	m_file = fopen(filename.getCPtr(), access);
-	m_size = m_info->GetPageSize() * m_info->GetPageSize() * s_channelCount;
+	uint8_t block[16 * 4];
+
+	for (int blockY = 0; blockY < _stride; blockY += 4)
+	{
+		for (int blockX = 0; blockX < _stride; blockX += 4)
+		{
+			for (int y = 0; y < 4; ++y)
+			{
+				int py = bx::min(blockY + y, _pagesize - 1);
+				for (int x = 0; x < 4; ++x)
+				{
+					int px = bx::min(blockX + x, _pagesize - 1);
+					bx::memCopy(&block[(y * 4 + x) * 4], &_bgra[(py * _pagesize + px) * s_channelCount], 4);
+				}
+			}
+
+			encodeBlockBc1(_dst, block);
+			_dst += 8;
+		}
+	}
+}
+
+TileDataFile::TileDataFile(const bx::FilePath& filename, VirtualTextureInfo* _info)
+	: m_info(_info)
+	, m_data(nullptr)
+	, m_size(0)
+	, m_header(nullptr)
+	, m_entries(nullptr)
+	, m_mapping(nullptr)
+{
+#if BX_PLATFORM_WINDOWS
+	HANDLE file = CreateFileA(filename.getCPtr(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (INVALID_HANDLE_VALUE != file)
+	{
+		LARGE_INTEGER size;
+		if (GetFileSizeEx(file, &size) )
+		{
+			m_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+			if (NULL != m_mapping)
+			{
+				m_data = (const uint8_t*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+				if (nullptr != m_data)
+				{
+					m_size = uint64_t(size.QuadPart);
+				}
+				else
+				{
+					CloseHandle(m_mapping);
+					m_mapping = nullptr;
+				}
+			}
+		}
+
+		CloseHandle(file);
+	}
+#elif BX_PLATFORM_POSIX
+	int fd = open(filename.getCPtr(), O_RDONLY);
+	if (-1 != fd)
+	{
+		struct stat st;
+		if (0 == fstat(fd, &st) )
+		{
+			void* data = mmap(NULL, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+			if (MAP_FAILED != data)
+			{
+				m_data = (const uint8_t*)data;
+				m_size = uint64_t(st.st_size);
+			}
+		}
+
+		close(fd);
+	}
+#else
+	// No memory mapping, read whole file
+	bx::FileReader reader;
+	if (bx::open(&reader, filename) )
+	{
+		m_size = uint64_t(bx::getSize(&reader) );
+		uint8_t* data = (uint8_t*)bx::alloc(VirtualTexture::getAllocator(), size_t(m_size) );
+		bx::read(&reader, data, int32_t(m_size), bx::ErrorAssert{});
+		bx::close(&reader);
+		m_data = data;
+	}
+#endif // BX_PLATFORM_*
+
+	const uint64_t headerSize = sizeof(VirtualTextureInfo) + sizeof(TileFileHeader);
+
+	if (nullptr != m_data
+	&&  m_size >= headerSize)
+	{
+		auto header = (const TileFileHeader*)(m_data + sizeof(VirtualTextureInfo) );
+
+		if (s_tileFileMagic == header->m_magic
+		&&  m_size >= headerSize + header->m_pageCount * sizeof(TileFileEntry) )
+		{
+			m_header  = header;
+			m_entries = m_data + headerSize;
+		}
+	}
+
+	if (nullptr == m_header)
+	{
+		bx::debugPrintf("Tile data file '%s' is missing or invalid.\n", filename.getCPtr() );
+	}
 }
 
 TileDataFile::~TileDataFile()
 {
-	fclose(m_file);
+	if (nullptr == m_data)
+	{
+		return;
+	}
+
+#if BX_PLATFORM_WINDOWS
+	UnmapViewOfFile(m_data);
+	CloseHandle(m_mapping);
+#elif BX_PLATFORM_POSIX
+	munmap(const_cast<uint8_t*>(m_data), size_t(m_size) );
+#else
+	bx::free(VirtualTexture::getAllocator(), const_cast<uint8_t*>(m_data) );
+#endif // BX_PLATFORM_*
 }
 
-void TileDataFile::readInfo()
+bool TileDataFile::isValid(const bx::FilePath& filename)
 {
-	fseek(m_file, 0, SEEK_SET);
-	auto ret = fread(m_info, sizeof(*m_info), 1, m_file);
-	BX_UNUSED(ret);
-	m_size = m_info->GetPageSize() * m_info->GetPageSize() * s_channelCount;
+	bx::FileReader reader;
+	if (!bx::open(&reader, filename) )
+	{
+		return false;
+	}
+
+	bx::Error err;
+	VirtualTextureInfo info;
+	TileFileHeader header;
+	bx::read(&reader, &info, sizeof(info), &err);
+	bx::read(&reader, &header, sizeof(header), &err);
+	bx::close(&reader);
+
+	return err.isOk()
+		&& s_tileFileMagic == header.m_magic
+		;
 }
 
-void TileDataFile::writeInfo()
+void TileDataFile::readInfo()
 {
-	fseek(m_file, 0, SEEK_SET);
-	auto ret = fwrite(m_info, sizeof(*m_info), 1, m_file);
-	BX_UNUSED(ret);
+	if (nullptr != m_header)
+	{
+		bx::memCopy(m_info, m_data, sizeof(*m_info) );
+	}
 }
 
 void TileDataFile::readPage(int index, uint8_t* data)
 {
-	fseek(m_file, m_size * index + s_tileFileDataOffset, SEEK_SET);
-	auto ret = fread(data, m_size, 1, m_file);
-	BX_UNUSED(ret);
-}
+	if (nullptr == m_header
+	||  uint32_t(index) >= m_header->m_pageCount)
+	{
+		return;
+	}
 
-void TileDataFile::writePage(int index, uint8_t* data)
-{
-	fseek(m_file, m_size * index + s_tileFileDataOffset, SEEK_SET);
-	auto ret = fwrite(data, m_size, 1, m_file);
-	BX_UNUSED(ret);
+	// Pages are stored as BC1, 8 bytes per 4x4 block
+	const int stride = m_info->GetPageStride();
+	const uint32_t pageSize = uint32_t( (stride / 4) * (stride / 4) * 8);
+
+	TileFileEntry entry;
+	bx::memCopy(&entry, &m_entries[index * sizeof(TileFileEntry)], sizeof(entry) );
+	if (entry.m_size != pageSize
+	||  entry.m_offset + entry.m_size > m_size)
+	{
+		return;
+	}
+
+	// Decode straight from mapped file into staging memory
+	bimg::imageDecodeToBgra8(
+		  VirtualTexture::getAllocator()
+		, data
+		, m_data + entry.m_offset
+		, uint32_t(stride)
+		, uint32_t(stride)
+		, uint32_t(stride * s_channelCount)
+		, bimg::TextureFormat::Enum(m_header->m_format)
+		);
 }
 
 // TileGenerator
 TileGenerator::TileGenerator(VirtualTextureInfo* _info)
 	: m_info(_info)
 	, m_indexer(nullptr)
-	, m_tileDataFile(nullptr)
 	, m_sourceImage(nullptr)
-	, m_page1Image(nullptr)
-	, m_page2Image(nullptr)
-	, m_2xtileImage(nullptr)
-	, m_4xtileImage(nullptr)
-	, m_tileImage(nullptr)
+	, m_pageData(nullptr)
+	, m_encodedPageSize(0)
+	, m_nextPage(0)
 {
 	m_tilesize = m_info->m_tileSize;
 	m_pagesize = m_info->GetPageSize();
@@ -1157,11 +1685,12 @@ TileGenerator::~TileGenerator()
 
 	bx::deleteObject(VirtualTexture::getAllocator(), m_indexer);
 
-	bx::deleteObject(VirtualTexture::getAllocator(), m_page1Image);
-	bx::deleteObject(VirtualTexture::getAllocator(), m_page2Image);
-	bx::deleteObject(VirtualTexture::getAllocator(), m_2xtileImage);
-	bx::deleteObject(VirtualTexture::getAllocator(), m_4xtileImage);
-	bx::deleteObject(VirtualTexture::getAllocator(), m_tileImage);
+	for (auto image : m_mipImages)
+	{
+		bx::deleteObject(VirtualTexture::getAllocator(), image);
+	}
+
+	bx::free(VirtualTexture::getAllocator(), m_pageData);
 }
 
 bool TileGenerator::generate(const bx::FilePath& _filePath)
@@ -1175,18 +1704,11 @@ bool TileGenerator::generate(const bx::FilePath& _filePath)
 	bx::FilePath cacheFilePath("temp");
 	cacheFilePath.join(tmp);
 
-	// Check if tile file already exist
+	// Check if tile file already exist, files in old uncompressed format are regenerated
+	if (TileDataFile::isValid(cacheFilePath) )
 	{
-		bx::Error err;
-		bx::FileReader fileReader;
-
-		if (bx::open(&fileReader, cacheFilePath, &err) )
-		{
-			bx::close(&fileReader);
-
-			bx::debugPrintf("Tile data file '%s' already exists. Skipping generation.\n", cacheFilePath.getCPtr() );
-			return true;
-		}
+		bx::debugPrintf("Tile data file '%s' already exists. Skipping generation.\n", cacheFilePath.getCPtr() );
+		return true;
 	}
 
 	// Read image
@@ -1236,54 +1758,157 @@ bool TileGenerator::generate(const bx::FilePath& _filePath)
 	m_info->m_virtualTextureSize = int(m_sourceImage->m_width);
 	m_indexer = BX_NEW(VirtualTexture::getAllocator(), PageIndexer)(m_info);
 
-	// Open tile data file
-	m_tileDataFile = BX_NEW(VirtualTexture::getAllocator(), TileDataFile)(cacheFilePath, m_info, true);
-	m_page1Image   = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_pagesize, m_pagesize, s_channelCount, 0xff);
-	m_page2Image   = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_pagesize, m_pagesize, s_channelCount, 0xff);
-	m_tileImage    = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_tilesize, m_tilesize, s_channelCount, 0xff);
-	m_2xtileImage  = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_tilesize * 2, m_tilesize * 2, s_channelCount, 0xff);
-	m_4xtileImage  = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_tilesize * 4, m_tilesize * 4, s_channelCount, 0xff);
-
-	// Generate tiles
-	bx::debugPrintf("Generating tiles\n");
+	// Generate mips, mip level 0 is source image clamped at edges to virtual texture size
+	bx::debugPrintf("Generating mips\n");
 	auto mipcount = m_indexer->getMipCount();
-	for (int i = 0; i < mipcount; ++i)
+	for (int i = 1; i < mipcount; ++i)
 	{
-		int count = (m_info->m_virtualTextureSize / m_tilesize) >> i;
-		bx::debugPrintf("Generating Mip:%d Count:%dx%d\n", i, count, count);
-		for (int y = 0; y < count; ++y)
+		int size = m_info->m_virtualTextureSize >> i;
+		auto image = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(size, size, s_channelCount);
+
+		if (i == 1)
 		{
-			for (int x = 0; x < count; ++x)
+			auto srcWidth = (int)m_sourceImage->m_width;
+			auto srcHeight = (int)m_sourceImage->m_height;
+			auto src = (uint8_t*)m_sourceImage->m_data;
+
+			for (int y = 0; y < size; ++y)
 			{
-				Page page = { x, y, i };
-				int index = m_indexer->getIndexFromPage(page);
-				CopyTile(*m_page1Image, page);
-				m_tileDataFile->writePage(index, &m_page1Image->m_data[0]);
+				int y0 = bx::min(y * 2,     srcHeight - 1);
+				int y1 = bx::min(y * 2 + 1, srcHeight - 1);
+
+				for (int x = 0; x < size; ++x)
+				{
+					int x0 = bx::min(x * 2,     srcWidth - 1);
+					int x1 = bx::min(x * 2 + 1, srcWidth - 1);
+
+					for (int c = 0; c < s_channelCount; ++c)
+					{
+						int sum_value = 4 >> 1;
+						sum_value += src[(y0 * srcWidth + x0) * s_channelCount + c];
+						sum_value += src[(y0 * srcWidth + x1) * s_channelCount + c];
+						sum_value += src[(y1 * srcWidth + x0) * s_channelCount + c];
+						sum_value += src[(y1 * srcWidth + x1) * s_channelCount + c];
+						image->m_data[(y * size + x) * s_channelCount + c] = (uint8_t)(sum_value / 4);
+					}
+				}
 			}
 		}
+		else
+		{
+			SimpleImage::mipmap(&m_mipImages.back()->m_data[0], size * 2, s_channelCount, &image->m_data[0]);
+		}
+
+		m_mipImages.push_back(image);
+	}
+
+	// Encode tiles, encoded pages have the same size, so their location in file is known up front
+	const uint32_t pageCount = uint32_t(m_indexer->getCount() );
+	const int stride = m_info->GetPageStride();
+	m_encodedPageSize = uint32_t( (stride / 4) * (stride / 4) * 8);
+	m_pageData = (uint8_t*)bx::alloc(VirtualTexture::getAllocator(), size_t(pageCount) * m_encodedPageSize);
+	m_nextPage = 0;
+
+	bx::debugPrintf("Encoding %d tiles\n", pageCount);
+	{
+		bx::Thread threads[s_generatorThreadCount];
+
+		for (auto& thread : threads)
+		{
+			thread.init(encodeThreadFunc, this, 0, "vt tile encoder");
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.shutdown();
+		}
 	}
 
 	bx::debugPrintf("Finishing\n");
-	// Write header
-	m_tileDataFile->writeInfo();
-	// Close tile file
-	bx::deleteObject(VirtualTexture::getAllocator(), m_tileDataFile);
-	m_tileDataFile = nullptr;
+
+	bx::Error err;
+	bx::FileWriter fileWriter;
+
+	if (!bx::open(&fileWriter, cacheFilePath, false, &err) )
+	{
+		bx::debugPrintf("Tile data file open failed'%s'.\n", cacheFilePath.getCPtr() );
+		return false;
+	}
+
+	TileFileHeader header;
+	header.m_magic     = s_tileFileMagic;
+	header.m_format    = bimg::TextureFormat::BC1;
+	header.m_pageCount = pageCount;
+	header.m_reserved  = 0;
+
+	bx::write(&fileWriter, *m_info, &err);
+	bx::write(&fileWriter, header, &err);
+
+	const uint64_t dataOffset = sizeof(VirtualTextureInfo) + sizeof(TileFileHeader) + pageCount * sizeof(TileFileEntry);
+
+	for (uint32_t i = 0; i < pageCount; ++i)
+	{
+		TileFileEntry entry;
+		entry.m_offset   = dataOffset + uint64_t(i) * m_encodedPageSize;
+		entry.m_size     = m_encodedPageSize;
+		entry.m_reserved = 0;
+		bx::write(&fileWriter, entry, &err);
+	}
+
+	for (uint32_t i = 0; i < pageCount; ++i)
+	{
+		bx::write(&fileWriter, &m_pageData[size_t(i) * m_encodedPageSize], int32_t(m_encodedPageSize), &err);
+	}
+
+	bx::close(&fileWriter);
+
+	if (!err.isOk() )
+	{
+		bx::debugPrintf("Tile data file write failed'%s'.\n", cacheFilePath.getCPtr() );
+		bx::remove(cacheFilePath);
+		return false;
+	}
+
 	bx::debugPrintf("Done!\n");
 	return true;
 }
 
+int32_t TileGenerator::encodeThreadFunc(bx::Thread* _thread, void* _userData)
+{
+	BX_UNUSED(_thread);
+	((TileGenerator*)_userData)->encodePages();
+	return 0;
+}
+
+void TileGenerator::encodePages()
+{
+	SimpleImage image(m_pagesize, m_pagesize, s_channelCount, 0xff);
+
+	const uint32_t pageCount = uint32_t(m_indexer->getCount() );
+	const int stride = m_info->GetPageStride();
+
+	for (uint32_t index = bx::atomicFetchAndAdd<uint32_t>(&m_nextPage, 1)
+		; index < pageCount
+		; index = bx::atomicFetchAndAdd<uint32_t>(&m_nextPage, 1)
+		)
+	{
+		CopyTile(image, m_indexer->getPageFromIndex(int(index) ) );
+		encodePageBc1(&m_pageData[size_t(index) * m_encodedPageSize], &image.m_data[0], m_pagesize, stride);
+	}
+}
+
 void TileGenerator::CopyTile(SimpleImage& image, Page request)
 {
+	int x = request.m_x * m_tilesize - m_info->m_borderSize;
+	int y = request.m_y * m_tilesize - m_info->m_borderSize;
+	auto dstPitch = image.m_width * image.m_channelCount;
+	auto dst = &image.m_data[0];
+
 	if (request.m_mip == 0)
 	{
-		int x = request.m_x * m_tilesize - m_info->m_borderSize;
-		int y = request.m_y * m_tilesize - m_info->m_borderSize;
 		// Copy sub-image with border
 		auto srcPitch = m_sourceImage->m_width * s_channelCount;
 		auto src = (uint8_t*)m_sourceImage->m_data;
-		auto dstPitch = image.m_width * image.m_channelCount;
-		auto dst = &image.m_data[0];
 		for (int iy = 0; iy < m_pagesize; ++iy)
 		{
 			int ry = bx::clamp(y + iy, 0, (int)m_sourceImage->m_height - 1);
@@ -1296,37 +1921,20 @@ void TileGenerator::CopyTile(SimpleImage& image, Page request)
 	}
 	else
 	{
-		int xpos = request.m_x << 1;
-		int ypos = request.m_y << 1;
-		int mip = request.m_mip - 1;
-
-		int size = m_info->GetPageTableSize() >> mip;
-
-		m_4xtileImage->clear((uint8_t)request.m_mip);
-
-		for (int y = 0; y < 4; ++y)
+		// Copy sub-image with border, wrapped so we get the border sections of other pages
+		auto mipImage = m_mipImages[request.m_mip - 1];
+		auto size = mipImage->m_width;
+		auto srcPitch = size * s_channelCount;
+		auto src = &mipImage->m_data[0];
+		for (int iy = 0; iy < m_pagesize; ++iy)
 		{
-			for (int x = 0; x < 4; ++x)
+			int ry = (y + iy + size) % size;
+			for (int ix = 0; ix < m_pagesize; ++ix)
 			{
-				Page page = { xpos + x - 1, ypos + y - 1, mip };
-
-				// Wrap so we get the border sections of other pages
-				page.m_x = (int)bx::mod((float)page.m_x, (float)size);
-				page.m_y = (int)bx::mod((float)page.m_y, (float)size);
-
-				m_tileDataFile->readPage(m_indexer->getIndexFromPage(page), &m_page2Image->m_data[0]);
-
-				Rect src_rect = { m_info->m_borderSize, m_info->m_borderSize, m_tilesize, m_tilesize };
-				Point dst_offset = { x * m_tilesize, y * m_tilesize };
-
-				m_4xtileImage->copy(dst_offset, *m_page2Image, src_rect);
+				int rx = (x + ix + size) % size;
+				bx::memCopy(&dst[iy * dstPitch + ix * image.m_channelCount], &src[ry * srcPitch + rx * s_channelCount], image.m_channelCount);
 			}
 		}
-
-		SimpleImage::mipmap(&m_4xtileImage->m_data[0], m_4xtileImage->m_width, s_channelCount, &m_2xtileImage->m_data[0]);
-
-		Rect srect = { m_tilesize / 2 - m_info->m_borderSize, m_tilesize / 2 - m_info->m_borderSize, m_pagesize, m_pagesize };
-		image.copy({ 0,0 }, *m_2xtileImage, srect);
 	}
 }
 
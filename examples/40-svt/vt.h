@@ -16,6 +16,9 @@
 #pragma once
 
 #include <bimg/decode.h>
+#include <bx/mutex.h>
+#include <bx/semaphore.h>
+#include <bx/thread.h>
 #include <tinystl/allocator.h>
 #include <tinystl/unordered_set.h>
 #include <tinystl/vector.h>
@@ -24,8 +27,6 @@
 #include "common.h"
 #include "bgfx_utils.h"
 
-#include <stdio.h> // FILE
-
 namespace vt
 {
 
@@ -103,6 +104,7 @@ struct VirtualTextureInfo
 {
 	VirtualTextureInfo();
 	int GetPageSize() const;
+	int GetPageStride() const;
 	int GetPageTableSize() const;
 
 	int m_virtualTextureSize = 0;
@@ -215,31 +217,87 @@ private:
 };
 
 // PageLoader
+//
+// Pages are read from tile data file on worker threads. Requests are kept in
+// bounded queue, and loaded by priority (low res pages and pages with most
+// feedback requests first). Requests that were not renewed by feedback are
+// cancelled before they're loaded, and loaded pages are handed back on main
+// thread from update.
 class PageLoader
 {
 public:
 	struct ReadState
 	{
+		enum Enum
+		{
+			Free,
+			Pending,
+			Loading,
+			Complete,
+		};
+
 		Page						m_page;
+		int							m_count;
+		int							m_frame;
+		int							m_generation;
+		Enum						m_state;
+		int64_t						m_submitTime;
+		bool						m_colorMipLevels; // Debug flags captured at submit, workers
+		bool						m_showBorders;    // never read the live ones.
 		tinystl::vector<uint8_t>	m_data;
 	};
 
-	PageLoader(TileDataFile* _tileDataFile, PageIndexer* _indexer, VirtualTextureInfo* _info);
-	void submit(Page request);
+	struct Stats
+	{
+		int    m_pending;     // Requests waiting in queue.
+		int    m_loading;     // Requests being loaded by worker threads.
+		int    m_submitted;   // Total number of submitted requests.
+		int    m_completed;   // Total number of pages handed to cache.
+		int    m_cancelled;   // Total number of stale requests dropped before loading.
+		int    m_rejected;    // Total number of requests rejected because queue was full.
+		float  m_pagesPerSec; // Pages handed to cache per second, averaged over last second.
+		float  m_latencyMs;   // Average time from submit to completion, over last second.
+	};
+
+	PageLoader(TileDataFile* _tileDataFile, PageIndexer* _indexer, VirtualTextureInfo* _info, int _queueSize = 64, int _numThreads = 2);
+	~PageLoader();
+
+	bool submit(const PageCount& request);
+	bool touch(const PageCount& request);
+	void update(int maxCompletions);
+	void clear();
 	void loadPage(ReadState& state);
-	void onPageLoadComplete(ReadState& state);
 	void copyBorder(uint8_t* image);
 	void copyColor(uint8_t* image, Page request);
 
+	const Stats& getStats() const;
+
 	std::function<void(Page, uint8_t*)> loadComplete;
+	std::function<void(Page)> loadCancelled;
 
 	bool m_colorMipLevels;
 	bool m_showBorders;
 
 private:
+	static int32_t threadFunc(bx::Thread* _thread, void* _userData);
+	int32_t worker();
+
 	TileDataFile*		m_tileDataFile;
 	PageIndexer*        m_indexer;
 	VirtualTextureInfo* m_info;
+
+	tinystl::vector<ReadState>	m_queue;
+	tinystl::vector<bx::Thread*>	m_threads;
+	bx::Mutex					m_mutex;
+	bx::Semaphore				m_sem;
+	bool						m_shutdown;
+	int							m_frame;
+	int							m_generation;
+
+	Stats	m_stats;
+	int64_t	m_statsTime;
+	int		m_statsCompleted;
+	int64_t	m_statsLatency;
 };
 
 // PageCache
@@ -248,9 +306,10 @@ class PageCache
 public:
 	PageCache(TextureAtlas* _atlas, PageLoader* _loader, int _count);
 	bool touch(Page page);
-	bool request(Page request, bgfx::ViewId blitViewId);
+	bool request(const PageCount& request, bgfx::ViewId blitViewId);
 	void clear();
 	void loadComplete(Page page, uint8_t* data);
+	void loadCancelled(Page page);
 
 	// These callbacks are used to notify the other systems
 	std::function<void(Page, Point)> removed;
@@ -363,6 +422,8 @@ public:
 	void clear();
 	void update(const tinystl::vector<int>& requests, bgfx::ViewId blitViewId);
 
+	const PageLoader::Stats& getLoaderStats() const;
+
 	void setUniforms();
 
 	static void setAllocator(bx::AllocatorI* allocator);
@@ -393,22 +454,48 @@ private:
 };
 
 // TileDataFile
+//
+// Tile data file layout:
+//   VirtualTextureInfo
+//   TileFileHeader
+//   TileFileEntry[pageCount]  - Page index, indexed by PageIndexer page index.
+//   Page data                 - BC1 compressed pages, padded to page stride.
+//
+// File is memory mapped, and pages are decoded directly from mapped memory,
+// so it can be read from multiple loader threads.
+struct TileFileHeader
+{
+	uint32_t m_magic;
+	uint32_t m_format;
+	uint32_t m_pageCount;
+	uint32_t m_reserved;
+};
+
+struct TileFileEntry
+{
+	uint64_t m_offset;
+	uint32_t m_size;
+	uint32_t m_reserved;
+};
+
 class TileDataFile
 {
 public:
-	TileDataFile(const bx::FilePath& filename, VirtualTextureInfo* _info, bool _readWrite = false);
+	TileDataFile(const bx::FilePath& filename, VirtualTextureInfo* _info);
 	~TileDataFile();
 
-	void readInfo();
-	void writeInfo();
+	static bool isValid(const bx::FilePath& filename);
 
+	void readInfo();
 	void readPage(int index, uint8_t* data);
-	void writePage(int index, uint8_t* data);
 
 private:
-	VirtualTextureInfo*	m_info;
-	int					m_size;
-	FILE*				m_file;
+	VirtualTextureInfo*		m_info;
+	const uint8_t*			m_data;
+	uint64_t				m_size;
+	const TileFileHeader*	m_header;
+	const uint8_t*			m_entries; // Entries are not aligned in file.
+	void*					m_mapping;
 };
 
 // TileGenerator
@@ -423,21 +510,23 @@ public:
 private:
 	void CopyTile(SimpleImage& image, Page request);
 
+	static int32_t encodeThreadFunc(bx::Thread* _thread, void* _userData);
+	void encodePages();
+
 private:
 	VirtualTextureInfo* m_info;
 	PageIndexer*		m_indexer;
-	TileDataFile*		m_tileDataFile;
 
 	int	m_tilesize;
 	int	m_pagesize;
 
 	bimg::ImageContainer*	m_sourceImage;
 
-	SimpleImage* m_page1Image;
-	SimpleImage* m_page2Image;
-	SimpleImage* m_2xtileImage;
-	SimpleImage* m_4xtileImage;
-	SimpleImage* m_tileImage;
+	tinystl::vector<SimpleImage*> m_mipImages; // Mip levels of source image, starting from mip level 1
+
+	uint8_t*	m_pageData;
+	uint32_t	m_encodedPageSize;
+	uint32_t	m_nextPage;
 };
 
 } // namespace vt
@@ -96,7 +96,7 @@ static void* loadMem(bx::FileReaderI* _reader, bx::AllocatorI* _allocator, const
 	return NULL;
 }
 
-static bgfx::ShaderHandle loadShader(bx::FileReaderI* _reader, const bx::StringView& _name)
+static bx::FilePath getShaderFilePath(const bx::StringView& _name)
 {
 	bx::FilePath filePath("shaders/");
 
@@ -124,6 +124,13 @@ static bgfx::ShaderHandle loadShader(bx::FileReaderI* _reader, const bx::StringV
 
 	filePath.join(fileName);
 
+	return filePath;
+}
+
+static bgfx::ShaderHandle loadShader(bx::FileReaderI* _reader, const bx::StringView& _name)
+{
+	const bx::FilePath filePath = getShaderFilePath(_name);
+
 	bgfx::ShaderHandle handle = bgfx::createShader(loadMem(_reader, filePath.getCPtr() ) );
 	bgfx::setName(handle, _name.getPtr(), _name.getLength() );
 
@@ -152,6 +159,179 @@ bgfx::ProgramHandle loadProgram(const bx::StringView& _vsName, const bx::StringV
 	return loadProgram(entry::getFileReader(), _vsName, _fsName);
 }
 
+#define BGFX_CHUNK_MAGIC_SHV BX_MAKEFOURCC('S', 'H', 'V', 1)
+
+bool ShaderVariants::load(const void* _data, uint32_t _size)
+{
+	bx::MemoryReader reader(_data, _size);
+	bx::Error err;
+
+	uint32_t magic;
+	bx::read(&reader, magic, &err);
+
+	if (!err.isOk()
+	||  BGFX_CHUNK_MAGIC_SHV != magic)
+	{
+		return false;
+	}
+
+	const char* data = (const char*)_data;
+
+	uint8_t numKeywords = 0;
+	bx::read(&reader, numKeywords, &err);
+
+	for (uint32_t ii = 0; ii < numKeywords && err.isOk(); ++ii)
+	{
+		uint8_t len = 0;
+		bx::read(&reader, len, &err);
+
+		const int64_t pos = bx::seek(&reader);
+		if (pos + len > _size)
+		{
+			return false;
+		}
+
+		m_keywords.push_back(bx::StringView(&data[pos], len) );
+		bx::seek(&reader, len, bx::Whence::Current);
+	}
+
+	uint16_t numVariants = 0;
+	bx::read(&reader, numVariants, &err);
+
+	for (uint32_t ii = 0; ii < numVariants && err.isOk(); ++ii)
+	{
+		Variant variant;
+		bx::read(&reader, variant.m_mask, &err);
+		bx::read(&reader, variant.m_binary, &err);
+		m_variants.push_back(variant);
+	}
+
+	uint16_t numBinaries = 0;
+	bx::read(&reader, numBinaries, &err);
+
+	for (uint32_t ii = 0; ii < numBinaries && err.isOk(); ++ii)
+	{
+		Binary binary;
+		bx::read(&reader, binary.m_offset, &err);
+		bx::read(&reader, binary.m_size, &err);
+		m_binaries.push_back(binary);
+	}
+
+	if (!err.isOk() )
+	{
+		return false;
+	}
+
+	const int64_t pos = bx::seek(&reader);
+	m_binaryData     = (const uint8_t*)&data[pos];
+	m_binaryDataSize = _size - uint32_t(pos);
+
+	for (uint32_t ii = 0, num = m_binaries.size(); ii < num; ++ii)
+	{
+		const Binary& binary = m_binaries[ii];
+		if (uint64_t(binary.m_offset) + binary.m_size > m_binaryDataSize)
+		{
+			return false;
+		}
+	}
+
+	for (uint32_t ii = 0, num = m_variants.size(); ii < num; ++ii)
+	{
+		if (m_variants[ii].m_binary >= m_binaries.size() )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void ShaderVariants::unload()
+{
+	m_keywords.clear();
+	m_variants.clear();
+	m_binaries.clear();
+
+	::unload(m_data);
+	m_data           = NULL;
+	m_binaryData     = NULL;
+	m_binaryDataSize = 0;
+}
+
+uint32_t ShaderVariants::getKeywordMask(const bx::StringView& _keyword) const
+{
+	for (uint32_t ii = 0, num = m_keywords.size(); ii < num; ++ii)
+	{
+		if (0 == bx::strCmp(_keyword, m_keywords[ii]) )
+		{
+			return UINT32_C(1) << ii;
+		}
+	}
+
+	return 0;
+}
+
+bgfx::ShaderHandle ShaderVariants::createShader(uint32_t _mask) const
+{
+	// Variants are sorted by mask.
+	uint32_t first = 0;
+	uint32_t last  = m_variants.size();
+
+	while (first < last)
+	{
+		const uint32_t mid = (first + last)/2;
+		if (m_variants[mid].m_mask < _mask)
+		{
+			first = mid + 1;
+		}
+		else
+		{
+			last = mid;
+		}
+	}
+
+	if (first == m_variants.size()
+	||  m_variants[first].m_mask != _mask)
+	{
+		DBG("Shader variant archive doesn't contain variant with mask 0x%08x.", _mask);
+		return BGFX_INVALID_HANDLE;
+	}
+
+	const Binary& binary = m_binaries[m_variants[first].m_binary];
+	return bgfx::createShader(bgfx::copy(&m_binaryData[binary.m_offset], binary.m_size) );
+}
+
+ShaderVariants* shaderVariantsLoad(const bx::StringView& _name)
+{
+	const bx::FilePath filePath = getShaderFilePath(_name);
+
+	uint32_t size;
+	void* data = load(filePath, &size);
+
+	if (NULL == data)
+	{
+		return NULL;
+	}
+
+	ShaderVariants* variants = new ShaderVariants;
+	variants->m_data = data;
+
+	if (!variants->load(data, size) )
+	{
+		DBG("Invalid shader variant archive %s.", filePath.getCPtr() );
+		shaderVariantsUnload(variants);
+		return NULL;
+	}
+
+	return variants;
+}
+
+void shaderVariantsUnload(ShaderVariants* _variants)
+{
+	_variants->unload();
+	delete _variants;
+}
+
 static void imageReleaseCb(void* _ptr, void* _userData)
 {
 	BX_UNUSED(_ptr);
@@ -29,6 +29,53 @@ bgfx::ShaderHandle loadShader(const bx::StringView& _name);
 ///
 bgfx::ProgramHandle loadProgram(const bx::StringView& _vsName, const bx::StringView& _fsName);
 
+/// Shader variant archive compiled with `shaderc --variants`.
+struct ShaderVariants
+{
+	ShaderVariants()
+		: m_data(NULL)
+		, m_binaryData(NULL)
+		, m_binaryDataSize(0)
+	{
+	}
+
+	bool load(const void* _data, uint32_t _size);
+	void unload();
+
+	/// Returns keyword bit in variant mask, or 0 if archive doesn't have keyword.
+	uint32_t getKeywordMask(const bx::StringView& _keyword) const;
+
+	/// Creates shader for variant mask. Returns invalid handle if archive
+	/// doesn't have variant with that mask.
+	bgfx::ShaderHandle createShader(uint32_t _mask) const;
+
+	struct Variant
+	{
+		uint32_t m_mask;
+		uint16_t m_binary;
+	};
+
+	struct Binary
+	{
+		uint32_t m_offset;
+		uint32_t m_size;
+	};
+
+	stl::vector<bx::StringView> m_keywords;
+	stl::vector<Variant> m_variants;
+	stl::vector<Binary>  m_binaries;
+
+	void* m_data;
+	const uint8_t* m_binaryData;
+	uint32_t m_binaryDataSize;
+};
+
+///
+ShaderVariants* shaderVariantsLoad(const bx::StringView& _name);
+
+///
+void shaderVariantsUnload(ShaderVariants* _variants);
+
 ///
 bgfx::TextureHandle loadTexture(const bx::FilePath& _filePath, uint64_t _flags = BGFX_TEXTURE_NONE|BGFX_SAMPLER_NONE, uint8_t _skip = 0, bgfx::TextureInfo* _info = NULL, bimg::Orientation::Enum* _orientation = NULL);
 
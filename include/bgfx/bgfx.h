@@ -421,6 +421,7 @@ namespace bgfx
 
 	static const uint16_t kInvalidHandle = UINT16_MAX;
 
+	BGFX_HANDLE(DrawListHandle)
 	BGFX_HANDLE(DynamicIndexBufferHandle)
 	BGFX_HANDLE(DynamicVertexBufferHandle)
 	BGFX_HANDLE(FrameBufferHandle)
@@ -714,10 +715,24 @@ namespace bgfx
 		{
 			Limits();
 
-			uint16_t maxEncoders;       //!< Maximum number of encoder threads.
-			uint32_t minResourceCbSize; //!< Minimum resource command buffer size.
-			uint32_t transientVbSize;   //!< Maximum transient vertex buffer size.
-			uint32_t transientIbSize;   //!< Maximum transient index buffer size.
+			uint16_t maxEncoders;        //!< Maximum number of encoder threads.
+			uint32_t minResourceCbSize;  //!< Minimum resource command buffer size.
+			uint32_t transientVbSize;    //!< Maximum transient vertex buffer size. When transient
+			                             //!  buffer growth is enabled, initial and minimum size.
+			uint32_t transientIbSize;    //!< Maximum transient index buffer size. When transient
+			                             //!  buffer growth is enabled, initial and minimum size.
+			uint32_t transientMaxVbSize; //!< Size transient vertex buffer can grow to between frames
+			                             //!  when demand exceeds its size. Zero disables growth.
+			uint32_t transientMaxIbSize; //!< Size transient index buffer can grow to between frames
+			                             //!  when demand exceeds its size. Zero disables growth.
+			uint32_t uploadBudgetSize;   //!< Amount of asynchronous upload data issued per frame.
+			                             //!  Zero is unlimited.
+			uint32_t uploadBudgetTime;   //!< Render thread time (in microseconds) asynchronous uploads
+			                             //!  can take per frame. Zero is unlimited.
+			uint16_t maxSortThreads;     //!< Maximum number of threads used to sort render items.
+			uint16_t maxFramesInFlight;  //!< Maximum number of frames API thread can submit ahead of
+			                             //!  render thread. Higher values increase throughput when
+			                             //!  render thread is slower, at cost of input latency.
 		};
 
 		Limits limits; //!< Configurable runtime limits.
@@ -732,7 +747,9 @@ namespace bgfx
 		bx::AllocatorI* allocator;
 	};
 
-	/// Memory release callback.
+	/// Memory release callback. Called from any thread once render thread
+	/// consumed memory, which can be up to `Init::Limits::maxFramesInFlight` + 1
+	/// `bgfx::frame` calls after it was passed to bgfx.
 	///
 	/// param[in] _ptr Pointer to allocated data.
 	/// param[in] _userData User defined data if needed.
@@ -818,6 +835,8 @@ namespace bgfx
 			uint32_t minResourceCbSize;       //!< Minimum resource command buffer size.
 			uint32_t transientVbSize;         //!< Maximum transient vertex buffer size.
 			uint32_t transientIbSize;         //!< Maximum transient index buffer size.
+			uint32_t maxSortThreads;          //!< Maximum number of threads used to sort render items.
+			uint32_t maxFramesInFlight;       //!< Maximum number of frames API thread can submit ahead of render thread.
 		};
 
 		Limits limits; //!< Renderer runtime limits.
@@ -959,6 +978,19 @@ namespace bgfx
 		uint16_t num; //!< Number of matrices.
 	};
 
+	/// Per draw call data for batched submit.
+	///
+	/// @attention C99's equivalent binding is `bgfx_batch_draw_t`.
+	///
+	struct BatchDraw
+	{
+		uint32_t transform;   //!< Matrix cache index returned by `setTransform` or `allocTransform`.
+		uint16_t numMatrices; //!< Number of matrices.
+		uint32_t start;       //!< First index, or first vertex of stream 0 if index buffer is not set.
+		uint32_t num;         //!< Number of indices, or number of vertices if index buffer is not set.
+		uint32_t depth;       //!< Depth for sorting.
+	};
+
 	/// View id.
 	typedef uint16_t ViewId;
 
@@ -983,8 +1015,21 @@ namespace bgfx
 	///
 	struct EncoderStats
 	{
-		int64_t cpuTimeBegin; //!< Encoder thread CPU submit begin time.
-		int64_t cpuTimeEnd;   //!< Encoder thread CPU submit end time.
+		int64_t cpuTimeBegin;  //!< Encoder thread CPU submit begin time.
+		int64_t cpuTimeEnd;    //!< Encoder thread CPU submit end time.
+		int64_t waitBeginTime; //!< Time spent waiting for encoder while frame was being submitted.
+		uint32_t numRetries;   //!< Number of contended attempts to begin encoder.
+	};
+
+	/// Pipeline stats.
+	///
+	/// @attention C99's equivalent binding is `bgfx_pipeline_stats_t`.
+	///
+	struct PipelineStats
+	{
+		uint64_t id;            //!< Renderer specific pipeline key, stable between runs.
+		int64_t  cpuTimeCreate; //!< CPU time spent creating pipeline.
+		bool     prewarm;       //!< Pipeline was created from pipeline manifest, before it was used.
 	};
 
 	/// Renderer statistics data.
@@ -1013,6 +1058,9 @@ namespace bgfx
 		uint32_t numBlit;                   //!< Number of blit calls submitted.
 		uint32_t maxGpuLatency;             //!< GPU driver latency.
 		uint32_t gpuFrameNum;               //!< Frame which generated gpuTimeBegin, gpuTimeEnd.
+		uint32_t numSortedItems;            //!< Number of render items submitted out of order, which needed sorting.
+		uint32_t numUniformDedup;           //!< Number of uniform writes replaced with reference to identical value
+		                                    //!  written earlier in frame.
 
 		uint16_t numDynamicIndexBuffers;    //!< Number of used dynamic index buffers.
 		uint16_t numDynamicVertexBuffers;   //!< Number of used dynamic vertex buffers.
@@ -1030,6 +1078,25 @@ namespace bgfx
 		int64_t rtMemoryUsed;               //!< Estimate of render target memory used.
 		int32_t transientVbUsed;            //!< Amount of transient vertex buffer used.
 		int32_t transientIbUsed;            //!< Amount of transient index buffer used.
+		int32_t transientVbSize;            //!< Current size of transient vertex buffer.
+		int32_t transientIbSize;            //!< Current size of transient index buffer.
+		int32_t transientVbOverflow;        //!< Amount of transient vertex buffer requested, but not
+		                                    //!  allocated because buffer was full.
+		int32_t transientIbOverflow;        //!< Amount of transient index buffer requested, but not
+		                                    //!  allocated because buffer was full.
+		int32_t transientVbWasted;          //!< Amount of transient vertex buffer wasted in tails of
+		                                    //!  encoder chunks.
+		int32_t transientIbWasted;          //!< Amount of transient index buffer wasted in tails of
+		                                    //!  encoder chunks.
+		int64_t dynamicIbFree;              //!< Amount of free space in dynamic index buffers.
+		int64_t dynamicVbFree;              //!< Amount of free space in dynamic vertex buffers.
+		uint32_t dynamicIbFreeMax;          //!< Size of largest free block in dynamic index buffers.
+		uint32_t dynamicVbFreeMax;          //!< Size of largest free block in dynamic vertex buffers.
+		uint32_t dynamicIbFreeBlocks;       //!< Number of free blocks in dynamic index buffers.
+		uint32_t dynamicVbFreeBlocks;       //!< Number of free blocks in dynamic vertex buffers.
+		uint32_t uploadPending;             //!< Number of queued asynchronous uploads.
+		uint32_t uploadPendingSize;         //!< Amount of queued asynchronous upload data not issued yet.
+		uint32_t uploadSize;                //!< Amount of asynchronous upload data issued last frame.
 
 		uint32_t numPrims[Topology::Count]; //!< Number of primitives rendered.
 
@@ -1046,6 +1113,9 @@ namespace bgfx
 
 		uint8_t       numEncoders;          //!< Number of encoders used during frame.
 		EncoderStats* encoderStats;         //!< Array of encoder stats.
+
+		uint16_t       numPipelines;        //!< Number of pipelines created since last frame.
+		PipelineStats* pipelineStats;       //!< Array of pipeline stats.
 	};
 
 	/// Encoders are used for submitting draw calls from multiple threads. Only one encoder
@@ -1557,6 +1627,112 @@ namespace bgfx
 			, uint8_t _flags = BGFX_DISCARD_ALL
 			);
 
+		/// Submit batch of draw calls sharing all state set on encoder. Only
+		/// transform, index (or vertex) range, and depth differ between draw calls.
+		///
+		/// @param[in] _id View id.
+		/// @param[in] _program Program.
+		/// @param[in] _draws Array of per draw call data.
+		/// @param[in] _num Number of draw calls in array.
+		/// @param[in] _flags Discard or preserve states. See `BGFX_DISCARD_*`.
+		///
+		/// @attention C99's equivalent binding is `bgfx_encoder_submit_batch`.
+		///
+		void submitBatch(
+			  ViewId _id
+			, ProgramHandle _program
+			, const BatchDraw* _draws
+			, uint32_t _num
+			, uint8_t _flags = BGFX_DISCARD_ALL
+			);
+
+		/// Begin recording draw calls into retained draw list. Until `endDrawList`
+		/// is called, draw calls submitted with this encoder are recorded into draw
+		/// list instead of being submitted into frame, and view id passed to `submit`
+		/// is ignored. Previous content of draw list is discarded.
+		///
+		/// @param[in] _handle Draw list handle.
+		///
+		/// @remarks
+		///   Recorded draw calls must not use transient buffers, instance data
+		///   buffers allocated with `allocInstanceDataBuffer`, or occlusion queries.
+		///
+		/// @attention C99's equivalent binding is `bgfx_encoder_begin_draw_list`.
+		///
+		void beginDrawList(DrawListHandle _handle);
+
+		/// End recording draw calls into retained draw list.
+		///
+		/// @attention C99's equivalent binding is `bgfx_encoder_end_draw_list`.
+		///
+		void endDrawList();
+
+		/// Submit draw calls recorded in retained draw list.
+		///
+		/// @param[in] _id View id.
+		/// @param[in] _handle Draw list handle.
+		/// @param[in] _mtx Pointer to transform matrices replacing transforms recorded
+		///   in draw list, or `NULL` to use recorded transforms.
+		/// @param[in] _num Number of matrices in array. Must be equal to number of
+		///   matrices recorded in draw list.
+		///
+		/// @attention C99's equivalent binding is `bgfx_encoder_submit_draw_list`.
+		///
+		void submit(
+			  ViewId _id
+			, DrawListHandle _handle
+			, const void* _mtx = NULL
+			, uint16_t _num = 0
+			);
+
+		/// Allocate transient index buffer. Encoder reserves chunks of frame's
+		/// transient index buffer, and sub-allocates from them without locking.
+		///
+		/// @param[out] _tib TransientIndexBuffer structure will be filled, and will be valid
+		///   for the duration of frame, and can be reused for multiple draw calls.
+		/// @param[in] _num Number of indices to allocate.
+		/// @param[in] _index32 Set to `true` if input indices will be 32-bit.
+		///
+		/// @attention C99's equivalent binding is `bgfx_encoder_alloc_transient_index_buffer`.
+		///
+		void allocTransientIndexBuffer(
+			  TransientIndexBuffer* _tib
+			, uint32_t _num
+			, bool _index32 = false
+			);
+
+		/// Allocate transient vertex buffer. Encoder reserves chunks of frame's
+		/// transient vertex buffer, and sub-allocates from them without locking.
+		///
+		/// @param[out] _tvb TransientVertexBuffer structure will be filled, and will be valid
+		///   for the duration of frame, and can be reused for multiple draw calls.
+		/// @param[in] _num Number of vertices to allocate.
+		/// @param[in] _layout Vertex layout.
+		///
+		/// @attention C99's equivalent binding is `bgfx_encoder_alloc_transient_vertex_buffer`.
+		///
+		void allocTransientVertexBuffer(
+			  TransientVertexBuffer* _tvb
+			, uint32_t _num
+			, const VertexLayout& _layout
+			);
+
+		/// Allocate instance data buffer from encoder's transient vertex buffer
+		/// chunk.
+		///
+		/// @param[out] _idb InstanceDataBuffer structure will be filled, and will be valid
+		///   for the duration of frame, and can be reused for multiple draw calls.
+		/// @param[in] _num Number of instances.
+		/// @param[in] _stride Instance stride. Must be multiple of 16.
+		///
+		/// @attention C99's equivalent binding is `bgfx_encoder_alloc_instance_data_buffer`.
+		///
+		void allocInstanceDataBuffer(
+			  InstanceDataBuffer* _idb
+			, uint32_t _num
+			, uint16_t _stride
+			);
+
 		/// Set compute index buffer.
 		///
 		/// @param[in] _stage Compute stage.
@@ -1948,6 +2124,35 @@ namespace bgfx
 		, float _epsilon = 0.001f
 		);
 
+	/// Weld vertices, and write unique vertices into compacted vertex stream.
+	///
+	/// @param[in] _output Welded vertices remapping table. The size of buffer
+	///   must be the same as number of vertices. Each entry is index of vertex
+	///   in compacted vertex stream.
+	/// @param[in] _dstData Compacted vertex stream. The size of buffer must be
+	///   large enough to hold all vertices of input vertex stream. Unique vertices
+	///   are written in order of their first occurrence.
+	/// @param[in] _layout Vertex stream layout.
+	/// @param[in] _data Vertex stream.
+	/// @param[in] _num Number of vertices in vertex stream.
+	/// @param[in] _index32 Set to `true` if input indices are 32-bit.
+	/// @param[in] _epsilon Error tolerance for vertex comparison.
+	/// @param[in] _flags Weld flags, see `BGFX_WELD_*`.
+	/// @returns Number of unique vertices after vertex welding.
+	///
+	/// @attention C99's equivalent binding is `bgfx_weld_vertices_compact`.
+	///
+	uint32_t weldVertices(
+		  void* _output
+		, void* _dstData
+		, const VertexLayout& _layout
+		, const void* _data
+		, uint32_t _num
+		, bool _index32
+		, float _epsilon = 0.001f
+		, uint8_t _flags = BGFX_WELD_NONE
+		);
+
 	/// Convert index buffer for use with different primitive topologies.
 	///
 	/// @param[in] _conversion Conversion type, see `TopologyConvert::Enum`.
@@ -2088,8 +2293,9 @@ namespace bgfx
 	/// @param[in] _capture Capture frame with graphics debugger.
 	///
 	/// @returns Current frame number. This might be used in conjunction with
-	///   double/multi buffering data outside the library and passing it to
-	///   library via `bgfx::makeRef` calls.
+	///   multi buffering data outside the library and passing it to library
+	///   via `bgfx::makeRef` calls. Memory referenced in frame N is consumed
+	///   by frame N + `Init::Limits::maxFramesInFlight` + 1.
 	///
 	/// @attention C99's equivalent binding is `bgfx_frame`.
 	///
@@ -2145,8 +2351,8 @@ namespace bgfx
 	/// Make reference to data to pass to bgfx. Unlike `bgfx::alloc`, this call
 	/// doesn't allocate memory for data. It just copies the _data pointer. You
 	/// can pass `ReleaseFn` function pointer to release this memory after it's
-	/// consumed, otherwise you must make sure _data is available for at least 2
-	/// `bgfx::frame` calls. `ReleaseFn` function must be able to be called
+	/// consumed, otherwise you must make sure _data is available for at least
+	/// `Init::Limits::maxFramesInFlight` + 1 `bgfx::frame` calls. `ReleaseFn` function must be able to be called
 	/// from any thread.
 	///
 	/// @param[in] _data Pointer to data.
@@ -2154,7 +2360,8 @@ namespace bgfx
 	/// @param[in] _releaseFn Callback function to release memory after use.
 	/// @param[in] _userData User data to be passed to callback function.
 	///
-	/// @attention Data passed must be available for at least 2 `bgfx::frame` calls.
+	/// @attention Data passed must be available for at least `Init::Limits::maxFramesInFlight` + 1
+	///   `bgfx::frame` calls.
 	/// @attention C99's equivalent bindings are `bgfx_make_ref`, `bgfx_make_ref_release`.
 	///
 	const Memory* makeRef(
@@ -2492,6 +2699,24 @@ namespace bgfx
 		, const Memory* _mem
 		);
 
+	/// Update dynamic vertex buffer asynchronously. Update is queued, and issued
+	///   over one or more frames within upload budget. See `Init::Limits`.
+	///
+	/// @param[in] _handle Dynamic vertex buffer handle.
+	/// @param[in] _startVertex Start vertex.
+	/// @param[in] _mem Vertex buffer data.
+	///
+	/// @returns Upload fence. See: `bgfx::isUploadComplete`.
+	///
+	/// @attention Asynchronous updates are not ordered with immediate updates.
+	/// @attention C99's equivalent binding is `bgfx_update_dynamic_vertex_buffer_async`.
+	///
+	uint32_t updateAsync(
+		  DynamicVertexBufferHandle _handle
+		, uint32_t _startVertex
+		, const Memory* _mem
+		);
+
 	/// Destroy dynamic vertex buffer.
 	///
 	/// @param[in] _handle Dynamic vertex buffer handle.
@@ -2936,6 +3161,47 @@ namespace bgfx
 		, uint16_t _pitch = UINT16_MAX
 		);
 
+	/// Update 2D texture asynchronously. Update is queued, and issued over one
+	///   or more frames within upload budget. See `Init::Limits`.
+	///
+	/// @param[in] _handle Texture handle.
+	/// @param[in] _layer Layers in texture array.
+	/// @param[in] _mip Mip level.
+	/// @param[in] _x X offset in texture.
+	/// @param[in] _y Y offset in texture.
+	/// @param[in] _width Width of texture block.
+	/// @param[in] _height Height of texture block.
+	/// @param[in] _mem Texture update data.
+	/// @param[in] _pitch Pitch of input image (bytes). When _pitch is set to
+	///   UINT16_MAX, it will be calculated internally based on _width.
+	///
+	/// @returns Upload fence. See: `bgfx::isUploadComplete`.
+	///
+	/// @attention It's valid to update only mutable texture. See `bgfx::createTexture2D` for more info.
+	/// @attention Asynchronous updates are not ordered with immediate updates.
+	/// @attention C99's equivalent binding is `bgfx_update_texture_2d_async`.
+	///
+	uint32_t updateTexture2DAsync(
+		  TextureHandle _handle
+		, uint16_t _layer
+		, uint8_t _mip
+		, uint16_t _x
+		, uint16_t _y
+		, uint16_t _width
+		, uint16_t _height
+		, const Memory* _mem
+		, uint16_t _pitch = UINT16_MAX
+		);
+
+	/// Returns true when asynchronous upload was consumed by render thread, and its
+	///   memory is released. Upload might still be in flight on GPU.
+	///
+	/// @param[in] _fence Upload fence returned by asynchronous update function.
+	///
+	/// @attention C99's equivalent binding is `bgfx_is_upload_complete`.
+	///
+	bool isUploadComplete(uint32_t _fence);
+
 	/// Update 3D texture.
 	///
 	/// @param[in] _handle Texture handle.
@@ -3305,6 +3571,23 @@ namespace bgfx
 	///
 	void destroy(OcclusionQueryHandle _handle);
 
+	/// Create retained draw list. Draw calls recorded into draw list can be
+	/// submitted every frame without encoding them again.
+	///
+	/// @returns Handle to draw list object.
+	///
+	/// @attention C99's equivalent binding is `bgfx_create_draw_list`.
+	///
+	DrawListHandle createDrawList();
+
+	/// Destroy retained draw list.
+	///
+	/// @param[in] _handle Handle to draw list object.
+	///
+	/// @attention C99's equivalent binding is `bgfx_destroy_draw_list`.
+	///
+	void destroy(DrawListHandle _handle);
+
 	/// Set palette color value.
 	///
 	/// @param[in] _index Index into palette.
@@ -4051,6 +4334,64 @@ namespace bgfx
 		, uint8_t _flags = BGFX_DISCARD_ALL
 		);
 
+	/// Submit batch of draw calls sharing all state set for draw call. Only
+	/// transform, index (or vertex) range, and depth differ between draw calls.
+	///
+	/// @param[in] _id View id.
+	/// @param[in] _program Program.
+	/// @param[in] _draws Array of per draw call data.
+	/// @param[in] _num Number of draw calls in array.
+	/// @param[in] _flags Which states to discard for next draw. See `BGFX_DISCARD_*`.
+	///
+	/// @attention C99's equivalent binding is `bgfx_submit_batch`.
+	///
+	void submitBatch(
+		  ViewId _id
+		, ProgramHandle _program
+		, const BatchDraw* _draws
+		, uint32_t _num
+		, uint8_t _flags = BGFX_DISCARD_ALL
+		);
+
+	/// Begin recording draw calls into retained draw list. Until `endDrawList`
+	/// is called, draw calls are recorded into draw list instead of being
+	/// submitted into frame, and view id passed to `submit` is ignored.
+	/// Previous content of draw list is discarded.
+	///
+	/// @param[in] _handle Draw list handle.
+	///
+	/// @remarks
+	///   Recorded draw calls must not use transient buffers, instance data
+	///   buffers allocated with `allocInstanceDataBuffer`, or occlusion queries.
+	///
+	/// @attention C99's equivalent binding is `bgfx_begin_draw_list`.
+	///
+	void beginDrawList(DrawListHandle _handle);
+
+	/// End recording draw calls into retained draw list.
+	///
+	/// @attention C99's equivalent binding is `bgfx_end_draw_list`.
+	///
+	void endDrawList();
+
+	/// Submit draw calls recorded in retained draw list.
+	///
+	/// @param[in] _id View id.
+	/// @param[in] _handle Draw list handle.
+	/// @param[in] _mtx Pointer to transform matrices replacing transforms recorded
+	///   in draw list, or `NULL` to use recorded transforms.
+	/// @param[in] _num Number of matrices in array. Must be equal to number of
+	///   matrices recorded in draw list.
+	///
+	/// @attention C99's equivalent binding is `bgfx_submit_draw_list`.
+	///
+	void submit(
+		  ViewId _id
+		, DrawListHandle _handle
+		, const void* _mtx = NULL
+		, uint16_t _num = 0
+		);
+
 	/// Set compute index buffer.
 	///
 	/// @param[in] _stage Compute stage.
@@ -4275,6 +4616,21 @@ namespace bgfx
 		, const char* _filePath
 		);
 
+	/// Replay pipeline manifest recorded in previous runs, and prewarm pipelines listed in it
+	/// before next frame is rendered.
+	///
+	/// @remarks
+	///   Manifest is recorded by renderer for every unique pipeline it creates, and it's stored
+	///   with `bgfx::CallbackI::cacheWrite`. Pipelines depending on programs created after this
+	///   call, but before next `bgfx::frame` are prewarmed too. Creation time of each pipeline
+	///   is reported in `bgfx::Stats::pipelineStats`.
+	///
+	/// @attention Only Vulkan and OpenGL (with program binary support) renderers record
+	///   pipeline manifest.
+	/// @attention C99's equivalent binding is `bgfx_replay_pipeline_manifest`.
+	///
+	void replayPipelineManifest();
+
 } // namespace bgfx
 
 #endif // BGFX_H_HEADER_GUARD
@@ -463,6 +463,8 @@ typedef struct bgfx_callback_vtbl_s
 
 } bgfx_callback_vtbl_t;
 
+typedef struct bgfx_draw_list_handle_s { uint16_t idx; } bgfx_draw_list_handle_t;
+
 typedef struct bgfx_dynamic_index_buffer_handle_s { uint16_t idx; } bgfx_dynamic_index_buffer_handle_t;
 
 typedef struct bgfx_dynamic_vertex_buffer_handle_s { uint16_t idx; } bgfx_dynamic_vertex_buffer_handle_t;
@@ -491,7 +493,9 @@ typedef struct bgfx_vertex_layout_handle_s { uint16_t idx; } bgfx_vertex_layout_
 #define BGFX_HANDLE_IS_VALID(h) ((h).idx != UINT16_MAX)
 
 /**
- * Memory release callback.
+ * Memory release callback. Called from any thread once render thread
+ * consumed memory, which can be up to `Init::Limits::maxFramesInFlight` + 1
+ * `bgfx::frame` calls after it was passed to bgfx.
  *
  * @param[in] _ptr Pointer to allocated data.
  * @param[in] _userData User defined data if needed.
@@ -540,6 +544,8 @@ typedef struct bgfx_caps_limits_s
     uint32_t             minResourceCbSize;  /** Minimum resource command buffer size.    */
     uint32_t             transientVbSize;    /** Maximum transient vertex buffer size.    */
     uint32_t             transientIbSize;    /** Maximum transient index buffer size.     */
+    uint32_t             maxSortThreads;     /** Maximum number of threads used to sort render items. */
+    uint32_t             maxFramesInFlight;  /** Maximum number of frames API thread can submit ahead of render thread. */
 
 } bgfx_caps_limits_t;
 
@@ -663,8 +669,50 @@ typedef struct bgfx_init_limits_s
 {
     uint16_t             maxEncoders;        /** Maximum number of encoder threads.       */
     uint32_t             minResourceCbSize;  /** Minimum resource command buffer size.    */
-    uint32_t             transientVbSize;    /** Maximum transient vertex buffer size.    */
-    uint32_t             transientIbSize;    /** Maximum transient index buffer size.     */
+    
+    /**
+     * Maximum transient vertex buffer size. When transient
+     * buffer growth is enabled, initial and minimum size.
+     */
+    uint32_t             transientVbSize;
+    
+    /**
+     * Maximum transient index buffer size. When transient
+     * buffer growth is enabled, initial and minimum size.
+     */
+    uint32_t             transientIbSize;
+    
+    /**
+     * Size transient vertex buffer can grow to between frames
+     * when demand exceeds its size. Zero disables growth.
+     */
+    uint32_t             transientMaxVbSize;
+    
+    /**
+     * Size transient index buffer can grow to between frames
+     * when demand exceeds its size. Zero disables growth.
+     */
+    uint32_t             transientMaxIbSize;
+    
+    /**
+     * Amount of asynchronous upload data issued per frame.
+     * Zero is unlimited.
+     */
+    uint32_t             uploadBudgetSize;
+    
+    /**
+     * Render thread time (in microseconds) asynchronous uploads
+     * can take per frame. Zero is unlimited.
+     */
+    uint32_t             uploadBudgetTime;
+    uint16_t             maxSortThreads;     /** Maximum number of threads used to sort render items. */
+    
+    /**
+     * Maximum number of frames API thread can submit ahead of
+     * render thread. Higher values increase throughput when
+     * render thread is slower, at cost of input latency.
+     */
+    uint16_t             maxFramesInFlight;
 
 } bgfx_init_limits_t;
 
@@ -834,6 +882,20 @@ typedef struct bgfx_transform_s
 
 } bgfx_transform_t;
 
+/**
+ * Per draw call data for batched submit.
+ *
+ */
+typedef struct bgfx_batch_draw_s
+{
+    uint32_t             transform;          /** Matrix cache index returned by `setTransform` or `allocTransform`. */
+    uint16_t             numMatrices;        /** Number of matrices.                      */
+    uint32_t             start;              /** First index, or first vertex of stream 0 if index buffer is not set. */
+    uint32_t             num;                /** Number of indices, or number of vertices if index buffer is not set. */
+    uint32_t             depth;              /** Depth for sorting.                       */
+
+} bgfx_batch_draw_t;
+
 /**
  * View stats.
  *
@@ -858,9 +920,23 @@ typedef struct bgfx_encoder_stats_s
 {
     int64_t              cpuTimeBegin;       /** Encoder thread CPU submit begin time.    */
     int64_t              cpuTimeEnd;         /** Encoder thread CPU submit end time.      */
+    int64_t              waitBeginTime;      /** Time spent waiting for encoder while frame was being submitted. */
+    uint32_t             numRetries;         /** Number of contended attempts to begin encoder. */
 
 } bgfx_encoder_stats_t;
 
+/**
+ * Pipeline stats.
+ *
+ */
+typedef struct bgfx_pipeline_stats_s
+{
+    uint64_t             id;                 /** Renderer specific pipeline key, stable between runs. */
+    int64_t              cpuTimeCreate;      /** CPU time spent creating pipeline.        */
+    bool                 prewarm;            /** Pipeline was created from pipeline manifest, before it was used. */
+
+} bgfx_pipeline_stats_t;
+
 /**
  * Renderer statistics data.
  * @remarks All time values are high-resolution timestamps, while
@@ -883,6 +959,8 @@ typedef struct bgfx_stats_s
     uint32_t             numBlit;            /** Number of blit calls submitted.          */
     uint32_t             maxGpuLatency;      /** GPU driver latency.                      */
     uint32_t             gpuFrameNum;        /** Frame which generated gpuTimeBegin, gpuTimeEnd. */
+    uint32_t             numSortedItems;     /** Number of render items submitted out of order, which needed sorting. */
+    uint32_t             numUniformDedup;    /** Number of uniform writes replaced with reference to identical value written earlier in frame. */
     uint16_t             numDynamicIndexBuffers; /** Number of used dynamic index buffers.    */
     uint16_t             numDynamicVertexBuffers; /** Number of used dynamic vertex buffers.   */
     uint16_t             numFrameBuffers;    /** Number of used frame buffers.            */
@@ -898,6 +976,21 @@ typedef struct bgfx_stats_s
     int64_t              rtMemoryUsed;       /** Estimate of render target memory used.   */
     int32_t              transientVbUsed;    /** Amount of transient vertex buffer used.  */
     int32_t              transientIbUsed;    /** Amount of transient index buffer used.   */
+    int32_t              transientVbSize;    /** Current size of transient vertex buffer. */
+    int32_t              transientIbSize;    /** Current size of transient index buffer.  */
+    int32_t              transientVbOverflow; /** Amount of transient vertex buffer requested, but not allocated because buffer was full. */
+    int32_t              transientIbOverflow; /** Amount of transient index buffer requested, but not allocated because buffer was full. */
+    int32_t              transientVbWasted;  /** Amount of transient vertex buffer wasted in tails of encoder chunks. */
+    int32_t              transientIbWasted;  /** Amount of transient index buffer wasted in tails of encoder chunks. */
+    int64_t              dynamicIbFree;      /** Amount of free space in dynamic index buffers. */
+    int64_t              dynamicVbFree;      /** Amount of free space in dynamic vertex buffers. */
+    uint32_t             dynamicIbFreeMax;   /** Size of largest free block in dynamic index buffers. */
+    uint32_t             dynamicVbFreeMax;   /** Size of largest free block in dynamic vertex buffers. */
+    uint32_t             dynamicIbFreeBlocks; /** Number of free blocks in dynamic index buffers. */
+    uint32_t             dynamicVbFreeBlocks; /** Number of free blocks in dynamic vertex buffers. */
+    uint32_t             uploadPending;      /** Number of queued asynchronous uploads.   */
+    uint32_t             uploadPendingSize;  /** Amount of queued asynchronous upload data not issued yet. */
+    uint32_t             uploadSize;         /** Amount of asynchronous upload data issued last frame. */
     uint32_t             numPrims[BGFX_TOPOLOGY_COUNT]; /** Number of primitives rendered.           */
     int64_t              gpuMemoryMax;       /** Maximum available GPU memory for application. */
     int64_t              gpuMemoryUsed;      /** Amount of GPU memory used by the application. */
@@ -909,6 +1002,8 @@ typedef struct bgfx_stats_s
     bgfx_view_stats_t*   viewStats;          /** Array of View stats.                     */
     uint8_t              numEncoders;        /** Number of encoders used during frame.    */
     bgfx_encoder_stats_t* encoderStats;      /** Array of encoder stats.                  */
+    uint16_t             numPipelines;       /** Number of pipelines created since last frame. */
+    bgfx_pipeline_stats_t* pipelineStats;    /** Array of pipeline stats.                 */
 
 } bgfx_stats_t;
 
@@ -1095,6 +1190,27 @@ BGFX_C_API void bgfx_vertex_convert(const bgfx_vertex_layout_t * _dstLayout, voi
  */
 BGFX_C_API uint32_t bgfx_weld_vertices(void* _output, const bgfx_vertex_layout_t * _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon);
 
+/**
+ * Weld vertices, and write unique vertices into compacted vertex stream.
+ *
+ * @param[in] _output Welded vertices remapping table. The size of buffer
+ *  must be the same as number of vertices. Each entry is index of vertex
+ *  in compacted vertex stream.
+ * @param[in] _dstData Compacted vertex stream. The size of buffer must be
+ *  large enough to hold all vertices of input vertex stream. Unique vertices
+ *  are written in order of their first occurrence.
+ * @param[in] _layout Vertex stream layout.
+ * @param[in] _data Vertex stream.
+ * @param[in] _num Number of vertices in vertex stream.
+ * @param[in] _index32 Set to `true` if input indices are 32-bit.
+ * @param[in] _epsilon Error tolerance for vertex comparison.
+ * @param[in] _flags Weld flags, see `BGFX_WELD_*`.
+ *
+ * @returns Number of unique vertices after vertex welding.
+ *
+ */
+BGFX_C_API uint32_t bgfx_weld_vertices_compact(void* _output, void* _dstData, const bgfx_vertex_layout_t * _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, uint8_t _flags);
+
 /**
  * Convert index buffer for use with different primitive topologies.
  *
@@ -1211,8 +1327,9 @@ BGFX_C_API void bgfx_reset(uint32_t _width, uint32_t _height, uint32_t _flags, b
  * @param[in] _capture Capture frame with graphics debugger.
  *
  * @returns Current frame number. This might be used in conjunction with
- *  double/multi buffering data outside the library and passing it to
- *  library via `bgfx::makeRef` calls.
+ *  multi buffering data outside the library and passing it to library
+ *  via `bgfx::makeRef` calls. Memory referenced in frame N is consumed
+ *  by frame N + `Init::Limits::maxFramesInFlight` + 1.
  *
  */
 BGFX_C_API uint32_t bgfx_frame(bool _capture);
@@ -1265,10 +1382,11 @@ BGFX_C_API const bgfx_memory_t* bgfx_copy(const void* _data, uint32_t _size);
  * Make reference to data to pass to bgfx. Unlike `bgfx::alloc`, this call
  * doesn't allocate memory for data. It just copies the _data pointer. You
  * can pass `ReleaseFn` function pointer to release this memory after it's
- * consumed, otherwise you must make sure _data is available for at least 2
- * `bgfx::frame` calls. `ReleaseFn` function must be able to be called
+ * consumed, otherwise you must make sure _data is available for at least
+ * `Init::Limits::maxFramesInFlight` + 1 `bgfx::frame` calls. `ReleaseFn` function must be able to be called
  * from any thread.
- * @attention Data passed must be available for at least 2 `bgfx::frame` calls.
+ * @attention Data passed must be available for at least `Init::Limits::maxFramesInFlight` + 1
+ * `bgfx::frame` calls.
  *
  * @param[in] _data Pointer to data.
  * @param[in] _size Size of data.
@@ -1282,10 +1400,11 @@ BGFX_C_API const bgfx_memory_t* bgfx_make_ref(const void* _data, uint32_t _size)
  * Make reference to data to pass to bgfx. Unlike `bgfx::alloc`, this call
  * doesn't allocate memory for data. It just copies the _data pointer. You
  * can pass `ReleaseFn` function pointer to release this memory after it's
- * consumed, otherwise you must make sure _data is available for at least 2
- * `bgfx::frame` calls. `ReleaseFn` function must be able to be called
+ * consumed, otherwise you must make sure _data is available for at least
+ * `Init::Limits::maxFramesInFlight` + 1 `bgfx::frame` calls. `ReleaseFn` function must be able to be called
  * from any thread.
- * @attention Data passed must be available for at least 2 `bgfx::frame` calls.
+ * @attention Data passed must be available for at least `Init::Limits::maxFramesInFlight` + 1
+ * `bgfx::frame` calls.
  *
  * @param[in] _data Pointer to data.
  * @param[in] _size Size of data.
@@ -1574,6 +1693,20 @@ BGFX_C_API bgfx_dynamic_vertex_buffer_handle_t bgfx_create_dynamic_vertex_buffer
  */
 BGFX_C_API void bgfx_update_dynamic_vertex_buffer(bgfx_dynamic_vertex_buffer_handle_t _handle, uint32_t _startVertex, const bgfx_memory_t* _mem);
 
+/**
+ * Update dynamic vertex buffer asynchronously. Update is queued, and issued
+ *   over one or more frames within upload budget. See `Init::Limits`.
+ * @attention Asynchronous updates are not ordered with immediate updates.
+ *
+ * @param[in] _handle Dynamic vertex buffer handle.
+ * @param[in] _startVertex Start vertex.
+ * @param[in] _mem Vertex buffer data.
+ *
+ * @returns Upload fence. See: `bgfx::isUploadComplete`.
+ *
+ */
+BGFX_C_API uint32_t bgfx_update_dynamic_vertex_buffer_async(bgfx_dynamic_vertex_buffer_handle_t _handle, uint32_t _startVertex, const bgfx_memory_t* _mem);
+
 /**
  * Destroy dynamic vertex buffer.
  *
@@ -1934,6 +2067,39 @@ BGFX_C_API bgfx_texture_handle_t bgfx_create_texture_cube(uint16_t _size, bool _
  */
 BGFX_C_API void bgfx_update_texture_2d(bgfx_texture_handle_t _handle, uint16_t _layer, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const bgfx_memory_t* _mem, uint16_t _pitch);
 
+/**
+ * Update 2D texture asynchronously. Update is queued, and issued over one
+ *   or more frames within upload budget. See `Init::Limits`.
+ * @attention It's valid to update only mutable texture. See `bgfx::createTexture2D` for more info.
+ * @attention Asynchronous updates are not ordered with immediate updates.
+ *
+ * @param[in] _handle Texture handle.
+ * @param[in] _layer Layer in texture array.
+ * @param[in] _mip Mip level.
+ * @param[in] _x X offset in texture.
+ * @param[in] _y Y offset in texture.
+ * @param[in] _width Width of texture block.
+ * @param[in] _height Height of texture block.
+ * @param[in] _mem Texture update data.
+ * @param[in] _pitch Pitch of input image (bytes). When _pitch is set to
+ *  UINT16_MAX, it will be calculated internally based on _width.
+ *
+ * @returns Upload fence. See: `bgfx::isUploadComplete`.
+ *
+ */
+BGFX_C_API uint32_t bgfx_update_texture_2d_async(bgfx_texture_handle_t _handle, uint16_t _layer, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const bgfx_memory_t* _mem, uint16_t _pitch);
+
+/**
+ * Returns true when asynchronous upload was consumed by render thread, and its
+ *   memory is released. Upload might still be in flight on GPU.
+ *
+ * @param[in] _fence Upload fence returned by asynchronous update function.
+ *
+ * @returns True when upload was consumed by render thread.
+ *
+ */
+BGFX_C_API bool bgfx_is_upload_complete(uint32_t _fence);
+
 /**
  * Update 3D texture.
  * @attention It's valid to update only mutable texture. See `bgfx::createTexture3D` for more info.
@@ -2221,6 +2387,21 @@ BGFX_C_API bgfx_occlusion_query_result_t bgfx_get_result(bgfx_occlusion_query_ha
  */
 BGFX_C_API void bgfx_destroy_occlusion_query(bgfx_occlusion_query_handle_t _handle);
 
+/**
+ * Create retained draw list. Draw calls recorded into draw list can be
+ * submitted every frame without encoding them again.
+ *
+ */
+BGFX_C_API bgfx_draw_list_handle_t bgfx_create_draw_list(void);
+
+/**
+ * Destroy retained draw list.
+ *
+ * @param[in] _handle Handle to draw list object.
+ *
+ */
+BGFX_C_API void bgfx_destroy_draw_list(bgfx_draw_list_handle_t _handle);
+
 /**
  * Set palette color value.
  *
@@ -2770,6 +2951,91 @@ BGFX_C_API void bgfx_encoder_submit_indirect(bgfx_encoder_t* _this, bgfx_view_id
  */
 BGFX_C_API void bgfx_encoder_submit_indirect_count(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint32_t _start, bgfx_index_buffer_handle_t _numHandle, uint32_t _numIndex, uint32_t _numMax, uint32_t _depth, uint8_t _flags);
 
+/**
+ * Submit batch of draw calls sharing all state set on encoder. Only
+ * transform, index (or vertex) range, and depth differ between draw calls.
+ *
+ * @param[in] _id View id.
+ * @param[in] _program Program.
+ * @param[in] _draws Array of per draw call data.
+ * @param[in] _num Number of draw calls in array.
+ * @param[in] _flags Discard or preserve states. See `BGFX_DISCARD_*`.
+ *
+ */
+BGFX_C_API void bgfx_encoder_submit_batch(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, const bgfx_batch_draw_t* _draws, uint32_t _num, uint8_t _flags);
+
+/**
+ * Begin recording draw calls into retained draw list. Until `endDrawList`
+ * is called, draw calls submitted with this encoder are recorded into draw
+ * list instead of being submitted into frame, and view id passed to `submit`
+ * is ignored. Previous content of draw list is discarded.
+ * @remarks
+ *   Recorded draw calls must not use transient buffers, instance data
+ *   buffers allocated with `allocInstanceDataBuffer`, or occlusion queries.
+ *
+ * @param[in] _handle Draw list handle.
+ *
+ */
+BGFX_C_API void bgfx_encoder_begin_draw_list(bgfx_encoder_t* _this, bgfx_draw_list_handle_t _handle);
+
+/**
+ * End recording draw calls into retained draw list.
+ *
+ */
+BGFX_C_API void bgfx_encoder_end_draw_list(bgfx_encoder_t* _this);
+
+/**
+ * Submit draw calls recorded in retained draw list.
+ *
+ * @param[in] _id View id.
+ * @param[in] _handle Draw list handle.
+ * @param[in] _mtx Pointer to transform matrices replacing transforms recorded
+ *  in draw list, or `NULL` to use recorded transforms.
+ * @param[in] _num Number of matrices in array. Must be equal to number of
+ *  matrices recorded in draw list.
+ *
+ */
+BGFX_C_API void bgfx_encoder_submit_draw_list(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_draw_list_handle_t _handle, const void* _mtx, uint16_t _num);
+
+/**
+ * Allocate transient index buffer. Encoder reserves chunks of frame's
+ * transient index buffer, and sub-allocates from them without locking.
+ *
+ * @param[out] _tib TransientIndexBuffer structure will be filled, and will be valid
+ *  for the duration of frame, and can be reused for multiple draw
+ *  calls.
+ * @param[in] _num Number of indices to allocate.
+ * @param[in] _index32 Set to `true` if input indices will be 32-bit.
+ *
+ */
+BGFX_C_API void bgfx_encoder_alloc_transient_index_buffer(bgfx_encoder_t* _this, bgfx_transient_index_buffer_t* _tib, uint32_t _num, bool _index32);
+
+/**
+ * Allocate transient vertex buffer. Encoder reserves chunks of frame's
+ * transient vertex buffer, and sub-allocates from them without locking.
+ *
+ * @param[out] _tvb TransientVertexBuffer structure will be filled, and will be valid
+ *  for the duration of frame, and can be reused for multiple draw
+ *  calls.
+ * @param[in] _num Number of vertices to allocate.
+ * @param[in] _layout Vertex layout.
+ *
+ */
+BGFX_C_API void bgfx_encoder_alloc_transient_vertex_buffer(bgfx_encoder_t* _this, bgfx_transient_vertex_buffer_t* _tvb, uint32_t _num, const bgfx_vertex_layout_t * _layout);
+
+/**
+ * Allocate instance data buffer from encoder's transient vertex buffer
+ * chunk.
+ *
+ * @param[out] _idb InstanceDataBuffer structure will be filled, and will be valid
+ *  for duration of frame, and can be reused for multiple draw
+ *  calls.
+ * @param[in] _num Number of instances.
+ * @param[in] _stride Instance stride. Must be multiple of 16.
+ *
+ */
+BGFX_C_API void bgfx_encoder_alloc_instance_data_buffer(bgfx_encoder_t* _this, bgfx_instance_data_buffer_t* _idb, uint32_t _num, uint16_t _stride);
+
 /**
  * Set compute index buffer.
  *
@@ -2907,6 +3173,20 @@ BGFX_C_API void bgfx_encoder_blit(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgf
  */
 BGFX_C_API void bgfx_request_screen_shot(bgfx_frame_buffer_handle_t _handle, const char* _filePath);
 
+/**
+ * Replay pipeline manifest recorded in previous runs, and prewarm pipelines listed in it
+ * before next frame is rendered.
+ * @remarks
+ *   Manifest is recorded by renderer for every unique pipeline it creates, and it's stored
+ *   with `bgfx::CallbackI::cacheWrite`. Pipelines depending on programs created after this
+ *   call, but before next `bgfx::frame` are prewarmed too. Creation time of each pipeline
+ *   is reported in `bgfx::Stats::pipelineStats`.
+ * @attention Only Vulkan and OpenGL (with program binary support) renderers record
+ *   pipeline manifest.
+ *
+ */
+BGFX_C_API void bgfx_replay_pipeline_manifest(void);
+
 /**
  * Render frame.
  * @attention `bgfx::renderFrame` is blocking call. It waits for
@@ -3353,6 +3633,52 @@ BGFX_C_API void bgfx_submit_indirect(bgfx_view_id_t _id, bgfx_program_handle_t _
  */
 BGFX_C_API void bgfx_submit_indirect_count(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint32_t _start, bgfx_index_buffer_handle_t _numHandle, uint32_t _numIndex, uint32_t _numMax, uint32_t _depth, uint8_t _flags);
 
+/**
+ * Submit batch of draw calls sharing all state set for draw call. Only
+ * transform, index (or vertex) range, and depth differ between draw calls.
+ *
+ * @param[in] _id View id.
+ * @param[in] _program Program.
+ * @param[in] _draws Array of per draw call data.
+ * @param[in] _num Number of draw calls in array.
+ * @param[in] _flags Discard or preserve states. See `BGFX_DISCARD_*`.
+ *
+ */
+BGFX_C_API void bgfx_submit_batch(bgfx_view_id_t _id, bgfx_program_handle_t _program, const bgfx_batch_draw_t* _draws, uint32_t _num, uint8_t _flags);
+
+/**
+ * Begin recording draw calls into retained draw list. Until `endDrawList`
+ * is called, draw calls are recorded into draw list instead of being
+ * submitted into frame, and view id passed to `submit` is ignored.
+ * Previous content of draw list is discarded.
+ * @remarks
+ *   Recorded draw calls must not use transient buffers, instance data
+ *   buffers allocated with `allocInstanceDataBuffer`, or occlusion queries.
+ *
+ * @param[in] _handle Draw list handle.
+ *
+ */
+BGFX_C_API void bgfx_begin_draw_list(bgfx_draw_list_handle_t _handle);
+
+/**
+ * End recording draw calls into retained draw list.
+ *
+ */
+BGFX_C_API void bgfx_end_draw_list(void);
+
+/**
+ * Submit draw calls recorded in retained draw list.
+ *
+ * @param[in] _id View id.
+ * @param[in] _handle Draw list handle.
+ * @param[in] _mtx Pointer to transform matrices replacing transforms recorded
+ *  in draw list, or `NULL` to use recorded transforms.
+ * @param[in] _num Number of matrices in array. Must be equal to number of
+ *  matrices recorded in draw list.
+ *
+ */
+BGFX_C_API void bgfx_submit_draw_list(bgfx_view_id_t _id, bgfx_draw_list_handle_t _handle, const void* _mtx, uint16_t _num);
+
 /**
  * Set compute index buffer.
  *
@@ -3494,6 +3820,7 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_VERTEX_UNPACK,
     BGFX_FUNCTION_ID_VERTEX_CONVERT,
     BGFX_FUNCTION_ID_WELD_VERTICES,
+    BGFX_FUNCTION_ID_WELD_VERTICES_COMPACT,
     BGFX_FUNCTION_ID_TOPOLOGY_CONVERT,
     BGFX_FUNCTION_ID_TOPOLOGY_SORT_TRI_LIST,
     BGFX_FUNCTION_ID_GET_SUPPORTED_RENDERERS,
@@ -3530,6 +3857,7 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_CREATE_DYNAMIC_VERTEX_BUFFER,
     BGFX_FUNCTION_ID_CREATE_DYNAMIC_VERTEX_BUFFER_MEM,
     BGFX_FUNCTION_ID_UPDATE_DYNAMIC_VERTEX_BUFFER,
+    BGFX_FUNCTION_ID_UPDATE_DYNAMIC_VERTEX_BUFFER_ASYNC,
     BGFX_FUNCTION_ID_DESTROY_DYNAMIC_VERTEX_BUFFER,
     BGFX_FUNCTION_ID_GET_AVAIL_TRANSIENT_INDEX_BUFFER,
     BGFX_FUNCTION_ID_GET_AVAIL_TRANSIENT_VERTEX_BUFFER,
@@ -3556,6 +3884,8 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_CREATE_TEXTURE_3D,
     BGFX_FUNCTION_ID_CREATE_TEXTURE_CUBE,
     BGFX_FUNCTION_ID_UPDATE_TEXTURE_2D,
+    BGFX_FUNCTION_ID_UPDATE_TEXTURE_2D_ASYNC,
+    BGFX_FUNCTION_ID_IS_UPLOAD_COMPLETE,
     BGFX_FUNCTION_ID_UPDATE_TEXTURE_3D,
     BGFX_FUNCTION_ID_UPDATE_TEXTURE_CUBE,
     BGFX_FUNCTION_ID_READ_TEXTURE,
@@ -3576,6 +3906,8 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_CREATE_OCCLUSION_QUERY,
     BGFX_FUNCTION_ID_GET_RESULT,
     BGFX_FUNCTION_ID_DESTROY_OCCLUSION_QUERY,
+    BGFX_FUNCTION_ID_CREATE_DRAW_LIST,
+    BGFX_FUNCTION_ID_DESTROY_DRAW_LIST,
     BGFX_FUNCTION_ID_SET_PALETTE_COLOR,
     BGFX_FUNCTION_ID_SET_PALETTE_COLOR_RGBA32F,
     BGFX_FUNCTION_ID_SET_PALETTE_COLOR_RGBA8,
@@ -3622,6 +3954,13 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_ENCODER_SUBMIT_OCCLUSION_QUERY,
     BGFX_FUNCTION_ID_ENCODER_SUBMIT_INDIRECT,
     BGFX_FUNCTION_ID_ENCODER_SUBMIT_INDIRECT_COUNT,
+    BGFX_FUNCTION_ID_ENCODER_SUBMIT_BATCH,
+    BGFX_FUNCTION_ID_ENCODER_BEGIN_DRAW_LIST,
+    BGFX_FUNCTION_ID_ENCODER_END_DRAW_LIST,
+    BGFX_FUNCTION_ID_ENCODER_SUBMIT_DRAW_LIST,
+    BGFX_FUNCTION_ID_ENCODER_ALLOC_TRANSIENT_INDEX_BUFFER,
+    BGFX_FUNCTION_ID_ENCODER_ALLOC_TRANSIENT_VERTEX_BUFFER,
+    BGFX_FUNCTION_ID_ENCODER_ALLOC_INSTANCE_DATA_BUFFER,
     BGFX_FUNCTION_ID_ENCODER_SET_COMPUTE_INDEX_BUFFER,
     BGFX_FUNCTION_ID_ENCODER_SET_COMPUTE_VERTEX_BUFFER,
     BGFX_FUNCTION_ID_ENCODER_SET_COMPUTE_DYNAMIC_INDEX_BUFFER,
@@ -3633,6 +3972,7 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_ENCODER_DISCARD,
     BGFX_FUNCTION_ID_ENCODER_BLIT,
     BGFX_FUNCTION_ID_REQUEST_SCREEN_SHOT,
+    BGFX_FUNCTION_ID_REPLAY_PIPELINE_MANIFEST,
     BGFX_FUNCTION_ID_RENDER_FRAME,
     BGFX_FUNCTION_ID_SET_PLATFORM_DATA,
     BGFX_FUNCTION_ID_GET_INTERNAL_DATA,
@@ -3668,6 +4008,10 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_SUBMIT_OCCLUSION_QUERY,
     BGFX_FUNCTION_ID_SUBMIT_INDIRECT,
     BGFX_FUNCTION_ID_SUBMIT_INDIRECT_COUNT,
+    BGFX_FUNCTION_ID_SUBMIT_BATCH,
+    BGFX_FUNCTION_ID_BEGIN_DRAW_LIST,
+    BGFX_FUNCTION_ID_END_DRAW_LIST,
+    BGFX_FUNCTION_ID_SUBMIT_DRAW_LIST,
     BGFX_FUNCTION_ID_SET_COMPUTE_INDEX_BUFFER,
     BGFX_FUNCTION_ID_SET_COMPUTE_VERTEX_BUFFER,
     BGFX_FUNCTION_ID_SET_COMPUTE_DYNAMIC_INDEX_BUFFER,
@@ -3700,6 +4044,7 @@ struct bgfx_interface_vtbl
     void (*vertex_unpack)(float _output[4], bgfx_attrib_t _attr, const bgfx_vertex_layout_t * _layout, const void* _data, uint32_t _index);
     void (*vertex_convert)(const bgfx_vertex_layout_t * _dstLayout, void* _dstData, const bgfx_vertex_layout_t * _srcLayout, const void* _srcData, uint32_t _num);
     uint32_t (*weld_vertices)(void* _output, const bgfx_vertex_layout_t * _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon);
+    uint32_t (*weld_vertices_compact)(void* _output, void* _dstData, const bgfx_vertex_layout_t * _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, uint8_t _flags);
     uint32_t (*topology_convert)(bgfx_topology_convert_t _conversion, void* _dst, uint32_t _dstSize, const void* _indices, uint32_t _numIndices, bool _index32);
     void (*topology_sort_tri_list)(bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
     uint8_t (*get_supported_renderers)(uint8_t _max, bgfx_renderer_type_t* _enum);
@@ -3736,6 +4081,7 @@ struct bgfx_interface_vtbl
     bgfx_dynamic_vertex_buffer_handle_t (*create_dynamic_vertex_buffer)(uint32_t _num, const bgfx_vertex_layout_t* _layout, uint16_t _flags);
     bgfx_dynamic_vertex_buffer_handle_t (*create_dynamic_vertex_buffer_mem)(const bgfx_memory_t* _mem, const bgfx_vertex_layout_t* _layout, uint16_t _flags);
     void (*update_dynamic_vertex_buffer)(bgfx_dynamic_vertex_buffer_handle_t _handle, uint32_t _startVertex, const bgfx_memory_t* _mem);
+    uint32_t (*update_dynamic_vertex_buffer_async)(bgfx_dynamic_vertex_buffer_handle_t _handle, uint32_t _startVertex, const bgfx_memory_t* _mem);
     void (*destroy_dynamic_vertex_buffer)(bgfx_dynamic_vertex_buffer_handle_t _handle);
     uint32_t (*get_avail_transient_index_buffer)(uint32_t _num, bool _index32);
     uint32_t (*get_avail_transient_vertex_buffer)(uint32_t _num, const bgfx_vertex_layout_t * _layout);
@@ -3762,6 +4108,8 @@ struct bgfx_interface_vtbl
     bgfx_texture_handle_t (*create_texture_3d)(uint16_t _width, uint16_t _height, uint16_t _depth, bool _hasMips, bgfx_texture_format_t _format, uint64_t _flags, const bgfx_memory_t* _mem);
     bgfx_texture_handle_t (*create_texture_cube)(uint16_t _size, bool _hasMips, uint16_t _numLayers, bgfx_texture_format_t _format, uint64_t _flags, const bgfx_memory_t* _mem);
     void (*update_texture_2d)(bgfx_texture_handle_t _handle, uint16_t _layer, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const bgfx_memory_t* _mem, uint16_t _pitch);
+    uint32_t (*update_texture_2d_async)(bgfx_texture_handle_t _handle, uint16_t _layer, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const bgfx_memory_t* _mem, uint16_t _pitch);
+    bool (*is_upload_complete)(uint32_t _fence);
     void (*update_texture_3d)(bgfx_texture_handle_t _handle, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _z, uint16_t _width, uint16_t _height, uint16_t _depth, const bgfx_memory_t* _mem);
     void (*update_texture_cube)(bgfx_texture_handle_t _handle, uint16_t _layer, uint8_t _side, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const bgfx_memory_t* _mem, uint16_t _pitch);
     uint32_t (*read_texture)(bgfx_texture_handle_t _handle, void* _data, uint8_t _mip);
@@ -3782,6 +4130,8 @@ struct bgfx_interface_vtbl
     bgfx_occlusion_query_handle_t (*create_occlusion_query)(void);
     bgfx_occlusion_query_result_t (*get_result)(bgfx_occlusion_query_handle_t _handle, int32_t* _result);
     void (*destroy_occlusion_query)(bgfx_occlusion_query_handle_t _handle);
+    bgfx_draw_list_handle_t (*create_draw_list)(void);
+    void (*destroy_draw_list)(bgfx_draw_list_handle_t _handle);
     void (*set_palette_color)(uint8_t _index, const float _rgba[4]);
     void (*set_palette_color_rgba32f)(uint8_t _index, float _r, float _g, float _b, float _a);
     void (*set_palette_color_rgba8)(uint8_t _index, uint32_t _rgba);
@@ -3828,6 +4178,13 @@ struct bgfx_interface_vtbl
     void (*encoder_submit_occlusion_query)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_occlusion_query_handle_t _occlusionQuery, uint32_t _depth, uint8_t _flags);
     void (*encoder_submit_indirect)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint32_t _start, uint32_t _num, uint32_t _depth, uint8_t _flags);
     void (*encoder_submit_indirect_count)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint32_t _start, bgfx_index_buffer_handle_t _numHandle, uint32_t _numIndex, uint32_t _numMax, uint32_t _depth, uint8_t _flags);
+    void (*encoder_submit_batch)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, const bgfx_batch_draw_t* _draws, uint32_t _num, uint8_t _flags);
+    void (*encoder_begin_draw_list)(bgfx_encoder_t* _this, bgfx_draw_list_handle_t _handle);
+    void (*encoder_end_draw_list)(bgfx_encoder_t* _this);
+    void (*encoder_submit_draw_list)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_draw_list_handle_t _handle, const void* _mtx, uint16_t _num);
+    void (*encoder_alloc_transient_index_buffer)(bgfx_encoder_t* _this, bgfx_transient_index_buffer_t* _tib, uint32_t _num, bool _index32);
+    void (*encoder_alloc_transient_vertex_buffer)(bgfx_encoder_t* _this, bgfx_transient_vertex_buffer_t* _tvb, uint32_t _num, const bgfx_vertex_layout_t * _layout);
+    void (*encoder_alloc_instance_data_buffer)(bgfx_encoder_t* _this, bgfx_instance_data_buffer_t* _idb, uint32_t _num, uint16_t _stride);
     void (*encoder_set_compute_index_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access);
     void (*encoder_set_compute_vertex_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_vertex_buffer_handle_t _handle, bgfx_access_t _access);
     void (*encoder_set_compute_dynamic_index_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_dynamic_index_buffer_handle_t _handle, bgfx_access_t _access);
@@ -3839,6 +4196,7 @@ struct bgfx_interface_vtbl
     void (*encoder_discard)(bgfx_encoder_t* _this, uint8_t _flags);
     void (*encoder_blit)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_texture_handle_t _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, bgfx_texture_handle_t _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth);
     void (*request_screen_shot)(bgfx_frame_buffer_handle_t _handle, const char* _filePath);
+    void (*replay_pipeline_manifest)(void);
     bgfx_render_frame_t (*render_frame)(int32_t _msecs);
     void (*set_platform_data)(const bgfx_platform_data_t * _data);
     const bgfx_internal_data_t* (*get_internal_data)(void);
@@ -3874,6 +4232,10 @@ struct bgfx_interface_vtbl
     void (*submit_occlusion_query)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_occlusion_query_handle_t _occlusionQuery, uint32_t _depth, uint8_t _flags);
     void (*submit_indirect)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint32_t _start, uint32_t _num, uint32_t _depth, uint8_t _flags);
     void (*submit_indirect_count)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint32_t _start, bgfx_index_buffer_handle_t _numHandle, uint32_t _numIndex, uint32_t _numMax, uint32_t _depth, uint8_t _flags);
+    void (*submit_batch)(bgfx_view_id_t _id, bgfx_program_handle_t _program, const bgfx_batch_draw_t* _draws, uint32_t _num, uint8_t _flags);
+    void (*begin_draw_list)(bgfx_draw_list_handle_t _handle);
+    void (*end_draw_list)(void);
+    void (*submit_draw_list)(bgfx_view_id_t _id, bgfx_draw_list_handle_t _handle, const void* _mtx, uint16_t _num);
     void (*set_compute_index_buffer)(uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access);
     void (*set_compute_vertex_buffer)(uint8_t _stage, bgfx_vertex_buffer_handle_t _handle, bgfx_access_t _access);
     void (*set_compute_dynamic_index_buffer)(uint8_t _stage, bgfx_dynamic_index_buffer_handle_t _handle, bgfx_access_t _access);
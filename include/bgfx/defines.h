@@ -15,7 +15,7 @@
 #ifndef BGFX_DEFINES_H_HEADER_GUARD
 #define BGFX_DEFINES_H_HEADER_GUARD
 
-#define BGFX_API_VERSION UINT32_C(129)
+#define BGFX_API_VERSION UINT32_C(142)
 
 /**
  * Color RGB/alpha/depth write. When it's not specified write will be disabled.
@@ -267,6 +267,9 @@
 #define BGFX_DISCARD_VERTEX_STREAMS               UINT8_C(0x20) //!< Discard vertex streams.
 #define BGFX_DISCARD_ALL                          UINT8_C(0xff) //!< Discard all states.
 
+#define BGFX_WELD_NONE                            UINT8_C(0x00) //!< Compare vertex position only.
+#define BGFX_WELD_ALL_ATTRIBUTES                  UINT8_C(0x01) //!< Compare all vertex attributes, not only position.
+
 #define BGFX_DEBUG_NONE                           UINT32_C(0x00000000) //!< No debug.
 #define BGFX_DEBUG_WIREFRAME                      UINT32_C(0x00000001) //!< Enable wireframe for all primitives.
 
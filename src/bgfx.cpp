@@ -302,10 +302,13 @@ namespace bgfx
 	};
 
 	static ThreadData s_threadIndex(0);
+	static ThreadData s_resourceCmdIdx(0);
 #elif !BGFX_CONFIG_MULTITHREADED
 	static uint32_t s_threadIndex(0);
+	static uint32_t s_resourceCmdIdx(0);
 #else
 	static BX_THREAD_LOCAL uint32_t s_threadIndex(0);
+	static BX_THREAD_LOCAL uint32_t s_resourceCmdIdx(0);
 #endif
 
 	static Context* s_ctx = NULL;
@@ -1223,6 +1226,259 @@ namespace bgfx
 		}
 	}
 
+	constexpr uint32_t kSortRadixBits    = 8;
+	constexpr uint32_t kSortRadixBuckets = 1<<kSortRadixBits;
+	constexpr uint32_t kSortRadixMask    = kSortRadixBuckets-1;
+	constexpr uint32_t kSortRadixPasses  = 64/kSortRadixBits;
+
+	// LSD radix sort of run sort keys. Histograms for all passes are built with a
+	// single read of the keys, and passes where all keys share the same digit are
+	// skipped. Keys within a run usually share view and most of the state bits, so
+	// only few passes are needed.
+	static void radixSortRun(
+		  uint64_t* _keys
+		, uint64_t* _tempKeys
+		, RenderItemCount* _values
+		, RenderItemCount* _tempValues
+		, uint32_t _num
+		)
+	{
+		uint32_t histogram[kSortRadixPasses][kSortRadixBuckets];
+		bx::memSet(histogram, 0, sizeof(histogram) );
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const uint64_t key = _keys[ii];
+
+			for (uint32_t pass = 0; pass < kSortRadixPasses; ++pass)
+			{
+				const uint32_t digit = uint32_t(key >> (pass*kSortRadixBits) ) & kSortRadixMask;
+				++histogram[pass][digit];
+			}
+		}
+
+		uint64_t*        srcKeys   = _keys;
+		uint64_t*        dstKeys   = _tempKeys;
+		RenderItemCount* srcValues = _values;
+		RenderItemCount* dstValues = _tempValues;
+
+		for (uint32_t pass = 0; pass < kSortRadixPasses; ++pass)
+		{
+			uint32_t* offset = histogram[pass];
+
+			const uint32_t digit = uint32_t(srcKeys[0] >> (pass*kSortRadixBits) ) & kSortRadixMask;
+			if (_num == offset[digit])
+			{
+				continue;
+			}
+
+			for (uint32_t bucket = 0, total = 0; bucket < kSortRadixBuckets; ++bucket)
+			{
+				const uint32_t count = offset[bucket];
+				offset[bucket] = total;
+				total += count;
+			}
+
+			const uint32_t shift = pass*kSortRadixBits;
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				const uint64_t key  = srcKeys[ii];
+				const uint32_t dest = offset[uint32_t(key >> shift) & kSortRadixMask]++;
+				dstKeys[dest]   = key;
+				dstValues[dest] = srcValues[ii];
+			}
+
+			bx::swap(srcKeys,   dstKeys);
+			bx::swap(srcValues, dstValues);
+		}
+
+		if (srcKeys != _keys)
+		{
+			bx::memCopy(_keys,   srcKeys,   _num*sizeof(uint64_t) );
+			bx::memCopy(_values, srcValues, _num*sizeof(RenderItemCount) );
+		}
+	}
+
+	uint32_t EncoderImpl::allocRenderItem(uint32_t _max)
+	{
+		if (m_runPos == m_runEnd)
+		{
+			finishRun();
+
+			// Reserve next run of render item slots. This is the only place where
+			// encoders touch shared render item counter.
+			const uint32_t begin = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItemSlots, m_runSize, BGFX_CONFIG_MAX_DRAW_CALLS);
+			if (BGFX_CONFIG_MAX_DRAW_CALLS <= begin)
+			{
+				return UINT32_MAX;
+			}
+
+			m_runIdx       = bx::atomicFetchAndAdd<uint32_t>(&m_frame->m_numSortRuns, 1);
+			m_runBegin     = begin;
+			m_runPos       = begin;
+			m_runEnd       = bx::min<uint32_t>(begin + m_runSize, BGFX_CONFIG_MAX_DRAW_CALLS);
+			m_runSortedEnd = begin;
+			m_runSize      = bx::min<uint32_t>(m_runSize*2, BGFX_CONFIG_MAX_SORT_RUN_SIZE);
+			m_runLastKey   = 0;
+			resetRunViews();
+
+			BX_ASSERT(m_runIdx < BGFX_CONFIG_MAX_SORT_RUNS, "Sort run index is out of range (idx %d).", m_runIdx);
+		}
+
+		if (_max <= m_runPos)
+		{
+			return UINT32_MAX;
+		}
+
+		return m_runPos++;
+	}
+
+	void EncoderImpl::finishRun()
+	{
+		if (m_runBegin == m_runEnd)
+		{
+			return;
+		}
+
+		const uint32_t num         = m_runPos - m_runBegin;
+		const uint32_t numInOrder  = m_runSortedEnd - m_runBegin;
+		const uint32_t numUnsorted = num - numInOrder;
+
+		if (0 < numUnsorted
+		&&  m_runTempSize < num)
+		{
+			// Scratch is sized to the current run, it grows only as runs double in
+			// size toward BGFX_CONFIG_MAX_SORT_RUN_SIZE.
+			m_runTempSize   = m_runEnd - m_runBegin;
+			m_runTempKeys   = (uint64_t*)bx::realloc(g_allocator, m_runTempKeys, m_runTempSize*sizeof(uint64_t) );
+			m_runTempValues = (RenderItemCount*)bx::realloc(g_allocator, m_runTempValues, m_runTempSize*sizeof(RenderItemCount) );
+		}
+
+		if (0 < numUnsorted
+		&&  m_runViewsInOrder)
+		{
+			// Keys are in order within each view, stable partition by view sorts
+			// the whole run.
+			uint64_t*        keys   = &m_frame->m_sortKeys[m_runBegin];
+			RenderItemCount* values = &m_frame->m_sortValues[m_runBegin];
+
+			// Only few views are used in single run, insertion sort is enough.
+			for (uint32_t ii = 1; ii < m_runNumViews; ++ii)
+			{
+				const ViewId view = m_runView[ii];
+
+				uint32_t jj = ii;
+				for (; 0 < jj && view < m_runView[jj-1]; --jj)
+				{
+					m_runView[jj] = m_runView[jj-1];
+				}
+
+				m_runView[jj] = view;
+			}
+
+			// View counts are turned into destination offsets.
+			for (uint32_t ii = 0, offset = 0; ii < m_runNumViews; ++ii)
+			{
+				const ViewId view = m_runView[ii];
+				const uint32_t count = m_runViewCount[view];
+				m_runViewCount[view] = offset;
+				offset += count;
+			}
+
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				const ViewId view = ViewId(keys[ii] >> kSortKeyViewBitShift);
+				const uint32_t dst = m_runViewCount[view]++;
+				m_runTempKeys[dst]   = keys[ii];
+				m_runTempValues[dst] = values[ii];
+			}
+
+			bx::memCopy(keys,   m_runTempKeys,   num*sizeof(uint64_t) );
+			bx::memCopy(values, m_runTempValues, num*sizeof(RenderItemCount) );
+
+			bx::atomicFetchAndAdd<uint32_t>(&m_frame->m_numSortedItems, numUnsorted);
+		}
+		else if (0 < numUnsorted)
+		{
+			uint64_t*        keys   = &m_frame->m_sortKeys[m_runBegin];
+			RenderItemCount* values = &m_frame->m_sortValues[m_runBegin];
+
+			radixSortRun(
+				  &keys[numInOrder]
+				, m_runTempKeys
+				, &values[numInOrder]
+				, m_runTempValues
+				, numUnsorted
+				);
+
+			if (0 < numInOrder)
+			{
+				// Merge in order head with sorted tail. On equal keys head goes first,
+				// to preserve submission order.
+				uint32_t head = 0;
+				uint32_t tail = numInOrder;
+				uint32_t dst  = 0;
+
+				while (head < numInOrder
+				&&     tail < num)
+				{
+					const uint32_t src = keys[tail] < keys[head] ? tail++ : head++;
+					m_runTempKeys[dst]   = keys[src];
+					m_runTempValues[dst] = values[src];
+					++dst;
+				}
+
+				for (; head < numInOrder; ++head, ++dst)
+				{
+					m_runTempKeys[dst]   = keys[head];
+					m_runTempValues[dst] = values[head];
+				}
+
+				for (; tail < num; ++tail, ++dst)
+				{
+					m_runTempKeys[dst]   = keys[tail];
+					m_runTempValues[dst] = values[tail];
+				}
+
+				bx::memCopy(keys,   m_runTempKeys,   num*sizeof(uint64_t) );
+				bx::memCopy(values, m_runTempValues, num*sizeof(RenderItemCount) );
+			}
+
+			bx::atomicFetchAndAdd<uint32_t>(&m_frame->m_numSortedItems, numUnsorted);
+		}
+
+		SortRun& run = m_frame->m_sortRun[m_runIdx];
+		run.m_begin = m_runBegin;
+		run.m_num   = num;
+
+		m_runBegin = m_runPos;
+		m_runEnd   = m_runPos;
+	}
+
+	void EncoderImpl::updateNumVertices()
+	{
+		if (UINT8_MAX != m_draw.m_streamMask)
+		{
+			uint32_t numVertices = UINT32_MAX;
+			for (uint32_t idx = 0, streamMask = m_draw.m_streamMask
+				; 0 != streamMask
+				; streamMask >>= 1, idx += 1
+				)
+			{
+				const uint32_t ntz = bx::uint32_cnttz(streamMask);
+				streamMask >>= ntz;
+				idx         += ntz;
+				numVertices = bx::min(numVertices, m_numVertices[idx]);
+			}
+
+			m_draw.m_numVertices = numVertices;
+		}
+		else
+		{
+			m_draw.m_numVertices = m_numVertices[0];
+		}
+	}
+
 	void EncoderImpl::submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, uint8_t _flags)
 	{
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM)
@@ -1255,164 +1511,1208 @@ namespace bgfx
 			return;
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS <= renderItemIdx)
-		{
-			discard(_flags);
-			++m_numDropped;
-			return;
-		}
+		updateNumVertices();
+
+		if (isValid(m_drawList) )
+		{
+			BX_ASSERT(!isValid(_occlusionQuery), "Occlusion query can't be recorded into draw list.");
+
+			if (!isRecordable() )
+			{
+				discard(_flags);
+				++m_numDropped;
+				return;
+			}
+
+			record(_program, _depth, _flags);
+			return;
+		}
+
+		const uint32_t renderItemIdx = allocRenderItem(BGFX_CONFIG_MAX_DRAW_CALLS);
+		if (UINT32_MAX == renderItemIdx)
+		{
+			discard(_flags);
+			++m_numDropped;
+			return;
+		}
+
+		++m_numSubmitted;
+
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		m_uniformEnd = uniformBuffer->getPos();
+
+		m_key.m_program = isValid(_program)
+			? _program
+			: ProgramHandle{0}
+			;
+
+		m_key.m_view = _id;
+
+		SortKey::Enum type;
+		switch (s_ctx->m_view[_id].m_mode)
+		{
+		case ViewMode::Sequential:      m_key.m_seq   = s_ctx->getSeqIncr(_id); type = SortKey::SortSequence; break;
+		case ViewMode::DepthAscending:  m_key.m_depth =            _depth;      type = SortKey::SortDepth;    break;
+		case ViewMode::DepthDescending: m_key.m_depth = UINT32_MAX-_depth;      type = SortKey::SortDepth;    break;
+		default:                        m_key.m_depth =            _depth;      type = SortKey::SortProgram;  break;
+		}
+
+		uint64_t key = m_key.encodeDraw(type);
+		setSortKey(renderItemIdx, key);
+
+		m_draw.m_uniformIdx   = m_uniformIdx;
+		m_draw.m_uniformBegin = m_uniformBegin;
+		m_draw.m_uniformEnd   = m_uniformEnd;
+
+		if (isValid(_occlusionQuery) )
+		{
+			m_draw.m_stateFlags |= BGFX_STATE_INTERNAL_OCCLUSION_QUERY;
+			m_draw.m_occlusionQuery = _occlusionQuery;
+		}
+
+		m_frame->m_renderItem[renderItemIdx].draw = m_draw;
+		m_frame->m_renderItemBind[renderItemIdx]  = m_bind;
+
+		m_draw.clear(_flags);
+		m_bind.clear(_flags);
+		if (_flags & BGFX_DISCARD_STATE)
+		{
+			m_uniformBegin = m_uniformEnd;
+		}
+	}
+
+	void DrawList::destroy()
+	{
+		if (NULL != m_item)
+		{
+			bx::alignedFree(g_allocator, m_item, BX_ALIGNOF(Item) );
+		}
+
+		if (NULL != m_matrix)
+		{
+			bx::alignedFree(g_allocator, m_matrix, BX_ALIGNOF(Matrix4) );
+		}
+
+		bx::free(g_allocator, m_uniform);
+		bx::free(g_allocator, m_ref);
+
+		m_item    = NULL;
+		m_matrix  = NULL;
+		m_uniform = NULL;
+		m_ref     = NULL;
+
+		m_maxItems       = 0;
+		m_maxMatrices    = 0;
+		m_maxUniformSize = 0;
+		m_maxRefs        = 0;
+
+		reset();
+	}
+
+	DrawList::Item& DrawList::addItem()
+	{
+		if (m_numItems == m_maxItems)
+		{
+			m_maxItems = bx::max<uint32_t>(m_maxItems*2, 64);
+
+			Item* item = (Item*)bx::alignedAlloc(g_allocator, m_maxItems*sizeof(Item), BX_ALIGNOF(Item) );
+			if (NULL != m_item)
+			{
+				bx::memCopy(item, m_item, m_numItems*sizeof(Item) );
+				bx::alignedFree(g_allocator, m_item, BX_ALIGNOF(Item) );
+			}
+
+			m_item = item;
+		}
+
+		return m_item[m_numItems++];
+	}
+
+	void DrawList::addRef(DrawListRef::Enum _type, uint16_t _idx)
+	{
+		const uint16_t gen = s_ctx->m_drawListRefGen[_type][_idx];
+
+		// Recorded draw calls mostly reuse the same few resources, look from the
+		// most recently added ones.
+		for (uint32_t ii = m_numRefs; 0 < ii; --ii)
+		{
+			const DrawListRef& ref = m_ref[ii-1];
+			if (_type == ref.m_type
+			&&  _idx  == ref.m_idx)
+			{
+				return;
+			}
+		}
+
+		if (m_numRefs == m_maxRefs)
+		{
+			m_maxRefs = bx::max<uint32_t>(m_maxRefs*2, 16);
+			m_ref = (DrawListRef*)bx::realloc(g_allocator, m_ref, m_maxRefs*sizeof(DrawListRef) );
+		}
+
+		DrawListRef& ref = m_ref[m_numRefs++];
+		ref.m_type = uint16_t(_type);
+		ref.m_idx  = _idx;
+		ref.m_gen  = gen;
+	}
+
+	bool DrawList::isValid() const
+	{
+		for (uint32_t ii = 0; ii < m_numRefs; ++ii)
+		{
+			const DrawListRef& ref = m_ref[ii];
+			if (ref.m_gen != s_ctx->m_drawListRefGen[ref.m_type][ref.m_idx])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	uint32_t DrawList::addMatrices(const void* _mtx, uint16_t _num)
+	{
+		BX_ASSERT(m_numMatrices + _num <= UINT16_MAX, "Too many matrices recorded in draw list.");
+
+		if (m_numMatrices + _num > m_maxMatrices)
+		{
+			m_maxMatrices = bx::max<uint32_t>(bx::max<uint32_t>(m_maxMatrices*2, 64), m_numMatrices + _num);
+
+			Matrix4* matrix = (Matrix4*)bx::alignedAlloc(g_allocator, m_maxMatrices*sizeof(Matrix4), BX_ALIGNOF(Matrix4) );
+			if (NULL != m_matrix)
+			{
+				bx::memCopy(matrix, m_matrix, m_numMatrices*sizeof(Matrix4) );
+				bx::alignedFree(g_allocator, m_matrix, BX_ALIGNOF(Matrix4) );
+			}
+
+			m_matrix = matrix;
+		}
+
+		const uint32_t first = m_numMatrices;
+		bx::memCopy(&m_matrix[first], _mtx, _num*sizeof(Matrix4) );
+		m_numMatrices += _num;
+
+		return first;
+	}
+
+	uint32_t DrawList::addUniforms(UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
+	{
+		const uint32_t offset = m_uniformSize;
+		const uint32_t pos    = _uniformBuffer->getPos();
+
+		_uniformBuffer->reset(_begin);
+		while (_uniformBuffer->getPos() < _end)
+		{
+			const uint32_t opcode = _uniformBuffer->read();
+
+			uint8_t type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+			const bool ref = 0 != (type & kUniformRefBit);
+			type &= ~kUniformRefBit;
+
+			// References to data written earlier in uniform stream are resolved, since
+			// recorded uniforms outlive the stream. Page padding is not copied.
+			const uint32_t size = g_uniformTypeSize[type]*num;
+			const char* data = ref
+				? _uniformBuffer->getData(_uniformBuffer->read() )
+				: _uniformBuffer->read(size)
+				;
+
+			const uint32_t recordSize = sizeof(uint32_t) + size;
+			if (m_uniformSize + recordSize > m_maxUniformSize)
+			{
+				m_maxUniformSize = bx::max<uint32_t>(bx::max<uint32_t>(m_maxUniformSize*2, 4<<10), m_uniformSize + recordSize);
+				m_uniform        = (char*)bx::realloc(g_allocator, m_uniform, m_maxUniformSize);
+			}
+
+			const uint32_t recordOpcode = UniformBuffer::encodeOpcode(type, loc, num, true);
+			bx::memCopy(&m_uniform[m_uniformSize], &recordOpcode, sizeof(uint32_t) );
+			bx::memCopy(&m_uniform[m_uniformSize + sizeof(uint32_t)], data, size);
+			m_uniformSize += recordSize;
+		}
+
+		_uniformBuffer->reset(pos);
+
+		return offset;
+	}
+
+	void EncoderImpl::beginDrawList(DrawListHandle _handle)
+	{
+		BX_ASSERT(!isValid(m_drawList), "Already recording draw list %d.", m_drawList.idx);
+
+		DrawList& drawList = s_ctx->m_drawList[_handle.idx];
+
+		const uint32_t busy = bx::atomicCompareAndSwap<uint32_t>(&drawList.m_busy, 0, 1);
+		BX_ASSERT(0 == busy, "Draw list %d is already being recorded by another encoder.", _handle.idx);
+		BX_UNUSED(busy);
+
+		m_drawList = _handle;
+		drawList.reset();
+	}
+
+	void EncoderImpl::endDrawList()
+	{
+		BX_ASSERT(isValid(m_drawList), "Draw list recording was not started.");
+
+		bx::atomicCompareAndSwap<uint32_t>(&s_ctx->m_drawList[m_drawList.idx].m_busy, 1, 0);
+		m_drawList.idx = kInvalidHandle;
+	}
+
+	void EncoderImpl::addDrawListRef(DrawListRef::Enum _type, uint16_t _idx)
+	{
+		if (isValid(m_drawList)
+		&&  kInvalidHandle != _idx)
+		{
+			s_ctx->m_drawList[m_drawList.idx].addRef(_type, _idx);
+		}
+	}
+
+	bool EncoderImpl::isRecordable() const
+	{
+		// Transient buffers are valid only for the frame they were allocated in, draw
+		// list outlives it.
+		const uint16_t transientIb = m_frame->m_transientIb->handle.idx;
+		const uint16_t transientVb = m_frame->m_transientVb->handle.idx;
+
+		bool transient = false
+			|| m_draw.m_indexBuffer.idx        == transientIb
+			|| m_draw.m_instanceDataBuffer.idx == transientVb
+			;
+
+		if (UINT8_MAX != m_draw.m_streamMask)
+		{
+			for (uint32_t idx = 0, streamMask = m_draw.m_streamMask
+				; 0 != streamMask
+				; streamMask >>= 1, idx += 1
+				)
+			{
+				const uint32_t ntz = bx::uint32_cnttz(streamMask);
+				streamMask >>= ntz;
+				idx         += ntz;
+				transient   |= m_draw.m_stream[idx].m_handle.idx == transientVb;
+			}
+		}
+
+		BX_WARN(!transient
+			, "Draw calls using transient buffers can't be recorded into draw list %d, draw call is dropped."
+			, m_drawList.idx
+			);
+
+		return !transient;
+	}
+
+	void EncoderImpl::record(ProgramHandle _program, uint32_t _depth, uint8_t _flags)
+	{
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		m_uniformEnd = uniformBuffer->getPos();
+
+		DrawList& drawList = s_ctx->m_drawList[m_drawList.idx];
+		if (isValid(_program) )
+		{
+			drawList.addRef(DrawListRef::Program, _program.idx);
+		}
+
+		DrawList::Item& item = drawList.addItem();
+		item.m_draw    = m_draw;
+		item.m_bind    = m_bind;
+		item.m_depth   = _depth;
+		item.m_blend   = m_key.m_blend;
+		item.m_program = isValid(_program)
+			? _program
+			: ProgramHandle{0}
+			;
+
+		if (m_uniformBegin != drawList.m_recordUniformBegin
+		||  m_uniformEnd   != drawList.m_recordUniformEnd)
+		{
+			drawList.m_recordUniformBegin  = m_uniformBegin;
+			drawList.m_recordUniformEnd    = m_uniformEnd;
+			drawList.m_recordUniformOffset = drawList.addUniforms(uniformBuffer, m_uniformBegin, m_uniformEnd);
+			drawList.m_recordUniformSize   = drawList.m_uniformSize - drawList.m_recordUniformOffset;
+		}
+
+		item.m_draw.m_uniformIdx   = 0;
+		item.m_draw.m_uniformBegin = drawList.m_recordUniformOffset;
+		item.m_draw.m_uniformEnd   = drawList.m_recordUniformOffset + drawList.m_recordUniformSize;
+
+		// Matrix 0 is identity, and it's not recorded. Recorded transforms are stored
+		// off by one, so that 0 still means identity.
+		if (0 != m_draw.m_startMatrix)
+		{
+			if (m_draw.m_startMatrix != drawList.m_recordMatrixSrc
+			||  m_draw.m_numMatrices != drawList.m_recordMatrixNum)
+			{
+				MatrixCache& matrixCache = m_frame->m_frameCache.m_matrixCache;
+				drawList.m_recordMatrixSrc = m_draw.m_startMatrix;
+				drawList.m_recordMatrixNum = m_draw.m_numMatrices;
+				drawList.m_recordMatrixDst = 1 + drawList.addMatrices(
+					  matrixCache.toPtr(m_draw.m_startMatrix)
+					, m_draw.m_numMatrices
+					);
+			}
+
+			item.m_draw.m_startMatrix = drawList.m_recordMatrixDst;
+		}
+
+		if (UINT16_MAX != m_draw.m_scissor)
+		{
+			item.m_scissor = m_frame->m_frameCache.m_rectCache.m_cache[m_draw.m_scissor];
+		}
+
+		m_draw.clear(_flags);
+		m_bind.clear(_flags);
+		if (_flags & BGFX_DISCARD_STATE)
+		{
+			m_uniformBegin = m_uniformEnd;
+		}
+	}
+
+	void EncoderImpl::submit(ViewId _id, DrawListHandle _handle, const void* _mtx, uint16_t _num)
+	{
+		BX_ASSERT(!isValid(m_drawList), "Draw list can't be submitted while recording draw list %d.", m_drawList.idx);
+
+		// Replay is serialized with draw list create and destroy.
+		BGFX_MUTEX_SCOPE(s_ctx->m_drawListLock);
+
+		const DrawList& drawList = s_ctx->m_drawList[_handle.idx];
+		BX_ASSERT(0 == drawList.m_busy, "Draw list %d can't be submitted while it's being recorded.", _handle.idx);
+		BX_ASSERT(NULL == _mtx || _num == drawList.m_numMatrices
+			, "Number of matrices %d doesn't match number of matrices recorded in draw list %d."
+			, _num
+			, drawList.m_numMatrices
+			);
+		BX_UNUSED(_num);
+
+		if (0 == drawList.m_numItems)
+		{
+			return;
+		}
+
+		if (!drawList.isValid() )
+		{
+			BX_WARN(false
+				, "Draw list %d references resource that was destroyed after it was recorded, draw list is dropped."
+				, _handle.idx
+				);
+			m_numDropped += drawList.m_numItems;
+			return;
+		}
+
+		uint32_t startMatrix = 0;
+		if (0 < drawList.m_numMatrices)
+		{
+			MatrixCache& matrixCache = m_frame->m_frameCache.m_matrixCache;
+
+			uint16_t numMatrices = uint16_t(drawList.m_numMatrices);
+			startMatrix = matrixCache.reserve(&numMatrices);
+			if (numMatrices != drawList.m_numMatrices)
+			{
+				m_numDropped += drawList.m_numItems;
+				return;
+			}
+
+			bx::memCopy(
+				  matrixCache.toPtr(startMatrix)
+				, NULL != _mtx ? _mtx : drawList.m_matrix
+				, sizeof(Matrix4)*numMatrices
+				);
+		}
+
+		// Recorded uniforms are copied as single block when they fit into one page of
+		// uniform stream, otherwise each recorded range is written record by record.
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		const bool contiguous = drawList.m_uniformSize <= uniformBuffer->getPageSize();
+		uint32_t uniformBase = uniformBuffer->getPos();
+		if (contiguous
+		&&  0 < drawList.m_uniformSize)
+		{
+			bx::memCopy(uniformBuffer->reserve(drawList.m_uniformSize), drawList.m_uniform, drawList.m_uniformSize);
+			uniformBase = uniformBuffer->getPos() - drawList.m_uniformSize;
+		}
+
+		uint32_t rangeBegin = UINT32_MAX;
+		uint32_t rangeStreamBegin = 0;
+		uint32_t rangeStreamEnd   = 0;
+
+		const ViewMode::Enum mode = s_ctx->m_view[_id].m_mode;
+		uint32_t seq = ViewMode::Sequential == mode
+			? s_ctx->getSeqIncr(_id, drawList.m_numItems)
+			: 0
+			;
+
+		SortKey key;
+		key.reset();
+		key.m_view = _id;
+
+		for (uint32_t ii = 0, num = drawList.m_numItems; ii < num; ++ii)
+		{
+			const uint32_t renderItemIdx = allocRenderItem(BGFX_CONFIG_MAX_DRAW_CALLS);
+			if (UINT32_MAX == renderItemIdx)
+			{
+				m_numDropped += num - ii;
+				break;
+			}
+
+			++m_numSubmitted;
+
+			const DrawList::Item& item = drawList.m_item[ii];
+
+			key.m_program = item.m_program;
+			key.m_blend   = item.m_blend;
+
+			SortKey::Enum type;
+			switch (mode)
+			{
+			case ViewMode::Sequential:      key.m_seq   = seq++;                  type = SortKey::SortSequence; break;
+			case ViewMode::DepthAscending:  key.m_depth =            item.m_depth; type = SortKey::SortDepth;    break;
+			case ViewMode::DepthDescending: key.m_depth = UINT32_MAX-item.m_depth; type = SortKey::SortDepth;    break;
+			default:                        key.m_depth =            item.m_depth; type = SortKey::SortProgram;  break;
+			}
+
+			setSortKey(renderItemIdx, key.encodeDraw(type) );
+
+			RenderDraw& draw = m_frame->m_renderItem[renderItemIdx].draw;
+			draw = item.m_draw;
+			draw.m_uniformIdx = m_uniformIdx;
+
+			if (contiguous)
+			{
+				draw.m_uniformBegin += uniformBase;
+				draw.m_uniformEnd   += uniformBase;
+			}
+			else
+			{
+				if (item.m_draw.m_uniformBegin != rangeBegin)
+				{
+					rangeBegin       = item.m_draw.m_uniformBegin;
+					rangeStreamBegin = uniformBuffer->getPos();
+					uniformBuffer->writeRecords(
+						  &drawList.m_uniform[rangeBegin]
+						, item.m_draw.m_uniformEnd - rangeBegin
+						);
+					rangeStreamEnd = uniformBuffer->getPos();
+				}
+
+				draw.m_uniformBegin = rangeStreamBegin;
+				draw.m_uniformEnd   = rangeStreamEnd;
+			}
+
+			if (0 != draw.m_startMatrix)
+			{
+				draw.m_startMatrix += startMatrix - 1;
+			}
+
+			if (UINT16_MAX != draw.m_scissor)
+			{
+				const Rect& rect = item.m_scissor;
+				draw.m_scissor = uint16_t(m_frame->m_frameCache.m_rectCache.add(rect.m_x, rect.m_y, rect.m_width, rect.m_height) );
+			}
+
+			m_frame->m_renderItemBind[renderItemIdx] = item.m_bind;
+		}
+
+		// Replayed draw calls don't use encoder state, but any pending state is
+		// discarded as it would be by submit.
+		discard(BGFX_DISCARD_ALL);
+		m_uniformEnd   = uniformBuffer->getPos();
+		m_uniformBegin = m_uniformEnd;
+	}
+
+	static void applyBatchDraw(RenderDraw& _draw, const BatchDraw& _batchDraw, bool _indexed)
+	{
+		BX_ASSERT(_batchDraw.transform < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+			, _batchDraw.transform
+			, BGFX_CONFIG_MAX_MATRIX_CACHE
+			);
+
+		const uint32_t numMatrices = bx::max<uint32_t>(_batchDraw.numMatrices, 1);
+		_draw.m_startMatrix = _batchDraw.transform;
+		_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_batchDraw.transform+numMatrices, BGFX_CONFIG_MAX_MATRIX_CACHE-1) - _batchDraw.transform);
+
+		if (_indexed)
+		{
+			_draw.m_startIndex = _batchDraw.start;
+			_draw.m_numIndices = _batchDraw.num;
+		}
+		else
+		{
+			_draw.m_stream[0].m_startVertex = _batchDraw.start;
+			_draw.m_numVertices             = _batchDraw.num;
+		}
+	}
+
+	void EncoderImpl::submitBatch(ViewId _id, ProgramHandle _program, const BatchDraw* _draws, uint32_t _num, uint8_t _flags)
+	{
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM)
+		&& (_flags & BGFX_DISCARD_STATE))
+		{
+			m_uniformSet.clear();
+		}
+
+		if (m_discard
+		||  0 == _num)
+		{
+			discard(_flags);
+			return;
+		}
+
+		// Shared state is validated and resolved once for the whole batch, only
+		// transform, index (or vertex) range, and depth differ per draw call.
+		const bool indexed = isValid(m_draw.m_indexBuffer);
+
+		updateNumVertices();
+
+		if (isValid(m_drawList) )
+		{
+			if (!isRecordable() )
+			{
+				discard(_flags);
+				m_numDropped += _num;
+				return;
+			}
+
+			const RenderDraw draw = m_draw;
+
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				const BatchDraw& batchDraw = _draws[ii];
+				if (0 == batchDraw.num)
+				{
+					++m_numDropped;
+					continue;
+				}
+
+				applyBatchDraw(m_draw, batchDraw, indexed);
+				record(_program, batchDraw.depth, 0);
+			}
+
+			m_draw = draw;
+			m_draw.clear(_flags);
+			m_bind.clear(_flags);
+			if (_flags & BGFX_DISCARD_STATE)
+			{
+				m_uniformBegin = m_uniformEnd;
+			}
+
+			return;
+		}
+
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		m_uniformEnd = uniformBuffer->getPos();
+
+		m_draw.m_uniformIdx   = m_uniformIdx;
+		m_draw.m_uniformBegin = m_uniformBegin;
+		m_draw.m_uniformEnd   = m_uniformEnd;
+
+		m_key.m_program = isValid(_program)
+			? _program
+			: ProgramHandle{0}
+			;
+
+		m_key.m_view = _id;
+
+		const ViewMode::Enum mode = s_ctx->m_view[_id].m_mode;
+		uint32_t seq = ViewMode::Sequential == mode
+			? s_ctx->getSeqIncr(_id, _num)
+			: 0
+			;
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const BatchDraw& batchDraw = _draws[ii];
+			if (0 == batchDraw.num)
+			{
+				++m_numDropped;
+				continue;
+			}
+
+			const uint32_t renderItemIdx = allocRenderItem(BGFX_CONFIG_MAX_DRAW_CALLS);
+			if (UINT32_MAX == renderItemIdx)
+			{
+				m_numDropped += _num - ii;
+				break;
+			}
+
+			++m_numSubmitted;
+
+			SortKey::Enum type;
+			switch (mode)
+			{
+			case ViewMode::Sequential:      m_key.m_seq   = seq++;                      type = SortKey::SortSequence; break;
+			case ViewMode::DepthAscending:  m_key.m_depth =            batchDraw.depth; type = SortKey::SortDepth;    break;
+			case ViewMode::DepthDescending: m_key.m_depth = UINT32_MAX-batchDraw.depth; type = SortKey::SortDepth;    break;
+			default:                        m_key.m_depth =            batchDraw.depth; type = SortKey::SortProgram;  break;
+			}
+
+			setSortKey(renderItemIdx, m_key.encodeDraw(type) );
+
+			RenderDraw& draw = m_frame->m_renderItem[renderItemIdx].draw;
+			draw = m_draw;
+			applyBatchDraw(draw, batchDraw, indexed);
+
+			m_frame->m_renderItemBind[renderItemIdx] = m_bind;
+		}
+
+		m_draw.clear(_flags);
+		m_bind.clear(_flags);
+		if (_flags & BGFX_DISCARD_STATE)
+		{
+			m_uniformBegin = m_uniformEnd;
+		}
+	}
+
+	void EncoderImpl::dispatch(ViewId _id, ProgramHandle _handle, uint32_t _numX, uint32_t _numY, uint32_t _numZ, uint8_t _flags)
+	{
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
+		{
+			m_uniformSet.clear();
+		}
+
+		if (m_discard)
+		{
+			discard(_flags);
+			return;
+		}
+
+		const uint32_t renderItemIdx = allocRenderItem(BGFX_CONFIG_MAX_DRAW_CALLS-1);
+		if (UINT32_MAX == renderItemIdx)
+		{
+			discard(_flags);
+			++m_numDropped;
+			return;
+		}
+
+		++m_numSubmitted;
+
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		m_uniformEnd = uniformBuffer->getPos();
+
+		m_compute.m_startMatrix = m_draw.m_startMatrix;
+		m_compute.m_numMatrices = m_draw.m_numMatrices;
+		m_compute.m_numX   = bx::max(_numX, 1u);
+		m_compute.m_numY   = bx::max(_numY, 1u);
+		m_compute.m_numZ   = bx::max(_numZ, 1u);
+
+		m_key.m_program = _handle;
+		m_key.m_depth   = 0;
+		m_key.m_view    = _id;
+		m_key.m_seq     = s_ctx->getSeqIncr(_id);
+
+		uint64_t key = m_key.encodeCompute();
+		setSortKey(renderItemIdx, key);
+
+		m_compute.m_uniformIdx   = m_uniformIdx;
+		m_compute.m_uniformBegin = m_uniformBegin;
+		m_compute.m_uniformEnd   = m_uniformEnd;
+		m_frame->m_renderItem[renderItemIdx].compute = m_compute;
+		m_frame->m_renderItemBind[renderItemIdx]     = m_bind;
+
+		m_compute.clear(_flags);
+		m_bind.clear(_flags);
+		m_uniformBegin = m_uniformEnd;
+	}
+
+	void EncoderImpl::blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth)
+	{
+		BX_WARN(m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS
+			, "Exceed number of available blit items per frame. BGFX_CONFIG_MAX_BLIT_ITEMS is %d. Skipping blit."
+			, BGFX_CONFIG_MAX_BLIT_ITEMS
+			);
+		if (m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS)
+		{
+			uint16_t item = m_frame->m_numBlitItems++;
+
+			BlitItem& bi = m_frame->m_blitItem[item];
+			bi.m_srcX    = _srcX;
+			bi.m_srcY    = _srcY;
+			bi.m_srcZ    = _srcZ;
+			bi.m_dstX    = _dstX;
+			bi.m_dstY    = _dstY;
+			bi.m_dstZ    = _dstZ;
+			bi.m_width   = _width;
+			bi.m_height  = _height;
+			bi.m_depth   = _depth;
+			bi.m_srcMip  = _srcMip;
+			bi.m_dstMip  = _dstMip;
+			bi.m_src     = _src;
+			bi.m_dst     = _dst;
+
+			BlitKey key;
+			key.m_view = _id;
+			key.m_item = item;
+			m_frame->m_blitKeys[item] = key.encode();
+		}
+	}
+
+	uint32_t EncoderImpl::allocTransient(TransientChunk& _chunk, uint32_t* _frameOffset, uint32_t* _frameOverflow, uint32_t _max, uint32_t& _num, uint16_t _stride, uint32_t& _wasted)
+	{
+		const uint32_t numRequested = _num;
+		const uint32_t size = _num*_stride;
+
+		// Large requests go directly to frame, so they don't retire chunk that
+		// still has enough space for small ones.
+		if (size > BGFX_CONFIG_TRANSIENT_BUFFER_CHUNK_SIZE/2)
+		{
+			const uint32_t offset = Frame::allocTransient(_frameOffset, _max, _num, _stride);
+			Frame::overflowTransient(_frameOverflow, numRequested, _num, _stride);
+			return offset;
+		}
+
+		uint32_t offset = bx::strideAlign(_chunk.m_offset, _stride);
+
+		if (offset > _chunk.m_end
+		||  size   > _chunk.m_end - offset)
+		{
+			retireTransientChunk(_chunk, _frameOffset, _wasted);
+
+			const uint32_t chunkSize = bx::alignUp(bx::max<uint32_t>(BGFX_CONFIG_TRANSIENT_BUFFER_CHUNK_SIZE, size+_stride), 16);
+			_chunk.m_offset = Frame::reserveTransientChunk(_frameOffset, _max, chunkSize, _chunk.m_end);
+
+			offset = bx::min<uint32_t>(bx::strideAlign(_chunk.m_offset, _stride), _chunk.m_end);
+		}
+
+		const uint32_t num = bx::min<uint32_t>(_num, (_chunk.m_end - offset)/_stride);
+		_chunk.m_offset = offset + num*_stride;
+		_num = num;
+
+		Frame::overflowTransient(_frameOverflow, numRequested, _num, _stride);
+
+		return offset;
+	}
+
+	void EncoderImpl::retireTransientChunk(TransientChunk& _chunk, uint32_t* _frameOffset, uint32_t& _wasted)
+	{
+		// Unused tail can be returned to frame only if nothing else was
+		// allocated after chunk was reserved, otherwise it's wasted.
+		if (_chunk.m_offset != _chunk.m_end
+		&&  !Frame::releaseTransientChunk(_frameOffset, _chunk.m_offset, _chunk.m_end) )
+		{
+			_wasted += _chunk.m_end - _chunk.m_offset;
+		}
+
+		_chunk.m_offset = 0;
+		_chunk.m_end    = 0;
+	}
+
+	VertexLayoutHandle EncoderImpl::findVertexLayout(const VertexLayout& _layout)
+	{
+		VertexLayoutCache& entry = m_vertexLayoutCache[_layout.m_hash % BX_COUNTOF(m_vertexLayoutCache)];
+
+		if (!isValid(entry.m_handle)
+		||  entry.m_hash != _layout.m_hash)
+		{
+			BGFX_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(s_ctx->m_vertexLayoutLock);
+			entry.m_hash   = _layout.m_hash;
+			entry.m_handle = s_ctx->findOrCreateVertexLayout(_layout, true);
+		}
+
+		return entry.m_handle;
+	}
+
+	void EncoderImpl::allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32)
+	{
+		const bool isIndex16     = !_index32;
+		const uint16_t indexSize = isIndex16 ? 2 : 4;
+		const uint32_t offset    = allocTransient(
+			  m_transientIbChunk
+			, &m_frame->m_iboffset
+			, &m_frame->m_iboverflow
+			, m_frame->m_transientIb->size
+			, _num
+			, indexSize
+			, m_transientIbWasted
+			);
+
+		const TransientIndexBuffer& tib = *m_frame->m_transientIb;
+
+		_tib->data       = &tib.data[offset];
+		_tib->size       = _num * indexSize;
+		_tib->handle     = tib.handle;
+		_tib->startIndex = offset / indexSize;
+		_tib->isIndex16  = isIndex16;
+	}
+
+	void EncoderImpl::allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexLayout& _layout)
+	{
+		const VertexLayoutHandle layoutHandle = findVertexLayout(_layout);
+		BX_ASSERT(isValid(layoutHandle), "Failed to allocate vertex layout handle (BGFX_CONFIG_MAX_VERTEX_LAYOUTS, max: %d).", BGFX_CONFIG_MAX_VERTEX_LAYOUTS);
+
+		const uint16_t stride = _layout.m_stride;
+		const uint32_t offset = allocTransient(
+			  m_transientVbChunk
+			, &m_frame->m_vboffset
+			, &m_frame->m_vboverflow
+			, m_frame->m_transientVb->size
+			, _num
+			, stride
+			, m_transientVbWasted
+			);
+
+		const TransientVertexBuffer& dvb = *m_frame->m_transientVb;
+
+		_tvb->data         = &dvb.data[offset];
+		_tvb->size         = _num * stride;
+		_tvb->startVertex  = offset / stride;
+		_tvb->stride       = stride;
+		_tvb->handle       = dvb.handle;
+		_tvb->layoutHandle = layoutHandle;
+	}
+
+	void EncoderImpl::allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride)
+	{
+		const uint16_t stride = bx::alignUp(_stride, 16);
+		const uint32_t offset = allocTransient(
+			  m_transientVbChunk
+			, &m_frame->m_vboffset
+			, &m_frame->m_vboverflow
+			, m_frame->m_transientVb->size
+			, _num
+			, stride
+			, m_transientVbWasted
+			);
+
+		const TransientVertexBuffer& dvb = *m_frame->m_transientVb;
+
+		_idb->data   = &dvb.data[offset];
+		_idb->size   = _num * stride;
+		_idb->offset = offset;
+		_idb->num    = _num;
+		_idb->stride = stride;
+		_idb->handle = dvb.handle;
+	}
+
+	SortThreadPool::SortThreadPool()
+		:
+#if BGFX_CONFIG_MULTITHREADED
+		  m_thread(NULL)
+		, m_next(0)
+		, m_exit(false)
+		,
+#endif // BGFX_CONFIG_MULTITHREADED
+		  m_numThreads(1)
+		, m_segment(NULL)
+		, m_segmentOrder(NULL)
+		, m_heap(NULL)
+		, m_maxSegments(0)
+		, m_srcKeys(NULL)
+		, m_dstKeys(NULL)
+		, m_srcValues(NULL)
+		, m_dstValues(NULL)
+	{
+	}
+
+	SortThreadPool::~SortThreadPool()
+	{
+	}
+
+	void SortThreadPool::init(uint16_t _numThreads)
+	{
+		m_numThreads = BX_ENABLED(BGFX_CONFIG_MULTITHREADED)
+			? bx::clamp<uint32_t>(_numThreads, 1, BGFX_CONFIG_MAX_SORT_THREADS)
+			: 1
+			;
+
+		m_maxSegments  = bx::min<uint32_t>(BGFX_CONFIG_MAX_DRAW_CALLS, BGFX_CONFIG_MAX_SORT_RUNS*BGFX_CONFIG_MAX_VIEWS);
+		m_segment      = (Segment*)bx::alloc(g_allocator, m_maxSegments*sizeof(Segment) );
+		m_segmentOrder = (uint32_t*)bx::alloc(g_allocator, m_maxSegments*sizeof(uint32_t) );
+		m_heap         = (HeapItem*)bx::alloc(g_allocator, m_numThreads*BGFX_CONFIG_MAX_SORT_RUNS*sizeof(HeapItem) );
 
-		++m_numSubmitted;
+#if BGFX_CONFIG_MULTITHREADED
+		m_exit = false;
 
-		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
-		m_uniformEnd = uniformBuffer->getPos();
+		const uint32_t numWorkers = m_numThreads-1;
+		if (0 < numWorkers)
+		{
+			m_thread = (bx::Thread*)bx::alloc(g_allocator, sizeof(bx::Thread)*numWorkers);
 
-		m_key.m_program = isValid(_program)
-			? _program
-			: ProgramHandle{0}
-			;
+			for (uint32_t ii = 0; ii < numWorkers; ++ii)
+			{
+				BX_PLACEMENT_NEW(&m_thread[ii], bx::Thread);
+				m_thread[ii].init(workerThread, this, 0, "bgfx - sort thread");
+			}
+		}
+#endif // BGFX_CONFIG_MULTITHREADED
 
-		m_key.m_view = _id;
+		BX_TRACE("Sort threads: %d", m_numThreads);
+	}
 
-		SortKey::Enum type;
-		switch (s_ctx->m_view[_id].m_mode)
+	void SortThreadPool::shutdown()
+	{
+#if BGFX_CONFIG_MULTITHREADED
+		const uint32_t numWorkers = m_numThreads-1;
+		if (0 < numWorkers)
 		{
-		case ViewMode::Sequential:      m_key.m_seq   = s_ctx->getSeqIncr(_id); type = SortKey::SortSequence; break;
-		case ViewMode::DepthAscending:  m_key.m_depth =            _depth;      type = SortKey::SortDepth;    break;
-		case ViewMode::DepthDescending: m_key.m_depth = UINT32_MAX-_depth;      type = SortKey::SortDepth;    break;
-		default:                        m_key.m_depth =            _depth;      type = SortKey::SortProgram;  break;
+			m_exit = true;
+			m_workSem.post(numWorkers);
+
+			for (uint32_t ii = 0; ii < numWorkers; ++ii)
+			{
+				m_thread[ii].shutdown();
+				m_thread[ii].~Thread();
+			}
+
+			bx::free(g_allocator, m_thread);
+			m_thread = NULL;
 		}
+#endif // BGFX_CONFIG_MULTITHREADED
 
-		uint64_t key = m_key.encodeDraw(type);
+		bx::free(g_allocator, m_segment);
+		bx::free(g_allocator, m_segmentOrder);
+		bx::free(g_allocator, m_heap);
+		m_segment      = NULL;
+		m_segmentOrder = NULL;
+		m_heap         = NULL;
+		m_maxSegments  = 0;
+		m_numThreads   = 1;
+	}
 
-		m_frame->m_sortKeys[renderItemIdx]   = key;
-		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+#if BGFX_CONFIG_MULTITHREADED
+	int32_t SortThreadPool::workerThread(bx::Thread* /*_self*/, void* _userData)
+	{
+		BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - Sort Thread");
 
-		m_draw.m_uniformIdx   = m_uniformIdx;
-		m_draw.m_uniformBegin = m_uniformBegin;
-		m_draw.m_uniformEnd   = m_uniformEnd;
+		SortThreadPool* pool = (SortThreadPool*)_userData;
 
-		if (UINT8_MAX != m_draw.m_streamMask)
+		for (;;)
 		{
-			uint32_t numVertices = UINT32_MAX;
-			for (uint32_t idx = 0, streamMask = m_draw.m_streamMask
-				; 0 != streamMask
-				; streamMask >>= 1, idx += 1
-				)
+			pool->m_workSem.wait();
+
+			if (pool->m_exit)
 			{
-				const uint32_t ntz = bx::uint32_cnttz(streamMask);
-				streamMask >>= ntz;
-				idx         += ntz;
-				numVertices = bx::min(numVertices, m_numVertices[idx]);
+				break;
 			}
 
-			m_draw.m_numVertices = numVertices;
-		}
-		else
-		{
-			m_draw.m_numVertices = m_numVertices[0];
+			const uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&pool->m_next, 1);
+			pool->execute(idx);
+
+			pool->m_doneSem.post();
 		}
 
-		if (isValid(_occlusionQuery) )
+		return bx::kExitSuccess;
+	}
+#endif // BGFX_CONFIG_MULTITHREADED
+
+	void SortThreadPool::dispatch()
+	{
+#if BGFX_CONFIG_MULTITHREADED
+		const uint32_t numWorkers = m_numThreads-1;
+		m_next = 1;
+		m_workSem.post(numWorkers);
+
+		execute(0);
+
+		for (uint32_t ii = 0; ii < numWorkers; ++ii)
 		{
-			m_draw.m_stateFlags |= BGFX_STATE_INTERNAL_OCCLUSION_QUERY;
-			m_draw.m_occlusionQuery = _occlusionQuery;
+			m_doneSem.wait();
 		}
+#else
+		execute(0);
+#endif // BGFX_CONFIG_MULTITHREADED
+	}
 
-		m_frame->m_renderItem[renderItemIdx].draw = m_draw;
-		m_frame->m_renderItemBind[renderItemIdx]  = m_bind;
+	void SortThreadPool::siftDown(HeapItem* _heap, uint32_t _num, uint32_t _idx)
+	{
+		const HeapItem item = _heap[_idx];
 
-		m_draw.clear(_flags);
-		m_bind.clear(_flags);
-		if (_flags & BGFX_DISCARD_STATE)
+		for (uint32_t child = _idx*2+1; child < _num; child = _idx*2+1)
 		{
-			m_uniformBegin = m_uniformEnd;
+			if (child+1 < _num
+			&&  _heap[child+1] < _heap[child])
+			{
+				++child;
+			}
+
+			if (!(_heap[child] < item) )
+			{
+				break;
+			}
+
+			_heap[_idx] = _heap[child];
+			_idx = child;
 		}
+
+		_heap[_idx] = item;
 	}
 
-	void EncoderImpl::dispatch(ViewId _id, ProgramHandle _handle, uint32_t _numX, uint32_t _numY, uint32_t _numZ, uint8_t _flags)
+	void SortThreadPool::execute(uint32_t _idx)
 	{
-		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
+		HeapItem* heap = &m_heap[_idx*BGFX_CONFIG_MAX_SORT_RUNS];
+
+		for (uint32_t view = m_threadView[_idx], viewEnd = m_threadView[_idx+1]; view < viewEnd; ++view)
 		{
-			m_uniformSet.clear();
+			const uint64_t viewKey     = uint64_t(view) << kSortKeyViewBitShift;
+			const uint32_t* order      = &m_segmentOrder[m_viewSegment[view] ];
+			const uint32_t numSegments = m_viewSegment[view+1] - m_viewSegment[view];
+			uint32_t dst = m_viewOffset[view];
+
+			if (1 == numSegments)
+			{
+				const Segment& segment = m_segment[order[0] ];
+
+				for (uint32_t pos = segment.m_begin; pos < segment.m_end; ++pos, ++dst)
+				{
+					m_dstKeys[dst]   = (m_srcKeys[pos] & ~kSortKeyViewMask) | viewKey;
+					m_dstValues[dst] = m_srcValues[pos];
+				}
+			}
+			else if (1 < numSegments)
+			{
+				for (uint32_t ii = 0; ii < numSegments; ++ii)
+				{
+					const Segment& segment = m_segment[order[ii] ];
+
+					HeapItem& item = heap[ii];
+					item.m_key = m_srcKeys[segment.m_begin];
+					item.m_pos = segment.m_begin;
+					item.m_end = segment.m_end;
+				}
+
+				uint32_t num = numSegments;
+				for (uint32_t ii = num/2; 0 < ii; --ii)
+				{
+					siftDown(heap, num, ii-1);
+				}
+
+				while (0 < num)
+				{
+					HeapItem& top = heap[0];
+					m_dstKeys[dst]   = (top.m_key & ~kSortKeyViewMask) | viewKey;
+					m_dstValues[dst] = m_srcValues[top.m_pos];
+					++dst;
+
+					++top.m_pos;
+					if (top.m_pos == top.m_end)
+					{
+						--num;
+						top = heap[num];
+					}
+					else
+					{
+						top.m_key = m_srcKeys[top.m_pos];
+					}
+
+					siftDown(heap, num, 0);
+				}
+			}
 		}
+	}
 
-		if (m_discard)
+	uint32_t SortThreadPool::merge(
+		  uint64_t* _keys
+		, uint64_t* _tempKeys
+		, RenderItemCount* _values
+		, RenderItemCount* _tempValues
+		, const SortRun* _run
+		, uint32_t _numRuns
+		, ViewId _viewRemap[BGFX_CONFIG_MAX_VIEWS]
+		)
+	{
+		bx::memSet(m_viewSegment, 0, sizeof(m_viewSegment) );
+		bx::memSet(m_viewOffset,  0, sizeof(m_viewOffset)  );
+
+		// Runs are sorted by raw sort key, so view id splits every run into contiguous
+		// segments. Find segment ends with binary search, and count number of segments
+		// and render items for each remapped view.
+		uint32_t numSegments = 0;
+		uint32_t num = 0;
+
+		for (uint32_t ii = 0; ii < _numRuns; ++ii)
 		{
-			discard(_flags);
-			return;
+			const uint32_t end = _run[ii].m_begin + _run[ii].m_num;
+
+			for (uint32_t pos = _run[ii].m_begin; pos < end;)
+			{
+				const ViewId   view    = SortKey::decodeView(_keys[pos]);
+				const uint64_t viewMax = (uint64_t(view) << kSortKeyViewBitShift) | ~kSortKeyViewMask;
+
+				uint32_t first = pos+1;
+				uint32_t last  = end;
+				while (first < last)
+				{
+					const uint32_t mid = first + (last-first)/2;
+					if (_keys[mid] <= viewMax)
+					{
+						first = mid+1;
+					}
+					else
+					{
+						last = mid;
+					}
+				}
+
+				BX_ASSERT(numSegments < m_maxSegments, "Too many sort segments.");
+				Segment& segment = m_segment[numSegments++];
+				segment.m_begin = pos;
+				segment.m_end   = first;
+
+				const ViewId remap = _viewRemap[view];
+				m_viewSegment[remap+1] += 1;
+				m_viewOffset[remap+1]  += first - pos;
+				num += first - pos;
+
+				pos = first;
+			}
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS-1 <= renderItemIdx)
+		for (uint32_t ii = 1; ii <= BGFX_CONFIG_MAX_VIEWS; ++ii)
 		{
-			discard(_flags);
-			++m_numDropped;
-			return;
+			m_viewSegment[ii] += m_viewSegment[ii-1];
+			m_viewOffset[ii]  += m_viewOffset[ii-1];
 		}
 
-		++m_numSubmitted;
-
-		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
-		m_uniformEnd = uniformBuffer->getPos();
+		// Group segments by remapped view, keeping run order inside the group.
+		uint32_t cursor[BGFX_CONFIG_MAX_VIEWS];
+		bx::memCopy(cursor, m_viewSegment, sizeof(cursor) );
 
-		m_compute.m_startMatrix = m_draw.m_startMatrix;
-		m_compute.m_numMatrices = m_draw.m_numMatrices;
-		m_compute.m_numX   = bx::max(_numX, 1u);
-		m_compute.m_numY   = bx::max(_numY, 1u);
-		m_compute.m_numZ   = bx::max(_numZ, 1u);
+		for (uint32_t ii = 0; ii < numSegments; ++ii)
+		{
+			const ViewId remap = _viewRemap[SortKey::decodeView(_keys[m_segment[ii].m_begin])];
+			m_segmentOrder[cursor[remap]++] = ii;
+		}
 
-		m_key.m_program = _handle;
-		m_key.m_depth   = 0;
-		m_key.m_view    = _id;
-		m_key.m_seq     = s_ctx->getSeqIncr(_id);
+		// Split views between threads so each of them merges about the same number of
+		// render items.
+		for (uint32_t ii = 0, view = 0; ii < m_numThreads; ++ii)
+		{
+			const uint32_t offset = uint32_t(uint64_t(num)*ii/m_numThreads);
+			while (view < BGFX_CONFIG_MAX_VIEWS
+			&&     m_viewOffset[view] < offset)
+			{
+				++view;
+			}
 
-		uint64_t key = m_key.encodeCompute();
-		m_frame->m_sortKeys[renderItemIdx]   = key;
-		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+			m_threadView[ii] = view;
+		}
 
-		m_compute.m_uniformIdx   = m_uniformIdx;
-		m_compute.m_uniformBegin = m_uniformBegin;
-		m_compute.m_uniformEnd   = m_uniformEnd;
-		m_frame->m_renderItem[renderItemIdx].compute = m_compute;
-		m_frame->m_renderItemBind[renderItemIdx]     = m_bind;
+		m_threadView[m_numThreads] = BGFX_CONFIG_MAX_VIEWS;
 
-		m_compute.clear(_flags);
-		m_bind.clear(_flags);
-		m_uniformBegin = m_uniformEnd;
-	}
+		m_srcKeys   = _keys;
+		m_srcValues = _values;
+		m_dstKeys   = _tempKeys;
+		m_dstValues = _tempValues;
 
-	void EncoderImpl::blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth)
-	{
-		BX_WARN(m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS
-			, "Exceed number of available blit items per frame. BGFX_CONFIG_MAX_BLIT_ITEMS is %d. Skipping blit."
-			, BGFX_CONFIG_MAX_BLIT_ITEMS
-			);
-		if (m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS)
+		if (1 == m_numThreads
+		||  BGFX_CONFIG_SORT_PARALLEL_MIN_ITEMS > num)
 		{
-			uint16_t item = m_frame->m_numBlitItems++;
+			for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+			{
+				execute(ii);
+			}
+		}
+		else
+		{
+			dispatch();
+		}
 
-			BlitItem& bi = m_frame->m_blitItem[item];
-			bi.m_srcX    = _srcX;
-			bi.m_srcY    = _srcY;
-			bi.m_srcZ    = _srcZ;
-			bi.m_dstX    = _dstX;
-			bi.m_dstY    = _dstY;
-			bi.m_dstZ    = _dstZ;
-			bi.m_width   = _width;
-			bi.m_height  = _height;
-			bi.m_depth   = _depth;
-			bi.m_srcMip  = _srcMip;
-			bi.m_dstMip  = _dstMip;
-			bi.m_src     = _src;
-			bi.m_dst     = _dst;
+		bx::memCopy(_keys,   _tempKeys,   num*sizeof(uint64_t) );
+		bx::memCopy(_values, _tempValues, num*sizeof(RenderItemCount) );
 
-			BlitKey key;
-			key.m_view = _id;
-			key.m_item = item;
-			m_frame->m_blitKeys[item] = key.encode();
-		}
+		return num;
 	}
 
 	void Frame::sort()
@@ -1454,12 +2754,17 @@ namespace bgfx
 			}
 		}
 
-		for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
-		{
-			m_sortKeys[ii] = SortKey::remapView(m_sortKeys[ii], viewRemap);
-		}
+		m_perfStats.numSortedItems = m_numSortedItems;
 
-		bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems);
+		m_numRenderItems = s_ctx->m_sortThreadPool.merge(
+			  m_sortKeys
+			, s_ctx->m_tempKeys
+			, m_sortValues
+			, s_ctx->m_tempValues
+			, m_sortRun
+			, m_numSortRuns
+			, viewRemap
+			);
 
 		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
 		{
@@ -1515,28 +2820,120 @@ namespace bgfx
 		1,
 	};
 
-	void UniformBuffer::writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num)
-	{
-		const uint32_t opcode = encodeOpcode(_type, _loc, _num, true);
-		write(opcode);
-		write(_value, g_uniformTypeSize[_type]*_num);
+	uint32_t UniformBuffer::writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num)
+	{
+		const uint32_t opcode = encodeOpcode(_type, _loc, _num, true);
+		write(opcode);
+
+		const uint32_t size = g_uniformTypeSize[_type]*_num;
+		write(_value, size);
+
+		return m_pos - size;
+	}
+
+	void UniformBuffer::writeUniformRef(UniformType::Enum _type, uint16_t _loc, uint32_t _pos, uint16_t _num)
+	{
+		const uint32_t opcode = encodeOpcode(_type|kUniformRefBit, _loc, _num, true);
+		write(opcode);
+		write(_pos);
+	}
+
+	void UniformBuffer::writeUniformHandle(uint8_t _type, uint16_t _loc, UniformHandle _handle, uint16_t _num)
+	{
+		const uint32_t opcode = encodeOpcode(_type, _loc, _num, false);
+		write(opcode);
+		write(&_handle, sizeof(UniformHandle) );
+	}
+
+	void UniformBuffer::writeMarker(const bx::StringView& _name)
+	{
+		const uint16_t num = bx::narrowCast<uint16_t>(_name.getLength()+1);
+		const uint32_t opcode = encodeOpcode(bgfx::UniformType::Count, 0, num, true);
+		write(opcode);
+
+		// Name and terminator are written together, reader reads them as single block.
+		char* data = reserve(num);
+		bx::memCopy(data, _name.getPtr(), num-1);
+		data[num-1] = '\0';
+	}
+
+	void UniformBuffer::writeRecords(const char* _data, uint32_t _size)
+	{
+		for (uint32_t pos = 0; pos < _size;)
+		{
+			uint32_t opcode;
+			bx::memCopy(&opcode, &_data[pos], sizeof(uint32_t) );
+			pos += sizeof(uint32_t);
+
+			uint8_t type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			decodeOpcode(opcode, type, loc, num, copy);
+
+			BX_ASSERT(0 == (type & kUniformRefBit), "Recorded uniforms must not reference uniform stream.");
+			const uint32_t size = g_uniformTypeSize[type]*num;
+			write(opcode);
+			write(&_data[pos], size);
+			pos += size;
+		}
+	}
+
+	struct UniformPagePool
+	{
+		UniformPagePool()
+			: m_num(0)
+		{
+		}
+
+		bx::Mutex m_mutex;
+		char*     m_page[BGFX_CONFIG_UNIFORM_BUFFER_MAX_FREE_PAGES];
+		uint32_t  m_num;
+	};
+
+	static UniformPagePool s_uniformPagePool;
+
+	char* UniformBuffer::allocPage(uint32_t _size)
+	{
+		if (BGFX_CONFIG_UNIFORM_BUFFER_PAGE_SIZE == _size)
+		{
+			bx::MutexScope scope(s_uniformPagePool.m_mutex);
+
+			if (0 < s_uniformPagePool.m_num)
+			{
+				return s_uniformPagePool.m_page[--s_uniformPagePool.m_num];
+			}
+		}
+
+		return (char*)bx::alloc(g_allocator, _size);
 	}
 
-	void UniformBuffer::writeUniformHandle(uint8_t _type, uint16_t _loc, UniformHandle _handle, uint16_t _num)
+	void UniformBuffer::freePage(char* _page, uint32_t _size)
 	{
-		const uint32_t opcode = encodeOpcode(_type, _loc, _num, false);
-		write(opcode);
-		write(&_handle, sizeof(UniformHandle) );
+		if (BGFX_CONFIG_UNIFORM_BUFFER_PAGE_SIZE == _size)
+		{
+			bx::MutexScope scope(s_uniformPagePool.m_mutex);
+
+			if (BX_COUNTOF(s_uniformPagePool.m_page) > s_uniformPagePool.m_num)
+			{
+				s_uniformPagePool.m_page[s_uniformPagePool.m_num++] = _page;
+				return;
+			}
+		}
+
+		bx::free(g_allocator, _page);
 	}
 
-	void UniformBuffer::writeMarker(const bx::StringView& _name)
+	void UniformBuffer::releasePages()
 	{
-		const uint16_t num = bx::narrowCast<uint16_t>(_name.getLength()+1);
-		const uint32_t opcode = encodeOpcode(bgfx::UniformType::Count, 0, num, true);
-		write(opcode);
-		write(_name.getPtr(), num-1);
-		const char zero = '\0';
-		write(&zero, 1);
+		bx::MutexScope scope(s_uniformPagePool.m_mutex);
+
+		for (uint32_t ii = 0; ii < s_uniformPagePool.m_num; ++ii)
+		{
+			bx::free(g_allocator, s_uniformPagePool.m_page[ii]);
+		}
+
+		s_uniformPagePool.m_num = 0;
 	}
 
 	struct CapsFlags
@@ -1687,6 +3084,8 @@ namespace bgfx
 		LIMITS(minResourceCbSize);
 		LIMITS(transientVbSize);
 		LIMITS(transientIbSize);
+		LIMITS(maxSortThreads);
+		LIMITS(maxFramesInFlight);
 #undef LIMITS
 
 		BX_TRACE("");
@@ -1932,10 +3331,53 @@ namespace bgfx
 		m_frameTimeLast = bx::getHPCounter();
 		m_flipAfterRender = !!(m_init.resolution.reset & BGFX_RESET_FLIP_AFTER_RENDER);
 
-		m_submit->create(_init.limits.minResourceCbSize);
+		m_sortThreadPool.init(_init.limits.maxSortThreads);
+
+		m_maxFramesInFlight = BX_ENABLED(BGFX_CONFIG_MULTITHREADED) ? _init.limits.maxFramesInFlight : 1;
+		m_numFrames         = BX_ENABLED(BGFX_CONFIG_MULTITHREADED) ? m_maxFramesInFlight + 1 : 1;
+		m_numFramesInFlight = 0;
+		m_submitIdx         = 0;
+		m_renderIdx         = 0;
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_resourceCmd); ++ii)
+		{
+			m_resourceCmd[ii].init(_init.limits.minResourceCbSize);
+		}
+
+		m_resourceCmdSeq  = 0;
+		m_resourceCmdNext = 0;
+
+		bx::memSet(m_drawListRefGen, 0, sizeof(m_drawListRefGen) );
+
+		m_asyncUploadHead          = 0;
+		m_asyncUploadNum           = 0;
+		m_asyncUploadFence         = 0;
+		m_asyncUploadFenceRendered = 0;
+		m_asyncUploadSeq           = 0;
+		m_asyncUploadPendingSize   = 0;
+		m_asyncUploadSizeLast      = 0;
+		m_asyncUploadBudgetSize    = _init.limits.uploadBudgetSize;
+		m_asyncUploadBudgetTime    = _init.limits.uploadBudgetTime;
+		m_asyncUploadRate          = 0;
+#if BGFX_CONFIG_MULTITHREADED
+		m_resourceApiState = 0;
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		m_transientVbSizer.init(_init.limits.transientVbSize, _init.limits.transientMaxVbSize);
+		m_transientIbSizer.init(_init.limits.transientIbSize, _init.limits.transientMaxIbSize);
+
+		m_frame = (Frame*)bx::alignedAlloc(g_allocator, sizeof(Frame)*m_numFrames, BX_ALIGNOF(Frame) );
+		for (uint32_t ii = 0; ii < m_numFrames; ++ii)
+		{
+			BX_PLACEMENT_NEW(&m_frame[ii], Frame);
+			m_frame[ii].create(_init.limits.minResourceCbSize);
+		}
+
+		m_submit = &m_frame[0];
+		m_render = &m_frame[0];
 
 #if BGFX_CONFIG_MULTITHREADED
-		m_render->create(_init.limits.minResourceCbSize);
+		m_waitSubmit = 0;
 
 		if (s_renderFrameCalled)
 		{
@@ -1986,7 +3428,6 @@ namespace bgfx
 
 		frameNoRenderWait();
 
-		m_encoderHandle = bx::createHandleAlloc(g_allocator, _init.limits.maxEncoders);
 		m_encoder       = (EncoderImpl*)bx::alignedAlloc(g_allocator, sizeof(EncoderImpl)*_init.limits.maxEncoders, BX_ALIGNOF(EncoderImpl) );
 		m_encoderStats  = (EncoderStats*)bx::alloc(g_allocator, sizeof(EncoderStats)*_init.limits.maxEncoders);
 		for (uint32_t ii = 0, num = _init.limits.maxEncoders; ii < num; ++ii)
@@ -1994,8 +3435,11 @@ namespace bgfx
 			BX_PLACEMENT_NEW(&m_encoder[ii], EncoderImpl);
 		}
 
-		uint16_t idx = m_encoderHandle->alloc();
-		BX_ASSERT(0 == idx, "Internal encoder handle is not 0 (idx %d).", idx); BX_UNUSED(idx);
+#if BGFX_CONFIG_MULTITHREADED
+		m_encoderState    = 0;
+		m_numEncodersUsed = 1;
+#endif // BGFX_CONFIG_MULTITHREADED
+
 		m_encoder[0].begin(m_submit, 0);
 		m_encoder0 = BX_ENABLED(BGFX_CONFIG_ENCODER_API_ONLY)
 			? NULL
@@ -2011,11 +3455,10 @@ namespace bgfx
 			getCommandBuffer(CommandBuffer::RendererShutdownEnd);
 			frame();
 			frame();
+			renderSemWaitAll();
 			m_vertexLayoutRef.shutdown(m_layoutHandle);
-			m_submit->destroy();
-#if BGFX_CONFIG_MULTITHREADED
-			m_render->destroy();
-#endif // BGFX_CONFIG_MULTITHREADED
+			destroyFrames();
+			m_sortThreadPool.shutdown();
 			return false;
 		}
 
@@ -2049,11 +3492,7 @@ namespace bgfx
 		m_textVideoMemBlitter.init(m_init.resolution.debugTextScale);
 		m_clearQuad.init();
 
-		m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize);
-		m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize);
-		frame();
-
-		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
+		for (uint32_t ii = 0; ii < m_numFrames; ++ii)
 		{
 			m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize);
 			m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize);
@@ -2067,19 +3506,25 @@ namespace bgfx
 
 	void Context::shutdown()
 	{
+		asyncUploadShutdown();
+
 		getCommandBuffer(CommandBuffer::RendererShutdownBegin);
 		frame();
 
 		destroyTransientVertexBuffer(m_submit->m_transientVb);
 		destroyTransientIndexBuffer(m_submit->m_transientIb);
+		m_submit->m_transientVb = NULL;
+		m_submit->m_transientIb = NULL;
 		m_textVideoMemBlitter.shutdown();
 		m_clearQuad.shutdown();
 		frame();
 
-		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
+		for (uint32_t ii = 1; ii < m_numFrames; ++ii)
 		{
 			destroyTransientVertexBuffer(m_submit->m_transientVb);
 			destroyTransientIndexBuffer(m_submit->m_transientIb);
+			m_submit->m_transientVb = NULL;
+			m_submit->m_transientIb = NULL;
 			frame();
 		}
 
@@ -2089,9 +3534,6 @@ namespace bgfx
 		frame();
 
 		m_encoder[0].end(true);
-		m_encoderHandle->free(0);
-		bx::destroyHandleAlloc(g_allocator, m_encoderHandle);
-		m_encoderHandle = NULL;
 
 		for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
 		{
@@ -2115,7 +3557,7 @@ namespace bgfx
 
 #if BGFX_CONFIG_MULTITHREADED
 		// Render thread shutdown sequence.
-		renderSemWait(); // Wait for previous frame.
+		renderSemWaitAll(); // Wait for frames in flight.
 		apiSemPost();   // OK to set context to NULL.
 		// s_ctx is NULL here.
 		renderSemWait(); // In RenderFrame::Exiting state.
@@ -2124,14 +3566,13 @@ namespace bgfx
 		{
 			m_thread.shutdown();
 		}
-
-		m_render->destroy();
 #endif // BGFX_CONFIG_MULTITHREADED
 
 		bx::memSet(&g_internalData, 0, sizeof(InternalData) );
 		s_ctx = NULL;
 
-		m_submit->destroy();
+		destroyFrames();
+		m_sortThreadPool.shutdown();
 
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
 		{
@@ -2207,13 +3648,21 @@ namespace bgfx
 			CHECK_HANDLE_LEAK_NAME   ("FrameBufferHandle",         m_frameBufferHandle,        FrameBufferRef, m_frameBufferRef);
 			CHECK_HANDLE_LEAK_RC_NAME("UniformHandle",             m_uniformHandle,            UniformRef,     m_uniformRef    );
 			CHECK_HANDLE_LEAK        ("OcclusionQueryHandle",      m_occlusionQueryHandle                                      );
+			CHECK_HANDLE_LEAK        ("DrawListHandle",            m_drawListHandle                                            );
 #undef CHECK_HANDLE_LEAK
 #undef CHECK_HANDLE_LEAK_NAME
 		}
+
+		for (uint16_t ii = 0, num = m_drawListHandle.getNumHandles(); ii < num; ++ii)
+		{
+			m_drawList[m_drawListHandle.getHandleAt(ii)].destroy();
+		}
 	}
 
 	void Context::freeDynamicBuffers()
 	{
+		BGFX_MUTEX_SCOPE(m_drawListLock);
+
 		for (uint16_t ii = 0, num = m_numFreeDynamicIndexBufferHandles; ii < num; ++ii)
 		{
 			destroyDynamicIndexBufferInternal(m_freeDynamicIndexBufferHandle[ii]);
@@ -2235,9 +3684,13 @@ namespace bgfx
 
 	void Context::freeAllHandles(Frame* _frame)
 	{
+		BGFX_MUTEX_SCOPE(m_drawListLock);
+
 		for (uint16_t ii = 0, num = _frame->m_freeIndexBuffer.getNumQueued(); ii < num; ++ii)
 		{
-			m_indexBufferHandle.free(_frame->m_freeIndexBuffer.get(ii).idx);
+			const uint16_t idx = _frame->m_freeIndexBuffer.get(ii).idx;
+			++m_drawListRefGen[DrawListRef::IndexBuffer][idx];
+			m_indexBufferHandle.free(idx);
 		}
 
 		for (uint16_t ii = 0, num = _frame->m_freeVertexBuffer.getNumQueued(); ii < num; ++ii)
@@ -2245,109 +3698,580 @@ namespace bgfx
 			destroyVertexBufferInternal(_frame->m_freeVertexBuffer.get(ii));
 		}
 
-		for (uint16_t ii = 0, num = _frame->m_freeVertexLayout.getNumQueued(); ii < num; ++ii)
+		for (uint16_t ii = 0, num = _frame->m_freeVertexLayout.getNumQueued(); ii < num; ++ii)
+		{
+			m_layoutHandle.free(_frame->m_freeVertexLayout.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeShader.getNumQueued(); ii < num; ++ii)
+		{
+			m_shaderHandle.free(_frame->m_freeShader.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeProgram.getNumQueued(); ii < num; ++ii)
+		{
+			const uint16_t idx = _frame->m_freeProgram.get(ii).idx;
+			++m_drawListRefGen[DrawListRef::Program][idx];
+			m_programHandle.free(idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeTexture.getNumQueued(); ii < num; ++ii)
+		{
+			const uint16_t idx = _frame->m_freeTexture.get(ii).idx;
+			++m_drawListRefGen[DrawListRef::Texture][idx];
+			m_textureHandle.free(idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeFrameBuffer.getNumQueued(); ii < num; ++ii)
+		{
+			m_frameBufferHandle.free(_frame->m_freeFrameBuffer.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeUniform.getNumQueued(); ii < num; ++ii)
+		{
+			const uint16_t idx = _frame->m_freeUniform.get(ii).idx;
+			++m_drawListRefGen[DrawListRef::Uniform][idx];
+			m_uniformHandle.free(idx);
+		}
+	}
+
+	Encoder* Context::begin(bool _forThread)
+	{
+		EncoderImpl* encoder = &m_encoder[0];
+
+#if BGFX_CONFIG_MULTITHREADED
+		if (_forThread || BGFX_API_THREAD_MAGIC != s_threadIndex)
+		{
+			int64_t  waitBeginTime = 0;
+			uint32_t numRetries    = 0;
+
+			// Encoder API state is number of encoders in flight, and closed flag
+			// which is set by frame while it holds encoder API lock.
+			for (uint32_t state = bx::atomicFetchAndAdd<uint32_t>(&m_encoderState, 0);;)
+			{
+				if (0 != (state & kEncoderApiClosed) )
+				{
+					const int64_t start = bx::getHPCounter();
+					{
+						bx::MutexScope scopeLock(m_encoderApiLock);
+						state = bx::atomicFetchAndAdd<uint32_t>(&m_encoderState, 0);
+					}
+					waitBeginTime += bx::getHPCounter() - start;
+					++numRetries;
+					continue;
+				}
+
+				const uint32_t prev = bx::atomicCompareAndSwap<uint32_t>(&m_encoderState, state, state+1);
+				if (prev == state)
+				{
+					break;
+				}
+
+				state = prev;
+				++numRetries;
+			}
+
+			// Encoder slots are not reused until next frame, so slot allocation
+			// is just a saturating counter.
+			const uint32_t maxEncoders = m_init.limits.maxEncoders;
+			const uint32_t idx = bx::atomicFetchAndAddsat<uint32_t>(&m_numEncodersUsed, 1, maxEncoders);
+			if (idx >= maxEncoders)
+			{
+				encoderApiEnd();
+				return NULL;
+			}
+
+			encoder = &m_encoder[idx];
+			encoder->begin(m_submit, uint8_t(idx) );
+			encoder->m_waitBeginTime   = waitBeginTime;
+			encoder->m_numBeginRetries = numRetries;
+		}
+#else
+		BX_UNUSED(_forThread);
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		return reinterpret_cast<Encoder*>(encoder);
+	}
+
+	void Context::end(Encoder* _encoder)
+	{
+#if BGFX_CONFIG_MULTITHREADED
+		EncoderImpl* encoder = reinterpret_cast<EncoderImpl*>(_encoder);
+		if (encoder != &m_encoder[0])
+		{
+			encoder->end(true);
+			encoderApiEnd();
+		}
+#else
+		BX_UNUSED(_encoder);
+#endif // BGFX_CONFIG_MULTITHREADED
+	}
+
+	uint32_t Context::frame(bool _capture)
+	{
+		m_encoder[0].end(true);
+
+#if BGFX_CONFIG_MULTITHREADED
+		bx::MutexScope resourceApiScope(m_resourceApiLock);
+		bx::MutexScope encoderApiScope(m_encoderApiLock);
+
+		encoderApiWait();
+		resourceApiWait();
+#else
+		encoderApiWait();
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		m_submit->m_capture = _capture;
+
+		uint32_t frameNum = m_submit->m_frameNum;
+
+		BGFX_PROFILER_SCOPE("bgfx/API thread frame", 0xff2040ff);
+		// wait for render thread to finish oldest frame in flight, if API
+		// thread is too far ahead.
+		if (m_numFramesInFlight >= m_maxFramesInFlight)
+		{
+			renderSemWait();
+			--m_numFramesInFlight;
+		}
+
+		frameNoRenderWait();
+
+		m_encoder[0].begin(m_submit, 0);
+
+		encoderApiResume();
+		resourceApiResume();
+
+		return frameNum;
+	}
+
+	void Context::frameNoRenderWait()
+	{
+		swap();
+
+		// release render thread
+		apiSemPost();
+		++m_numFramesInFlight;
+	}
+
+	void Context::renderSemWaitAll()
+	{
+		for (; 0 < m_numFramesInFlight; --m_numFramesInFlight)
+		{
+			renderSemWait();
+		}
+	}
+
+	void Context::destroyFrames()
+	{
+		for (uint32_t ii = 0; ii < m_numFrames; ++ii)
+		{
+			m_frame[ii].destroy();
+			m_frame[ii].~Frame();
+		}
+
+		bx::alignedFree(g_allocator, m_frame, BX_ALIGNOF(Frame) );
+		m_frame  = NULL;
+		m_render = NULL;
+		m_submit = NULL;
+
+		UniformBuffer::releasePages();
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_resourceCmd); ++ii)
+		{
+			m_resourceCmd[ii].shutdown();
+		}
+	}
+
+	CommandBuffer& Context::getCommandBuffer(CommandBuffer::Enum _cmd)
+	{
+		const uint32_t seq = bx::atomicFetchAndAdd<uint32_t>(&m_resourceCmdSeq, 1);
+		return m_resourceCmd[s_resourceCmdIdx].write(seq, _cmd);
+	}
+
+	uint32_t Context::resourceApiBegin()
+	{
+#if BGFX_CONFIG_MULTITHREADED
+		BX_STATIC_ASSERT(1 < BGFX_CONFIG_MAX_RESOURCE_COMMAND_BUFFERS);
+
+		if (0 != s_resourceCmdIdx)
+		{
+			// Resource function called from another resource function, keep
+			// using calling thread's resource command buffer.
+			return kResourceApiNested;
+		}
+
+		for (uint32_t state = bx::atomicFetchAndAdd<uint32_t>(&m_resourceApiState, 0);;)
+		{
+			if (0 != (state & kResourceApiClosed) )
+			{
+				// Frame is being swapped, wait for it and continue under resource
+				// API lock.
+				m_resourceApiLock.lock();
+				return 0;
+			}
+
+			const uint32_t prev = bx::atomicCompareAndSwap<uint32_t>(&m_resourceApiState, state, state+1);
+			if (prev == state)
+			{
+				break;
+			}
+
+			state = prev;
+		}
+
+		const uint32_t num = BX_COUNTOF(m_resourceCmd)-1;
+		for (uint32_t ii = bx::atomicFetchAndAdd<uint32_t>(&m_resourceCmdNext, 1);; ++ii)
+		{
+			const uint32_t idx = 1 + ii%num;
+			if (0 == bx::atomicCompareAndSwap<uint32_t>(&m_resourceCmd[idx].m_busy, 0, 1) )
+			{
+				s_resourceCmdIdx = idx;
+				return idx;
+			}
+
+			if (num-1 == ii%num)
+			{
+				// All resource command buffers are busy, give other threads
+				// a chance to finish before trying again.
+				bx::yield();
+			}
+		}
+#else
+		return 0;
+#endif // BGFX_CONFIG_MULTITHREADED
+	}
+
+	void Context::resourceApiEnd(uint32_t _idx)
+	{
+#if BGFX_CONFIG_MULTITHREADED
+		if (0 == _idx)
+		{
+			m_resourceApiLock.unlock();
+			return;
+		}
+
+		if (kResourceApiNested == _idx)
+		{
+			return;
+		}
+
+		s_resourceCmdIdx = 0;
+		bx::atomicCompareAndSwap<uint32_t>(&m_resourceCmd[_idx].m_busy, 1, 0);
+
+		// Only the last resource function to end while API is closed signals
+		// semaphore.
+		const uint32_t state = bx::atomicFetchAndSub<uint32_t>(&m_resourceApiState, 1);
+		if (kResourceApiClosed + 1 == state)
+		{
+			m_resourceApiEndSem.post();
+		}
+#else
+		BX_UNUSED(_idx);
+#endif // BGFX_CONFIG_MULTITHREADED
+	}
+
+	void Context::mergeResourceCommands()
+	{
+		CommandBuffer* frameCmdbuf[] = { &m_submit->m_cmdPre, &m_submit->m_cmdPost };
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_resourceCmd); ++ii)
+		{
+			m_resourceCmd[ii].finish();
+		}
+
+		for (uint32_t type = 0; type < BX_COUNTOF(frameCmdbuf); ++type)
+		{
+			CommandBuffer& cmdbuf = *frameCmdbuf[type];
+			uint32_t markIdx[BGFX_CONFIG_MAX_RESOURCE_COMMAND_BUFFERS] = {};
+
+			for (;;)
+			{
+				// Pick command with lowest sequence number.
+				uint32_t src = UINT32_MAX;
+				uint32_t seq = 0;
+
+				for (uint32_t ii = 0; ii < BX_COUNTOF(m_resourceCmd); ++ii)
+				{
+					const ResourceCommandBuffer& rcb = m_resourceCmd[ii];
+					if (markIdx[ii] < rcb.m_numMarks[type])
+					{
+						const uint32_t markSeq = rcb.m_mark[type][markIdx[ii] ].m_seq;
+						if (UINT32_MAX == src
+						||  int32_t(markSeq - seq) < 0)
+						{
+							src = ii;
+							seq = markSeq;
+						}
+					}
+				}
+
+				if (UINT32_MAX == src)
+				{
+					break;
+				}
+
+				const ResourceCommandBuffer& rcb = m_resourceCmd[src];
+				const ResourceCommandBuffer::Mark& mark = rcb.m_mark[type][markIdx[src]++];
+
+				const uint8_t nop = CommandBuffer::Nop;
+				while (0 != (cmdbuf.m_pos & 15) )
+				{
+					cmdbuf.write(nop);
+				}
+
+				if (0 == type
+				&&  UINT32_MAX == m_submit->m_uploadCmdPos
+				&&  0 <= int32_t(seq - m_asyncUploadSeq) )
+				{
+					m_submit->m_uploadCmdPos = cmdbuf.m_pos;
+				}
+
+				cmdbuf.write(&rcb.m_cmdbuf[type].m_buffer[mark.m_begin], mark.m_end - mark.m_begin);
+			}
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_resourceCmd); ++ii)
 		{
-			m_layoutHandle.free(_frame->m_freeVertexLayout.get(ii).idx);
+			m_resourceCmd[ii].reset();
 		}
+	}
 
-		for (uint16_t ii = 0, num = _frame->m_freeShader.getNumQueued(); ii < num; ++ii)
+	static void asyncUploadRelease(void* _ptr, void* _userData)
+	{
+		BX_UNUSED(_ptr);
+
+		AsyncUploadMemory* memory = (AsyncUploadMemory*)_userData;
+		if (1 == bx::atomicFetchAndSub<int32_t>(&memory->m_refCount, 1) )
 		{
-			m_shaderHandle.free(_frame->m_freeShader.get(ii).idx);
+			release(memory->m_mem);
+			bx::free(g_allocator, memory);
 		}
+	}
 
-		for (uint16_t ii = 0, num = _frame->m_freeProgram.getNumQueued(); ii < num; ++ii)
+	static const Memory* asyncUploadRef(const AsyncUpload& _upload, uint32_t _size)
+	{
+		AsyncUploadMemory* memory = _upload.m_memory;
+		bx::atomicFetchAndAdd<int32_t>(&memory->m_refCount, 1);
+		return makeRef(&memory->m_mem->data[_upload.m_offset], _size, asyncUploadRelease, memory);
+	}
+
+	uint32_t Context::asyncUploadPush(AsyncUpload& _upload, const Memory* _mem)
+	{
+		BGFX_MUTEX_SCOPE(m_asyncUploadLock);
+
+		if (NULL != _mem
+		&&  BX_COUNTOF(m_asyncUpload) == m_asyncUploadNum)
 		{
-			m_programHandle.free(_frame->m_freeProgram.get(ii).idx);
+			return 0;
 		}
 
-		for (uint16_t ii = 0, num = _frame->m_freeTexture.getNumQueued(); ii < num; ++ii)
+		// Fence 0 is reserved for uploads that were never queued.
+		if (0 == ++m_asyncUploadFence)
 		{
-			m_textureHandle.free(_frame->m_freeTexture.get(ii).idx);
+			++m_asyncUploadFence;
 		}
 
-		for (uint16_t ii = 0, num = _frame->m_freeFrameBuffer.getNumQueued(); ii < num; ++ii)
+		if (NULL != _mem)
 		{
-			m_frameBufferHandle.free(_frame->m_freeFrameBuffer.get(ii).idx);
+			AsyncUploadMemory* memory = (AsyncUploadMemory*)bx::alloc(g_allocator, sizeof(AsyncUploadMemory) );
+			memory->m_mem      = _mem;
+			memory->m_refCount = 1;
+
+			_upload.m_memory = memory;
+			_upload.m_fence  = m_asyncUploadFence;
+			_upload.m_size   = _mem->size;
+			_upload.m_offset = 0;
+			_upload.m_row    = 0;
+
+			m_asyncUpload[(m_asyncUploadHead + m_asyncUploadNum) % BX_COUNTOF(m_asyncUpload)] = _upload;
+			++m_asyncUploadNum;
+			m_asyncUploadPendingSize += _mem->size;
 		}
 
-		for (uint16_t ii = 0, num = _frame->m_freeUniform.getNumQueued(); ii < num; ++ii)
+		return m_asyncUploadFence;
+	}
+
+	void Context::asyncUploadCancel(AsyncUpload::Enum _type, uint16_t _handle)
+	{
+		BGFX_MUTEX_SCOPE(m_asyncUploadLock);
+
+		for (uint32_t ii = 0; ii < m_asyncUploadNum; ++ii)
 		{
-			m_uniformHandle.free(_frame->m_freeUniform.get(ii).idx);
+			AsyncUpload& upload = m_asyncUpload[(m_asyncUploadHead + ii) % BX_COUNTOF(m_asyncUpload)];
+			if (_type   == upload.m_type
+			&&  _handle == upload.m_handle)
+			{
+				m_asyncUploadPendingSize -= upload.m_size - upload.m_offset;
+				asyncUploadRelease(NULL, upload.m_memory);
+				upload.m_type = AsyncUpload::Cancelled;
+			}
 		}
 	}
 
-	Encoder* Context::begin(bool _forThread)
+	uint32_t Context::asyncUploadIssue(AsyncUpload& _upload, uint32_t _budget, bool _force)
 	{
-		EncoderImpl* encoder = &m_encoder[0];
+		uint32_t size = _upload.m_size - _upload.m_offset;
 
-#if BGFX_CONFIG_MULTITHREADED
-		if (_forThread || BGFX_API_THREAD_MAGIC != s_threadIndex)
+		if (AsyncUpload::Texture == _upload.m_type)
 		{
-			bx::MutexScope scopeLock(m_encoderApiLock);
+			uint32_t num = bx::min(_budget/bx::max<uint32_t>(_upload.m_rowPitch, 1), _upload.m_numRows - _upload.m_row);
+			if (0 == num)
+			{
+				if (!_force)
+				{
+					return 0;
+				}
 
-			uint16_t idx = m_encoderHandle->alloc();
-			if (kInvalidHandle == idx)
+				num = 1;
+			}
+
+			if (_upload.m_row + num < _upload.m_numRows)
 			{
-				return NULL;
+				size = num*_upload.m_rowPitch;
 			}
 
-			encoder = &m_encoder[idx];
-			encoder->begin(m_submit, uint8_t(idx) );
+			const uint32_t rowHeight = _upload.m_height/_upload.m_numRows;
+			const TextureHandle handle = { _upload.m_handle };
+			updateTextureImpl(
+				  handle
+				, 0
+				, _upload.m_mip
+				, _upload.m_x
+				, uint16_t(_upload.m_y + _upload.m_row*rowHeight)
+				, _upload.m_layer
+				, _upload.m_width
+				, uint16_t(num*rowHeight)
+				, 1
+				, _upload.m_pitch
+				, asyncUploadRef(_upload, size)
+				);
+
+			_upload.m_row += num;
 		}
-#else
-		BX_UNUSED(_forThread);
-#endif // BGFX_CONFIG_MULTITHREADED
+		else
+		{
+			if (size > _budget)
+			{
+				size = _budget & ~UINT32_C(15);
+				if (0 == size)
+				{
+					if (!_force)
+					{
+						return 0;
+					}
 
-		return reinterpret_cast<Encoder*>(encoder);
+					size = 16;
+				}
+			}
+
+			const DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[_upload.m_handle];
+			update(dvb, _upload.m_startOffset + _upload.m_offset, asyncUploadRef(_upload, size) );
+		}
+
+		_upload.m_offset += size;
+
+		return size;
 	}
 
-	void Context::end(Encoder* _encoder)
+	void Context::asyncUploadProcess(Frame* _frame)
 	{
-#if BGFX_CONFIG_MULTITHREADED
-		EncoderImpl* encoder = reinterpret_cast<EncoderImpl*>(_encoder);
-		if (encoder != &m_encoder[0])
+		// Resource API is closed during swap, commands issued here have the
+		// highest sequence numbers and are merged at the end of m_cmdPre.
+		m_asyncUploadSeq = bx::atomicFetchAndAdd<uint32_t>(&m_resourceCmdSeq, 0);
+
+		uint32_t budget = 0 == m_asyncUploadBudgetSize ? UINT32_MAX : m_asyncUploadBudgetSize;
+
+		if (0 != m_asyncUploadBudgetTime
+		&&  0 != m_asyncUploadRate)
 		{
-			encoder->end(true);
-			m_encoderEndSem.post();
+			const int64_t size = m_asyncUploadRate*m_asyncUploadBudgetTime/1000000;
+			budget = uint32_t(bx::clamp<int64_t>(size, 1, budget) );
 		}
-#else
-		BX_UNUSED(_encoder);
-#endif // BGFX_CONFIG_MULTITHREADED
-	}
 
-	uint32_t Context::frame(bool _capture)
-	{
-		m_encoder[0].end(true);
+		uint32_t used = 0;
 
-#if BGFX_CONFIG_MULTITHREADED
-		bx::MutexScope resourceApiScope(m_resourceApiLock);
+		while (0 < m_asyncUploadNum)
+		{
+			AsyncUpload& upload = m_asyncUpload[m_asyncUploadHead];
 
-		encoderApiWait();
-		bx::MutexScope encoderApiScope(m_encoderApiLock);
-#else
-		encoderApiWait();
-#endif // BGFX_CONFIG_MULTITHREADED
+			if (AsyncUpload::Cancelled != upload.m_type)
+			{
+				// Always make progress on the oldest upload, even when its
+				// smallest chunk doesn't fit into budget.
+				const uint32_t size = asyncUploadIssue(upload, bx::uint32_satsub(budget, used), 0 == used);
+				used += size;
+				m_asyncUploadPendingSize -= size;
 
-		m_submit->m_capture = _capture;
+				if (upload.m_offset < upload.m_size)
+				{
+					break;
+				}
 
-		uint32_t frameNum = m_submit->m_frameNum;
+				asyncUploadRelease(NULL, upload.m_memory);
+			}
 
-		BGFX_PROFILER_SCOPE("bgfx/API thread frame", 0xff2040ff);
-		// wait for render thread to finish
-		renderSemWait();
-		frameNoRenderWait();
+			m_asyncUploadHead = (m_asyncUploadHead + 1) % BX_COUNTOF(m_asyncUpload);
+			--m_asyncUploadNum;
+		}
 
-		m_encoder[0].begin(m_submit, 0);
+		// Uploads complete in order they were queued, so all fences before
+		// oldest pending upload are complete once this frame is rendered.
+		_frame->m_uploadSize  = used;
+		_frame->m_uploadFence = 0 == m_asyncUploadNum
+			? m_asyncUploadFence
+			: m_asyncUpload[m_asyncUploadHead].m_fence - 1
+			;
 
-		return frameNum;
+		m_asyncUploadSizeLast = used;
 	}
 
-	void Context::frameNoRenderWait()
+	void Context::asyncUploadShutdown()
 	{
-		swap();
+		for (; 0 < m_asyncUploadNum; --m_asyncUploadNum)
+		{
+			AsyncUpload& upload = m_asyncUpload[m_asyncUploadHead];
 
-		// release render thread
-		apiSemPost();
+			if (AsyncUpload::Cancelled != upload.m_type)
+			{
+				asyncUploadRelease(NULL, upload.m_memory);
+			}
+
+			m_asyncUploadHead = (m_asyncUploadHead + 1) % BX_COUNTOF(m_asyncUpload);
+		}
+
+		m_asyncUploadPendingSize = 0;
+	}
+
+	void Context::resizeTransientBuffers(Frame* _frame)
+	{
+		// Frame's transient buffers are no longer used by render thread, and
+		// nothing was allocated from them yet, so they can be replaced.
+		if (m_transientVbSizer.isAdaptive()
+		&&  NULL != _frame->m_transientVb
+		&&  m_transientVbSizer.m_size != _frame->m_transientVb->size)
+		{
+			TransientVertexBuffer* tvb = createTransientVertexBuffer(m_transientVbSizer.m_size);
+			if (NULL != tvb)
+			{
+				destroyTransientVertexBuffer(_frame->m_transientVb);
+				_frame->m_transientVb = tvb;
+			}
+		}
+
+		if (m_transientIbSizer.isAdaptive()
+		&&  NULL != _frame->m_transientIb
+		&&  m_transientIbSizer.m_size != _frame->m_transientIb->size)
+		{
+			TransientIndexBuffer* tib = createTransientIndexBuffer(m_transientIbSizer.m_size);
+			if (NULL != tib)
+			{
+				destroyTransientIndexBuffer(_frame->m_transientIb);
+				_frame->m_transientIb = tib;
+			}
+		}
+
+		_frame->m_perfStats.transientVbSize = NULL != _frame->m_transientVb ? int32_t(_frame->m_transientVb->size) : 0;
+		_frame->m_perfStats.transientIbSize = NULL != _frame->m_transientIb ? int32_t(_frame->m_transientIb->size) : 0;
 	}
 
 	void Context::swap()
@@ -2370,11 +4294,23 @@ namespace bgfx
 		freeAllHandles(m_submit);
 		m_submit->resetFreeHandles();
 
+		asyncUploadProcess(m_submit);
+		mergeResourceCommands();
 		m_submit->finish();
 
-		bx::swap(m_render, m_submit);
+		// Next frame in ring is the oldest one, and render thread already
+		// finished rendering it.
+		Frame* submitted = m_submit;
+		m_transientVbSizer.update(bx::max<uint32_t>(submitted->m_vboffset + submitted->m_vboverflow, submitted->m_vbrequested) );
+		m_transientIbSizer.update(bx::max<uint32_t>(submitted->m_iboffset + submitted->m_iboverflow, submitted->m_ibrequested) );
+
+		m_submitIdx = (m_submitIdx + 1) % m_numFrames;
+		m_submit    = &m_frame[m_submitIdx];
 
-		bx::memCopy(m_render->m_occlusion, m_submit->m_occlusion, sizeof(m_submit->m_occlusion) );
+		if (submitted != m_submit)
+		{
+			bx::memCopy(submitted->m_occlusion, m_submit->m_occlusion, sizeof(m_submit->m_occlusion) );
+		}
 
 		if (!BX_ENABLED(BGFX_CONFIG_MULTITHREADED)
 		||  m_singleThreaded)
@@ -2382,13 +4318,26 @@ namespace bgfx
 			renderFrame();
 		}
 
-		uint32_t nextFrameNum = m_render->m_frameNum + 1;
+		// Oldest frame in ring is rendered, use time render thread spent
+		// executing its async upload commands to estimate upload throughput.
+		if (0 != m_submit->m_uploadSize
+		&&  0 <  m_submit->m_uploadTime)
+		{
+			const int64_t rate = int64_t(m_submit->m_uploadSize)*bx::getHPFrequency()/m_submit->m_uploadTime;
+			m_asyncUploadRate = 0 == m_asyncUploadRate
+				? rate
+				: (m_asyncUploadRate*3 + rate)/4
+				;
+		}
+
+		uint32_t nextFrameNum = submitted->m_frameNum + 1;
 		m_submit->start(nextFrameNum);
+		resizeTransientBuffers(m_submit);
 
 		bx::memSet(m_seq, 0, sizeof(m_seq) );
 
 		m_submit->m_textVideoMem->resize(
-			  m_render->m_textVideoMem->m_small
+			  submitted->m_textVideoMem->m_small
 			, m_init.resolution.width
 			, m_init.resolution.height
 			);
@@ -2461,15 +4410,24 @@ namespace bgfx
 
 		if (apiSemWait(_msecs) )
 		{
+			// Frames are rendered in same order as they were submitted.
+			m_render    = &m_frame[m_renderIdx];
+			m_renderIdx = (m_renderIdx + 1) % m_numFrames;
+
+#if BGFX_CONFIG_MULTITHREADED
+			m_render->m_waitSubmit = m_waitSubmit;
+#endif // BGFX_CONFIG_MULTITHREADED
+
 			{
 				BGFX_PROFILER_SCOPE("bgfx/Exec commands pre", 0xff2040ff);
-				rendererExecCommands(m_render->m_cmdPre);
+				m_render->m_uploadTime = rendererExecCommands(m_render->m_cmdPre, m_render->m_uploadCmdPos);
 			}
 
 			if (m_rendererInitialized)
 			{
 				{
 					BGFX_PROFILER_SCOPE("bgfx/Render submit", 0xff2040ff);
+					bx::memSet(m_uniformApplied, 0, sizeof(m_uniformApplied) );
 					m_renderCtx->submit(m_render, m_clearQuad, m_textVideoMemBlitter);
 					m_flipped = false;
 				}
@@ -2489,6 +4447,11 @@ namespace bgfx
 				rendererExecCommands(m_render->m_cmdPost);
 			}
 
+			{
+				BGFX_MUTEX_SCOPE(m_asyncUploadLock);
+				m_asyncUploadFenceRendered = m_render->m_uploadFence;
+			}
+
 			renderSemPost();
 
 			if (m_flipAfterRender)
@@ -2526,19 +4489,25 @@ namespace bgfx
 			uint16_t copy;
 			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
 
+			const bool ref = 0 != (type & kUniformRefBit);
+			type &= ~kUniformRefBit;
+
 			const uint32_t size = g_uniformTypeSize[type]*num;
-			const char* data = _uniformBuffer->read(size);
+			const char* data = ref
+				? _uniformBuffer->getData(_uniformBuffer->read() )
+				: _uniformBuffer->read(size)
+				;
 
 			if (UniformType::Count > type)
 			{
-				if (copy)
+				// Reference to the value that was last applied to this uniform in
+				// current frame doesn't need to be applied again.
+				const char*& applied = s_ctx->m_uniformApplied[loc];
+				if (applied != data)
 				{
+					applied = data;
 					_renderCtx->updateUniform(loc, data, size);
 				}
-				else
-				{
-					_renderCtx->updateUniform(loc, *(const char**)(data), size);
-				}
 			}
 			else
 			{
@@ -2805,7 +4774,7 @@ namespace bgfx
 		}
 	}
 
-	void Context::rendererExecCommands(CommandBuffer& _cmdbuf)
+	int64_t Context::rendererExecCommands(CommandBuffer& _cmdbuf, uint32_t _timePos)
 	{
 		_cmdbuf.reset();
 
@@ -2820,10 +4789,10 @@ namespace bgfx
 			{
 			case CommandBuffer::RendererShutdownEnd:
 				m_exit = true;
-				return;
+				return 0;
 
 			case CommandBuffer::End:
-				return;
+				return 0;
 
 			default:
 				{
@@ -2846,15 +4815,23 @@ namespace bgfx
 						BX_ASSERT(CommandBuffer::End == command, "Unexpected command %d?"
 							, command
 							);
-						return;
+						return 0;
 					}
 				}
 				break;
 			}
 		}
 
+		int64_t timeBegin = 0;
+
 		do
 		{
+			if (0 == timeBegin
+			&&  _timePos <= _cmdbuf.m_pos)
+			{
+				timeBegin = bx::getHPCounter();
+			}
+
 			uint8_t command;
 			_cmdbuf.read(command);
 
@@ -3367,6 +5344,9 @@ namespace bgfx
 				}
 				break;
 
+			case CommandBuffer::Nop:
+				break;
+
 			case CommandBuffer::SetName:
 				{
 					BGFX_PROFILER_SCOPE("SetName", 0xff2040ff);
@@ -3383,6 +5363,14 @@ namespace bgfx
 				}
 				break;
 
+			case CommandBuffer::ReplayPipelineManifest:
+				{
+					BGFX_PROFILER_SCOPE("ReplayPipelineManifest", 0xff2040ff);
+
+					m_renderCtx->replayPipelineManifest();
+				}
+				break;
+
 			default:
 				BX_ASSERT(false, "Invalid command: %d", command);
 				break;
@@ -3390,6 +5378,8 @@ namespace bgfx
 		} while (!end);
 
 		flushTextureUpdateBatch(_cmdbuf);
+
+		return 0 == timeBegin ? 0 : bx::getHPCounter() - timeBegin;
 	}
 
 	uint32_t weldVertices(void* _output, const VertexLayout& _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon)
@@ -3397,6 +5387,11 @@ namespace bgfx
 		return weldVertices(_output, _layout, _data, _num, _index32, _epsilon, g_allocator);
 	}
 
+	uint32_t weldVertices(void* _output, void* _dstData, const VertexLayout& _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, uint8_t _flags)
+	{
+		return weldVertices(_output, _dstData, _layout, _data, _num, _index32, _epsilon, _flags, g_allocator);
+	}
+
 	uint32_t topologyConvert(TopologyConvert::Enum _conversion, void* _dst, uint32_t _dstSize, const void* _indices, uint32_t _numIndices, bool _index32)
 	{
 		return topologyConvert(_conversion, _dst, _dstSize, _indices, _numIndices, _index32, g_allocator);
@@ -3469,6 +5464,12 @@ namespace bgfx
 		, minResourceCbSize(BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE)
 		, transientVbSize(BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE)
 		, transientIbSize(BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE)
+		, transientMaxVbSize(BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_MAX_SIZE)
+		, transientMaxIbSize(BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_MAX_SIZE)
+		, uploadBudgetSize(BGFX_CONFIG_ASYNC_UPLOAD_BUDGET_SIZE)
+		, uploadBudgetTime(BGFX_CONFIG_ASYNC_UPLOAD_BUDGET_TIME)
+		, maxSortThreads(BGFX_CONFIG_DEFAULT_MAX_SORT_THREADS)
+		, maxFramesInFlight(BGFX_CONFIG_DEFAULT_MAX_FRAMES_IN_FLIGHT)
 	{
 	}
 
@@ -3506,6 +5507,8 @@ namespace bgfx
 
 		init.limits.maxEncoders       = bx::clamp<uint16_t>(init.limits.maxEncoders, 1, (0 != BGFX_CONFIG_MULTITHREADED) ? 128 : 1);
 		init.limits.minResourceCbSize = bx::min<uint32_t>(init.limits.minResourceCbSize, BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE);
+		init.limits.maxSortThreads    = bx::clamp<uint16_t>(init.limits.maxSortThreads, 1, (0 != BGFX_CONFIG_MULTITHREADED) ? BGFX_CONFIG_MAX_SORT_THREADS : 1);
+		init.limits.maxFramesInFlight = bx::clamp<uint16_t>(init.limits.maxFramesInFlight, 1, (0 != BGFX_CONFIG_MULTITHREADED) ? BGFX_CONFIG_MAX_FRAMES_IN_FLIGHT : 1);
 
 		struct ErrorState
 		{
@@ -3564,6 +5567,8 @@ namespace bgfx
 		g_caps.limits.minResourceCbSize       = init.limits.minResourceCbSize;
 		g_caps.limits.transientVbSize         = init.limits.transientVbSize;
 		g_caps.limits.transientIbSize         = init.limits.transientIbSize;
+		g_caps.limits.maxSortThreads          = init.limits.maxSortThreads;
+		g_caps.limits.maxFramesInFlight       = init.limits.maxFramesInFlight;
 
 		g_caps.vendorId = init.vendorId;
 		g_caps.deviceId = init.deviceId;
@@ -3721,6 +5726,7 @@ namespace bgfx
 		const UniformRef& uniform = s_ctx->m_uniformRef[_handle.idx];
 		BX_ASSERT(isValid(_handle) && 0 < uniform.m_refCount, "Setting invalid uniform (handle %3d)!", _handle.idx);
 		BX_ASSERT(_num == UINT16_MAX || uniform.m_num >= _num, "Truncated uniform update. %d (max: %d)", _num, uniform.m_num);
+		BGFX_ENCODER(addDrawListRef(DrawListRef::Uniform, _handle.idx) );
 		BGFX_ENCODER(setUniform(uniform.m_type, _handle, _value, UINT16_MAX != _num ? _num : uniform.m_num) );
 	}
 
@@ -3733,6 +5739,7 @@ namespace bgfx
 	{
 		BGFX_CHECK_HANDLE("setIndexBuffer", s_ctx->m_indexBufferHandle, _handle);
 		const IndexBuffer& ib = s_ctx->m_indexBuffers[_handle.idx];
+		BGFX_ENCODER(addDrawListRef(DrawListRef::IndexBuffer, _handle.idx) );
 		BGFX_ENCODER(setIndexBuffer(_handle, ib, _firstIndex, _numIndices) );
 	}
 
@@ -3745,6 +5752,7 @@ namespace bgfx
 	{
 		BGFX_CHECK_HANDLE("setIndexBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle);
 		const DynamicIndexBuffer& dib = s_ctx->m_dynamicIndexBuffers[_handle.idx];
+		BGFX_ENCODER(addDrawListRef(DrawListRef::DynamicIndexBuffer, _handle.idx) );
 		BGFX_ENCODER(setIndexBuffer(dib, _firstIndex, _numIndices) );
 	}
 
@@ -3770,6 +5778,7 @@ namespace bgfx
 	{
 		BGFX_CHECK_HANDLE("setVertexBuffer", s_ctx->m_vertexBufferHandle, _handle);
 		BGFX_CHECK_HANDLE_INVALID_OK("setVertexBuffer", s_ctx->m_layoutHandle, _layoutHandle);
+		BGFX_ENCODER(addDrawListRef(DrawListRef::VertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setVertexBuffer(_stream, _handle, _startVertex, _numVertices, _layoutHandle) );
 	}
 
@@ -3789,6 +5798,7 @@ namespace bgfx
 		BGFX_CHECK_HANDLE("setVertexBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
 		BGFX_CHECK_HANDLE_INVALID_OK("setVertexBuffer", s_ctx->m_layoutHandle, _layoutHandle);
 		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
+		BGFX_ENCODER(addDrawListRef(DrawListRef::DynamicVertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setVertexBuffer(_stream, dvb, _startVertex, _numVertices, _layoutHandle) );
 	}
 
@@ -3837,6 +5847,7 @@ namespace bgfx
 	{
 		BGFX_CHECK_HANDLE("setInstanceDataBuffer", s_ctx->m_vertexBufferHandle, _handle);
 		const VertexBuffer& vb = s_ctx->m_vertexBuffers[_handle.idx];
+		BGFX_ENCODER(addDrawListRef(DrawListRef::VertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setInstanceDataBuffer(_handle, _startVertex, _num, vb.m_stride) );
 	}
 
@@ -3844,6 +5855,7 @@ namespace bgfx
 	{
 		BGFX_CHECK_HANDLE("setInstanceDataBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
 		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
+		BGFX_ENCODER(addDrawListRef(DrawListRef::DynamicVertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setInstanceDataBuffer(dvb.m_handle
 			, dvb.m_startVertex + _startVertex
 			, _num
@@ -3872,6 +5884,8 @@ namespace bgfx
 			BX_UNUSED(ref);
 		}
 
+		BGFX_ENCODER(addDrawListRef(DrawListRef::Uniform, _sampler.idx) );
+		BGFX_ENCODER(addDrawListRef(DrawListRef::Texture, _handle.idx) );
 		BGFX_ENCODER(setTexture(_stage, _sampler, _handle, _flags) );
 	}
 
@@ -3904,6 +5918,7 @@ namespace bgfx
 		BGFX_CHECK_HANDLE_INVALID_OK("submit", s_ctx->m_programHandle, _program);
 		BGFX_CHECK_HANDLE("submit", s_ctx->m_vertexBufferHandle, _indirectHandle);
 		BGFX_CHECK_CAPS(BGFX_CAPS_DRAW_INDIRECT, "Draw indirect is not supported!");
+		BGFX_ENCODER(addDrawListRef(DrawListRef::VertexBuffer, _indirectHandle.idx) );
 		BGFX_ENCODER(submit(_id, _program, _indirectHandle, _start, _num, _depth, _flags) );
 	}
 
@@ -3914,13 +5929,94 @@ namespace bgfx
 		BGFX_CHECK_HANDLE("submit", s_ctx->m_indexBufferHandle, _numHandle);
 		BGFX_CHECK_CAPS(BGFX_CAPS_DRAW_INDIRECT, "Draw indirect is not supported!");
 		BGFX_CHECK_CAPS(BGFX_CAPS_DRAW_INDIRECT_COUNT, "Draw indirect count is not supported!");
+		BGFX_ENCODER(addDrawListRef(DrawListRef::VertexBuffer, _indirectHandle.idx) );
+		BGFX_ENCODER(addDrawListRef(DrawListRef::IndexBuffer, _numHandle.idx) );
 		BGFX_ENCODER(submit(_id, _program, _indirectHandle, _start, _numHandle, _numIndex, _numMax, _depth, _flags) );
 	}
 
+	void Encoder::submitBatch(ViewId _id, ProgramHandle _program, const BatchDraw* _draws, uint32_t _num, uint8_t _flags)
+	{
+		BGFX_CHECK_HANDLE_INVALID_OK("submitBatch", s_ctx->m_programHandle, _program);
+		BX_ASSERT(NULL != _draws || 0 == _num, "Draw call data must be provided when number of draw calls is not zero.");
+		BGFX_ENCODER(submitBatch(_id, _program, _draws, _num, _flags) );
+	}
+
+	void Encoder::beginDrawList(DrawListHandle _handle)
+	{
+		BGFX_CHECK_HANDLE("beginDrawList", s_ctx->m_drawListHandle, _handle);
+		BGFX_ENCODER(beginDrawList(_handle) );
+	}
+
+	void Encoder::endDrawList()
+	{
+		BGFX_ENCODER(endDrawList() );
+	}
+
+	void Encoder::submit(ViewId _id, DrawListHandle _handle, const void* _mtx, uint16_t _num)
+	{
+		BGFX_CHECK_HANDLE("submit", s_ctx->m_drawListHandle, _handle);
+		BX_ASSERT(NULL != _mtx || 0 == _num, "Transform data must be provided when number of matrices is not zero.");
+		BGFX_ENCODER(submit(_id, _handle, _mtx, _num) );
+	}
+
+	void Encoder::allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32)
+	{
+		BX_ASSERT(NULL != _tib, "_tib can't be NULL");
+		BX_ASSERT(0 < _num, "Requesting 0 indices.");
+		BX_ASSERT(
+			  !_index32 || 0 != (g_caps.supported & BGFX_CAPS_INDEX32)
+			, "32-bit indices are not supported. Use bgfx::getCaps to check BGFX_CAPS_INDEX32 backend renderer capabilities."
+			);
+
+		BGFX_ENCODER(allocTransientIndexBuffer(_tib, _num, _index32) );
+
+		const uint32_t indexSize = _tib->isIndex16 ? 2 : 4;
+		BX_ASSERT(_num == _tib->size/ indexSize
+			, "Failed to allocate transient index buffer (requested %d, available %d). "
+			  "Use bgfx::getAvailTransient* functions to ensure availability."
+			, _num
+			, _tib->size/indexSize
+			);
+		BX_UNUSED(indexSize);
+	}
+
+	void Encoder::allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexLayout& _layout)
+	{
+		BX_ASSERT(NULL != _tvb, "_tvb can't be NULL");
+		BX_ASSERT(0 < _num, "Requesting 0 vertices.");
+		BX_ASSERT(isValid(_layout), "Invalid VertexLayout.");
+
+		BGFX_ENCODER(allocTransientVertexBuffer(_tvb, _num, _layout) );
+
+		BX_ASSERT(_num == _tvb->size / _layout.m_stride
+			, "Failed to allocate transient vertex buffer (requested %d, available %d). "
+			  "Use bgfx::getAvailTransient* functions to ensure availability."
+			, _num
+			, _tvb->size / _layout.m_stride
+			);
+	}
+
+	void Encoder::allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride)
+	{
+		BGFX_CHECK_CAPS(BGFX_CAPS_INSTANCING, "Instancing is not supported!");
+		BX_ASSERT(bx::isAligned(_stride, 16), "Stride must be multiple of 16.");
+		BX_ASSERT(0 < _num, "Requesting 0 instanced data vertices.");
+
+		BGFX_ENCODER(allocInstanceDataBuffer(_idb, _num, _stride) );
+
+		BX_ASSERT(_num == _idb->size / _stride
+			, "Failed to allocate instance data buffer (requested %d, available %d). "
+			  "Use bgfx::getAvailTransient* functions to ensure availability."
+			, _num
+			, _idb->size / _stride
+			);
+	}
+
 	void Encoder::setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 	{
 		BX_ASSERT(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
 		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_indexBufferHandle, _handle);
+		BGFX_ENCODER(addDrawListRef(DrawListRef::IndexBuffer, _handle.idx) );
 		BGFX_ENCODER(setBuffer(_stage, _handle, _access) );
 	}
 
@@ -3928,6 +6024,7 @@ namespace bgfx
 	{
 		BX_ASSERT(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
 		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_vertexBufferHandle, _handle);
+		BGFX_ENCODER(addDrawListRef(DrawListRef::VertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setBuffer(_stage, _handle, _access) );
 	}
 
@@ -3936,6 +6033,7 @@ namespace bgfx
 		BX_ASSERT(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
 		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle);
 		const DynamicIndexBuffer& dib = s_ctx->m_dynamicIndexBuffers[_handle.idx];
+		BGFX_ENCODER(addDrawListRef(DrawListRef::DynamicIndexBuffer, _handle.idx) );
 		BGFX_ENCODER(setBuffer(_stage, dib.m_handle, _access) );
 	}
 
@@ -3944,6 +6042,7 @@ namespace bgfx
 		BX_ASSERT(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
 		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
 		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
+		BGFX_ENCODER(addDrawListRef(DrawListRef::DynamicVertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setBuffer(_stage, dvb.m_handle, _access) );
 	}
 
@@ -3952,6 +6051,7 @@ namespace bgfx
 		BX_ASSERT(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
 		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_vertexBufferHandle, _handle);
 		VertexBufferHandle handle = { _handle.idx };
+		BGFX_ENCODER(addDrawListRef(DrawListRef::VertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setBuffer(_stage, handle, _access) );
 	}
 
@@ -3978,6 +6078,7 @@ namespace bgfx
 			BX_UNUSED(ref);
 		}
 
+		BGFX_ENCODER(addDrawListRef(DrawListRef::Texture, _handle.idx) );
 		BGFX_ENCODER(setImage(_stage, _handle, _mip, _access, _format) );
 	}
 
@@ -4269,6 +6370,12 @@ namespace bgfx
 		s_ctx->update(_handle, _startVertex, _mem);
 	}
 
+	uint32_t updateAsync(DynamicVertexBufferHandle _handle, uint32_t _startVertex, const Memory* _mem)
+	{
+		BX_ASSERT(NULL != _mem, "_mem can't be NULL");
+		return s_ctx->updateAsync(_handle, _startVertex, _mem);
+	}
+
 	void destroy(DynamicVertexBufferHandle _handle)
 	{
 		s_ctx->destroyDynamicVertexBuffer(_handle);
@@ -4323,6 +6430,7 @@ namespace bgfx
 		VertexLayoutHandle layoutHandle;
 		{
 			BGFX_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(s_ctx->m_vertexLayoutLock);
 			layoutHandle = s_ctx->findOrCreateVertexLayout(_layout, true);
 		}
 		BX_ASSERT(isValid(layoutHandle), "Failed to allocate vertex layout handle (BGFX_CONFIG_MAX_VERTEX_LAYOUTS, max: %d).", BGFX_CONFIG_MAX_VERTEX_LAYOUTS);
@@ -5036,6 +7144,24 @@ namespace bgfx
 		}
 	}
 
+	uint32_t updateTexture2DAsync(TextureHandle _handle, uint16_t _layer, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const Memory* _mem, uint16_t _pitch)
+	{
+		BX_ASSERT(NULL != _mem, "_mem can't be NULL");
+		if (_width  == 0
+		||  _height == 0)
+		{
+			release(_mem);
+			return 0;
+		}
+
+		return s_ctx->updateTextureAsync(_handle, _layer, _mip, _x, _y, _width, _height, _pitch, _mem);
+	}
+
+	bool isUploadComplete(uint32_t _fence)
+	{
+		return s_ctx->isUploadComplete(_fence);
+	}
+
 	void updateTexture3D(TextureHandle _handle, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _z, uint16_t _width, uint16_t _height, uint16_t _depth, const Memory* _mem)
 	{
 		BX_ASSERT(NULL != _mem, "_mem can't be NULL");
@@ -5186,6 +7312,16 @@ namespace bgfx
 		s_ctx->destroyOcclusionQuery(_handle);
 	}
 
+	DrawListHandle createDrawList()
+	{
+		return s_ctx->createDrawList();
+	}
+
+	void destroy(DrawListHandle _handle)
+	{
+		s_ctx->destroyDrawList(_handle);
+	}
+
 	void setPaletteColor(uint8_t _index, uint32_t _rgba)
 	{
 		const uint8_t rr = uint8_t(_rgba>>24);
@@ -5519,6 +7655,30 @@ namespace bgfx
 		s_ctx->m_encoder0->submit(_id, _program, _indirectHandle, _start, _numHandle, _numIndex, _numMax, _depth, _flags);
 	}
 
+	void submitBatch(ViewId _id, ProgramHandle _program, const BatchDraw* _draws, uint32_t _num, uint8_t _flags)
+	{
+		BGFX_CHECK_ENCODER0();
+		s_ctx->m_encoder0->submitBatch(_id, _program, _draws, _num, _flags);
+	}
+
+	void beginDrawList(DrawListHandle _handle)
+	{
+		BGFX_CHECK_ENCODER0();
+		s_ctx->m_encoder0->beginDrawList(_handle);
+	}
+
+	void endDrawList()
+	{
+		BGFX_CHECK_ENCODER0();
+		s_ctx->m_encoder0->endDrawList();
+	}
+
+	void submit(ViewId _id, DrawListHandle _handle, const void* _mtx, uint16_t _num)
+	{
+		BGFX_CHECK_ENCODER0();
+		s_ctx->m_encoder0->submit(_id, _handle, _mtx, _num);
+	}
+
 	void setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 	{
 		BGFX_CHECK_ENCODER0();
@@ -5591,6 +7751,12 @@ namespace bgfx
 		s_ctx->requestScreenShot(_handle, _filePath);
 	}
 
+	void replayPipelineManifest()
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->replayPipelineManifest();
+	}
+
 #undef BGFX_CHECK_ENCODER0
 
 } // namespace bgfx
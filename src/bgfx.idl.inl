@@ -138,6 +138,12 @@ BGFX_C_API uint32_t bgfx_weld_vertices(void* _output, const bgfx_vertex_layout_t
 	return bgfx::weldVertices(_output, layout, _data, _num, _index32, _epsilon);
 }
 
+BGFX_C_API uint32_t bgfx_weld_vertices_compact(void* _output, void* _dstData, const bgfx_vertex_layout_t * _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, uint8_t _flags)
+{
+	const bgfx::VertexLayout & layout = *(const bgfx::VertexLayout *)_layout;
+	return bgfx::weldVertices(_output, _dstData, layout, _data, _num, _index32, _epsilon, _flags);
+}
+
 BGFX_C_API uint32_t bgfx_topology_convert(bgfx_topology_convert_t _conversion, void* _dst, uint32_t _dstSize, const void* _indices, uint32_t _numIndices, bool _index32)
 {
 	return bgfx::topologyConvert((bgfx::TopologyConvert::Enum)_conversion, _dst, _dstSize, _indices, _numIndices, _index32);
@@ -341,6 +347,12 @@ BGFX_C_API void bgfx_update_dynamic_vertex_buffer(bgfx_dynamic_vertex_buffer_han
 	bgfx::update(handle.cpp, _startVertex, (const bgfx::Memory*)_mem);
 }
 
+BGFX_C_API uint32_t bgfx_update_dynamic_vertex_buffer_async(bgfx_dynamic_vertex_buffer_handle_t _handle, uint32_t _startVertex, const bgfx_memory_t* _mem)
+{
+	union { bgfx_dynamic_vertex_buffer_handle_t c; bgfx::DynamicVertexBufferHandle cpp; } handle = { _handle };
+	return bgfx::updateAsync(handle.cpp, _startVertex, (const bgfx::Memory*)_mem);
+}
+
 BGFX_C_API void bgfx_destroy_dynamic_vertex_buffer(bgfx_dynamic_vertex_buffer_handle_t _handle)
 {
 	union { bgfx_dynamic_vertex_buffer_handle_t c; bgfx::DynamicVertexBufferHandle cpp; } handle = { _handle };
@@ -503,6 +515,17 @@ BGFX_C_API void bgfx_update_texture_2d(bgfx_texture_handle_t _handle, uint16_t _
 	bgfx::updateTexture2D(handle.cpp, _layer, _mip, _x, _y, _width, _height, (const bgfx::Memory*)_mem, _pitch);
 }
 
+BGFX_C_API uint32_t bgfx_update_texture_2d_async(bgfx_texture_handle_t _handle, uint16_t _layer, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const bgfx_memory_t* _mem, uint16_t _pitch)
+{
+	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle = { _handle };
+	return bgfx::updateTexture2DAsync(handle.cpp, _layer, _mip, _x, _y, _width, _height, (const bgfx::Memory*)_mem, _pitch);
+}
+
+BGFX_C_API bool bgfx_is_upload_complete(uint32_t _fence)
+{
+	return bgfx::isUploadComplete(_fence);
+}
+
 BGFX_C_API void bgfx_update_texture_3d(bgfx_texture_handle_t _handle, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _z, uint16_t _width, uint16_t _height, uint16_t _depth, const bgfx_memory_t* _mem)
 {
 	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle = { _handle };
@@ -633,6 +656,19 @@ BGFX_C_API void bgfx_destroy_occlusion_query(bgfx_occlusion_query_handle_t _hand
 	bgfx::destroy(handle.cpp);
 }
 
+BGFX_C_API bgfx_draw_list_handle_t bgfx_create_draw_list(void)
+{
+	union { bgfx_draw_list_handle_t c; bgfx::DrawListHandle cpp; } handle_ret;
+	handle_ret.cpp = bgfx::createDrawList();
+	return handle_ret.c;
+}
+
+BGFX_C_API void bgfx_destroy_draw_list(bgfx_draw_list_handle_t _handle)
+{
+	union { bgfx_draw_list_handle_t c; bgfx::DrawListHandle cpp; } handle = { _handle };
+	bgfx::destroy(handle.cpp);
+}
+
 BGFX_C_API void bgfx_set_palette_color(uint8_t _index, const float _rgba[4])
 {
 	bgfx::setPaletteColor(_index, _rgba);
@@ -917,6 +953,52 @@ BGFX_C_API void bgfx_encoder_submit_indirect_count(bgfx_encoder_t* _this, bgfx_v
 	This->submit((bgfx::ViewId)_id, program.cpp, indirectHandle.cpp, _start, numHandle.cpp, _numIndex, _numMax, _depth, _flags);
 }
 
+BGFX_C_API void bgfx_encoder_submit_batch(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, const bgfx_batch_draw_t* _draws, uint32_t _num, uint8_t _flags)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_program_handle_t c; bgfx::ProgramHandle cpp; } program = { _program };
+	This->submitBatch((bgfx::ViewId)_id, program.cpp, (const bgfx::BatchDraw*)_draws, _num, _flags);
+}
+
+BGFX_C_API void bgfx_encoder_begin_draw_list(bgfx_encoder_t* _this, bgfx_draw_list_handle_t _handle)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_draw_list_handle_t c; bgfx::DrawListHandle cpp; } handle = { _handle };
+	This->beginDrawList(handle.cpp);
+}
+
+BGFX_C_API void bgfx_encoder_end_draw_list(bgfx_encoder_t* _this)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->endDrawList();
+}
+
+BGFX_C_API void bgfx_encoder_submit_draw_list(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_draw_list_handle_t _handle, const void* _mtx, uint16_t _num)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_draw_list_handle_t c; bgfx::DrawListHandle cpp; } handle = { _handle };
+	This->submit((bgfx::ViewId)_id, handle.cpp, _mtx, _num);
+}
+
+BGFX_C_API void bgfx_encoder_alloc_transient_index_buffer(bgfx_encoder_t* _this, bgfx_transient_index_buffer_t* _tib, uint32_t _num, bool _index32)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->allocTransientIndexBuffer((bgfx::TransientIndexBuffer*)_tib, _num, _index32);
+}
+
+BGFX_C_API void bgfx_encoder_alloc_transient_vertex_buffer(bgfx_encoder_t* _this, bgfx_transient_vertex_buffer_t* _tvb, uint32_t _num, const bgfx_vertex_layout_t * _layout)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	const bgfx::VertexLayout & layout = *(const bgfx::VertexLayout *)_layout;
+	This->allocTransientVertexBuffer((bgfx::TransientVertexBuffer*)_tvb, _num, layout);
+}
+
+BGFX_C_API void bgfx_encoder_alloc_instance_data_buffer(bgfx_encoder_t* _this, bgfx_instance_data_buffer_t* _idb, uint32_t _num, uint16_t _stride)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->allocInstanceDataBuffer((bgfx::InstanceDataBuffer*)_idb, _num, _stride);
+}
+
 BGFX_C_API void bgfx_encoder_set_compute_index_buffer(bgfx_encoder_t* _this, uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access)
 {
 	bgfx::Encoder* This = (bgfx::Encoder*)_this;
@@ -994,6 +1076,11 @@ BGFX_C_API void bgfx_request_screen_shot(bgfx_frame_buffer_handle_t _handle, con
 	bgfx::requestScreenShot(handle.cpp, _filePath);
 }
 
+BGFX_C_API void bgfx_replay_pipeline_manifest(void)
+{
+	bgfx::replayPipelineManifest();
+}
+
 BGFX_C_API bgfx_render_frame_t bgfx_render_frame(int32_t _msecs)
 {
 	return (bgfx_render_frame_t)bgfx::renderFrame(_msecs);
@@ -1195,6 +1282,29 @@ BGFX_C_API void bgfx_submit_indirect_count(bgfx_view_id_t _id, bgfx_program_hand
 	bgfx::submit((bgfx::ViewId)_id, program.cpp, indirectHandle.cpp, _start, numHandle.cpp, _numIndex, _numMax, _depth, _flags);
 }
 
+BGFX_C_API void bgfx_submit_batch(bgfx_view_id_t _id, bgfx_program_handle_t _program, const bgfx_batch_draw_t* _draws, uint32_t _num, uint8_t _flags)
+{
+	union { bgfx_program_handle_t c; bgfx::ProgramHandle cpp; } program = { _program };
+	bgfx::submitBatch((bgfx::ViewId)_id, program.cpp, (const bgfx::BatchDraw*)_draws, _num, _flags);
+}
+
+BGFX_C_API void bgfx_begin_draw_list(bgfx_draw_list_handle_t _handle)
+{
+	union { bgfx_draw_list_handle_t c; bgfx::DrawListHandle cpp; } handle = { _handle };
+	bgfx::beginDrawList(handle.cpp);
+}
+
+BGFX_C_API void bgfx_end_draw_list(void)
+{
+	bgfx::endDrawList();
+}
+
+BGFX_C_API void bgfx_submit_draw_list(bgfx_view_id_t _id, bgfx_draw_list_handle_t _handle, const void* _mtx, uint16_t _num)
+{
+	union { bgfx_draw_list_handle_t c; bgfx::DrawListHandle cpp; } handle = { _handle };
+	bgfx::submit((bgfx::ViewId)_id, handle.cpp, _mtx, _num);
+}
+
 BGFX_C_API void bgfx_set_compute_index_buffer(uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access)
 {
 	union { bgfx_index_buffer_handle_t c; bgfx::IndexBufferHandle cpp; } handle = { _handle };
@@ -1310,6 +1420,7 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_vertex_unpack,
 			bgfx_vertex_convert,
 			bgfx_weld_vertices,
+			bgfx_weld_vertices_compact,
 			bgfx_topology_convert,
 			bgfx_topology_sort_tri_list,
 			bgfx_get_supported_renderers,
@@ -1346,6 +1457,7 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_create_dynamic_vertex_buffer,
 			bgfx_create_dynamic_vertex_buffer_mem,
 			bgfx_update_dynamic_vertex_buffer,
+			bgfx_update_dynamic_vertex_buffer_async,
 			bgfx_destroy_dynamic_vertex_buffer,
 			bgfx_get_avail_transient_index_buffer,
 			bgfx_get_avail_transient_vertex_buffer,
@@ -1372,6 +1484,8 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_create_texture_3d,
 			bgfx_create_texture_cube,
 			bgfx_update_texture_2d,
+			bgfx_update_texture_2d_async,
+			bgfx_is_upload_complete,
 			bgfx_update_texture_3d,
 			bgfx_update_texture_cube,
 			bgfx_read_texture,
@@ -1392,6 +1506,8 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_create_occlusion_query,
 			bgfx_get_result,
 			bgfx_destroy_occlusion_query,
+			bgfx_create_draw_list,
+			bgfx_destroy_draw_list,
 			bgfx_set_palette_color,
 			bgfx_set_palette_color_rgba32f,
 			bgfx_set_palette_color_rgba8,
@@ -1438,6 +1554,13 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_encoder_submit_occlusion_query,
 			bgfx_encoder_submit_indirect,
 			bgfx_encoder_submit_indirect_count,
+			bgfx_encoder_submit_batch,
+			bgfx_encoder_begin_draw_list,
+			bgfx_encoder_end_draw_list,
+			bgfx_encoder_submit_draw_list,
+			bgfx_encoder_alloc_transient_index_buffer,
+			bgfx_encoder_alloc_transient_vertex_buffer,
+			bgfx_encoder_alloc_instance_data_buffer,
 			bgfx_encoder_set_compute_index_buffer,
 			bgfx_encoder_set_compute_vertex_buffer,
 			bgfx_encoder_set_compute_dynamic_index_buffer,
@@ -1449,6 +1572,7 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_encoder_discard,
 			bgfx_encoder_blit,
 			bgfx_request_screen_shot,
+			bgfx_replay_pipeline_manifest,
 			bgfx_render_frame,
 			bgfx_set_platform_data,
 			bgfx_get_internal_data,
@@ -1484,6 +1608,10 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_submit_occlusion_query,
 			bgfx_submit_indirect,
 			bgfx_submit_indirect_count,
+			bgfx_submit_batch,
+			bgfx_begin_draw_list,
+			bgfx_end_draw_list,
+			bgfx_submit_draw_list,
 			bgfx_set_compute_index_buffer,
 			bgfx_set_compute_vertex_buffer,
 			bgfx_set_compute_dynamic_index_buffer,
@@ -858,6 +858,117 @@ namespace bgfx
 	const char* getPredefinedUniformName(PredefinedUniform::Enum _enum);
 	PredefinedUniform::Enum nameToPredefinedUniformEnum(const bx::StringView& _name);
 
+	// Handle allocator that can be used from multiple threads without lock.
+	// Free handles are kept in stack, and stack head is tagged with counter
+	// to avoid ABA problem.
+	template<uint16_t MaxHandlesT>
+	class HandleAllocMt
+	{
+		BX_CLASS(HandleAllocMt
+			, NO_COPY
+			);
+
+	public:
+		HandleAllocMt()
+		{
+			reset();
+		}
+
+		void reset()
+		{
+			for (uint16_t ii = 0; ii < MaxHandlesT; ++ii)
+			{
+				m_next[ii]  = ii+1;
+				m_alive[ii] = false;
+			}
+
+			m_head       = 0;
+			m_numHandles = 0;
+		}
+
+		uint16_t alloc()
+		{
+			for (uint64_t head = m_head;;)
+			{
+				const uint16_t idx = uint16_t(head);
+				if (MaxHandlesT <= idx)
+				{
+					return kInvalidHandle;
+				}
+
+				const uint64_t next = ( ( (head>>16)+1)<<16) | m_next[idx];
+				const uint64_t prev = bx::atomicCompareAndSwap<uint64_t>(&m_head, head, next);
+				if (prev == head)
+				{
+					m_alive[idx] = true;
+					bx::atomicFetchAndAdd<uint32_t>(&m_numHandles, 1);
+					return idx;
+				}
+
+				head = prev;
+			}
+		}
+
+		void free(uint16_t _handle)
+		{
+			BX_ASSERT(isValid(_handle), "Invalid handle %d.", _handle);
+			m_alive[_handle] = false;
+			bx::atomicFetchAndSub<uint32_t>(&m_numHandles, 1);
+
+			for (uint64_t head = m_head;;)
+			{
+				m_next[_handle] = uint16_t(head);
+
+				const uint64_t next = ( ( (head>>16)+1)<<16) | _handle;
+				const uint64_t prev = bx::atomicCompareAndSwap<uint64_t>(&m_head, head, next);
+				if (prev == head)
+				{
+					return;
+				}
+
+				head = prev;
+			}
+		}
+
+		bool isValid(uint16_t _handle) const
+		{
+			return _handle < MaxHandlesT
+				&& m_alive[_handle]
+				;
+		}
+
+		uint16_t getNumHandles() const
+		{
+			return uint16_t(m_numHandles);
+		}
+
+		uint16_t getMaxHandles() const
+		{
+			return MaxHandlesT;
+		}
+
+		// Linear search, it's used only for leak reporting.
+		uint16_t getHandleAt(uint16_t _at) const
+		{
+			for (uint16_t ii = 0, num = 0; ii < MaxHandlesT; ++ii)
+			{
+				if (m_alive[ii]
+				&&  num++ == _at)
+				{
+					return ii;
+				}
+			}
+
+			return kInvalidHandle;
+		}
+
+	private:
+		uint64_t m_head;
+		uint32_t m_numHandles;
+		uint16_t m_next[MaxHandlesT];
+		bool     m_alive[MaxHandlesT];
+	};
+
 	class CommandBuffer
 	{
 		BX_CLASS(CommandBuffer
@@ -907,6 +1018,8 @@ namespace bgfx
 			UpdateViewName,
 			InvalidateOcclusionQuery,
 			SetName,
+			ReplayPipelineManifest,
+			Nop,
 			End,
 			RendererShutdownEnd,
 			DestroyVertexLayout,
@@ -1033,6 +1146,101 @@ namespace bgfx
 		uint32_t m_minCapacity;
 	};
 
+	// Resource commands are recorded into one of these buffers and tagged with
+	// global sequence number. At swap, they are merged into frame command
+	// buffers in order they were issued, regardless of which thread issued them.
+	struct ResourceCommandBuffer
+	{
+		struct Mark
+		{
+			uint32_t m_seq;
+			uint32_t m_begin;
+			uint32_t m_end;
+		};
+
+		void init(uint32_t _minCapacity)
+		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_cmdbuf); ++ii)
+			{
+				m_cmdbuf[ii].init(_minCapacity);
+				m_cmdbuf[ii].start();
+				m_mark[ii]     = NULL;
+				m_numMarks[ii] = 0;
+				m_maxMarks[ii] = 0;
+			}
+
+			m_busy = 0;
+		}
+
+		void shutdown()
+		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_cmdbuf); ++ii)
+			{
+				bx::free(g_allocator, m_mark[ii]);
+				m_mark[ii] = NULL;
+			}
+		}
+
+		CommandBuffer& write(uint32_t _seq, CommandBuffer::Enum _cmd)
+		{
+			const uint32_t type = _cmd < CommandBuffer::End ? 0 : 1;
+			CommandBuffer& cmdbuf = m_cmdbuf[type];
+
+			uint32_t& numMarks = m_numMarks[type];
+			if (0 < numMarks)
+			{
+				m_mark[type][numMarks-1].m_end = cmdbuf.m_pos;
+			}
+
+			if (numMarks == m_maxMarks[type])
+			{
+				m_maxMarks[type] = bx::max<uint32_t>(m_maxMarks[type]*2, 64);
+				m_mark[type] = (Mark*)bx::realloc(g_allocator, m_mark[type], m_maxMarks[type]*sizeof(Mark) );
+			}
+
+			// Commands start at 16 byte aligned position, and are copied to 16
+			// byte aligned position in frame, so that aligned reads of command
+			// data stay the same.
+			cmdbuf.align(16);
+
+			Mark& mark = m_mark[type][numMarks++];
+			mark.m_seq   = _seq;
+			mark.m_begin = cmdbuf.m_pos;
+			mark.m_end   = UINT32_MAX;
+
+			const uint8_t cmd = uint8_t(_cmd);
+			cmdbuf.write(cmd);
+
+			return cmdbuf;
+		}
+
+		void finish()
+		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_cmdbuf); ++ii)
+			{
+				if (0 < m_numMarks[ii])
+				{
+					m_mark[ii][m_numMarks[ii]-1].m_end = m_cmdbuf[ii].m_pos;
+				}
+			}
+		}
+
+		void reset()
+		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_cmdbuf); ++ii)
+			{
+				m_cmdbuf[ii].start();
+				m_numMarks[ii] = 0;
+			}
+		}
+
+		CommandBuffer m_cmdbuf[2];
+		Mark*    m_mark[2];
+		uint32_t m_numMarks[2];
+		uint32_t m_maxMarks[2];
+		uint32_t m_busy;
+	};
+
 	//
 	constexpr uint8_t  kSortKeyViewNumBits         = uint8_t(31 - bx::uint32_cntlz(BGFX_CONFIG_MAX_VIEWS) );
 	constexpr uint8_t  kSortKeyViewBitShift        = 64-kSortKeyViewNumBits;
@@ -1464,6 +1672,10 @@ namespace bgfx
 	constexpr uint8_t  kConstantOpcodeCopyShift = 0;
 	constexpr uint32_t kConstantOpcodeCopyMask  = UINT32_C(0x00000001);
 
+	// Set in opcode type of uniform stream record that references value written
+	// earlier in the same stream, instead of carrying value inline.
+	constexpr uint8_t kUniformRefBit       = 0x08;
+
 	constexpr uint8_t kUniformFragmentBit  = 0x10;
 	constexpr uint8_t kUniformSamplerBit   = 0x20;
 	constexpr uint8_t kUniformReadOnlyBit  = 0x40;
@@ -1475,16 +1687,19 @@ namespace bgfx
 		| kUniformCompareBit
 		;
 
+	// Uniform stream is split into fixed size pages, and stream position is
+	// virtual (page index * page size + offset in page). Single write or read
+	// never straddles a page, when it doesn't fit into remaining space of the
+	// current page both writer and reader skip to the start of the next page.
+	// Since reader sees the same sequence of sizes as writer they stay in sync.
+	// Growing stream only adds pages, data that is already written never moves.
 	class UniformBuffer
 	{
 	public:
-		static UniformBuffer* create(uint32_t _size = 1<<20)
+		static UniformBuffer* create(uint32_t _pageSize = BGFX_CONFIG_UNIFORM_BUFFER_PAGE_SIZE)
 		{
-			const uint32_t structSize = sizeof(UniformBuffer)-sizeof(UniformBuffer::m_buffer);
-
-			uint32_t size = bx::alignUp(_size, 16);
-			void*    data = bx::alloc(g_allocator, size+structSize);
-			return BX_PLACEMENT_NEW(data, UniformBuffer)(size);
+			void* data = bx::alloc(g_allocator, sizeof(UniformBuffer) );
+			return BX_PLACEMENT_NEW(data, UniformBuffer)(_pageSize);
 		}
 
 		static void destroy(UniformBuffer* _uniformBuffer)
@@ -1493,20 +1708,8 @@ namespace bgfx
 			bx::free(g_allocator, _uniformBuffer);
 		}
 
-		static void update(UniformBuffer** _uniformBuffer, uint32_t _threshold = 64<<10, uint32_t _grow = 1<<20)
-		{
-			UniformBuffer* uniformBuffer = *_uniformBuffer;
-			if (_threshold >= uniformBuffer->m_size - uniformBuffer->m_pos)
-			{
-				const uint32_t structSize = sizeof(UniformBuffer)-sizeof(UniformBuffer::m_buffer);
-				uint32_t size = bx::alignUp(uniformBuffer->m_size + _grow, 16);
-				void*    data = bx::realloc(g_allocator, uniformBuffer, size+structSize);
-				uniformBuffer = reinterpret_cast<UniformBuffer*>(data);
-				uniformBuffer->m_size = size;
-
-				*_uniformBuffer = uniformBuffer;
-			}
-		}
+		// Releases pages cached for reuse between frames.
+		static void releasePages();
 
 		static uint32_t encodeOpcode(uint8_t _type, uint16_t _loc, uint16_t _num, uint16_t _copy)
 		{
@@ -1530,15 +1733,22 @@ namespace bgfx
 			_loc  = (uint16_t)loc;
 		}
 
-		void write(const void* _data, uint32_t _size)
+		char* reserve(uint32_t _size)
 		{
-			BX_ASSERT(m_pos + _size < m_size, "Write would go out of bounds. pos %d + size %d > max size: %d).", m_pos, _size, m_size);
+			const uint32_t pos  = advance(_size);
+			const uint32_t page = pos >> m_pageShift;
 
-			if (m_pos + _size < m_size)
+			if (page >= m_numPages)
 			{
-				bx::memCopy(&m_buffer[m_pos], _data, _size);
-				m_pos += _size;
+				addPage();
 			}
+
+			return &m_page[page][pos & m_pageMask];
+		}
+
+		void write(const void* _data, uint32_t _size)
+		{
+			bx::memCopy(reserve(_size), _data, _size);
 		}
 
 		void write(uint32_t _value)
@@ -1546,12 +1756,14 @@ namespace bgfx
 			write(&_value, sizeof(uint32_t) );
 		}
 
+		void writeRecords(const char* _data, uint32_t _size);
+
 		const char* read(uint32_t _size)
 		{
-			BX_ASSERT(m_pos < m_size, "Out of bounds %d (size: %d).", m_pos, m_size);
-			const char* result = &m_buffer[m_pos];
-			m_pos += _size;
-			return result;
+			const uint32_t pos  = advance(_size);
+			const uint32_t page = pos >> m_pageShift;
+			BX_ASSERT(page < m_numPages, "Out of bounds %d (pages: %d).", pos, m_numPages);
+			return &m_page[page][pos & m_pageMask];
 		}
 
 		uint32_t read()
@@ -1571,6 +1783,16 @@ namespace bgfx
 			return m_pos;
 		}
 
+		const char* getData(uint32_t _pos) const
+		{
+			return &m_page[_pos >> m_pageShift][_pos & m_pageMask];
+		}
+
+		uint32_t getPageSize() const
+		{
+			return m_pageMask + 1;
+		}
+
 		void reset(uint32_t _pos = 0)
 		{
 			m_pos = _pos;
@@ -1579,16 +1801,30 @@ namespace bgfx
 		void finish()
 		{
 			write(UniformType::End);
+
+			// Pages past the end of the stream were needed only by an earlier peak.
+			const uint32_t numUsed = ( (m_pos - 1) >> m_pageShift) + 1;
+			while (m_numPages > numUsed)
+			{
+				--m_numPages;
+				freePage(m_page[m_numPages], getPageSize() );
+			}
+
 			m_pos = 0;
 		}
 
-		void writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num = 1);
+		uint32_t writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num = 1);
+		void writeUniformRef(UniformType::Enum _type, uint16_t _loc, uint32_t _pos, uint16_t _num = 1);
 		void writeUniformHandle(uint8_t _type, uint16_t _loc, UniformHandle _handle, uint16_t _num = 1);
 		void writeMarker(const bx::StringView& _name);
 
 	private:
-		UniformBuffer(uint32_t _size)
-			: m_size(_size)
+		UniformBuffer(uint32_t _pageSize)
+			: m_page(NULL)
+			, m_numPages(0)
+			, m_maxPages(0)
+			, m_pageShift(bx::uint32_cnttz(bx::uint32_nextpow2(_pageSize) ) )
+			, m_pageMask(bx::uint32_nextpow2(_pageSize) - 1)
 			, m_pos(0)
 		{
 			finish();
@@ -1596,11 +1832,48 @@ namespace bgfx
 
 		~UniformBuffer()
 		{
+			for (uint32_t ii = 0; ii < m_numPages; ++ii)
+			{
+				freePage(m_page[ii], getPageSize() );
+			}
+
+			bx::free(g_allocator, m_page);
 		}
 
-		uint32_t m_size;
+		uint32_t advance(uint32_t _size)
+		{
+			BX_ASSERT(_size <= getPageSize(), "Uniform data size %d is larger than page size %d.", _size, getPageSize() );
+
+			if ( (m_pos & m_pageMask) + _size > getPageSize() )
+			{
+				m_pos = (m_pos | m_pageMask) + 1;
+			}
+
+			const uint32_t pos = m_pos;
+			m_pos += _size;
+			return pos;
+		}
+
+		void addPage()
+		{
+			if (m_numPages == m_maxPages)
+			{
+				m_maxPages = bx::max<uint32_t>(m_maxPages*2, 4);
+				m_page     = (char**)bx::realloc(g_allocator, m_page, sizeof(char*)*m_maxPages);
+			}
+
+			m_page[m_numPages++] = allocPage(getPageSize() );
+		}
+
+		static char* allocPage(uint32_t _size);
+		static void freePage(char* _page, uint32_t _size);
+
+		char**   m_page;
+		uint32_t m_numPages;
+		uint32_t m_maxPages;
+		uint32_t m_pageShift;
+		uint32_t m_pageMask;
 		uint32_t m_pos;
-		char     m_buffer[256<<20];
 	};
 
 	struct UniformRegInfo
@@ -1874,6 +2147,125 @@ namespace bgfx
 		Handle m_dst;
 	};
 
+	// Retained draw list. Draw calls are recorded with everything that's needed to
+	// submit them again in later frames: render draw and bind state, sort key inputs,
+	// and copies of per-frame data (uniforms, transforms, and scissor rects) which
+	// are referenced by offsets relative to draw list.
+	// Resources draw list can reference. Every handle has generation that is
+	// bumped when handle is freed, draw list stores generations seen while
+	// recording, and it's rejected on submit if any of them changed.
+	struct DrawListRef
+	{
+		enum Enum
+		{
+			IndexBuffer,
+			VertexBuffer,
+			DynamicIndexBuffer,
+			DynamicVertexBuffer,
+			Texture,
+			Program,
+			Uniform,
+
+			Count
+		};
+
+		uint16_t m_type;
+		uint16_t m_idx;
+		uint16_t m_gen;
+	};
+
+	constexpr uint32_t kMaxDrawListRefHandles = bx::max<uint32_t>(
+		  bx::max<uint32_t>(
+			  bx::max<uint32_t>(BGFX_CONFIG_MAX_INDEX_BUFFERS, BGFX_CONFIG_MAX_VERTEX_BUFFERS)
+			, bx::max<uint32_t>(BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS, BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS)
+			)
+		, bx::max<uint32_t>(
+			  BGFX_CONFIG_MAX_TEXTURES
+			, bx::max<uint32_t>(BGFX_CONFIG_MAX_PROGRAMS, BGFX_CONFIG_MAX_UNIFORMS)
+			)
+		);
+
+	struct DrawList
+	{
+		struct Item
+		{
+			RenderDraw    m_draw;
+			RenderBind    m_bind;
+			Rect          m_scissor;
+			uint32_t      m_depth;
+			ProgramHandle m_program;
+			uint8_t       m_blend;
+		};
+
+		DrawList()
+			: m_item(NULL)
+			, m_matrix(NULL)
+			, m_uniform(NULL)
+			, m_ref(NULL)
+			, m_numItems(0)
+			, m_maxItems(0)
+			, m_numMatrices(0)
+			, m_maxMatrices(0)
+			, m_uniformSize(0)
+			, m_maxUniformSize(0)
+			, m_numRefs(0)
+			, m_maxRefs(0)
+			, m_busy(0)
+		{
+			reset();
+		}
+
+		void reset()
+		{
+			m_numItems    = 0;
+			m_numMatrices = 0;
+			m_uniformSize = 0;
+			m_numRefs     = 0;
+
+			m_recordUniformBegin  = 0;
+			m_recordUniformEnd    = 0;
+			m_recordUniformOffset = 0;
+			m_recordUniformSize   = 0;
+			m_recordMatrixSrc     = 0;
+			m_recordMatrixDst     = 0;
+			m_recordMatrixNum     = 0;
+		}
+
+		void destroy();
+
+		Item& addItem();
+		uint32_t addMatrices(const void* _mtx, uint16_t _num);
+		uint32_t addUniforms(UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
+		void addRef(DrawListRef::Enum _type, uint16_t _idx);
+		bool isValid() const;
+
+		Item*        m_item;
+		Matrix4*     m_matrix;
+		char*        m_uniform;
+		DrawListRef* m_ref;
+		uint32_t m_numItems;
+		uint32_t m_maxItems;
+		uint32_t m_numMatrices;
+		uint32_t m_maxMatrices;
+		uint32_t m_uniformSize;
+		uint32_t m_maxUniformSize;
+		uint32_t m_numRefs;
+		uint32_t m_maxRefs;
+
+		// Consecutive draw calls often share uniforms and transform, these are
+		// used to avoid copying them more than once while recording.
+		uint32_t m_recordUniformBegin;
+		uint32_t m_recordUniformEnd;
+		uint32_t m_recordUniformOffset;
+		uint32_t m_recordUniformSize;
+		uint32_t m_recordMatrixSrc;
+		uint32_t m_recordMatrixDst;
+		uint16_t m_recordMatrixNum;
+
+		// Set while an encoder is recording into draw list.
+		uint32_t m_busy;
+	};
+
 	struct IndexBuffer
 	{
 		String   m_name;
@@ -2155,6 +2547,102 @@ namespace bgfx
 		FrameBufferHandle handle;
 	};
 
+	struct SortRun
+	{
+		uint32_t m_begin;
+		uint32_t m_num;
+	};
+
+	// Multi-threaded k-way merge of render item sort runs.
+	//
+	// Each encoder reserves render item slots from the frame in runs, and sorts
+	// every run by its own raw sort key before it's merged here. Because view id
+	// is stored in the most significant bits of sort key, every run is a sequence
+	// of per-view segments. Segments are grouped by remapped view, and each group
+	// is merged independently, so view remap doesn't require runs to be resorted.
+	// Groups are split between threads so that every thread merges about the same
+	// number of render items.
+	class SortThreadPool
+	{
+		BX_CLASS(SortThreadPool
+			, NO_COPY
+			);
+
+	public:
+		SortThreadPool();
+		~SortThreadPool();
+
+		void init(uint16_t _numThreads);
+		void shutdown();
+
+		uint32_t getNumThreads() const
+		{
+			return m_numThreads;
+		}
+
+		uint32_t merge(
+			  uint64_t* _keys
+			, uint64_t* _tempKeys
+			, RenderItemCount* _values
+			, RenderItemCount* _tempValues
+			, const SortRun* _run
+			, uint32_t _numRuns
+			, ViewId _viewRemap[BGFX_CONFIG_MAX_VIEWS]
+			);
+
+	private:
+		struct Segment
+		{
+			uint32_t m_begin;
+			uint32_t m_end;
+		};
+
+		struct HeapItem
+		{
+			bool operator<(const HeapItem& _rhs) const
+			{
+				return m_key < _rhs.m_key
+					|| (m_key == _rhs.m_key && m_pos < _rhs.m_pos)
+					;
+			}
+
+			uint64_t m_key;
+			uint32_t m_pos;
+			uint32_t m_end;
+		};
+
+		static void siftDown(HeapItem* _heap, uint32_t _num, uint32_t _idx);
+
+		void dispatch();
+		void execute(uint32_t _idx);
+
+#if BGFX_CONFIG_MULTITHREADED
+		static int32_t workerThread(bx::Thread* _self, void* _userData);
+
+		bx::Semaphore m_workSem;
+		bx::Semaphore m_doneSem;
+		bx::Thread*   m_thread;
+		uint32_t      m_next;
+		bool          m_exit;
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		uint32_t m_numThreads;
+
+		Segment*  m_segment;
+		uint32_t* m_segmentOrder;
+		HeapItem* m_heap;
+		uint32_t  m_maxSegments;
+
+		uint32_t m_viewSegment[BGFX_CONFIG_MAX_VIEWS+1];
+		uint32_t m_viewOffset[BGFX_CONFIG_MAX_VIEWS+1];
+		uint32_t m_threadView[BGFX_CONFIG_MAX_SORT_THREADS+1];
+
+		uint64_t*        m_srcKeys;
+		uint64_t*        m_dstKeys;
+		RenderItemCount* m_srcValues;
+		RenderItemCount* m_dstValues;
+	};
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) Frame
 	{
 		Frame()
@@ -2170,7 +2658,9 @@ namespace bgfx
 			m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS] = BGFX_CONFIG_MAX_DRAW_CALLS;
 			bx::memSet(m_occlusion, 0xff, sizeof(m_occlusion) );
 
-			m_perfStats.viewStats = m_viewStats;
+			m_perfStats.viewStats     = m_viewStats;
+			m_perfStats.numPipelines  = 0;
+			m_perfStats.pipelineStats = m_pipelineStats;
 
 			bx::memSet(&m_renderItemBind[0], 0, sizeof(m_renderItemBind));
 		}
@@ -2220,16 +2710,29 @@ namespace bgfx
 
 		void start(uint32_t frameNum)
 		{
-			m_perfStats.transientVbUsed = m_vboffset;
-			m_perfStats.transientIbUsed = m_iboffset;
+			m_perfStats.transientVbUsed     = m_vboffset;
+			m_perfStats.transientIbUsed     = m_iboffset;
+			m_perfStats.transientVbOverflow = m_vboverflow;
+			m_perfStats.transientIbOverflow = m_iboverflow;
 
 			m_frameCache.reset();
-			m_numRenderItems = 0;
-			m_numBlitItems   = 0;
-			m_iboffset = 0;
-			m_vboffset = 0;
+			m_numRenderItems     = 0;
+			m_numRenderItemSlots = 0;
+			m_numSortRuns        = 0;
+			m_numSortedItems     = 0;
+			m_numBlitItems       = 0;
+			m_iboffset    = 0;
+			m_vboffset    = 0;
+			m_iboverflow  = 0;
+			m_vboverflow  = 0;
+			m_ibrequested = 0;
+			m_vbrequested = 0;
 			m_cmdPre.start();
 			m_cmdPost.start();
+			m_uploadFence  = 0;
+			m_uploadSize   = 0;
+			m_uploadCmdPos = UINT32_MAX;
+			m_uploadTime   = 0;
 			m_capture = false;
 			m_numScreenShots = 0;
 			m_frameNum = frameNum;
@@ -2245,42 +2748,107 @@ namespace bgfx
 
 		uint32_t getAvailTransientIndexBuffer(uint32_t _num, uint16_t _indexSize)
 		{
-			const uint32_t offset = bx::strideAlign(m_iboffset, _indexSize);
+			const uint32_t size   = m_transientIb->size;
+			const uint32_t offset = bx::min<uint32_t>(bx::strideAlign(m_iboffset, _indexSize), size);
 			uint32_t iboffset = offset + _num*_indexSize;
-			iboffset = bx::min<uint32_t>(iboffset, g_caps.limits.transientIbSize);
+			requestTransient(&m_ibrequested, iboffset);
+			iboffset = bx::min<uint32_t>(iboffset, size);
 			const uint32_t num = (iboffset-offset)/_indexSize;
 			return num;
 		}
 
 		uint32_t allocTransientIndexBuffer(uint32_t& _num, uint16_t _indexSize)
 		{
-			uint32_t offset = bx::strideAlign(m_iboffset, _indexSize);
-			uint32_t num    = getAvailTransientIndexBuffer(_num, _indexSize);
-			m_iboffset = offset + num*_indexSize;
-			_num = num;
-
+			const uint32_t num    = _num;
+			const uint32_t offset = allocTransient(&m_iboffset, m_transientIb->size, _num, _indexSize);
+			overflowTransient(&m_iboverflow, num, _num, _indexSize);
 			return offset;
 		}
 
 		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
 		{
-			uint32_t offset   = bx::strideAlign(m_vboffset, _stride);
+			const uint32_t size = m_transientVb->size;
+			uint32_t offset   = bx::min<uint32_t>(bx::strideAlign(m_vboffset, _stride), size);
 			uint32_t vboffset = offset + _num * _stride;
-			vboffset = bx::min<uint32_t>(vboffset, g_caps.limits.transientVbSize);
+			requestTransient(&m_vbrequested, vboffset);
+			vboffset = bx::min<uint32_t>(vboffset, size);
 			uint32_t num = (vboffset-offset)/_stride;
 			return num;
 		}
 
 		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride)
 		{
-			uint32_t offset = bx::strideAlign(m_vboffset, _stride);
-			uint32_t num    = getAvailTransientVertexBuffer(_num, _stride);
-			m_vboffset = offset + num * _stride;
-			_num = num;
+			const uint32_t num    = _num;
+			const uint32_t offset = allocTransient(&m_vboffset, m_transientVb->size, _num, _stride);
+			overflowTransient(&m_vboverflow, num, _num, _stride);
+			return offset;
+		}
 
+		// Accounts for part of transient buffer request that didn't fit. It's
+		// used to size transient buffers for following frames.
+		static void overflowTransient(uint32_t* _overflow, uint32_t _numRequested, uint32_t _num, uint16_t _stride)
+		{
+			if (_numRequested != _num)
+			{
+				bx::atomicFetchAndAdd<uint32_t>(_overflow, (_numRequested-_num)*_stride);
+			}
+		}
+
+		// Tracks furthest transient buffer end requested in frame. Callers that
+		// check availability with getAvailTransient* and skip allocation never
+		// overflow, this keeps their demand visible to transient buffer sizing.
+		// Request that is allocated anyway ends at the same place as offset plus
+		// its overflow, so it's not counted twice.
+		static void requestTransient(uint32_t* _requested, uint32_t _end)
+		{
+			for (uint32_t current = *(volatile uint32_t*)_requested; current < _end;)
+			{
+				const uint32_t prev = bx::atomicCompareAndSwap<uint32_t>(_requested, current, _end);
+				if (prev == current)
+				{
+					break;
+				}
+
+				current = prev;
+			}
+		}
+
+		// Bump allocates from transient buffer. Offsets are advanced atomically,
+		// since encoders reserve their transient buffer chunks without holding
+		// resource API lock.
+		static uint32_t allocTransient(uint32_t* _offset, uint32_t _max, uint32_t& _num, uint16_t _stride)
+		{
+			for (;;)
+			{
+				const uint32_t current = *(volatile uint32_t*)_offset;
+				const uint32_t offset  = bx::min<uint32_t>(bx::strideAlign(current, _stride), _max);
+				const uint32_t num     = bx::min<uint32_t>(_num, (_max-offset)/_stride);
+				const uint32_t end     = offset + num*_stride;
+
+				if (current == bx::atomicCompareAndSwap<uint32_t>(_offset, current, end) )
+				{
+					_num = num;
+					return offset;
+				}
+			}
+		}
+
+		// Reserves chunk of `_size` bytes (or whatever is left) from transient
+		// buffer. Returns chunk begin, and chunk end in `_end`.
+		static uint32_t reserveTransientChunk(uint32_t* _offset, uint32_t _max, uint32_t _size, uint32_t& _end)
+		{
+			uint32_t num = _size/16;
+			const uint32_t offset = allocTransient(_offset, _max, num, 16);
+			_end = offset + num*16;
 			return offset;
 		}
 
+		// Returns unused tail of chunk, if nothing was allocated after it.
+		static bool releaseTransientChunk(uint32_t* _offset, uint32_t _begin, uint32_t _end)
+		{
+			return _end == bx::atomicCompareAndSwap<uint32_t>(_offset, _end, _begin);
+		}
+
 		bool free(IndexBufferHandle _handle)
 		{
 			return m_freeIndexBuffer.queue(_handle);
@@ -2344,6 +2912,7 @@ namespace bgfx
 		RenderItemCount m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS+1];
 		RenderItem m_renderItem[BGFX_CONFIG_MAX_DRAW_CALLS+1];
 		RenderBind m_renderItemBind[BGFX_CONFIG_MAX_DRAW_CALLS + 1];
+		SortRun m_sortRun[BGFX_CONFIG_MAX_SORT_RUNS];
 
 		uint32_t m_blitKeys[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
 		BlitItem m_blitItem[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
@@ -2352,10 +2921,17 @@ namespace bgfx
 		UniformBuffer** m_uniformBuffer;
 
 		uint32_t m_numRenderItems;
+		uint32_t m_numRenderItemSlots;
+		uint32_t m_numSortRuns;
+		uint32_t m_numSortedItems;
 		uint16_t m_numBlitItems;
 
 		uint32_t m_iboffset;
 		uint32_t m_vboffset;
+		uint32_t m_iboverflow;
+		uint32_t m_vboverflow;
+		uint32_t m_ibrequested;
+		uint32_t m_vbrequested;
 		TransientIndexBuffer* m_transientIb;
 		TransientVertexBuffer* m_transientVb;
 
@@ -2368,45 +2944,61 @@ namespace bgfx
 		CommandBuffer m_cmdPre;
 		CommandBuffer m_cmdPost;
 
+		uint32_t m_uploadFence;
+		uint32_t m_uploadSize;
+		uint32_t m_uploadCmdPos; // Async upload commands are tail of m_cmdPre starting here.
+		int64_t  m_uploadTime;
+
 		template<typename Ty, uint32_t Max>
 		struct FreeHandle
 		{
 			FreeHandle()
 				: m_num(0)
 			{
-			}
-
-			bool isQueued(Ty _handle)
-			{
-				for (uint32_t ii = 0, num = m_num; ii < num; ++ii)
-				{
-					if (m_queue[ii].idx == _handle.idx)
-					{
-						return true;
-					}
-				}
-
-				return false;
+				bx::memSet(m_queued, 0, sizeof(m_queued) );
 			}
 
 			bool queue(Ty _handle)
 			{
 				if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
 				{
-					if (isQueued(_handle) )
+					// Handles can be queued from multiple threads, per handle bit
+					// is set atomically so that the same handle can't be queued
+					// twice, even when its slot in queue is not written yet.
+					volatile uint32_t* word = &m_queued[_handle.idx/32];
+					const uint32_t mask = UINT32_C(1) << (_handle.idx%32);
+
+					for (uint32_t queued = *word;;)
 					{
-						return false;
+						if (0 != (queued & mask) )
+						{
+							return false;
+						}
+
+						const uint32_t prev = bx::atomicCompareAndSwap<uint32_t>(word, queued, queued | mask);
+						if (prev == queued)
+						{
+							break;
+						}
+
+						queued = prev;
 					}
 				}
 
-				m_queue[m_num] = _handle;
-				++m_num;
+				// Handles can be queued from multiple threads.
+				const uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&m_num, 1);
+				m_queue[idx] = _handle;
 
 				return true;
 			}
 
 			void reset()
 			{
+				if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
+				{
+					bx::memSet(m_queued, 0, sizeof(m_queued) );
+				}
+
 				m_num = 0;
 			}
 
@@ -2417,11 +3009,12 @@ namespace bgfx
 
 			uint16_t getNumQueued() const
 			{
-				return m_num;
+				return uint16_t(m_num);
 			}
 
 			Ty m_queue[Max];
-			uint16_t m_num;
+			uint32_t m_queued[(Max+31)/32];
+			uint32_t m_num;
 		};
 
 		FreeHandle<IndexBufferHandle,  BGFX_CONFIG_MAX_INDEX_BUFFERS>  m_freeIndexBuffer;
@@ -2437,6 +3030,7 @@ namespace bgfx
 
 		Stats     m_perfStats;
 		ViewStats m_viewStats[BGFX_CONFIG_MAX_VIEWS];
+		PipelineStats m_pipelineStats[BGFX_CONFIG_MAX_PIPELINE_STATS];
 
 		int64_t m_waitSubmit;
 		int64_t m_waitRender;
@@ -2458,6 +3052,42 @@ namespace bgfx
 			bx::memSet(&m_bind, 0, sizeof(m_bind));
 
 			discard(BGFX_DISCARD_ALL);
+
+			m_runIdx       = 0;
+			m_runBegin     = 0;
+			m_runPos       = 0;
+			m_runEnd       = 0;
+			m_runSortedEnd = 0;
+			m_runSize      = BGFX_CONFIG_MIN_SORT_RUN_SIZE;
+			m_runLastKey   = 0;
+
+			bx::memSet(m_runViewStamp, 0, sizeof(m_runViewStamp) );
+			m_runStamp        = 1;
+			m_runNumViews     = 0;
+			m_runViewsInOrder = true;
+
+			m_runTempKeys   = NULL;
+			m_runTempValues = NULL;
+			m_runTempSize   = 0;
+
+			bx::memSet(m_uniformShadow, 0, sizeof(m_uniformShadow) );
+			m_uniformShadowGen = 0;
+			m_numUniformDedup  = 0;
+
+			m_transientVbChunk.m_offset = 0;
+			m_transientVbChunk.m_end    = 0;
+			m_transientIbChunk.m_offset = 0;
+			m_transientIbChunk.m_end    = 0;
+			m_transientVbWasted = 0;
+			m_transientIbWasted = 0;
+
+			m_drawList.idx = kInvalidHandle;
+		}
+
+		~EncoderImpl()
+		{
+			bx::free(g_allocator, m_runTempKeys);
+			bx::free(g_allocator, m_runTempValues);
 		}
 
 		void begin(Frame* _frame, uint8_t _idx)
@@ -2475,10 +3105,43 @@ namespace bgfx
 
 			m_numSubmitted = 0;
 			m_numDropped   = 0;
+
+			m_waitBeginTime   = 0;
+			m_numBeginRetries = 0;
+
+			m_numUniformDedup = 0;
+			++m_uniformShadowGen;
+
+			m_transientVbChunk.m_offset = 0;
+			m_transientVbChunk.m_end    = 0;
+			m_transientIbChunk.m_offset = 0;
+			m_transientIbChunk.m_end    = 0;
+			m_transientVbWasted = 0;
+			m_transientIbWasted = 0;
+
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_vertexLayoutCache); ++ii)
+			{
+				m_vertexLayoutCache[ii].m_handle.idx = kInvalidHandle;
+			}
+
+			m_runIdx       = 0;
+			m_runBegin     = 0;
+			m_runPos       = 0;
+			m_runEnd       = 0;
+			m_runSortedEnd = 0;
+			m_runSize      = BGFX_CONFIG_MIN_SORT_RUN_SIZE;
+			m_runLastKey   = 0;
+			resetRunViews();
 		}
 
 		void end(bool _finalize)
 		{
+			BX_ASSERT(!isValid(m_drawList), "Draw list recording must end before encoder ends (draw list %d).", m_drawList.idx);
+
+			finishRun();
+			retireTransientChunk(m_transientVbChunk, &m_frame->m_vboffset, m_transientVbWasted);
+			retireTransientChunk(m_transientIbChunk, &m_frame->m_iboffset, m_transientIbWasted);
+
 			if (_finalize)
 			{
 				UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
@@ -2500,7 +3163,6 @@ namespace bgfx
 
 		void setMarker(const bx::StringView& _name)
 		{
-			UniformBuffer::update(&m_frame->m_uniformBuffer[m_uniformIdx]);
 			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
 			uniformBuffer->writeMarker(_name);
 		}
@@ -2517,9 +3179,28 @@ namespace bgfx
 //				m_uniformSet.insert(_handle.idx);
 			}
 
-			UniformBuffer::update(&m_frame->m_uniformBuffer[m_uniformIdx]);
 			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
-			uniformBuffer->writeUniform(_type, _handle.idx, _value, _num);
+			const uint32_t size = g_uniformTypeSize[_type]*_num;
+			const uint32_t hash = bx::hash<bx::HashMurmur2A>(_value, size);
+
+			// When value is same as the last one written for this uniform in this frame,
+			// only reference to already written data is added to uniform stream. Write
+			// can't be skipped entirely since draw calls are reordered before rendering.
+			UniformShadow& shadow = m_uniformShadow[_handle.idx];
+			if (m_uniformShadowGen == shadow.m_gen
+			&&  hash == shadow.m_hash
+			&&  size == shadow.m_size
+			&&  0    == bx::memCmp(uniformBuffer->getData(shadow.m_pos), _value, size) )
+			{
+				uniformBuffer->writeUniformRef(_type, _handle.idx, shadow.m_pos, _num);
+				++m_numUniformDedup;
+				return;
+			}
+
+			shadow.m_gen  = m_uniformShadowGen;
+			shadow.m_hash = hash;
+			shadow.m_size = size;
+			shadow.m_pos  = uniformBuffer->writeUniform(_type, _handle.idx, _value, _num);
 		}
 
 		void setState(uint64_t _state, uint32_t _rgba)
@@ -2792,6 +3473,16 @@ namespace bgfx
 		}
 
 		void submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, uint8_t _flags);
+		void submitBatch(ViewId _id, ProgramHandle _program, const BatchDraw* _draws, uint32_t _num, uint8_t _flags);
+
+		void beginDrawList(DrawListHandle _handle);
+		void endDrawList();
+		void addDrawListRef(DrawListRef::Enum _type, uint16_t _idx);
+		void submit(ViewId _id, DrawListHandle _handle, const void* _mtx, uint16_t _num);
+
+		void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32);
+		void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexLayout& _layout);
+		void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride);
 
 		void submit(ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint32_t _start, uint32_t _num, uint32_t _depth, uint8_t _flags)
 		{
@@ -2821,6 +3512,50 @@ namespace bgfx
 
 		void blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth);
 
+		uint32_t allocRenderItem(uint32_t _max);
+		void finishRun();
+		void updateNumVertices();
+		bool isRecordable() const;
+		void record(ProgramHandle _program, uint32_t _depth, uint8_t _flags);
+
+		void setSortKey(uint32_t _renderItemIdx, uint64_t _key)
+		{
+			m_frame->m_sortKeys[_renderItemIdx]   = _key;
+			m_frame->m_sortValues[_renderItemIdx] = RenderItemCount(_renderItemIdx);
+
+			// Track how much of the run is already in order. Only out of order tail
+			// of the run is sorted when run is finished.
+			if (m_runSortedEnd == _renderItemIdx
+			&&  m_runLastKey   <= _key)
+			{
+				m_runSortedEnd = _renderItemIdx+1;
+				m_runLastKey   = _key;
+			}
+
+			// Track order within each view too. Views are often submitted
+			// interleaved, while draws within each view are in order. Such run
+			// is sorted with single stable pass over view bits.
+			const ViewId view = ViewId(_key >> kSortKeyViewBitShift);
+			if (m_runStamp != m_runViewStamp[view])
+			{
+				m_runViewStamp[view]   = m_runStamp;
+				m_runViewLastKey[view] = _key;
+				m_runViewCount[view]   = 0;
+				m_runView[m_runNumViews++] = view;
+			}
+
+			m_runViewsInOrder &= m_runViewLastKey[view] <= _key;
+			m_runViewLastKey[view] = _key;
+			++m_runViewCount[view];
+		}
+
+		void resetRunViews()
+		{
+			++m_runStamp;
+			m_runNumViews     = 0;
+			m_runViewsInOrder = true;
+		}
+
 		Frame* m_frame;
 
 		SortKey m_key;
@@ -2844,6 +3579,73 @@ namespace bgfx
 
 		int64_t m_cpuTimeBegin;
 		int64_t m_cpuTimeEnd;
+
+		int64_t  m_waitBeginTime;
+		uint32_t m_numBeginRetries;
+
+		// Last value written per uniform in current frame's uniform stream.
+		struct UniformShadow
+		{
+			uint32_t m_gen;
+			uint32_t m_hash;
+			uint32_t m_size;
+			uint32_t m_pos;
+		};
+
+		UniformShadow m_uniformShadow[BGFX_CONFIG_MAX_UNIFORMS];
+		uint32_t m_uniformShadowGen;
+		uint32_t m_numUniformDedup;
+
+		// Range of frame's transient buffer reserved by encoder, and not yet
+		// sub-allocated.
+		struct TransientChunk
+		{
+			uint32_t m_offset;
+			uint32_t m_end;
+		};
+
+		uint32_t allocTransient(TransientChunk& _chunk, uint32_t* _frameOffset, uint32_t* _frameOverflow, uint32_t _max, uint32_t& _num, uint16_t _stride, uint32_t& _wasted);
+		void retireTransientChunk(TransientChunk& _chunk, uint32_t* _frameOffset, uint32_t& _wasted);
+		VertexLayoutHandle findVertexLayout(const VertexLayout& _layout);
+
+		TransientChunk m_transientVbChunk;
+		TransientChunk m_transientIbChunk;
+		uint32_t m_transientVbWasted;
+		uint32_t m_transientIbWasted;
+
+		// Vertex layout handles looked up by this encoder in current frame.
+		struct VertexLayoutCache
+		{
+			uint32_t m_hash;
+			VertexLayoutHandle m_handle;
+		};
+
+		VertexLayoutCache m_vertexLayoutCache[8];
+
+		uint32_t m_runIdx;
+		uint32_t m_runBegin;
+		uint32_t m_runPos;
+		uint32_t m_runEnd;
+		uint32_t m_runSortedEnd;
+		uint32_t m_runSize;
+		uint64_t m_runLastKey;
+
+		// Per view order tracking of current run. View entries are valid only
+		// when their stamp matches run stamp.
+		uint64_t m_runViewLastKey[BGFX_CONFIG_MAX_VIEWS];
+		uint32_t m_runViewCount[BGFX_CONFIG_MAX_VIEWS];
+		uint32_t m_runViewStamp[BGFX_CONFIG_MAX_VIEWS];
+		ViewId   m_runView[BGFX_CONFIG_MAX_VIEWS];
+		uint32_t m_runStamp;
+		uint32_t m_runNumViews;
+		bool     m_runViewsInOrder;
+
+		DrawListHandle m_drawList;
+
+		// Scratch used to sort run, grows to the largest run encoder has sorted.
+		uint64_t*        m_runTempKeys;
+		RenderItemCount* m_runTempValues;
+		uint32_t         m_runTempSize;
 	};
 
 	struct VertexLayoutRef
@@ -2943,7 +3745,12 @@ namespace bgfx
 		VertexLayoutHandle m_dynamicVertexBufferRef[BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS];
 	};
 
-	// First-fit non-local allocator.
+	// Two-level segregated-fit (TLSF) allocator for memory that is not
+	// directly accessible by CPU. Allocation and free are O(1), and free
+	// blocks are coalesced with their neighbours immediately.
+	//
+	// Each region added with `add` is managed separately, blocks are never
+	// coalesced across regions.
 	class NonLocalAllocator
 	{
 	public:
@@ -2951,6 +3758,7 @@ namespace bgfx
 
 		NonLocalAllocator()
 		{
+			reset();
 		}
 
 		~NonLocalAllocator()
@@ -2959,113 +3767,342 @@ namespace bgfx
 
 		void reset()
 		{
-			m_free.clear();
+			m_block.clear();
 			m_used.clear();
+
+			m_freeBlock   = kInvalidIndex;
+			m_flBitmap    = 0;
+			m_freeSize    = 0;
+			m_usedSize    = 0;
+			m_numFree     = 0;
+			bx::memSet(m_slBitmap, 0, sizeof(m_slBitmap) );
+			bx::memSet(m_head, 0xff, sizeof(m_head) );
 		}
 
 		void add(uint64_t _ptr, uint32_t _size)
 		{
-			m_free.push_back(Free(_ptr, _size) );
+			BX_ASSERT(_size >= kMinBlockSize, "Region is too small (size %d, min %d).", _size, kMinBlockSize);
+
+			const uint32_t idx = allocBlock();
+			Block& block = m_block[idx];
+			block.m_ptr      = _ptr;
+			block.m_size     = _size;
+			block.m_prevPhys = kInvalidIndex;
+			block.m_nextPhys = kInvalidIndex;
+			insertFree(idx);
 		}
 
 		uint64_t remove()
 		{
-			BX_ASSERT(0 == m_used.size(), "");
+			BX_ASSERT(m_used.empty(), "");
 
-			if (0 < m_free.size() )
+			if (0 != m_flBitmap)
 			{
-				Free freeBlock = m_free.front();
-				m_free.pop_front();
-				return freeBlock.m_ptr;
+				const uint32_t fl  = bx::uint32_cnttz(m_flBitmap);
+				const uint32_t sl  = bx::uint32_cnttz(m_slBitmap[fl]);
+				const uint32_t idx = m_head[fl][sl];
+
+				const uint64_t ptr = m_block[idx].m_ptr;
+				removeFree(idx);
+				freeBlock(idx);
+
+				return ptr;
 			}
 
-			return 0;
+			return kInvalidBlock;
 		}
 
 		uint64_t alloc(uint32_t _size)
 		{
-			_size = bx::max(_size, 16u);
+			_size = bx::max(_size, kMinBlockSize);
 
-			for (FreeList::iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
+			const uint32_t idx = findFree(_size);
+			if (kInvalidIndex == idx)
 			{
-				if (it->m_size >= _size)
-				{
-					uint64_t ptr = it->m_ptr;
+				// there is no block large enough.
+				return kInvalidBlock;
+			}
 
-					m_used.insert(stl::make_pair(ptr, _size) );
+			removeFree(idx);
 
-					if (it->m_size != _size)
-					{
-						it->m_size -= _size;
-						it->m_ptr  += _size;
-					}
-					else
-					{
-						m_free.erase(it);
-					}
+			const uint32_t remainder = m_block[idx].m_size - _size;
+			if (remainder >= kMinBlockSize)
+			{
+				const uint32_t split = allocBlock();
+				Block& block = m_block[idx];
+				Block& next  = m_block[split];
+				next.m_ptr      = block.m_ptr + _size;
+				next.m_size     = remainder;
+				next.m_prevPhys = idx;
+				next.m_nextPhys = block.m_nextPhys;
 
-					return ptr;
+				if (kInvalidIndex != block.m_nextPhys)
+				{
+					m_block[block.m_nextPhys].m_prevPhys = split;
 				}
+
+				block.m_size     = _size;
+				block.m_nextPhys = split;
+				insertFree(split);
 			}
 
-			// there is no block large enough.
-			return kInvalidBlock;
+			const Block& block = m_block[idx];
+			m_usedSize += block.m_size;
+			m_used.insert(stl::make_pair(block.m_ptr, idx) );
+
+			return block.m_ptr;
 		}
 
 		void free(uint64_t _block)
 		{
 			UsedList::iterator it = m_used.find(_block);
-			if (it != m_used.end() )
+			if (it == m_used.end() )
 			{
-				m_free.push_front(Free(it->first, it->second) );
-				m_used.erase(it);
+				return;
 			}
+
+			uint32_t idx = it->second;
+			m_used.erase(it);
+			m_usedSize -= m_block[idx].m_size;
+
+			const uint32_t prev = m_block[idx].m_prevPhys;
+			if (kInvalidIndex != prev
+			&&  m_block[prev].m_free)
+			{
+				removeFree(prev);
+				merge(prev, idx);
+				idx = prev;
+			}
+
+			const uint32_t next = m_block[idx].m_nextPhys;
+			if (kInvalidIndex != next
+			&&  m_block[next].m_free)
+			{
+				removeFree(next);
+				merge(idx, next);
+			}
+
+			insertFree(idx);
+		}
+
+		/// Free blocks are coalesced on free, returns true when there are no
+		/// used blocks, and regions can be removed.
+		bool compact()
+		{
+			return m_used.empty();
+		}
+
+		/// Returns total size of free blocks.
+		uint64_t getFreeSize() const
+		{
+			return m_freeSize;
+		}
+
+		/// Returns total size of used blocks.
+		uint64_t getUsedSize() const
+		{
+			return m_usedSize;
+		}
+
+		/// Returns number of free blocks.
+		uint32_t getNumFreeBlocks() const
+		{
+			return m_numFree;
+		}
+
+		/// Returns size of largest free block.
+		uint32_t getMaxFreeBlock() const
+		{
+			if (0 == m_flBitmap)
+			{
+				return 0;
+			}
+
+			const uint32_t fl = 31 - bx::uint32_cntlz(m_flBitmap);
+			const uint32_t sl = 31 - bx::uint32_cntlz(m_slBitmap[fl]);
+
+			uint32_t maxSize = 0;
+			for (uint32_t idx = m_head[fl][sl]; kInvalidIndex != idx; idx = m_block[idx].m_nextFree)
+			{
+				maxSize = bx::max(maxSize, m_block[idx].m_size);
+			}
+
+			return maxSize;
+		}
+
+	private:
+		static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+		static constexpr uint32_t kSlLog2       = 4;
+		static constexpr uint32_t kNumSl        = 1<<kSlLog2;
+		static constexpr uint32_t kNumFl        = 32;
+		static constexpr uint32_t kMinBlockSize = 1<<kSlLog2;
+
+		struct Block
+		{
+			uint64_t m_ptr;
+			uint32_t m_size;
+			uint32_t m_prevPhys;
+			uint32_t m_nextPhys;
+			uint32_t m_prevFree;
+			uint32_t m_nextFree;
+			bool     m_free;
+		};
+
+		static void mapping(uint32_t _size, uint32_t& _fl, uint32_t& _sl)
+		{
+			_fl = 31 - bx::uint32_cntlz(_size);
+			_sl = (_size >> (_fl - kSlLog2) ) ^ kNumSl;
+		}
+
+		uint32_t findFree(uint32_t _size) const
+		{
+			// Round size up to next list boundary, so that any block in found
+			// list is large enough.
+			const uint64_t size = uint64_t(_size) + (uint64_t(1) << ( (31 - bx::uint32_cntlz(_size) ) - kSlLog2) ) - 1;
+			if (size > UINT32_MAX)
+			{
+				return kInvalidIndex;
+			}
+
+			uint32_t fl, sl;
+			mapping(uint32_t(size), fl, sl);
+
+			uint32_t slMap = m_slBitmap[fl] & (UINT32_MAX << sl);
+			if (0 == slMap)
+			{
+				const uint32_t flMap = fl+1 < kNumFl
+					? m_flBitmap & (UINT32_MAX << (fl+1) )
+					: 0
+					;
+				if (0 == flMap)
+				{
+					return kInvalidIndex;
+				}
+
+				fl    = bx::uint32_cnttz(flMap);
+				slMap = m_slBitmap[fl];
+			}
+
+			sl = bx::uint32_cnttz(slMap);
+
+			return m_head[fl][sl];
+		}
+
+		void insertFree(uint32_t _idx)
+		{
+			Block& block = m_block[_idx];
+
+			uint32_t fl, sl;
+			mapping(block.m_size, fl, sl);
+
+			block.m_free     = true;
+			block.m_prevFree = kInvalidIndex;
+			block.m_nextFree = m_head[fl][sl];
+
+			if (kInvalidIndex != block.m_nextFree)
+			{
+				m_block[block.m_nextFree].m_prevFree = _idx;
+			}
+
+			m_head[fl][sl] = _idx;
+			m_flBitmap    |= 1u<<fl;
+			m_slBitmap[fl] |= 1u<<sl;
+
+			m_freeSize += block.m_size;
+			++m_numFree;
+		}
+
+		void removeFree(uint32_t _idx)
+		{
+			Block& block = m_block[_idx];
+
+			uint32_t fl, sl;
+			mapping(block.m_size, fl, sl);
+
+			if (kInvalidIndex != block.m_prevFree)
+			{
+				m_block[block.m_prevFree].m_nextFree = block.m_nextFree;
+			}
+			else
+			{
+				m_head[fl][sl] = block.m_nextFree;
+
+				if (kInvalidIndex == block.m_nextFree)
+				{
+					m_slBitmap[fl] &= ~(1u<<sl);
+
+					if (0 == m_slBitmap[fl])
+					{
+						m_flBitmap &= ~(1u<<fl);
+					}
+				}
+			}
+
+			if (kInvalidIndex != block.m_nextFree)
+			{
+				m_block[block.m_nextFree].m_prevFree = block.m_prevFree;
+			}
+
+			block.m_free = false;
+
+			m_freeSize -= block.m_size;
+			--m_numFree;
 		}
 
-		bool compact()
+		void merge(uint32_t _idx, uint32_t _next)
 		{
-			m_free.sort();
+			Block& block = m_block[_idx];
+			const Block& next = m_block[_next];
 
-			for (FreeList::iterator it = m_free.begin(), next = it, itEnd = m_free.end(); next != itEnd;)
+			block.m_size    += next.m_size;
+			block.m_nextPhys = next.m_nextPhys;
+
+			if (kInvalidIndex != block.m_nextPhys)
 			{
-				if ( (it->m_ptr + it->m_size) == next->m_ptr)
-				{
-					it->m_size += next->m_size;
-					next = m_free.erase(next);
-				}
-				else
-				{
-					it = next;
-					++next;
-				}
+				m_block[block.m_nextPhys].m_prevPhys = _idx;
 			}
 
-			return 0 == m_used.size();
+			freeBlock(_next);
 		}
 
-	private:
-		struct Free
+		uint32_t allocBlock()
 		{
-			Free(uint64_t _ptr, uint32_t _size)
-				: m_ptr(_ptr)
-				, m_size(_size)
+			uint32_t idx = m_freeBlock;
+			if (kInvalidIndex != idx)
 			{
+				m_freeBlock = m_block[idx].m_nextFree;
 			}
-
-			bool operator<(const Free& rhs) const
+			else
 			{
-				return m_ptr < rhs.m_ptr;
+				idx = uint32_t(m_block.size() );
+				m_block.push_back(Block() );
 			}
 
-			uint64_t m_ptr;
-			uint32_t m_size;
-		};
+			m_block[idx].m_free = false;
+
+			return idx;
+		}
 
-		typedef stl::list<Free> FreeList;
-		FreeList m_free;
+		void freeBlock(uint32_t _idx)
+		{
+			m_block[_idx].m_nextFree = m_freeBlock;
+			m_freeBlock = _idx;
+		}
+
+		typedef stl::vector<Block> BlockArray;
+		BlockArray m_block;
+		uint32_t   m_freeBlock;
 
 		typedef stl::unordered_map<uint64_t, uint32_t> UsedList;
 		UsedList m_used;
+
+		uint32_t m_flBitmap;
+		uint32_t m_slBitmap[kNumFl];
+		uint32_t m_head[kNumFl][kNumSl];
+
+		uint64_t m_freeSize;
+		uint64_t m_usedSize;
+		uint32_t m_numFree;
 	};
 
 	struct BX_NO_VTABLE RendererContextI
@@ -3106,6 +4143,7 @@ namespace bgfx
 		virtual void createUniform(UniformHandle _handle, UniformType::Enum _type, uint16_t _num, const char* _name) = 0;
 		virtual void destroyUniform(UniformHandle _handle) = 0;
 		virtual void requestScreenShot(FrameBufferHandle _handle, const char* _filePath) = 0;
+		virtual void replayPipelineManifest() = 0;
 		virtual void updateViewName(ViewId _id, const char* _name) = 0;
 		virtual void updateUniform(uint16_t _loc, const void* _data, uint32_t _size) = 0;
 		virtual void invalidateOcclusionQuery(OcclusionQueryHandle _handle) = 0;
@@ -3122,6 +4160,111 @@ namespace bgfx
 
 	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
 
+	// Picks transient buffer size from per frame demand (used + overflow).
+	// Buffer grows as soon as demand exceeds its size, and shrinks only after
+	// demand stays low for BGFX_CONFIG_TRANSIENT_BUFFER_SHRINK_FRAMES frames.
+	struct TransientBufferSizer
+	{
+		void init(uint32_t _size, uint32_t _maxSize)
+		{
+			m_size    = _size;
+			m_minSize = _size;
+			m_maxSize = bx::max<uint32_t>(_size, _maxSize);
+			m_peak    = 0;
+			m_numLow  = 0;
+		}
+
+		bool isAdaptive() const
+		{
+			return m_minSize != m_maxSize;
+		}
+
+		uint32_t update(uint32_t _demand)
+		{
+			if (_demand > m_size)
+			{
+				m_size   = calcSize(_demand + _demand/2);
+				m_peak   = 0;
+				m_numLow = 0;
+			}
+			else if (m_size > m_minSize
+			&&       _demand < m_size/4)
+			{
+				m_peak = bx::max<uint32_t>(m_peak, _demand);
+
+				if (++m_numLow >= BGFX_CONFIG_TRANSIENT_BUFFER_SHRINK_FRAMES)
+				{
+					m_size   = calcSize(m_peak*2);
+					m_peak   = 0;
+					m_numLow = 0;
+				}
+			}
+			else
+			{
+				m_peak   = 0;
+				m_numLow = 0;
+			}
+
+			return m_size;
+		}
+
+		uint32_t calcSize(uint32_t _size) const
+		{
+			const uint32_t size = bx::alignUp(_size, BGFX_CONFIG_TRANSIENT_BUFFER_CHUNK_SIZE);
+			return bx::clamp<uint32_t>(size, m_minSize, m_maxSize);
+		}
+
+		uint32_t m_size;
+		uint32_t m_minSize;
+		uint32_t m_maxSize;
+		uint32_t m_peak;
+		uint32_t m_numLow;
+	};
+
+	// Shared by all chunks of one asynchronous upload. Original memory is
+	// released when the queue and all chunks issued to render thread are done
+	// with it.
+	struct AsyncUploadMemory
+	{
+		const Memory* m_mem;
+		int32_t m_refCount;
+	};
+
+	struct AsyncUpload
+	{
+		enum Enum
+		{
+			Texture,
+			DynamicVertexBuffer,
+			Cancelled,
+
+			Count
+		};
+
+		AsyncUploadMemory* m_memory;
+		uint32_t m_fence;
+		uint32_t m_size;
+		uint32_t m_offset;
+		uint16_t m_handle;
+		uint8_t  m_type;
+
+		// Texture uploads are split into bands of rows. Compressed textures
+		// are uploaded as single row of m_height pixels.
+		uint8_t  m_mip;
+		uint16_t m_layer;
+		uint16_t m_x;
+		uint16_t m_y;
+		uint16_t m_width;
+		uint16_t m_height;
+		uint16_t m_pitch;
+		uint32_t m_rowPitch;
+		uint32_t m_numRows;
+		uint32_t m_row;
+
+		// Dynamic vertex buffer uploads are split into byte ranges.
+		uint32_t m_startOffset;
+	};
+
 #if BGFX_CONFIG_DEBUG
 #	define BGFX_API_FUNC(_func) BX_NO_INLINE _func
 #else
@@ -3133,8 +4276,9 @@ namespace bgfx
 		static constexpr uint32_t kAlignment = 64;
 
 		Context()
-			: m_render(&m_frame[0])
-			, m_submit(&m_frame[BGFX_CONFIG_MULTITHREADED ? 1 : 0])
+			: m_frame(NULL)
+			, m_render(NULL)
+			, m_submit(NULL)
 			, m_numFreeDynamicIndexBufferHandles(0)
 			, m_numFreeDynamicVertexBufferHandles(0)
 			, m_numFreeOcclusionQueryHandles(0)
@@ -3171,14 +4315,48 @@ namespace bgfx
 		bool init(const Init& _init);
 		void shutdown();
 
-		CommandBuffer& getCommandBuffer(CommandBuffer::Enum _cmd)
+		Frame* nextSubmitFrame()
 		{
-			CommandBuffer& cmdbuf = _cmd < CommandBuffer::End ? m_submit->m_cmdPre : m_submit->m_cmdPost;
-			uint8_t cmd = (uint8_t)_cmd;
-			cmdbuf.write(cmd);
-			return cmdbuf;
+			return &m_frame[(m_submitIdx + 1) % m_numFrames];
 		}
 
+		CommandBuffer& getCommandBuffer(CommandBuffer::Enum _cmd);
+
+		// Resource create, update and destroy functions run without resource
+		// API lock. Shared state they touch is guarded by smaller locks per
+		// resource type (vertex layouts, dynamic buffers, textures, shaders,
+		// async uploads). Their commands are recorded into calling thread's
+		// resource command buffer. While frame is swapped they fall back to
+		// resource API lock. Functions running without resource API lock
+		// must never take it.
+		uint32_t resourceApiBegin();
+		void resourceApiEnd(uint32_t _idx);
+
+		struct ResourceApiScope
+		{
+			ResourceApiScope(Context* _ctx)
+				: m_ctx(_ctx)
+				, m_idx(_ctx->resourceApiBegin() )
+			{
+			}
+
+			~ResourceApiScope()
+			{
+				m_ctx->resourceApiEnd(m_idx);
+			}
+
+			Context* m_ctx;
+			uint32_t m_idx;
+		};
+
+		void mergeResourceCommands();
+
+		uint32_t asyncUploadPush(AsyncUpload& _upload, const Memory* _mem);
+		void asyncUploadCancel(AsyncUpload::Enum _type, uint16_t _handle);
+		uint32_t asyncUploadIssue(AsyncUpload& _upload, uint32_t _budget, bool _force);
+		void asyncUploadProcess(Frame* _frame);
+		void asyncUploadShutdown();
+
 		BGFX_API_FUNC(void reset(uint32_t _width, uint32_t _height, uint32_t _flags, TextureFormat::Enum _format) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -3323,12 +4501,24 @@ namespace bgfx
 			stats.textureMemoryUsed = m_textureMemoryUsed;
 			stats.rtMemoryUsed      = m_rtMemoryUsed;
 
+			BGFX_MUTEX_SCOPE(m_dynamicBufferLock);
+			stats.dynamicIbFree       = int64_t(m_dynIndexBufferAllocator.getFreeSize() );
+			stats.dynamicIbFreeMax    = m_dynIndexBufferAllocator.getMaxFreeBlock();
+			stats.dynamicIbFreeBlocks = m_dynIndexBufferAllocator.getNumFreeBlocks();
+			stats.dynamicVbFree       = int64_t(m_dynVertexBufferAllocator.getFreeSize() );
+			stats.dynamicVbFreeMax    = m_dynVertexBufferAllocator.getMaxFreeBlock();
+			stats.dynamicVbFreeBlocks = m_dynVertexBufferAllocator.getNumFreeBlocks();
+
+			stats.uploadPending     = m_asyncUploadNum;
+			stats.uploadPendingSize = m_asyncUploadPendingSize;
+			stats.uploadSize        = m_asyncUploadSizeLast;
+
 			return &stats;
 		}
 
 		BGFX_API_FUNC(IndexBufferHandle createIndexBuffer(const Memory* _mem, uint16_t _flags) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
 
 			IndexBufferHandle handle = { m_indexBufferHandle.alloc() };
 
@@ -3368,8 +4558,12 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyIndexBuffer(IndexBufferHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			destroyIndexBufferImpl(_handle);
+		}
 
+		void destroyIndexBufferImpl(IndexBufferHandle _handle)
+		{
 			BGFX_CHECK_HANDLE("destroyIndexBuffer", m_indexBufferHandle, _handle);
 			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
 			BX_ASSERT(ok, "Index buffer handle %d is already destroyed!", _handle.idx);
@@ -3412,6 +4606,7 @@ namespace bgfx
 		BGFX_API_FUNC(VertexLayoutHandle createVertexLayout(const VertexLayout& _layout) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_vertexLayoutLock);
 
 			VertexLayoutHandle handle = findOrCreateVertexLayout(_layout);
 			if (!isValid(handle) )
@@ -3427,6 +4622,8 @@ namespace bgfx
 		BGFX_API_FUNC(void destroyVertexLayout(VertexLayoutHandle _handle) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_vertexLayoutLock);
+
 			if (isValid(m_vertexLayoutRef.release(_handle) ) )
 			{
 				m_submit->free(_handle);
@@ -3435,21 +4632,26 @@ namespace bgfx
 
 		BGFX_API_FUNC(VertexBufferHandle createVertexBuffer(const Memory* _mem, const VertexLayout& _layout, uint16_t _flags) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
 
 			VertexBufferHandle handle = { m_vertexBufferHandle.alloc() };
 
 			if (isValid(handle) )
 			{
-				VertexLayoutHandle layoutHandle = findOrCreateVertexLayout(_layout);
-				if (!isValid(layoutHandle) )
+				VertexLayoutHandle layoutHandle;
 				{
-					BX_TRACE("WARNING: Failed to allocate vertex layout handle (BGFX_CONFIG_MAX_VERTEX_LAYOUTS, max: %d).", BGFX_CONFIG_MAX_VERTEX_LAYOUTS);
-					m_vertexBufferHandle.free(handle.idx);
-					return BGFX_INVALID_HANDLE;
-				}
+					BGFX_MUTEX_SCOPE(m_vertexLayoutLock);
+
+					layoutHandle = findOrCreateVertexLayout(_layout);
+					if (!isValid(layoutHandle) )
+					{
+						BX_TRACE("WARNING: Failed to allocate vertex layout handle (BGFX_CONFIG_MAX_VERTEX_LAYOUTS, max: %d).", BGFX_CONFIG_MAX_VERTEX_LAYOUTS);
+						m_vertexBufferHandle.free(handle.idx);
+						return BGFX_INVALID_HANDLE;
+					}
 
-				m_vertexLayoutRef.add(handle, layoutHandle, _layout.m_hash);
+					m_vertexLayoutRef.add(handle, layoutHandle, _layout.m_hash);
+				}
 
 				VertexBuffer& vb = m_vertexBuffers[handle.idx];
 				vb.m_size   = _mem->size;
@@ -3486,8 +4688,12 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyVertexBuffer(VertexBufferHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			destroyVertexBufferImpl(_handle);
+		}
 
+		void destroyVertexBufferImpl(VertexBufferHandle _handle)
+		{
 			BGFX_CHECK_HANDLE("destroyVertexBuffer", m_vertexBufferHandle, _handle);
 			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
 			BX_ASSERT(ok, "Vertex buffer handle %d is already destroyed!", _handle.idx);
@@ -3501,14 +4707,17 @@ namespace bgfx
 
 		void destroyVertexBufferInternal(VertexBufferHandle _handle)
 		{
+			BGFX_MUTEX_SCOPE(m_vertexLayoutLock);
+
 			VertexLayoutHandle layoutHandle = m_vertexLayoutRef.release(_handle);
 			if (isValid(layoutHandle) )
 			{
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexLayout);
 				cmdbuf.write(layoutHandle);
-				m_render->free(layoutHandle);
+				nextSubmitFrame()->free(layoutHandle);
 			}
 
+			++m_drawListRefGen[DrawListRef::VertexBuffer][_handle.idx];
 			m_vertexBufferHandle.free(_handle.idx);
 		}
 
@@ -3565,7 +4774,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(DynamicIndexBufferHandle createDynamicIndexBuffer(uint32_t _num, uint16_t _flags) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_dynamicBufferLock);
 
 			DynamicIndexBufferHandle handle = { m_dynamicIndexBufferHandle.alloc() };
 			if (!isValid(handle) )
@@ -3600,7 +4810,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(DynamicIndexBufferHandle createDynamicIndexBuffer(const Memory* _mem, uint16_t _flags) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_dynamicBufferLock);
 
 			BX_ASSERT(0 == (_flags & BGFX_BUFFER_COMPUTE_WRITE), "Can't initialize compute write buffer from CPU.");
 
@@ -3620,7 +4831,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(void update(DynamicIndexBufferHandle _handle, uint32_t _startIndex, const Memory* _mem) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_dynamicBufferLock);
 
 			BGFX_CHECK_HANDLE("updateDynamicIndexBuffer", m_dynamicIndexBufferHandle, _handle);
 
@@ -3662,7 +4874,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyDynamicIndexBuffer(DynamicIndexBufferHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_dynamicBufferLock);
 
 			BGFX_CHECK_HANDLE("destroyDynamicIndexBuffer", m_dynamicIndexBufferHandle, _handle);
 
@@ -3673,17 +4886,17 @@ namespace bgfx
 		{
 			if (0 != (_dib.m_flags & BGFX_BUFFER_COMPUTE_READ_WRITE) )
 			{
-				destroyIndexBuffer(_dib.m_handle);
+				destroyIndexBufferImpl(_dib.m_handle);
 			}
 			else
 			{
 				m_dynIndexBufferAllocator.free(uint64_t(_dib.m_handle.idx) << 32 | _dib.m_offset);
 				if (m_dynIndexBufferAllocator.compact() )
 				{
-					for (uint64_t ptr = m_dynIndexBufferAllocator.remove(); 0 != ptr; ptr = m_dynIndexBufferAllocator.remove() )
+					for (uint64_t ptr = m_dynIndexBufferAllocator.remove(); NonLocalAllocator::kInvalidBlock != ptr; ptr = m_dynIndexBufferAllocator.remove() )
 					{
 						IndexBufferHandle handle = { uint16_t(ptr >> 32) };
-						destroyIndexBuffer(handle);
+						destroyIndexBufferImpl(handle);
 					}
 				}
 			}
@@ -3694,6 +4907,7 @@ namespace bgfx
 			DynamicIndexBuffer& dib = m_dynamicIndexBuffers[_handle.idx];
 			destroy(dib);
 			dib.reset();
+			++m_drawListRefGen[DrawListRef::DynamicIndexBuffer][_handle.idx];
 			m_dynamicIndexBufferHandle.free(_handle.idx);
 		}
 
@@ -3753,7 +4967,9 @@ namespace bgfx
 
 		BGFX_API_FUNC(DynamicVertexBufferHandle createDynamicVertexBuffer(uint32_t _num, const VertexLayout& _layout, uint16_t _flags) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_dynamicBufferLock);
+			BGFX_MUTEX_SCOPE(m_vertexLayoutLock);
 
 			VertexLayoutHandle layoutHandle = findOrCreateVertexLayout(_layout);
 			if (!isValid(layoutHandle) )
@@ -3798,7 +5014,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(DynamicVertexBufferHandle createDynamicVertexBuffer(const Memory* _mem, const VertexLayout& _layout, uint16_t _flags) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_dynamicBufferLock);
 
 			BX_ASSERT(0 == (_flags & BGFX_BUFFER_COMPUTE_WRITE), "Can't initialize compute write buffer from CPU.");
 
@@ -3818,36 +5035,74 @@ namespace bgfx
 
 		BGFX_API_FUNC(void update(DynamicVertexBufferHandle _handle, uint32_t _startVertex, const Memory* _mem) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_dynamicBufferLock);
 
 			BGFX_CHECK_HANDLE("updateDynamicVertexBuffer", m_dynamicVertexBufferHandle, _handle);
 
 			DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[_handle.idx];
 			BX_ASSERT(0 == (dvb.m_flags & BGFX_BUFFER_COMPUTE_WRITE), "Can't update GPU write buffer from CPU.");
 
-			if (dvb.m_size < _mem->size
-			&&  0 != (dvb.m_flags & BGFX_BUFFER_ALLOW_RESIZE) )
+			resize(dvb, _mem->size);
+			update(dvb, _startVertex*dvb.m_stride, _mem);
+		}
+
+		BGFX_API_FUNC(uint32_t updateAsync(DynamicVertexBufferHandle _handle, uint32_t _startVertex, const Memory* _mem) )
+		{
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_dynamicBufferLock);
+
+			BGFX_CHECK_HANDLE("updateDynamicVertexBufferAsync", m_dynamicVertexBufferHandle, _handle);
+
+			DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[_handle.idx];
+			BX_ASSERT(0 == (dvb.m_flags & BGFX_BUFFER_COMPUTE_WRITE), "Can't update GPU write buffer from CPU.");
+
+			resize(dvb, _mem->size);
+
+			AsyncUpload upload;
+			upload.m_type        = AsyncUpload::DynamicVertexBuffer;
+			upload.m_handle      = _handle.idx;
+			upload.m_startOffset = _startVertex*dvb.m_stride;
+
+			const uint32_t fence = asyncUploadPush(upload, _mem);
+			if (0 == fence)
+			{
+				BX_WARN(false, "Asynchronous upload queue is full, updating dynamic vertex buffer immediately.");
+				update(dvb, upload.m_startOffset, _mem);
+				return asyncUploadPush(upload, NULL);
+			}
+
+			return fence;
+		}
+
+		void resize(DynamicVertexBuffer& _dvb, uint32_t _size)
+		{
+			if (_dvb.m_size < _size
+			&&  0 != (_dvb.m_flags & BGFX_BUFFER_ALLOW_RESIZE) )
 			{
-				destroy(dvb);
+				destroy(_dvb);
 
-				const uint32_t size = bx::strideAlign<16>(_mem->size, dvb.m_stride)+dvb.m_stride;
+				const uint32_t size = bx::strideAlign<16>(_size, _dvb.m_stride)+_dvb.m_stride;
 
-				const uint64_t ptr = (0 != (dvb.m_flags & BGFX_BUFFER_COMPUTE_READ) )
-					? allocVertexBuffer(size, dvb.m_flags)
-					: allocDynamicVertexBuffer(size, dvb.m_flags)
+				const uint64_t ptr = (0 != (_dvb.m_flags & BGFX_BUFFER_COMPUTE_READ) )
+					? allocVertexBuffer(size, _dvb.m_flags)
+					: allocDynamicVertexBuffer(size, _dvb.m_flags)
 					;
 
-				dvb.m_handle.idx  = uint16_t(ptr>>32);
-				dvb.m_offset      = uint32_t(ptr);
-				dvb.m_size        = size;
-				dvb.m_numVertices = _mem->size / dvb.m_stride;
-				dvb.m_startVertex = bx::strideAlign(dvb.m_offset, dvb.m_stride)/dvb.m_stride;
+				_dvb.m_handle.idx  = uint16_t(ptr>>32);
+				_dvb.m_offset      = uint32_t(ptr);
+				_dvb.m_size        = size;
+				_dvb.m_numVertices = _size / _dvb.m_stride;
+				_dvb.m_startVertex = bx::strideAlign(_dvb.m_offset, _dvb.m_stride)/_dvb.m_stride;
 			}
+		}
 
-			const uint32_t offset = (dvb.m_startVertex + _startVertex)*dvb.m_stride;
+		void update(const DynamicVertexBuffer& _dvb, uint32_t _offset, const Memory* _mem)
+		{
+			const uint32_t offset = _dvb.m_startVertex*_dvb.m_stride + _offset;
 			const uint32_t size   = bx::min<uint32_t>(offset
-				+ bx::min(bx::uint32_satsub(dvb.m_size, _startVertex*dvb.m_stride), _mem->size)
-				, m_vertexBuffers[dvb.m_handle.idx].m_size) - offset
+				+ bx::min(bx::uint32_satsub(_dvb.m_size, _offset), _mem->size)
+				, m_vertexBuffers[_dvb.m_handle.idx].m_size) - offset
 				;
 			BX_ASSERT(_mem->size <= size, "Truncating dynamic vertex buffer update (size %d, mem size %d)."
 				, size
@@ -3855,7 +5110,7 @@ namespace bgfx
 				);
 
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicVertexBuffer);
-			cmdbuf.write(dvb.m_handle);
+			cmdbuf.write(_dvb.m_handle);
 			cmdbuf.write(offset);
 			cmdbuf.write(size);
 			cmdbuf.write(_mem);
@@ -3863,10 +5118,13 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyDynamicVertexBuffer(DynamicVertexBufferHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_dynamicBufferLock);
 
 			BGFX_CHECK_HANDLE("destroyDynamicVertexBuffer", m_dynamicVertexBufferHandle, _handle);
 
+			asyncUploadCancel(AsyncUpload::DynamicVertexBuffer, _handle.idx);
+
 			m_freeDynamicVertexBufferHandle[m_numFreeDynamicVertexBufferHandles++] = _handle;
 		}
 
@@ -3874,17 +5132,17 @@ namespace bgfx
 		{
 			if (0 != (_dvb.m_flags & BGFX_BUFFER_COMPUTE_READ_WRITE) )
 			{
-				destroyVertexBuffer(_dvb.m_handle);
+				destroyVertexBufferImpl(_dvb.m_handle);
 			}
 			else
 			{
 				m_dynVertexBufferAllocator.free(uint64_t(_dvb.m_handle.idx) << 32 | _dvb.m_offset);
 				if (m_dynVertexBufferAllocator.compact() )
 				{
-					for (uint64_t ptr = m_dynVertexBufferAllocator.remove(); 0 != ptr; ptr = m_dynVertexBufferAllocator.remove() )
+					for (uint64_t ptr = m_dynVertexBufferAllocator.remove(); NonLocalAllocator::kInvalidBlock != ptr; ptr = m_dynVertexBufferAllocator.remove() )
 					{
 						VertexBufferHandle handle = { uint16_t(ptr >> 32) };
-						destroyVertexBuffer(handle);
+						destroyVertexBufferImpl(handle);
 					}
 				}
 			}
@@ -3892,6 +5150,8 @@ namespace bgfx
 
 		void destroyDynamicVertexBufferInternal(DynamicVertexBufferHandle _handle)
 		{
+			BGFX_MUTEX_SCOPE(m_vertexLayoutLock);
+
 			VertexLayoutHandle layoutHandle = m_vertexLayoutRef.release(_handle);
 			BGFX_CHECK_HANDLE_INVALID_OK("destroyDynamicVertexBufferInternal", m_layoutHandle, layoutHandle);
 
@@ -3899,12 +5159,13 @@ namespace bgfx
 			{
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexLayout);
 				cmdbuf.write(layoutHandle);
-				m_render->free(layoutHandle);
+				nextSubmitFrame()->free(layoutHandle);
 			}
 
 			DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[_handle.idx];
 			destroy(dvb);
 			dvb.reset();
+			++m_drawListRefGen[DrawListRef::DynamicVertexBuffer][_handle.idx];
 			m_dynamicVertexBufferHandle.free(_handle.idx);
 		}
 
@@ -3993,6 +5254,8 @@ namespace bgfx
 
 				if (NULL != _layout)
 				{
+					BGFX_MUTEX_SCOPE(m_vertexLayoutLock);
+
 					layoutHandle = findOrCreateVertexLayout(*_layout);
 					m_vertexLayoutRef.add(handle, layoutHandle, _layout->m_hash);
 
@@ -4095,7 +5358,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(ShaderHandle createShader(const Memory* _mem) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_shaderLock);
 
 			bx::MemoryReader reader(_mem->data, _mem->size);
 
@@ -4255,7 +5519,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(uint16_t getShaderUniforms(ShaderHandle _handle, UniformHandle* _uniforms, uint16_t _max) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_shaderLock);
 
 			if (!isValid(_handle) )
 			{
@@ -4298,7 +5563,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(void setName(ShaderHandle _handle, const bx::StringView& _name) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_shaderLock);
 
 			BGFX_CHECK_HANDLE("setName", m_shaderHandle, _handle);
 
@@ -4310,7 +5576,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyShader(ShaderHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_shaderLock);
 
 			BGFX_CHECK_HANDLE("destroyShader", m_shaderHandle, _handle);
 
@@ -4364,7 +5631,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(ProgramHandle createProgram(ShaderHandle _vsh, ShaderHandle _fsh, bool _destroyShaders) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_shaderLock);
 
 			if (!isValid(_vsh)
 			||  !isValid(_fsh) )
@@ -4425,7 +5693,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(ProgramHandle createProgram(ShaderHandle _vsh, bool _destroyShader) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_shaderLock);
 
 			if (!isValid(_vsh) )
 			{
@@ -4476,7 +5745,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyProgram(ProgramHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_shaderLock);
 
 			BGFX_CHECK_HANDLE("destroyProgram", m_programHandle, _handle);
 
@@ -4503,7 +5773,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(TextureHandle createTexture(const Memory* _mem, uint64_t _flags, uint8_t _skip, TextureInfo* _info, BackbufferRatio::Enum _ratio, bool _immutable) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_textureLock);
 
 			TextureInfo ti;
 			if (NULL == _info)
@@ -4587,7 +5858,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(void setName(TextureHandle _handle, const bx::StringView& _name) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_textureLock);
 			BGFX_CHECK_HANDLE("setName", m_textureHandle, _handle);
 
 			TextureRef& ref = m_textureRef[_handle.idx];
@@ -4613,7 +5885,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyTexture(TextureHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_textureLock);
 
 			BGFX_CHECK_HANDLE("destroyTexture", m_textureHandle, _handle);
 
@@ -4641,7 +5914,7 @@ namespace bgfx
 			cmdbuf.write(_handle);
 			cmdbuf.write(_data);
 			cmdbuf.write(_mip);
-			return m_submit->m_frameNum + 2;
+			return m_submit->m_frameNum + 1 + m_maxFramesInFlight;
 		}
 
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers)
@@ -4669,6 +5942,8 @@ namespace bgfx
 
 		void textureTakeOwnership(TextureHandle _handle)
 		{
+			BGFX_MUTEX_SCOPE(m_textureLock);
+
 			TextureRef& ref = m_textureRef[_handle.idx];
 			if (!ref.m_owned)
 			{
@@ -4679,16 +5954,22 @@ namespace bgfx
 
 		void textureIncRef(TextureHandle _handle)
 		{
+			BGFX_MUTEX_SCOPE(m_textureLock);
+
 			TextureRef& ref = m_textureRef[_handle.idx];
 			++ref.m_refCount;
 		}
 
 		void textureDecRef(TextureHandle _handle)
 		{
+			BGFX_MUTEX_SCOPE(m_textureLock);
+
 			TextureRef& ref = m_textureRef[_handle.idx];
 			int32_t refs = --ref.m_refCount;
 			if (0 == refs)
 			{
+				asyncUploadCancel(AsyncUpload::Texture, _handle.idx);
+
 				ref.m_name.clear();
 
 				if (ref.isRt() )
@@ -4732,6 +6013,23 @@ namespace bgfx
 				return;
 			}
 
+			updateTextureImpl(_handle, _side, _mip, _x, _y, _z, _width, _height, _depth, _pitch, _mem);
+		}
+
+		void updateTextureImpl(
+			  TextureHandle _handle
+			, uint8_t _side
+			, uint8_t _mip
+			, uint16_t _x
+			, uint16_t _y
+			, uint16_t _z
+			, uint16_t _width
+			, uint16_t _height
+			, uint16_t _depth
+			, uint16_t _pitch
+			, const Memory* _mem
+			)
+		{
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateTexture);
 			cmdbuf.write(_handle);
 			cmdbuf.write(_side);
@@ -4748,6 +6046,71 @@ namespace bgfx
 			cmdbuf.write(_mem);
 		}
 
+		BGFX_API_FUNC(uint32_t updateTextureAsync(
+			  TextureHandle _handle
+			, uint16_t _layer
+			, uint8_t _mip
+			, uint16_t _x
+			, uint16_t _y
+			, uint16_t _width
+			, uint16_t _height
+			, uint16_t _pitch
+			, const Memory* _mem
+		) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("updateTexture2DAsync", m_textureHandle, _handle);
+
+			const TextureRef& ref = m_textureRef[_handle.idx];
+			if (ref.m_immutable)
+			{
+				BX_WARN(false, "Can't update immutable texture.");
+				release(_mem);
+				return 0;
+			}
+
+			const bimg::TextureFormat::Enum format = bimg::TextureFormat::Enum(ref.m_format);
+			const uint32_t bpp = bimg::getBitsPerPixel(format);
+
+			AsyncUpload upload;
+			upload.m_type     = AsyncUpload::Texture;
+			upload.m_handle   = _handle.idx;
+			upload.m_mip      = _mip;
+			upload.m_layer    = _layer;
+			upload.m_x        = _x;
+			upload.m_y        = _y;
+			upload.m_width    = _width;
+			upload.m_height   = _height;
+			upload.m_pitch    = _pitch;
+			upload.m_rowPitch = UINT16_MAX == _pitch ? _width*bpp/8 : _pitch;
+			upload.m_numRows  = _height;
+
+			if (bimg::isCompressed(format)
+			||  _mem->size < (_height-1)*upload.m_rowPitch + _width*bpp/8)
+			{
+				upload.m_rowPitch = _mem->size;
+				upload.m_numRows  = 1;
+			}
+
+			const uint32_t fence = asyncUploadPush(upload, _mem);
+			if (0 == fence)
+			{
+				BX_WARN(false, "Asynchronous upload queue is full, updating texture immediately.");
+				updateTextureImpl(_handle, 0, _mip, _x, _y, _layer, _width, _height, 1, _pitch, _mem);
+				return asyncUploadPush(upload, NULL);
+			}
+
+			return fence;
+		}
+
+		BGFX_API_FUNC(bool isUploadComplete(uint32_t _fence) )
+		{
+			// Written by render thread under same lock.
+			BGFX_MUTEX_SCOPE(m_asyncUploadLock);
+			return 0 <= int32_t(m_asyncUploadFenceRendered - _fence);
+		}
+
 		BGFX_API_FUNC(FrameBufferHandle createFrameBuffer(uint8_t _num, const Attachment* _attachment, bool _destroyTextures) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -4889,7 +6252,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(UniformHandle createUniform(const char* _name, UniformType::Enum _type, uint16_t _num) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_shaderLock);
 
 			{
 				bx::ErrorAssert err;
@@ -4970,7 +6334,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(void getUniformInfo(UniformHandle _handle, UniformInfo& _info) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_shaderLock);
 
 			BGFX_CHECK_HANDLE("getUniformInfo", m_uniformHandle, _handle);
 
@@ -4982,7 +6347,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyUniform(UniformHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			ResourceApiScope resourceApiScope(this);
+			BGFX_MUTEX_SCOPE(m_shaderLock);
 
 			BGFX_CHECK_HANDLE("destroyUniform", m_uniformHandle, _handle);
 
@@ -5049,6 +6415,34 @@ namespace bgfx
 			m_freeOcclusionQueryHandle[m_numFreeOcclusionQueryHandles++] = _handle;
 		}
 
+		BGFX_API_FUNC(DrawListHandle createDrawList() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_drawListLock);
+
+			DrawListHandle handle = { m_drawListHandle.alloc() };
+			BX_WARN(isValid(handle), "Failed to allocate draw list handle.");
+
+			if (isValid(handle) )
+			{
+				m_drawList[handle.idx].reset();
+			}
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(void destroyDrawList(DrawListHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_drawListLock);
+
+			BGFX_CHECK_HANDLE("destroyDrawList", m_drawListHandle, _handle);
+			BX_ASSERT(0 == m_drawList[_handle.idx].m_busy, "Draw list %d can't be destroyed while it's being recorded.", _handle.idx);
+
+			m_drawList[_handle.idx].destroy();
+			m_drawListHandle.free(_handle.idx);
+		}
+
 		BGFX_API_FUNC(void requestScreenShot(FrameBufferHandle _handle, const char* _filePath) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -5086,6 +6480,13 @@ namespace bgfx
 			screenShot.filePath.set(_filePath);
 		}
 
+		BGFX_API_FUNC(void replayPipelineManifest() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			getCommandBuffer(CommandBuffer::ReplayPipelineManifest);
+		}
+
 		BGFX_API_FUNC(void setPaletteColor(uint8_t _index, const float _rgba[4]) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -5181,22 +6582,25 @@ namespace bgfx
 
 		BGFX_API_FUNC(uint32_t frame(bool _capture = false) );
 
-		uint32_t getSeqIncr(ViewId _id)
+		uint32_t getSeqIncr(ViewId _id, uint32_t _num = 1)
 		{
-			return bx::atomicFetchAndAdd<uint32_t>(&m_seq[_id], 1);
+			return bx::atomicFetchAndAdd<uint32_t>(&m_seq[_id], _num);
 		}
 
 		void dumpViewStats();
 		void freeDynamicBuffers();
 		void freeAllHandles(Frame* _frame);
 		void frameNoRenderWait();
+		void renderSemWaitAll();
+		void destroyFrames();
+		void resizeTransientBuffers(Frame* _frame);
 		void swap();
 
 		// render thread
 		void flip();
 		RenderFrame::Enum renderFrame(int32_t _msecs = -1);
 		void flushTextureUpdateBatch(CommandBuffer& _cmdbuf);
-		void rendererExecCommands(CommandBuffer& _cmdbuf);
+		int64_t rendererExecCommands(CommandBuffer& _cmdbuf, uint32_t _timePos = UINT32_MAX);
 
 #if BGFX_CONFIG_MULTITHREADED
 		void apiSemPost()
@@ -5219,7 +6623,7 @@ namespace bgfx
 			bool ok = m_apiSem.wait(_msecs);
 			if (ok)
 			{
-				m_render->m_waitSubmit = bx::getHPCounter()-start;
+				m_waitSubmit = bx::getHPCounter()-start;
 				m_submit->m_perfStats.waitSubmit = m_submit->m_waitSubmit;
 				return true;
 			}
@@ -5250,32 +6654,95 @@ namespace bgfx
 
 		void encoderApiWait()
 		{
-			uint16_t numEncoders = m_encoderHandle->getNumHandles();
-
-			for (uint16_t ii = 1; ii < numEncoders; ++ii)
+			// Close encoder API, and wait for encoders that are still in flight.
+			// Only the last encoder to end while API is closed signals semaphore.
+			const uint32_t state = bx::atomicFetchAndAdd<uint32_t>(&m_encoderState, kEncoderApiClosed);
+			if (0 != state)
 			{
 				m_encoderEndSem.wait();
 			}
 
-			for (uint16_t ii = 0; ii < numEncoders; ++ii)
+			const uint32_t numEncoders = m_numEncodersUsed;
+			uint32_t numUniformDedup = 0;
+			uint32_t transientVbWasted = 0;
+			uint32_t transientIbWasted = 0;
+
+			for (uint32_t ii = 0; ii < numEncoders; ++ii)
 			{
-				uint16_t idx = m_encoderHandle->getHandleAt(ii);
-				m_encoderStats[ii].cpuTimeBegin = m_encoder[idx].m_cpuTimeBegin;
-				m_encoderStats[ii].cpuTimeEnd   = m_encoder[idx].m_cpuTimeEnd;
+				const EncoderImpl& encoder = m_encoder[ii];
+				EncoderStats& stats = m_encoderStats[ii];
+				stats.cpuTimeBegin  = encoder.m_cpuTimeBegin;
+				stats.cpuTimeEnd    = encoder.m_cpuTimeEnd;
+				stats.waitBeginTime = encoder.m_waitBeginTime;
+				stats.numRetries    = encoder.m_numBeginRetries;
+				numUniformDedup   += encoder.m_numUniformDedup;
+				transientVbWasted += encoder.m_transientVbWasted;
+				transientIbWasted += encoder.m_transientIbWasted;
 			}
 
+			m_submit->m_perfStats.numUniformDedup   = numUniformDedup;
+			m_submit->m_perfStats.transientVbWasted = int32_t(transientVbWasted);
+			m_submit->m_perfStats.transientIbWasted = int32_t(transientIbWasted);
+
 			m_submit->m_perfStats.numEncoders = uint8_t(numEncoders);
 
-			m_encoderHandle->reset();
-			uint16_t idx = m_encoderHandle->alloc();
-			BX_ASSERT(0 == idx, "Internal encoder handle is not 0 (idx %d).", idx); BX_UNUSED(idx);
+			// Encoder 0 is reserved for API thread.
+			m_numEncodersUsed = 1;
+		}
+
+		void encoderApiResume()
+		{
+			bx::atomicFetchAndSub<uint32_t>(&m_encoderState, kEncoderApiClosed);
+		}
+
+		void encoderApiEnd()
+		{
+			const uint32_t state = bx::atomicFetchAndSub<uint32_t>(&m_encoderState, 1);
+			if (kEncoderApiClosed + 1 == state)
+			{
+				m_encoderEndSem.post();
+			}
+		}
+
+		static constexpr uint32_t kEncoderApiClosed = UINT32_C(1)<<31;
+
+		uint32_t m_encoderState;
+		uint32_t m_numEncodersUsed;
+
+		void resourceApiWait()
+		{
+			// Wait for resource functions running without resource API lock.
+			// New ones will wait on resource API lock until frame is swapped.
+			const uint32_t state = bx::atomicFetchAndAdd<uint32_t>(&m_resourceApiState, kResourceApiClosed);
+			if (0 != state)
+			{
+				m_resourceApiEndSem.wait();
+			}
+		}
+
+		void resourceApiResume()
+		{
+			bx::atomicFetchAndSub<uint32_t>(&m_resourceApiState, kResourceApiClosed);
 		}
 
+		static constexpr uint32_t kResourceApiClosed = UINT32_C(1)<<31;
+		static constexpr uint32_t kResourceApiNested = UINT32_MAX;
+
+		uint32_t m_resourceApiState;
+		bx::Semaphore m_resourceApiEndSem;
+
+		int64_t       m_waitSubmit;
 		bx::Semaphore m_renderSem;
 		bx::Semaphore m_apiSem;
 		bx::Semaphore m_encoderEndSem;
 		bx::Mutex     m_encoderApiLock;
 		bx::Mutex     m_resourceApiLock;
+		bx::Mutex     m_vertexLayoutLock;
+		bx::Mutex     m_dynamicBufferLock;
+		bx::Mutex     m_textureLock;
+		bx::Mutex     m_shaderLock;
+		bx::Mutex     m_asyncUploadLock;
+		bx::Mutex     m_drawListLock;
 		bx::Thread    m_thread;
 #else
 		void apiSemPost()
@@ -5298,9 +6765,26 @@ namespace bgfx
 
 		void encoderApiWait()
 		{
-			m_encoderStats[0].cpuTimeBegin = m_encoder[0].m_cpuTimeBegin;
-			m_encoderStats[0].cpuTimeEnd   = m_encoder[0].m_cpuTimeEnd;
-			m_submit->m_perfStats.numEncoders = 1;
+			m_encoderStats[0].cpuTimeBegin  = m_encoder[0].m_cpuTimeBegin;
+			m_encoderStats[0].cpuTimeEnd    = m_encoder[0].m_cpuTimeEnd;
+			m_encoderStats[0].waitBeginTime = 0;
+			m_encoderStats[0].numRetries    = 0;
+			m_submit->m_perfStats.numEncoders       = 1;
+			m_submit->m_perfStats.numUniformDedup   = m_encoder[0].m_numUniformDedup;
+			m_submit->m_perfStats.transientVbWasted = int32_t(m_encoder[0].m_transientVbWasted);
+			m_submit->m_perfStats.transientIbWasted = int32_t(m_encoder[0].m_transientIbWasted);
+		}
+
+		void encoderApiResume()
+		{
+		}
+
+		void resourceApiWait()
+		{
+		}
+
+		void resourceApiResume()
+		{
 		}
 #endif // BGFX_CONFIG_MULTITHREADED
 
@@ -5308,14 +6792,48 @@ namespace bgfx
 		Encoder*      m_encoder0;
 		EncoderImpl*  m_encoder;
 		uint32_t      m_numEncoders;
-		bx::HandleAlloc* m_encoderHandle;
 
-		Frame  m_frame[1+(BGFX_CONFIG_MULTITHREADED ? 1 : 0)];
-		Frame* m_render;
-		Frame* m_submit;
+		// Frames are used as ring, API thread fills m_submit while render thread
+		// renders up to m_maxFramesInFlight frames submitted before it.
+		Frame*   m_frame;
+		Frame*   m_render;
+		Frame*   m_submit;
+		uint32_t m_numFrames;
+		uint32_t m_submitIdx;
+		uint32_t m_renderIdx;
+		uint32_t m_maxFramesInFlight;
+		uint32_t m_numFramesInFlight;
+
+		// Uniform stream data last applied to renderer per uniform, used by
+		// render thread to skip references to value that is already applied.
+		const char* m_uniformApplied[BGFX_CONFIG_MAX_UNIFORMS];
+
+		TransientBufferSizer m_transientVbSizer;
+		TransientBufferSizer m_transientIbSizer;
+
+		// Resource command buffer 0 is used under resource API lock, others are
+		// claimed by threads running resource functions without lock.
+		ResourceCommandBuffer m_resourceCmd[BGFX_CONFIG_MAX_RESOURCE_COMMAND_BUFFERS];
+		uint32_t m_resourceCmdSeq;
+		uint32_t m_resourceCmdNext;
+
+		// Asynchronous uploads are queued in order, and issued in swap within
+		// per frame size and time budget.
+		AsyncUpload m_asyncUpload[BGFX_CONFIG_MAX_ASYNC_UPLOADS];
+		uint32_t m_asyncUploadHead;
+		uint32_t m_asyncUploadNum;
+		uint32_t m_asyncUploadFence;
+		uint32_t m_asyncUploadFenceRendered;
+		uint32_t m_asyncUploadSeq;
+		uint32_t m_asyncUploadPendingSize;
+		uint32_t m_asyncUploadSizeLast;
+		uint32_t m_asyncUploadBudgetSize;
+		uint32_t m_asyncUploadBudgetTime;
+		int64_t  m_asyncUploadRate;
 
 		uint64_t m_tempKeys[BGFX_CONFIG_MAX_DRAW_CALLS];
 		RenderItemCount m_tempValues[BGFX_CONFIG_MAX_DRAW_CALLS];
+		SortThreadPool m_sortThreadPool;
 
 		IndexBuffer  m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
 		VertexBuffer m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
@@ -5335,16 +6853,20 @@ namespace bgfx
 		NonLocalAllocator m_dynVertexBufferAllocator;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS> m_dynamicVertexBufferHandle;
 
-		bx::HandleAllocT<BGFX_CONFIG_MAX_INDEX_BUFFERS> m_indexBufferHandle;
+		HandleAllocMt<BGFX_CONFIG_MAX_INDEX_BUFFERS> m_indexBufferHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_VERTEX_LAYOUTS > m_layoutHandle;
 
-		bx::HandleAllocT<BGFX_CONFIG_MAX_VERTEX_BUFFERS> m_vertexBufferHandle;
+		HandleAllocMt<BGFX_CONFIG_MAX_VERTEX_BUFFERS> m_vertexBufferHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_SHADERS> m_shaderHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_PROGRAMS> m_programHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_TEXTURES> m_textureHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_FRAME_BUFFERS> m_frameBufferHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_UNIFORMS> m_uniformHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_OCCLUSION_QUERIES> m_occlusionQueryHandle;
+		bx::HandleAllocT<BGFX_CONFIG_MAX_DRAW_LISTS> m_drawListHandle;
+
+		DrawList m_drawList[BGFX_CONFIG_MAX_DRAW_LISTS];
+		uint16_t m_drawListRefGen[DrawListRef::Count][kMaxDrawListRefHandles];
 
 		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_UNIFORMS*2> UniformHashMap;
 		UniformHashMap m_uniformHashMap;
@@ -312,10 +312,26 @@ static_assert(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS must
 #	define BGFX_CONFIG_MAX_OCCLUSION_QUERIES 256
 #endif // BGFX_CONFIG_MAX_OCCLUSION_QUERIES
 
+#ifndef BGFX_CONFIG_MAX_DRAW_LISTS
+#	define BGFX_CONFIG_MAX_DRAW_LISTS 256
+#endif // BGFX_CONFIG_MAX_DRAW_LISTS
+
 #ifndef BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE
 #	define BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE (64<<10)
 #endif // BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE
 
+#ifndef BGFX_CONFIG_UNIFORM_BUFFER_PAGE_SIZE
+/// Uniform stream page size. Must be power of 2 and large enough to hold the
+/// largest single uniform write (uniform array of 1023 4x4 matrices).
+#	define BGFX_CONFIG_UNIFORM_BUFFER_PAGE_SIZE (256<<10)
+#endif // BGFX_CONFIG_UNIFORM_BUFFER_PAGE_SIZE
+
+#ifndef BGFX_CONFIG_UNIFORM_BUFFER_MAX_FREE_PAGES
+/// Maximum number of uniform stream pages kept for reuse once the peak that
+/// required them has passed. Pages above this are returned to allocator.
+#	define BGFX_CONFIG_UNIFORM_BUFFER_MAX_FREE_PAGES 32
+#endif // BGFX_CONFIG_UNIFORM_BUFFER_MAX_FREE_PAGES
+
 #ifndef BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE
 #	define BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE (6<<20)
 #endif // BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE
@@ -324,6 +340,61 @@ static_assert(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS must
 #	define BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE (2<<20)
 #endif // BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE
 
+#ifndef BGFX_CONFIG_TRANSIENT_BUFFER_CHUNK_SIZE
+/// Size of transient vertex/index buffer chunk encoder reserves from frame
+/// at once, and sub-allocates from without locking.
+#	define BGFX_CONFIG_TRANSIENT_BUFFER_CHUNK_SIZE (64<<10)
+#endif // BGFX_CONFIG_TRANSIENT_BUFFER_CHUNK_SIZE
+
+static_assert(bx::isPowerOf2(BGFX_CONFIG_TRANSIENT_BUFFER_CHUNK_SIZE), "BGFX_CONFIG_TRANSIENT_BUFFER_CHUNK_SIZE must be power of 2.");
+
+#ifndef BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_MAX_SIZE
+/// Maximum size transient vertex buffer can grow to when demand exceeds
+/// its size. Zero disables growth.
+#	define BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_MAX_SIZE 0
+#endif // BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_MAX_SIZE
+
+#ifndef BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_MAX_SIZE
+/// Maximum size transient index buffer can grow to when demand exceeds
+/// its size. Zero disables growth.
+#	define BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_MAX_SIZE 0
+#endif // BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_MAX_SIZE
+
+#ifndef BGFX_CONFIG_TRANSIENT_BUFFER_SHRINK_FRAMES
+/// Number of consecutive frames with low transient buffer use after which
+/// grown transient buffer shrinks.
+#	define BGFX_CONFIG_TRANSIENT_BUFFER_SHRINK_FRAMES 300
+#endif // BGFX_CONFIG_TRANSIENT_BUFFER_SHRINK_FRAMES
+
+#ifndef BGFX_CONFIG_MAX_RESOURCE_COMMAND_BUFFERS
+/// Number of resource command buffers. Resource functions that run without
+/// resource API lock record commands into one of them.
+#	define BGFX_CONFIG_MAX_RESOURCE_COMMAND_BUFFERS 8
+#endif // BGFX_CONFIG_MAX_RESOURCE_COMMAND_BUFFERS
+
+#ifndef BGFX_CONFIG_MAX_ASYNC_UPLOADS
+/// Maximum number of queued asynchronous uploads. When queue is full,
+/// asynchronous updates are executed immediately.
+#	define BGFX_CONFIG_MAX_ASYNC_UPLOADS 1024
+#endif // BGFX_CONFIG_MAX_ASYNC_UPLOADS
+
+#ifndef BGFX_CONFIG_ASYNC_UPLOAD_BUDGET_SIZE
+/// Amount of asynchronous upload data issued per frame. Zero is unlimited.
+#	define BGFX_CONFIG_ASYNC_UPLOAD_BUDGET_SIZE (4<<20)
+#endif // BGFX_CONFIG_ASYNC_UPLOAD_BUDGET_SIZE
+
+#ifndef BGFX_CONFIG_ASYNC_UPLOAD_BUDGET_TIME
+/// Render thread time (in microseconds) asynchronous uploads can take per
+/// frame, based on measured upload throughput. Zero is unlimited.
+#	define BGFX_CONFIG_ASYNC_UPLOAD_BUDGET_TIME 2000
+#endif // BGFX_CONFIG_ASYNC_UPLOAD_BUDGET_TIME
+
+#ifndef BGFX_CONFIG_RENDERER_NOOP_UPLOAD_RATE
+/// Upload throughput (in bytes per second) simulated by Noop renderer when
+/// creating or updating buffers and textures. Zero makes uploads free.
+#	define BGFX_CONFIG_RENDERER_NOOP_UPLOAD_RATE 0
+#endif // BGFX_CONFIG_RENDERER_NOOP_UPLOAD_RATE
+
 #ifndef BGFX_CONFIG_PER_FRAME_SCRATCH_STAGING_BUFFER_SIZE
 /// Amount of scratch buffer size (per in-flight frame) that will be reserved
 /// for staging data for copying to the device (such as vertex buffer data,
@@ -340,6 +411,25 @@ static_assert(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS must
 #   define BGFX_CONFIG_MAX_STAGING_SIZE_FOR_SCRATCH_BUFFER (16 << 20)
 #endif
 
+#ifndef BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_FILE
+/// Store whole Vulkan pipeline cache, and list of pipelines created so far,
+/// as single blob via CallbackI::cacheRead/cacheWrite, instead of one blob
+/// per pipeline.
+#	define BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_FILE 1
+#endif // BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_FILE
+
+#ifndef BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_SAVE_FRAMES
+/// Number of frames without new pipelines after which changed pipeline cache
+/// blob is written. Zero writes it only on shutdown.
+#	define BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_SAVE_FRAMES 300
+#endif // BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_SAVE_FRAMES
+
+#ifndef BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_PRECOMPILE
+/// Compile pipelines recorded in pipeline cache blob on background thread as
+/// soon as program they use is created.
+#	define BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_PRECOMPILE BGFX_CONFIG_MULTITHREADED
+#endif // BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_PRECOMPILE
+
 #ifndef BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
 #	define BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT 5
 #endif // BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
@@ -374,6 +464,42 @@ static_assert(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS must
 #	define BGFX_CONFIG_DEFAULT_MAX_ENCODERS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 8 : 1)
 #endif // BGFX_CONFIG_DEFAULT_MAX_ENCODERS
 
+#ifndef BGFX_CONFIG_DEFAULT_MAX_FRAMES_IN_FLIGHT
+#	define BGFX_CONFIG_DEFAULT_MAX_FRAMES_IN_FLIGHT 1
+#endif // BGFX_CONFIG_DEFAULT_MAX_FRAMES_IN_FLIGHT
+
+#ifndef BGFX_CONFIG_MAX_FRAMES_IN_FLIGHT
+#	define BGFX_CONFIG_MAX_FRAMES_IN_FLIGHT 4
+#endif // BGFX_CONFIG_MAX_FRAMES_IN_FLIGHT
+
+#ifndef BGFX_CONFIG_DEFAULT_MAX_SORT_THREADS
+#	define BGFX_CONFIG_DEFAULT_MAX_SORT_THREADS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 4 : 1)
+#endif // BGFX_CONFIG_DEFAULT_MAX_SORT_THREADS
+
+#ifndef BGFX_CONFIG_MAX_SORT_THREADS
+#	define BGFX_CONFIG_MAX_SORT_THREADS 64
+#endif // BGFX_CONFIG_MAX_SORT_THREADS
+
+/// Minimum number of render items in frame before sort is split across sort threads.
+#ifndef BGFX_CONFIG_SORT_PARALLEL_MIN_ITEMS
+#	define BGFX_CONFIG_SORT_PARALLEL_MIN_ITEMS (8<<10)
+#endif // BGFX_CONFIG_SORT_PARALLEL_MIN_ITEMS
+
+/// Encoder reserves render item slots from frame in runs. First run reserved in
+/// frame is BGFX_CONFIG_MIN_SORT_RUN_SIZE slots, and every next run is twice as
+/// big until it reaches BGFX_CONFIG_MAX_SORT_RUN_SIZE.
+#ifndef BGFX_CONFIG_MIN_SORT_RUN_SIZE
+#	define BGFX_CONFIG_MIN_SORT_RUN_SIZE 256
+#endif // BGFX_CONFIG_MIN_SORT_RUN_SIZE
+
+#ifndef BGFX_CONFIG_MAX_SORT_RUN_SIZE
+#	define BGFX_CONFIG_MAX_SORT_RUN_SIZE (4<<10)
+#endif // BGFX_CONFIG_MAX_SORT_RUN_SIZE
+
+static_assert(BGFX_CONFIG_MIN_SORT_RUN_SIZE <= BGFX_CONFIG_MAX_SORT_RUN_SIZE, "BGFX_CONFIG_MIN_SORT_RUN_SIZE must be smaller or equal to BGFX_CONFIG_MAX_SORT_RUN_SIZE.");
+
+#define BGFX_CONFIG_MAX_SORT_RUNS (BGFX_CONFIG_MAX_DRAW_CALLS/BGFX_CONFIG_MIN_SORT_RUN_SIZE + 1)
+
 #ifndef BGFX_CONFIG_MAX_BACK_BUFFERS
 #	define BGFX_CONFIG_MAX_BACK_BUFFERS 4
 #endif // BGFX_CONFIG_MAX_BACK_BUFFERS
@@ -392,6 +518,12 @@ static_assert(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS must
 #	define BGFX_CONFIG_MAX_SCREENSHOTS 4
 #endif // BGFX_CONFIG_MAX_SCREENSHOTS
 
+#ifndef BGFX_CONFIG_MAX_PIPELINE_STATS
+/// Maximum number of pipelines reported in Stats::pipelineStats per frame.
+/// Pipelines created after that in the same frame are not reported.
+#	define BGFX_CONFIG_MAX_PIPELINE_STATS 256
+#endif // BGFX_CONFIG_MAX_PIPELINE_STATS
+
 #ifndef BGFX_CONFIG_ENCODER_API_ONLY
 #	define BGFX_CONFIG_ENCODER_API_ONLY 0
 #endif // BGFX_CONFIG_ENCODER_API_ONLY
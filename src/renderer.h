@@ -539,6 +539,37 @@ namespace bgfx
 		bool     m_enabled;
 	};
 
+	// Pipelines can be created outside of submit (program creation, manifest
+	// replay), so they are collected here and reported with next frame.
+	struct PipelineStatsCollector
+	{
+		PipelineStatsCollector()
+			: m_num(0)
+		{
+		}
+
+		void add(uint64_t _id, int64_t _cpuTime, bool _prewarm)
+		{
+			if (m_num < BGFX_CONFIG_MAX_PIPELINE_STATS)
+			{
+				PipelineStats& stats = m_stats[m_num++];
+				stats.id            = _id;
+				stats.cpuTimeCreate = _cpuTime;
+				stats.prewarm       = _prewarm;
+			}
+		}
+
+		void flush(Frame* _frame)
+		{
+			bx::memCopy(_frame->m_pipelineStats, m_stats, m_num*sizeof(PipelineStats) );
+			_frame->m_perfStats.numPipelines = m_num;
+			m_num = 0;
+		}
+
+		PipelineStats m_stats[BGFX_CONFIG_MAX_PIPELINE_STATS];
+		uint16_t      m_num;
+	};
+
 } // namespace bgfx
 
 #endif // BGFX_RENDERER_H_HEADER_GUARD
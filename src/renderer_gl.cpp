@@ -546,6 +546,7 @@ namespace bgfx { namespace gl
 			APPLE_texture_format_BGRA8888,
 			APPLE_texture_max_level,
 
+			ARB_buffer_storage,
 			ARB_clip_control,
 			ARB_compute_shader,
 			ARB_conservative_depth,
@@ -610,6 +611,7 @@ namespace bgfx { namespace gl
 			EXT_blend_color,
 			EXT_blend_minmax,
 			EXT_blend_subtract,
+			EXT_buffer_storage,
 			EXT_color_buffer_half_float,
 			EXT_color_buffer_float,
 			EXT_copy_image,
@@ -764,6 +766,7 @@ namespace bgfx { namespace gl
 		{ "APPLE_texture_format_BGRA8888",            false,                             true  },
 		{ "APPLE_texture_max_level",                  false,                             true  },
 
+		{ "ARB_buffer_storage",                       BGFX_CONFIG_RENDERER_OPENGL >= 44, true  },
 		{ "ARB_clip_control",                         BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_compute_shader",                       BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_conservative_depth",                   BGFX_CONFIG_RENDERER_OPENGL >= 42, true  },
@@ -828,6 +831,7 @@ namespace bgfx { namespace gl
 		{ "EXT_blend_color",                          BGFX_CONFIG_RENDERER_OPENGL >= 31, true  },
 		{ "EXT_blend_minmax",                         BGFX_CONFIG_RENDERER_OPENGL >= 14, true  },
 		{ "EXT_blend_subtract",                       BGFX_CONFIG_RENDERER_OPENGL >= 14, true  },
+		{ "EXT_buffer_storage",                       false,                             true  }, // GLES3.1 extension.
 		{ "EXT_color_buffer_half_float",              false,                             true  }, // GLES2 extension.
 		{ "EXT_color_buffer_float",                   false,                             true  }, // GLES2 extension.
 		{ "EXT_copy_image",                           false,                             true  }, // GLES2 extension.
@@ -2219,6 +2223,17 @@ namespace bgfx { namespace gl
 		bool m_detachShader;
 	};
 
+#define MAX_PROGRAM_MANIFEST (4<<10)
+
+	static const uint64_t kProgramManifestId    = uint64_t(BX_MAKEFOURCC('G', 'L', 'P', 'M') ) << 32;
+	static const uint32_t kProgramManifestMagic = BX_MAKEFOURCC('G', 'L', 'P', 1);
+
+	struct ProgramManifestEntryGL
+	{
+		uint64_t m_id;
+		uint32_t m_time;
+	};
+
 	struct RendererContextGL : public RendererContextI
 	{
 		RendererContextGL()
@@ -2246,6 +2261,7 @@ namespace bgfx { namespace gl
 			, m_atocSupport(false)
 			, m_conservativeRasterSupport(false)
 			, m_flip(false)
+			, m_programManifestDirty(false)
 			, m_hash( (BX_PLATFORM_WINDOWS<<1) | BX_ARCH_64BIT)
 			, m_backBufferFbo(0)
 			, m_msaaBackBufferFbo(0)
@@ -3193,6 +3209,12 @@ namespace bgfx { namespace gl
 					m_occlusionQuery.create();
 				}
 
+				if (s_extension[Extension::ARB_buffer_storage].m_supported
+				||  s_extension[Extension::EXT_buffer_storage].m_supported)
+				{
+					m_streamBuffer.create(BGFX_GL_CONFIG_STREAM_BUFFER_SIZE*BGFX_CONFIG_MAX_FRAME_LATENCY);
+				}
+
 				// Init reserved part of view name.
 				for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
 				{
@@ -3200,6 +3222,8 @@ namespace bgfx { namespace gl
 				}
 
 				m_needPresent = false;
+
+				programManifestLoad();
 			}
 
 			return true;
@@ -3230,6 +3254,17 @@ namespace bgfx { namespace gl
 
 			invalidateCache();
 
+			programManifestSave();
+
+			m_streamBuffer.destroy();
+
+			for (ProgramPrewarmMap::iterator it = m_programPrewarm.begin(), itEnd = m_programPrewarm.end(); it != itEnd; ++it)
+			{
+				GL_CHECK(glDeleteProgram(it->second) );
+			}
+
+			m_programPrewarm.clear();
+
 			if (m_timerQuerySupport)
 			{
 				m_gpuTimer.destroy();
@@ -3562,6 +3597,58 @@ namespace bgfx { namespace gl
 			m_uniformReg.remove(_handle);
 		}
 
+		void replayPipelineManifest() override
+		{
+			if (!m_programBinarySupport
+			||  m_programManifest.empty() )
+			{
+				return;
+			}
+
+			// Link programs used in previous runs from program binary cache
+			// before they are requested, so that first frames using them don't
+			// stall. Most expensive programs are linked first.
+			ProgramManifestArray manifest = m_programManifest;
+			bx::quickSort(
+				  &manifest[0]
+				, uint32_t(manifest.size() )
+				, sizeof(ProgramManifestEntryGL)
+				, [](const void* _lhs, const void* _rhs) -> int32_t {
+					const ProgramManifestEntryGL& lhs = *(const ProgramManifestEntryGL*)_lhs;
+					const ProgramManifestEntryGL& rhs = *(const ProgramManifestEntryGL*)_rhs;
+					return lhs.m_time > rhs.m_time ? -1 : lhs.m_time < rhs.m_time ? 1 : 0;
+				});
+
+			for (uint32_t ii = 0, num = uint32_t(manifest.size() ); ii < num; ++ii)
+			{
+				const uint64_t id = manifest[ii].m_id;
+
+				if (m_programPrewarm.end() != m_programPrewarm.find(id) )
+				{
+					continue;
+				}
+
+				const int64_t timeBegin = bx::getHPCounter();
+
+				GLuint programId = glCreateProgram();
+
+				GLint linked = 0;
+				if (programFetchFromCache(programId, id) )
+				{
+					GL_CHECK(glGetProgramiv(programId, GL_LINK_STATUS, &linked) );
+				}
+
+				if (0 == linked)
+				{
+					GL_CHECK(glDeleteProgram(programId) );
+					continue;
+				}
+
+				m_programPrewarm.insert(stl::make_pair(id, programId) );
+				m_pipelineStats.add(id, bx::getHPCounter() - timeBegin, true);
+			}
+		}
+
 		void requestScreenShot(FrameBufferHandle _handle, const char* _filePath) override
 		{
 			SwapChainGL* swapChain = NULL;
@@ -4383,6 +4470,136 @@ namespace bgfx { namespace gl
 			return cached;
 		}
 
+		GLuint programAcquirePrewarmed(uint64_t _id)
+		{
+			ProgramPrewarmMap::iterator it = m_programPrewarm.find(_id);
+
+			if (m_programPrewarm.end() == it)
+			{
+				return 0;
+			}
+
+			const GLuint programId = it->second;
+			m_programPrewarm.erase(it);
+
+			return programId;
+		}
+
+		void programManifestRecord(uint64_t _id, int64_t _cpuTime)
+		{
+			m_pipelineStats.add(_id, _cpuTime, false);
+
+			if (!m_programBinarySupport)
+			{
+				return;
+			}
+
+			const uint32_t time = uint32_t(bx::min<int64_t>(_cpuTime*1000000/bx::getHPFrequency(), UINT32_MAX) );
+
+			ProgramManifestMap::iterator it = m_programManifestMap.find(_id);
+
+			if (m_programManifestMap.end() != it)
+			{
+				m_programManifest[it->second].m_time = time;
+			}
+			else if (MAX_PROGRAM_MANIFEST > m_programManifest.size() )
+			{
+				m_programManifestMap.insert(stl::make_pair(_id, uint32_t(m_programManifest.size() ) ) );
+
+				ProgramManifestEntryGL entry;
+				entry.m_id   = _id;
+				entry.m_time = time;
+				m_programManifest.push_back(entry);
+			}
+			else
+			{
+				return;
+			}
+
+			m_programManifestDirty = true;
+		}
+
+		void programManifestLoad()
+		{
+			if (!m_programBinarySupport)
+			{
+				return;
+			}
+
+			const uint64_t id = kProgramManifestId ^ m_hash;
+
+			const uint32_t length = g_callback->cacheReadSize(id);
+
+			if (0 == length)
+			{
+				return;
+			}
+
+			void* data = bx::alloc(g_allocator, length);
+
+			if (g_callback->cacheRead(id, data, length) )
+			{
+				bx::Error err;
+				bx::MemoryReader reader(data, length);
+
+				uint32_t magic = 0;
+				uint32_t num   = 0;
+				bx::read(&reader, magic, &err);
+				bx::read(&reader, num, &err);
+
+				if (err.isOk()
+				&&  kProgramManifestMagic == magic
+				&&  num <= MAX_PROGRAM_MANIFEST
+				&&  uint32_t(reader.remaining() ) == num*(sizeof(uint64_t)+sizeof(uint32_t) ) )
+				{
+					m_programManifest.resize(num);
+
+					for (uint32_t ii = 0; ii < num; ++ii)
+					{
+						ProgramManifestEntryGL& entry = m_programManifest[ii];
+						bx::read(&reader, entry.m_id,   &err);
+						bx::read(&reader, entry.m_time, &err);
+						m_programManifestMap.insert(stl::make_pair(entry.m_id, ii) );
+					}
+				}
+				else
+				{
+					BX_TRACE("Program manifest is invalid, ignoring.");
+				}
+			}
+
+			bx::free(g_allocator, data);
+		}
+
+		void programManifestSave()
+		{
+			if (!m_programManifestDirty)
+			{
+				return;
+			}
+
+			const uint32_t num    = uint32_t(m_programManifest.size() );
+			const uint32_t length = 2*sizeof(uint32_t) + num*(sizeof(uint64_t)+sizeof(uint32_t) );
+
+			uint8_t* data = (uint8_t*)bx::alloc(g_allocator, length);
+
+			bx::StaticMemoryBlockWriter writer(data, length);
+			bx::write(&writer, kProgramManifestMagic, bx::ErrorAssert{});
+			bx::write(&writer, num, bx::ErrorAssert{});
+
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				bx::write(&writer, m_programManifest[ii].m_id,   bx::ErrorAssert{});
+				bx::write(&writer, m_programManifest[ii].m_time, bx::ErrorAssert{});
+			}
+
+			g_callback->cacheWrite(kProgramManifestId ^ m_hash, data, length);
+
+			bx::free(g_allocator, data);
+
+			m_programManifestDirty = false;
+		}
+
 		void programCache(GLuint programId, uint64_t _id)
 		{
 			_id ^= m_hash;
@@ -4801,6 +5018,17 @@ namespace bgfx { namespace gl
 		bool m_imageLoadStoreSupport;
 		bool m_flip;
 
+		typedef stl::vector<ProgramManifestEntryGL> ProgramManifestArray;
+		typedef stl::unordered_map<uint64_t, uint32_t> ProgramManifestMap;
+		typedef stl::unordered_map<uint64_t, GLuint> ProgramPrewarmMap;
+		ProgramManifestArray m_programManifest;
+		ProgramManifestMap m_programManifestMap;
+		ProgramPrewarmMap m_programPrewarm;
+		PipelineStatsCollector m_pipelineStats;
+		bool m_programManifestDirty;
+
+		StreamBufferGL m_streamBuffer;
+
 		uint64_t m_hash;
 
 		GLenum m_readPixelsFmt;
@@ -5028,11 +5256,21 @@ namespace bgfx { namespace gl
 
 	void ProgramGL::create(const ShaderGL& _vsh, const ShaderGL& _fsh)
 	{
-		m_id = glCreateProgram();
-		BX_TRACE("Program create: GL%d: GL%d, GL%d", m_id, _vsh.m_id, _fsh.m_id);
+		const int64_t timeBegin = bx::getHPCounter();
 
 		const uint64_t id = (uint64_t(_vsh.m_hash)<<32) | _fsh.m_hash;
-		const bool cached = s_renderGL->programFetchFromCache(m_id, id);
+
+		m_id = s_renderGL->programAcquirePrewarmed(id);
+		const bool prewarmed = 0 != m_id;
+
+		if (!prewarmed)
+		{
+			m_id = glCreateProgram();
+		}
+
+		BX_TRACE("Program create: GL%d: GL%d, GL%d%s", m_id, _vsh.m_id, _fsh.m_id, prewarmed ? " (prewarmed)" : "");
+
+		const bool cached = prewarmed || s_renderGL->programFetchFromCache(m_id, id);
 
 		if (!cached)
 		{
@@ -5071,6 +5309,11 @@ namespace bgfx { namespace gl
 
 		init();
 
+		if (!prewarmed)
+		{
+			s_renderGL->programManifestRecord(id, bx::getHPCounter() - timeBegin);
+		}
+
 		if (!cached
 		&&  s_renderGL->m_workaround.m_detachShader)
 		{
@@ -5513,6 +5756,179 @@ namespace bgfx { namespace gl
 		}
 	}
 
+#if BGFX_GL_CONFIG_STREAM_BUFFER
+	bool StreamBufferGL::create(uint32_t _size)
+	{
+		if (NULL == glBufferStorage)
+		{
+			return false;
+		}
+
+		const GLbitfield flags = 0
+			| GL_MAP_WRITE_BIT
+			| GL_MAP_PERSISTENT_BIT
+			| GL_MAP_COHERENT_BIT
+			;
+
+		GL_CHECK(glGenBuffers(1, &m_id) );
+		GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, m_id) );
+		GL_CHECK(glBufferStorage(GL_COPY_READ_BUFFER, _size, NULL, flags) );
+		m_data = (uint8_t*)glMapBufferRange(GL_COPY_READ_BUFFER, 0, _size, flags);
+		GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0) );
+
+		if (NULL == m_data)
+		{
+			BX_TRACE("Stream buffer: Failed to map persistent buffer, falling back to glBufferSubData.");
+			GL_CHECK(glDeleteBuffers(1, &m_id) );
+			m_id = 0;
+			return false;
+		}
+
+		m_size     = _size;
+		m_pos      = 0;
+		m_overflow = 0;
+		m_frame    = 0;
+
+		BX_TRACE("Stream buffer: %d bytes, %d frames.", _size, BGFX_CONFIG_MAX_FRAME_LATENCY);
+
+		return true;
+	}
+
+	void StreamBufferGL::destroy()
+	{
+		if (0 == m_id)
+		{
+			return;
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_fence); ++ii)
+		{
+			if (NULL != m_fence[ii])
+			{
+				GL_CHECK(glDeleteSync(m_fence[ii]) );
+				m_fence[ii] = NULL;
+			}
+		}
+
+		GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, m_id) );
+		GL_CHECK(glUnmapBuffer(GL_COPY_READ_BUFFER) );
+		GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0) );
+		GL_CHECK(glDeleteBuffers(1, &m_id) );
+
+		m_id   = 0;
+		m_data = NULL;
+		m_size = 0;
+	}
+
+	bool StreamBufferGL::update(GLuint _id, uint32_t _offset, uint32_t _size, const void* _data)
+	{
+		if (0 == m_id)
+		{
+			return false;
+		}
+
+		const uint32_t frameSize = m_size / BGFX_CONFIG_MAX_FRAME_LATENCY;
+		const uint32_t size      = bx::alignUp(_size, 16);
+
+		if (m_pos + size > frameSize)
+		{
+			if (0 == m_overflow)
+			{
+				BX_TRACE("Stream buffer: Frame portion of %d bytes is full, falling back to glBufferSubData.", frameSize);
+			}
+
+			m_overflow += size;
+			return false;
+		}
+
+		const uint32_t idx = m_frame % BGFX_CONFIG_MAX_FRAME_LATENCY;
+
+		if (NULL != m_fence[idx])
+		{
+			// Part of ring used by this frame was last used
+			// BGFX_CONFIG_MAX_FRAME_LATENCY frames ago, copies from it must
+			// be done before it's overwritten.
+			BGFX_PROFILER_SCOPE("StreamBufferGL::wait", kColorResource);
+
+			GLenum result;
+			do
+			{
+				result = glClientWaitSync(m_fence[idx], GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_C(1000000000) );
+			}
+			while (GL_TIMEOUT_EXPIRED == result);
+
+			BX_WARN(GL_WAIT_FAILED != result, "Stream buffer: glClientWaitSync failed.");
+
+			GL_CHECK(glDeleteSync(m_fence[idx]) );
+			m_fence[idx] = NULL;
+		}
+
+		const uint32_t offset = idx*frameSize + m_pos;
+		bx::memCopy(&m_data[offset], _data, _size);
+		m_pos += size;
+
+		// Copy is ordered with draw calls on GPU, so the destination buffer
+		// doesn't need to be orphaned even if it's still in use.
+		GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER,  m_id) );
+		GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, _id) );
+		GL_CHECK(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset, _offset, _size) );
+		GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, 0) );
+		GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER,  0) );
+
+		return true;
+	}
+
+	void StreamBufferGL::frame()
+	{
+		if (0 == m_id)
+		{
+			return;
+		}
+
+		if (0 < m_pos)
+		{
+			m_fence[m_frame % BGFX_CONFIG_MAX_FRAME_LATENCY] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
+
+		if (0 < m_overflow)
+		{
+			// Frame needed more than its part of ring, usually because transient
+			// buffers were resized. Grow ring so that next frames don't fall back
+			// to glBufferSubData.
+			const uint32_t frameSize = bx::alignUp(m_pos + m_overflow, 64<<10);
+			destroy();
+			create(frameSize*BGFX_CONFIG_MAX_FRAME_LATENCY);
+			return;
+		}
+
+		m_frame++;
+		m_pos = 0;
+	}
+#else
+	bool StreamBufferGL::create(uint32_t /*_size*/)
+	{
+		return false;
+	}
+
+	void StreamBufferGL::destroy()
+	{
+	}
+
+	bool StreamBufferGL::update(GLuint /*_id*/, uint32_t /*_offset*/, uint32_t /*_size*/, const void* /*_data*/)
+	{
+		return false;
+	}
+
+	void StreamBufferGL::frame()
+	{
+	}
+#endif // BGFX_GL_CONFIG_STREAM_BUFFER
+
+	bool streamBufferUpdate(GLuint _id, uint32_t _offset, uint32_t _size, const void* _data)
+	{
+		return s_renderGL->m_streamBuffer.update(_id, _offset, _size, _data);
+	}
+
 	void IndexBufferGL::destroy()
 	{
 		GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
@@ -8629,6 +9045,8 @@ namespace bgfx { namespace gl
 		perfStats.gpuMemoryMax  = -INT64_MAX;
 		perfStats.gpuMemoryUsed = -INT64_MAX;
 
+		m_pipelineStats.flush(_render);
+
 		if (_render->m_debug & (BGFX_DEBUG_IFH|BGFX_DEBUG_STATS) )
 		{
 			BGFX_GL_PROFILER_BEGIN_LITERAL("debugstats", kColorFrame);
@@ -8819,6 +9237,8 @@ namespace bgfx { namespace gl
 			BGFX_GL_PROFILER_END();
 		}
 
+		m_streamBuffer.frame();
+
 		if (0 != m_vao)
 		{
 			GL_CHECK(glBindVertexArray(0) );
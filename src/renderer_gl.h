@@ -38,6 +38,21 @@
 #	define BGFX_GL_CONFIG_TEXTURE_READ_BACK_EMULATION 0
 #endif // BGFX_GL_CONFIG_TEXTURE_READ_BACK_EMULATION
 
+// Stream transient and dynamic buffer updates through persistently mapped
+// ring buffer when GL_ARB_buffer_storage or GL_EXT_buffer_storage is
+// available, instead of glBufferSubData.
+#ifndef BGFX_GL_CONFIG_STREAM_BUFFER
+#	define BGFX_GL_CONFIG_STREAM_BUFFER (!BX_PLATFORM_EMSCRIPTEN \
+		&& (BGFX_CONFIG_RENDERER_OPENGL || BGFX_CONFIG_RENDERER_OPENGLES >= 30) )
+#endif // BGFX_GL_CONFIG_STREAM_BUFFER
+
+// Initial amount of stream buffer memory available to single frame. Ring
+// buffer is BGFX_CONFIG_MAX_FRAME_LATENCY times this size. Updates that don't
+// fit fall back to glBufferSubData, and ring grows at the end of frame.
+#ifndef BGFX_GL_CONFIG_STREAM_BUFFER_SIZE
+#	define BGFX_GL_CONFIG_STREAM_BUFFER_SIZE (BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE + BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE)
+#endif // BGFX_GL_CONFIG_STREAM_BUFFER_SIZE
+
 #define BGFX_GL_PROFILER_BEGIN(_view, _abgr)                                               \
 	BX_MACRO_BLOCK_BEGIN                                                                   \
 		GL_CHECK(glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, s_viewName[view]) ); \
@@ -1099,6 +1114,14 @@ typedef uint64_t GLuint64;
 #	define GL_DISPATCH_INDIRECT_BUFFER 0x90EE
 #endif // GL_DISPATCH_INDIRECT_BUFFER
 
+#ifndef GL_MAP_PERSISTENT_BIT
+#	define GL_MAP_PERSISTENT_BIT 0x0040
+#endif // GL_MAP_PERSISTENT_BIT
+
+#ifndef GL_MAP_COHERENT_BIT
+#	define GL_MAP_COHERENT_BIT 0x0080
+#endif // GL_MAP_COHERENT_BIT
+
 #ifndef GL_MAX_NAME_LENGTH
 #	define GL_MAX_NAME_LENGTH 0x92F6
 #endif // GL_MAX_NAME_LENGTH
@@ -1321,6 +1344,35 @@ namespace bgfx { namespace gl
 		HashMap m_hashMap;
 	};
 
+	struct StreamBufferGL
+	{
+		StreamBufferGL()
+			: m_id(0)
+			, m_data(NULL)
+			, m_size(0)
+			, m_pos(0)
+			, m_overflow(0)
+			, m_frame(0)
+		{
+			bx::memSet(m_fence, 0, sizeof(m_fence) );
+		}
+
+		bool create(uint32_t _size);
+		void destroy();
+		bool update(GLuint _id, uint32_t _offset, uint32_t _size, const void* _data);
+		void frame();
+
+		GLuint   m_id;
+		uint8_t* m_data;
+		uint32_t m_size;
+		uint32_t m_pos;
+		uint32_t m_overflow;
+		uint32_t m_frame;
+		GLsync   m_fence[BGFX_CONFIG_MAX_FRAME_LATENCY];
+	};
+
+	bool streamBufferUpdate(GLuint _id, uint32_t _offset, uint32_t _size, const void* _data);
+
 	struct IndexBufferGL
 	{
 		void create(uint32_t _size, void* _data, uint16_t _flags)
@@ -1343,6 +1395,11 @@ namespace bgfx { namespace gl
 		{
 			BX_ASSERT(0 != m_id, "Updating invalid index buffer.");
 
+			if (streamBufferUpdate(m_id, _offset, _size, _data) )
+			{
+				return;
+			}
+
 			if (_discard)
 			{
 				// orphan buffer...
@@ -1391,6 +1448,11 @@ namespace bgfx { namespace gl
 		{
 			BX_ASSERT(0 != m_id, "Updating invalid vertex buffer.");
 
+			if (streamBufferUpdate(m_id, _offset, _size, _data) )
+			{
+				return;
+			}
+
 			if (_discard)
 			{
 				// orphan buffer...
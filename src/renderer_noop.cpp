@@ -7,6 +7,20 @@
 
 namespace bgfx { namespace noop
 {
+	// Busy wait for as long as upload would take at simulated throughput, so
+	// that upload budgets can be tested without GPU backend.
+	static void simulateUpload(uint32_t _size)
+	{
+		if (0 != BGFX_CONFIG_RENDERER_NOOP_UPLOAD_RATE)
+		{
+			const int64_t wait = int64_t(_size)*bx::getHPFrequency()/int64_t(BGFX_CONFIG_RENDERER_NOOP_UPLOAD_RATE);
+			const int64_t end  = bx::getHPCounter() + wait;
+			while (bx::getHPCounter() < end)
+			{
+			}
+		}
+	}
+
 	struct RendererContextNOOP : public RendererContextI
 	{
 		RendererContextNOOP()
@@ -100,8 +114,9 @@ namespace bgfx { namespace noop
 		{
 		}
 
-		void createIndexBuffer(IndexBufferHandle /*_handle*/, const Memory* /*_mem*/, uint16_t /*_flags*/) override
+		void createIndexBuffer(IndexBufferHandle /*_handle*/, const Memory* _mem, uint16_t /*_flags*/) override
 		{
+			simulateUpload(_mem->size);
 		}
 
 		void destroyIndexBuffer(IndexBufferHandle /*_handle*/) override
@@ -116,8 +131,9 @@ namespace bgfx { namespace noop
 		{
 		}
 
-		void createVertexBuffer(VertexBufferHandle /*_handle*/, const Memory* /*_mem*/, VertexLayoutHandle /*_layoutHandle*/, uint16_t /*_flags*/) override
+		void createVertexBuffer(VertexBufferHandle /*_handle*/, const Memory* _mem, VertexLayoutHandle /*_layoutHandle*/, uint16_t /*_flags*/) override
 		{
+			simulateUpload(_mem->size);
 		}
 
 		void destroyVertexBuffer(VertexBufferHandle /*_handle*/) override
@@ -128,8 +144,9 @@ namespace bgfx { namespace noop
 		{
 		}
 
-		void updateDynamicIndexBuffer(IndexBufferHandle /*_handle*/, uint32_t /*_offset*/, uint32_t /*_size*/, const Memory* /*_mem*/) override
+		void updateDynamicIndexBuffer(IndexBufferHandle /*_handle*/, uint32_t /*_offset*/, uint32_t _size, const Memory* /*_mem*/) override
 		{
+			simulateUpload(_size);
 		}
 
 		void destroyDynamicIndexBuffer(IndexBufferHandle /*_handle*/) override
@@ -140,8 +157,9 @@ namespace bgfx { namespace noop
 		{
 		}
 
-		void updateDynamicVertexBuffer(VertexBufferHandle /*_handle*/, uint32_t /*_offset*/, uint32_t /*_size*/, const Memory* /*_mem*/) override
+		void updateDynamicVertexBuffer(VertexBufferHandle /*_handle*/, uint32_t /*_offset*/, uint32_t _size, const Memory* /*_mem*/) override
 		{
+			simulateUpload(_size);
 		}
 
 		void destroyDynamicVertexBuffer(VertexBufferHandle /*_handle*/) override
@@ -164,8 +182,9 @@ namespace bgfx { namespace noop
 		{
 		}
 
-		void* createTexture(TextureHandle /*_handle*/, const Memory* /*_mem*/, uint64_t /*_flags*/, uint8_t /*_skip*/) override
+		void* createTexture(TextureHandle /*_handle*/, const Memory* _mem, uint64_t /*_flags*/, uint8_t /*_skip*/) override
 		{
+			simulateUpload(_mem->size);
 			return NULL;
 		}
 
@@ -173,8 +192,9 @@ namespace bgfx { namespace noop
 		{
 		}
 
-		void updateTexture(TextureHandle /*_handle*/, uint8_t /*_side*/, uint8_t /*_mip*/, const Rect& /*_rect*/, uint16_t /*_z*/, uint16_t /*_depth*/, uint16_t /*_pitch*/, const Memory* /*_mem*/) override
+		void updateTexture(TextureHandle /*_handle*/, uint8_t /*_side*/, uint8_t /*_mip*/, const Rect& /*_rect*/, uint16_t /*_z*/, uint16_t /*_depth*/, uint16_t /*_pitch*/, const Memory* _mem) override
 		{
+			simulateUpload(_mem->size);
 		}
 
 		void updateTextureEnd() override
@@ -226,6 +246,10 @@ namespace bgfx { namespace noop
 		{
 		}
 
+		void replayPipelineManifest() override
+		{
+		}
+
 		void updateViewName(ViewId /*_id*/, const char* /*_name*/) override
 		{
 		}
@@ -251,9 +275,13 @@ namespace bgfx { namespace noop
 			const int64_t timerFreq = bx::getHPFrequency();
 			const int64_t timeBegin = bx::getHPCounter();
 
+			// Sort render items like other renderers do, so that CPU frame cost can be
+			// measured without GPU backend.
+			_render->sort();
+
 			Stats& perfStats = _render->m_perfStats;
 			perfStats.cpuTimeBegin  = timeBegin;
-			perfStats.cpuTimeEnd    = timeBegin;
+			perfStats.cpuTimeEnd    = bx::getHPCounter();
 			perfStats.cpuTimerFreq  = timerFreq;
 
 			perfStats.gpuTimeBegin  = 0;
@@ -1131,6 +1131,38 @@ VK_IMPORT_DEVICE
 	}
 
 #define MAX_DESCRIPTOR_SETS (1024 * BGFX_CONFIG_MAX_FRAME_LATENCY)
+#define MAX_CACHED_IMAGE_VIEWS 1024
+
+// Half of descriptor pool is left for sets released by cache flush, which
+// are freed only after frames that use them are done.
+#define MAX_CACHED_DESCRIPTOR_SETS (MAX_DESCRIPTOR_SETS / (2 * BGFX_CONFIG_MAX_FRAME_LATENCY) )
+
+#define MAX_PIPELINE_CACHE_KEYS (16<<10)
+
+	// Pipeline cache blob id, outside of range of 32-bit pipeline hashes used
+	// as ids when each pipeline is cached separately.
+	static const uint64_t kPipelineCacheId   = uint64_t(BX_MAKEFOURCC('V', 'K', 'P', 'C') ) << 32;
+	static const uint32_t kPipelineCacheMagic = BX_MAKEFOURCC('V', 'K', 'P', 2);
+
+	struct PipelineCacheHeaderVK
+	{
+		uint32_t m_magic;
+		uint32_t m_keySize;
+		uint32_t m_vendorId;
+		uint32_t m_deviceId;
+		uint32_t m_driverVersion;
+		uint8_t  m_uuid[VK_UUID_SIZE];
+		uint32_t m_numKeys;
+		uint32_t m_dataSize;
+	};
+
+	static const VkDynamicState s_dynamicStates[] =
+	{
+		VK_DYNAMIC_STATE_VIEWPORT,
+		VK_DYNAMIC_STATE_SCISSOR,
+		VK_DYNAMIC_STATE_BLEND_CONSTANTS,
+		VK_DYNAMIC_STATE_STENCIL_REFERENCE,
+	};
 
 	struct RendererContextVK : public RendererContextI
 	{
@@ -1144,7 +1176,15 @@ VK_IMPORT_DEVICE
 			, m_captureBuffer(VK_NULL_HANDLE)
 			, m_captureMemory(VK_NULL_HANDLE)
 			, m_captureSize(0)
+			, m_descriptorSetCacheHits(0)
+			, m_descriptorSetCacheMisses(0)
+			, m_pipelineReplay(false)
+			, m_pipelineCacheDirty(false)
+			, m_pipelineCacheIdleFrames(0)
+			, m_pipelineCompileActive(NULL)
+			, m_pipelineCompileExit(false)
 		{
+			bx::memSet(m_descriptorSetPalette, 0, sizeof(m_descriptorSetPalette) );
 		}
 
 		~RendererContextVK()
@@ -1997,8 +2037,29 @@ VK_IMPORT_DEVICE
 				pcci.flags = 0;
 				pcci.initialDataSize = 0;
 				pcci.pInitialData    = NULL;
+
+				const uint32_t cacheSize = BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_FILE
+					? g_callback->cacheReadSize(kPipelineCacheId)
+					: 0
+					;
+				void* cacheData = NULL;
+
+				if (0 < cacheSize)
+				{
+					cacheData = bx::alloc(g_allocator, cacheSize);
+					if (g_callback->cacheRead(kPipelineCacheId, cacheData, cacheSize) )
+					{
+						loadPipelineCache(pcci, cacheData, cacheSize);
+					}
+				}
+
 				result = vkCreatePipelineCache(m_device, &pcci, m_allocatorCb, &m_pipelineCache);
 
+				if (NULL != cacheData)
+				{
+					bx::free(g_allocator, cacheData);
+				}
+
 				if (VK_SUCCESS != result)
 				{
 					BX_TRACE("Init error: vkCreatePipelineCache failed %d: %s.", result, getName(result) );
@@ -2069,6 +2130,12 @@ VK_IMPORT_DEVICE
 				goto error;
 			}
 
+			if (BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_FILE
+			&&  BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_PRECOMPILE)
+			{
+				m_pipelineCompileThread.init(pipelineCompileThread, this, 0, "bgfx - pipeline compile thread");
+			}
+
 			g_internalData.context = m_device;
 			return true;
 
@@ -2140,12 +2207,27 @@ VK_IMPORT_DEVICE
 
 			preReset();
 
+			if (m_pipelineCompileThread.isRunning() )
+			{
+				pipelineCompileCancel(BGFX_INVALID_HANDLE);
+				m_pipelineCompileExit = true;
+				m_pipelineCompileSem.post();
+				m_pipelineCompileThread.shutdown();
+			}
+
+			if (m_pipelineCacheDirty)
+			{
+				savePipelineCache();
+			}
+
 			m_pipelineStateCache.invalidate();
 			m_descriptorSetLayoutCache.invalidate();
 			m_renderPassCache.invalidate();
+			m_renderPassDesc.clear();
 			m_samplerCache.invalidate();
 			m_samplerBorderColorCache.invalidate();
 			m_imageViewCache.invalidate();
+			invalidateDescriptorSetCache();
 
 			for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 			{
@@ -2245,6 +2327,7 @@ VK_IMPORT_DEVICE
 
 		void destroyIndexBuffer(IndexBufferHandle _handle) override
 		{
+			invalidateDescriptorSetCache(m_indexBuffers[_handle.idx]);
 			m_indexBuffers[_handle.idx].destroy();
 		}
 
@@ -2266,6 +2349,7 @@ VK_IMPORT_DEVICE
 
 		void destroyVertexBuffer(VertexBufferHandle _handle) override
 		{
+			invalidateDescriptorSetCache(m_vertexBuffers[_handle.idx]);
 			m_vertexBuffers[_handle.idx].destroy();
 		}
 
@@ -2281,6 +2365,7 @@ VK_IMPORT_DEVICE
 
 		void destroyDynamicIndexBuffer(IndexBufferHandle _handle) override
 		{
+			invalidateDescriptorSetCache(m_indexBuffers[_handle.idx]);
 			m_indexBuffers[_handle.idx].destroy();
 		}
 
@@ -2297,6 +2382,7 @@ VK_IMPORT_DEVICE
 
 		void destroyDynamicVertexBuffer(VertexBufferHandle _handle) override
 		{
+			invalidateDescriptorSetCache(m_vertexBuffers[_handle.idx]);
 			m_vertexBuffers[_handle.idx].destroy();
 		}
 
@@ -2313,10 +2399,18 @@ VK_IMPORT_DEVICE
 		void createProgram(ProgramHandle _handle, ShaderHandle _vsh, ShaderHandle _fsh) override
 		{
 			m_program[_handle.idx].create(&m_shaders[_vsh.idx], isValid(_fsh) ? &m_shaders[_fsh.idx] : NULL);
+
+			if (m_pipelineCompileThread.isRunning()
+			||  m_pipelineReplay)
+			{
+				pipelineCompileProgram(_handle);
+			}
 		}
 
 		void destroyProgram(ProgramHandle _handle) override
 		{
+			pipelineCompileCancel(_handle);
+			invalidateDescriptorSetCache();
 			m_program[_handle.idx].destroy();
 		}
 
@@ -2408,6 +2502,7 @@ VK_IMPORT_DEVICE
 
 		void destroyTexture(TextureHandle _handle) override
 		{
+			invalidateDescriptorSetCache();
 			m_imageViewCache.invalidateWithParent(_handle.idx);
 			m_textures[_handle.idx].destroy();
 		}
@@ -2480,6 +2575,29 @@ VK_IMPORT_DEVICE
 			m_uniforms[_handle.idx] = NULL;
 		}
 
+		void replayPipelineManifest() override
+		{
+			if (0 == BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_FILE
+			||  m_pipelineKeys.empty() )
+			{
+				return;
+			}
+
+			// Create all recorded pipelines for programs that already exist,
+			// programs created before next frame are precompiled too. Next
+			// frame waits until all of them are created.
+			m_pipelineReplay = true;
+
+			for (uint16_t ii = 0; ii < BGFX_CONFIG_MAX_PROGRAMS; ++ii)
+			{
+				if (NULL != m_program[ii].m_vsh)
+				{
+					ProgramHandle handle = { ii };
+					pipelineCompileProgram(handle);
+				}
+			}
+		}
+
 		void requestScreenShot(FrameBufferHandle _fbh, const char* _filePath) override
 		{
 			const FrameBufferVK& frameBuffer = isValid(_fbh)
@@ -2792,6 +2910,7 @@ VK_IMPORT_DEVICE
 			if (m_depthClamp != depthClamp)
 			{
 				m_depthClamp = depthClamp;
+				pipelineCompileCancel(BGFX_INVALID_HANDLE);
 				m_pipelineStateCache.invalidate();
 			}
 
@@ -2955,6 +3074,7 @@ VK_IMPORT_DEVICE
 			if (m_wireframe != wireframe)
 			{
 				m_wireframe = wireframe;
+				pipelineCompileCancel(BGFX_INVALID_HANDLE);
 				m_pipelineStateCache.invalidate();
 			}
 		}
@@ -3345,6 +3465,22 @@ VK_IMPORT_DEVICE
 
 			m_renderPassCache.add(hashKey, renderPass);
 
+			if (BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_FILE)
+			{
+				RenderPassDescVK desc;
+				bx::memSet(&desc, 0, sizeof(desc) );
+				bx::memCopy(desc.m_formats, _formats, sizeof(VkFormat) * _num);
+				bx::memCopy(desc.m_aspects, _aspects, sizeof(VkImageAspectFlags) * _num);
+				if (NULL != _resolve)
+				{
+					bx::memCopy(desc.m_resolve, _resolve, sizeof(bool) * _num);
+				}
+				desc.m_samples    = _samples;
+				desc.m_num        = _num;
+				desc.m_hasResolve = NULL != _resolve;
+				m_renderPassDesc.push_back(stl::make_pair(renderPass, desc) );
+			}
+
 			*_renderPass = renderPass;
 
 			return result;
@@ -3523,6 +3659,13 @@ VK_IMPORT_DEVICE
 				| ( _stencil ? VK_IMAGE_ASPECT_STENCIL_BIT : VK_IMAGE_ASPECT_DEPTH_BIT)
 				;
 
+			if (MAX_CACHED_IMAGE_VIEWS == m_imageViewCache.getCount() )
+			{
+				// Adding view will evict least recently used view, which might
+				// be referenced by cached descriptor sets.
+				invalidateDescriptorSetCache();
+			}
+
 			VkImageView view;
 			VK_CHECK(texture.createView(0, texture.m_numSides, _mip, _numMips, _type, aspectMask, false, &view) );
 			m_imageViewCache.add(hashKey, view, _handle.idx);
@@ -3570,11 +3713,9 @@ VK_IMPORT_DEVICE
 			return pipeline;
 		}
 
-		VkPipeline getPipeline(uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, ProgramHandle _program, uint8_t _numInstanceData)
+		uint64_t getPipelineStateMask() const
 		{
-			ProgramVK& program = m_program[_program.idx];
-
-			_state &= 0
+			return 0
 				| BGFX_STATE_WRITE_MASK
 				| BGFX_STATE_DEPTH_TEST_MASK
 				| BGFX_STATE_BLEND_MASK
@@ -3588,14 +3729,15 @@ VK_IMPORT_DEVICE
 				| (g_caps.supported & BGFX_CAPS_CONSERVATIVE_RASTER ? BGFX_STATE_CONSERVATIVE_RASTER : 0)
 				| BGFX_STATE_PT_MASK
 				;
+		}
 
-			_stencil &= packStencil(~BGFX_STENCIL_FUNC_REF_MASK, ~BGFX_STENCIL_FUNC_REF_MASK);
-
+		uint32_t getPipelineHash(uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, const ProgramVK& _program, uint8_t _numInstanceData, VkRenderPass _renderPass)
+		{
 			VertexLayout layout;
 			if (0 < _numStreams)
 			{
 				bx::memCopy(&layout, _layouts[0], sizeof(VertexLayout) );
-				const uint16_t* attrMask = program.m_vsh->m_attrMask;
+				const uint16_t* attrMask = _program.m_vsh->m_attrMask;
 
 				for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
 				{
@@ -3605,21 +3747,16 @@ VK_IMPORT_DEVICE
 				}
 			}
 
-			const FrameBufferVK& frameBuffer = isValid(m_fbh)
-				? m_frameBuffers[m_fbh.idx]
-				: m_backBuffer
-				;
-
 			bx::HashMurmur2A murmur;
 			murmur.begin();
 			murmur.add(_state);
 			murmur.add(_stencil);
-			murmur.add(program.m_vsh->m_hash);
-			murmur.add(program.m_vsh->m_attrMask, sizeof(program.m_vsh->m_attrMask) );
+			murmur.add(_program.m_vsh->m_hash);
+			murmur.add(_program.m_vsh->m_attrMask, sizeof(_program.m_vsh->m_attrMask) );
 
-			if (NULL != program.m_fsh)
+			if (NULL != _program.m_fsh)
 			{
-				murmur.add(program.m_fsh->m_hash);
+				murmur.add(_program.m_fsh->m_hash);
 			}
 
 			for (uint8_t ii = 0; ii < _numStreams; ++ii)
@@ -3629,96 +3766,74 @@ VK_IMPORT_DEVICE
 
 			murmur.add(layout.m_attributes, sizeof(layout.m_attributes) );
 			murmur.add(_numInstanceData);
-			murmur.add(frameBuffer.m_renderPass);
-			const uint32_t hash = murmur.end();
-
-			VkPipeline pipeline = m_pipelineStateCache.find(hash);
-
-			if (VK_NULL_HANDLE != pipeline)
-			{
-				return pipeline;
-			}
+			murmur.add(_renderPass);
+			return murmur.end();
+		}
 
-			VkPipelineColorBlendAttachmentState blendAttachmentState[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
-			VkPipelineColorBlendStateCreateInfo colorBlendState;
-			colorBlendState.pAttachments = blendAttachmentState;
-			setBlendState(colorBlendState, _state);
+		void fillGraphicsPipeline(GraphicsPipelineCreateInfoVK& _gpci, uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, const ProgramVK& _program, uint8_t _numInstanceData, VkRenderPass _renderPass, VkSampleCountFlagBits _samples)
+		{
+			_gpci.m_colorBlendState.pAttachments = _gpci.m_blendAttachmentState;
+			setBlendState(_gpci.m_colorBlendState, _state);
 
-			VkPipelineInputAssemblyStateCreateInfo inputAssemblyState;
+			VkPipelineInputAssemblyStateCreateInfo& inputAssemblyState = _gpci.m_inputAssemblyState;
 			inputAssemblyState.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
 			inputAssemblyState.pNext = NULL;
 			inputAssemblyState.flags = 0;
 			inputAssemblyState.topology = s_primInfo[(_state&BGFX_STATE_PT_MASK) >> BGFX_STATE_PT_SHIFT].m_topology;
 			inputAssemblyState.primitiveRestartEnable = VK_FALSE;
 
-			VkPipelineRasterizationStateCreateInfo rasterizationState;
-			setRasterizerState(rasterizationState, _state, m_wireframe);
+			setRasterizerState(_gpci.m_rasterizationState, _state, m_wireframe);
 
-			VkBaseInStructure* nextRasterizationState = (VkBaseInStructure*)&rasterizationState;
+			VkBaseInStructure* nextRasterizationState = (VkBaseInStructure*)&_gpci.m_rasterizationState;
 
-			VkPipelineRasterizationConservativeStateCreateInfoEXT conservativeRasterizationState;
 			if (s_extension[Extension::EXT_conservative_rasterization].m_supported)
 			{
-				nextRasterizationState->pNext = (VkBaseInStructure*)&conservativeRasterizationState;
-				nextRasterizationState = (VkBaseInStructure*)&conservativeRasterizationState;
-				setConservativeRasterizerState(conservativeRasterizationState, _state);
+				nextRasterizationState->pNext = (VkBaseInStructure*)&_gpci.m_conservativeRasterizationState;
+				nextRasterizationState = (VkBaseInStructure*)&_gpci.m_conservativeRasterizationState;
+				setConservativeRasterizerState(_gpci.m_conservativeRasterizationState, _state);
 			}
 
-			VkPipelineRasterizationLineStateCreateInfoEXT lineRasterizationState;
 			if (m_lineAASupport)
 			{
-				nextRasterizationState->pNext = (VkBaseInStructure*)&lineRasterizationState;
-				nextRasterizationState = (VkBaseInStructure*)&lineRasterizationState;
-				setLineRasterizerState(lineRasterizationState, _state);
+				nextRasterizationState->pNext = (VkBaseInStructure*)&_gpci.m_lineRasterizationState;
+				nextRasterizationState = (VkBaseInStructure*)&_gpci.m_lineRasterizationState;
+				setLineRasterizerState(_gpci.m_lineRasterizationState, _state);
 			}
 
-			VkPipelineDepthStencilStateCreateInfo depthStencilState;
-			setDepthStencilState(depthStencilState, _state, _stencil);
+			setDepthStencilState(_gpci.m_depthStencilState, _state, _stencil);
 
-			VkVertexInputBindingDescription  inputBinding[BGFX_CONFIG_MAX_VERTEX_STREAMS + 1];
-			VkVertexInputAttributeDescription inputAttrib[Attrib::Count + BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT];
+			_gpci.m_vertexInputState.pVertexBindingDescriptions   = _gpci.m_inputBinding;
+			_gpci.m_vertexInputState.pVertexAttributeDescriptions = _gpci.m_inputAttrib;
+			setInputLayout(_gpci.m_vertexInputState, _numStreams, _layouts, _program, _numInstanceData);
 
-			VkPipelineVertexInputStateCreateInfo vertexInputState;
-			vertexInputState.pVertexBindingDescriptions   = inputBinding;
-			vertexInputState.pVertexAttributeDescriptions = inputAttrib;
-			setInputLayout(vertexInputState, _numStreams, _layouts, program, _numInstanceData);
-
-			const VkDynamicState dynamicStates[] =
-			{
-				VK_DYNAMIC_STATE_VIEWPORT,
-				VK_DYNAMIC_STATE_SCISSOR,
-				VK_DYNAMIC_STATE_BLEND_CONSTANTS,
-				VK_DYNAMIC_STATE_STENCIL_REFERENCE,
-			};
-
-			VkPipelineDynamicStateCreateInfo dynamicState;
+			VkPipelineDynamicStateCreateInfo& dynamicState = _gpci.m_dynamicState;
 			dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
 			dynamicState.pNext = NULL;
 			dynamicState.flags = 0;
-			dynamicState.dynamicStateCount = BX_COUNTOF(dynamicStates);
-			dynamicState.pDynamicStates    = dynamicStates;
+			dynamicState.dynamicStateCount = BX_COUNTOF(s_dynamicStates);
+			dynamicState.pDynamicStates    = s_dynamicStates;
 
-			VkPipelineShaderStageCreateInfo shaderStages[2];
+			VkPipelineShaderStageCreateInfo* shaderStages = _gpci.m_shaderStages;
 			shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 			shaderStages[0].pNext = NULL;
 			shaderStages[0].flags = 0;
 			shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
-			shaderStages[0].module = program.m_vsh->m_module;
+			shaderStages[0].module = _program.m_vsh->m_module;
 			shaderStages[0].pName  = "main";
 			shaderStages[0].pSpecializationInfo = NULL;
 
-			if (NULL != program.m_fsh)
+			if (NULL != _program.m_fsh)
 			{
 				shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 				shaderStages[1].pNext = NULL;
 				shaderStages[1].flags = 0;
 				shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-				shaderStages[1].module = program.m_fsh->m_module;
+				shaderStages[1].module = _program.m_fsh->m_module;
 				shaderStages[1].pName  = "main";
 				shaderStages[1].pSpecializationInfo = NULL;
 			}
 
-			VkPipelineViewportStateCreateInfo viewportState;
+			VkPipelineViewportStateCreateInfo& viewportState = _gpci.m_viewportState;
 			viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
 			viewportState.pNext = NULL;
 			viewportState.flags = 0;
@@ -3727,37 +3842,94 @@ VK_IMPORT_DEVICE
 			viewportState.scissorCount  = 1;
 			viewportState.pScissors     = NULL;
 
-			VkPipelineMultisampleStateCreateInfo multisampleState;
+			VkPipelineMultisampleStateCreateInfo& multisampleState = _gpci.m_multisampleState;
 			multisampleState.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
 			multisampleState.pNext = NULL;
 			multisampleState.flags = 0;
-			multisampleState.rasterizationSamples  = frameBuffer.m_sampler.Sample;
+			multisampleState.rasterizationSamples  = _samples;
 			multisampleState.sampleShadingEnable   = VK_FALSE;
 			multisampleState.minSampleShading      = 0.0f;
 			multisampleState.pSampleMask           = NULL;
 			multisampleState.alphaToCoverageEnable = !!(BGFX_STATE_BLEND_ALPHA_TO_COVERAGE & _state);
 			multisampleState.alphaToOneEnable      = VK_FALSE;
 
-			VkGraphicsPipelineCreateInfo graphicsPipeline;
+			VkGraphicsPipelineCreateInfo& graphicsPipeline = _gpci.m_graphicsPipeline;
 			graphicsPipeline.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
 			graphicsPipeline.pNext = NULL;
 			graphicsPipeline.flags = 0;
-			graphicsPipeline.stageCount = NULL == program.m_fsh ? 1 : 2;
+			graphicsPipeline.stageCount = NULL == _program.m_fsh ? 1 : 2;
 			graphicsPipeline.pStages    = shaderStages;
-			graphicsPipeline.pVertexInputState   = &vertexInputState;
+			graphicsPipeline.pVertexInputState   = &_gpci.m_vertexInputState;
 			graphicsPipeline.pInputAssemblyState = &inputAssemblyState;
 			graphicsPipeline.pTessellationState  = NULL;
 			graphicsPipeline.pViewportState      = &viewportState;
-			graphicsPipeline.pRasterizationState = &rasterizationState;
+			graphicsPipeline.pRasterizationState = &_gpci.m_rasterizationState;
 			graphicsPipeline.pMultisampleState   = &multisampleState;
-			graphicsPipeline.pDepthStencilState  = &depthStencilState;
-			graphicsPipeline.pColorBlendState    = &colorBlendState;
+			graphicsPipeline.pDepthStencilState  = &_gpci.m_depthStencilState;
+			graphicsPipeline.pColorBlendState    = &_gpci.m_colorBlendState;
 			graphicsPipeline.pDynamicState       = &dynamicState;
-			graphicsPipeline.layout     = program.m_pipelineLayout;
-			graphicsPipeline.renderPass = frameBuffer.m_renderPass;
+			graphicsPipeline.layout     = _program.m_pipelineLayout;
+			graphicsPipeline.renderPass = _renderPass;
 			graphicsPipeline.subpass    = 0;
 			graphicsPipeline.basePipelineHandle = VK_NULL_HANDLE;
 			graphicsPipeline.basePipelineIndex  = 0;
+		}
+
+		VkPipeline getPipeline(uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, ProgramHandle _program, uint8_t _numInstanceData)
+		{
+			ProgramVK& program = m_program[_program.idx];
+
+			_state   &= getPipelineStateMask();
+			_stencil &= packStencil(~BGFX_STENCIL_FUNC_REF_MASK, ~BGFX_STENCIL_FUNC_REF_MASK);
+
+			const FrameBufferVK& frameBuffer = isValid(m_fbh)
+				? m_frameBuffers[m_fbh.idx]
+				: m_backBuffer
+				;
+
+			const uint32_t hash = getPipelineHash(_state, _stencil, _numStreams, _layouts, program, _numInstanceData, frameBuffer.m_renderPass);
+
+			VkPipeline pipeline = m_pipelineStateCache.find(hash);
+
+			if (VK_NULL_HANDLE != pipeline)
+			{
+				return pipeline;
+			}
+
+			if (m_pipelineCompilePending.end() != m_pipelineCompilePending.find(hash) )
+			{
+				pipelineCompileWait(hash);
+
+				pipeline = m_pipelineStateCache.find(hash);
+
+				if (VK_NULL_HANDLE != pipeline)
+				{
+					return pipeline;
+				}
+			}
+
+			GraphicsPipelineCreateInfoVK gpci;
+			fillGraphicsPipeline(gpci, _state, _stencil, _numStreams, _layouts, program, _numInstanceData, frameBuffer.m_renderPass, frameBuffer.m_sampler.Sample);
+
+			if (BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_FILE)
+			{
+				const int64_t timeBegin = bx::getHPCounter();
+				VK_CHECK(vkCreateGraphicsPipelines(
+					  m_device
+					, m_pipelineCache
+					, 1
+					, &gpci.m_graphicsPipeline
+					, m_allocatorCb
+					, &pipeline
+					) );
+				const int64_t cpuTime = bx::getHPCounter() - timeBegin;
+				m_pipelineStateCache.add(hash, pipeline);
+
+				const uint32_t keyHash = recordPipelineKey(_state, _stencil, _numStreams, _layouts, program, _numInstanceData, frameBuffer.m_renderPass, cpuTime);
+				m_pipelineStats.add(0 != keyHash ? keyHash : hash, cpuTime, false);
+
+				return pipeline;
+			}
 
 			uint32_t length = g_callback->cacheReadSize(hash);
 			bool cached = length > 0;
@@ -3787,14 +3959,16 @@ VK_IMPORT_DEVICE
 			VkPipelineCache cache;
 			VK_CHECK(vkCreatePipelineCache(m_device, &pcci, m_allocatorCb, &cache) );
 
+			const int64_t timeBegin = bx::getHPCounter();
 			VK_CHECK(vkCreateGraphicsPipelines(
 				  m_device
 				, cache
 				, 1
-				, &graphicsPipeline
+				, &gpci.m_graphicsPipeline
 				, m_allocatorCb
 				, &pipeline
 				) );
+			m_pipelineStats.add(hash, bx::getHPCounter() - timeBegin, false);
 			m_pipelineStateCache.add(hash, pipeline);
 
 			size_t dataSize;
@@ -3822,9 +3996,544 @@ VK_IMPORT_DEVICE
 			return pipeline;
 		}
 
+		uint32_t recordPipelineKey(uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, const ProgramVK& _program, uint8_t _numInstanceData, VkRenderPass _renderPass, int64_t _cpuTime)
+		{
+			m_pipelineCacheDirty      = true;
+			m_pipelineCacheIdleFrames = 0;
+
+			const RenderPassDescVK* renderPassDesc = NULL;
+			for (RenderPassDescArray::const_iterator it = m_renderPassDesc.begin(), itEnd = m_renderPassDesc.end(); it != itEnd; ++it)
+			{
+				if (it->first.vk == _renderPass.vk)
+				{
+					renderPassDesc = &it->second;
+					break;
+				}
+			}
+
+			if (NULL == renderPassDesc)
+			{
+				return 0;
+			}
+
+			PipelineKeyVK key;
+			bx::memSet(&key, 0, sizeof(key) );
+			key.m_state   = _state;
+			key.m_stencil = _stencil;
+			key.m_vshHash = _program.m_vsh->m_hash;
+			key.m_fshHash = NULL != _program.m_fsh ? _program.m_fsh->m_hash : 0;
+
+			for (uint8_t ii = 0; ii < _numStreams; ++ii)
+			{
+				bx::memCopy(&key.m_layouts[ii], _layouts[ii], sizeof(VertexLayout) );
+			}
+
+			bx::memCopy(&key.m_renderPass, renderPassDesc, sizeof(RenderPassDescVK) );
+			key.m_numStreams      = _numStreams;
+			key.m_numInstanceData = _numInstanceData;
+
+			const uint32_t keyHash = bx::hash<bx::HashMurmur2A>(&key, sizeof(key) );
+			const uint32_t keyTime = toMicroseconds(_cpuTime);
+
+			PipelineKeyMap::iterator it = m_pipelineKeyMap.find(keyHash);
+
+			if (it != m_pipelineKeyMap.end() )
+			{
+				m_pipelineKeyTime[it->second] = keyTime;
+			}
+			else if (MAX_PIPELINE_CACHE_KEYS > m_pipelineKeys.size() )
+			{
+				m_pipelineKeyMap.insert(stl::make_pair(keyHash, uint32_t(m_pipelineKeys.size() ) ) );
+				m_pipelineKeys.push_back(key);
+				m_pipelineKeyTime.push_back(keyTime);
+			}
+
+			return keyHash;
+		}
+
+		static uint32_t toMicroseconds(int64_t _cpuTime)
+		{
+			return uint32_t(bx::min<int64_t>(_cpuTime * 1000000 / bx::getHPFrequency(), UINT32_MAX) );
+		}
+
+		void loadPipelineCache(VkPipelineCacheCreateInfo& _pcci, const void* _data, uint32_t _size)
+		{
+			bx::MemoryReader reader(_data, _size);
+			bx::Error err;
+
+			PipelineCacheHeaderVK header;
+			bx::read(&reader, header, &err);
+
+			const uint64_t keysSize = uint64_t(header.m_numKeys) * (sizeof(PipelineKeyVK) + sizeof(uint32_t) );
+
+			if (!err.isOk()
+			||  kPipelineCacheMagic    != header.m_magic
+			||  sizeof(PipelineKeyVK) != header.m_keySize
+			||  uint64_t(reader.remaining() ) < keysSize + header.m_dataSize)
+			{
+				BX_TRACE("Pipeline cache blob is invalid or out of date, ignoring it.");
+				return;
+			}
+
+			const uint32_t numKeys = bx::min<uint32_t>(header.m_numKeys, MAX_PIPELINE_CACHE_KEYS);
+
+			// Keys and their creation times (in microseconds) are not aligned
+			// in blob.
+			if (0 < numKeys)
+			{
+				m_pipelineKeys.resize(numKeys);
+				m_pipelineKeyTime.resize(numKeys);
+				bx::memCopy(&m_pipelineKeys[0], reader.getDataPtr(), numKeys * sizeof(PipelineKeyVK) );
+				reader.seek(int64_t(header.m_numKeys) * sizeof(PipelineKeyVK), bx::Whence::Current);
+				bx::memCopy(&m_pipelineKeyTime[0], reader.getDataPtr(), numKeys * sizeof(uint32_t) );
+				reader.seek(int64_t(header.m_numKeys) * sizeof(uint32_t), bx::Whence::Current);
+			}
+
+			for (uint32_t ii = 0; ii < numKeys; ++ii)
+			{
+				m_pipelineKeyMap.insert(stl::make_pair(bx::hash<bx::HashMurmur2A>(&m_pipelineKeys[ii], sizeof(PipelineKeyVK) ), ii) );
+			}
+
+			// Recorded pipelines are still useful to precompile on another
+			// device or driver, but driver's data is not.
+			if (m_deviceProperties.vendorID      == header.m_vendorId
+			&&  m_deviceProperties.deviceID      == header.m_deviceId
+			&&  m_deviceProperties.driverVersion == header.m_driverVersion
+			&&  0 == bx::memCmp(m_deviceProperties.pipelineCacheUUID, header.m_uuid, VK_UUID_SIZE) )
+			{
+				_pcci.initialDataSize = header.m_dataSize;
+				_pcci.pInitialData    = reader.getDataPtr();
+			}
+
+			BX_TRACE("Loaded pipeline cache blob (%d pipelines, %d bytes of driver data)."
+				, numKeys
+				, uint32_t(_pcci.initialDataSize)
+				);
+		}
+
+		void savePipelineCache()
+		{
+			BGFX_PROFILER_SCOPE("RendererContextVK::savePipelineCache", kColorResource);
+
+			m_pipelineCacheDirty      = false;
+			m_pipelineCacheIdleFrames = 0;
+
+			size_t dataSize = 0;
+			VK_CHECK(vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, NULL) );
+
+			const uint32_t numKeys  = uint32_t(m_pipelineKeys.size() );
+			const uint32_t keysSize = numKeys * sizeof(PipelineKeyVK);
+			const uint32_t timeSize = numKeys * sizeof(uint32_t);
+			const uint32_t offset   = sizeof(PipelineCacheHeaderVK) + keysSize + timeSize;
+			uint8_t* data = (uint8_t*)bx::alloc(g_allocator, offset + dataSize);
+
+			// Background compile might grow cache in between, in which case
+			// driver returns VK_INCOMPLETE with data that fits.
+			const VkResult result = vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, data + offset);
+
+			if (VK_SUCCESS == result
+			||  VK_INCOMPLETE == result)
+			{
+				PipelineCacheHeaderVK header;
+				bx::memSet(&header, 0, sizeof(header) );
+				header.m_magic         = kPipelineCacheMagic;
+				header.m_keySize       = sizeof(PipelineKeyVK);
+				header.m_vendorId      = m_deviceProperties.vendorID;
+				header.m_deviceId      = m_deviceProperties.deviceID;
+				header.m_driverVersion = m_deviceProperties.driverVersion;
+				bx::memCopy(header.m_uuid, m_deviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+				header.m_numKeys  = numKeys;
+				header.m_dataSize = uint32_t(dataSize);
+
+				bx::memCopy(data, &header, sizeof(header) );
+
+				if (0 < numKeys)
+				{
+					bx::memCopy(data + sizeof(header), &m_pipelineKeys[0], keysSize);
+					bx::memCopy(data + sizeof(header) + keysSize, &m_pipelineKeyTime[0], timeSize);
+				}
+
+				g_callback->cacheWrite(kPipelineCacheId, data, offset + uint32_t(dataSize) );
+			}
+			else
+			{
+				BX_TRACE("Save pipeline cache error: vkGetPipelineCacheData failed %d: %s.", result, getName(result) );
+			}
+
+			bx::free(g_allocator, data);
+		}
+
+		void pipelineCompileProgram(ProgramHandle _program)
+		{
+			const ProgramVK& program = m_program[_program.idx];
+			const uint32_t vshHash = program.m_vsh->m_hash;
+			const uint32_t fshHash = NULL != program.m_fsh ? program.m_fsh->m_hash : 0;
+			const bool async = m_pipelineCompileThread.isRunning();
+
+			uint32_t numJobs = 0;
+
+			for (uint32_t ii = 0, num = uint32_t(m_pipelineKeys.size() ); ii < num; ++ii)
+			{
+				const PipelineKeyVK& key = m_pipelineKeys[ii];
+
+				if (vshHash != key.m_vshHash
+				||  fshHash != key.m_fshHash)
+				{
+					continue;
+				}
+
+				const RenderPassDescVK& desc = key.m_renderPass;
+
+				VkRenderPass renderPass;
+				VkResult result = getRenderPass(
+					  desc.m_num
+					, desc.m_formats
+					, desc.m_aspects
+					, desc.m_hasResolve ? desc.m_resolve : NULL
+					, VkSampleCountFlagBits(desc.m_samples)
+					, &renderPass
+					);
+
+				if (VK_SUCCESS != result)
+				{
+					continue;
+				}
+
+				const VertexLayout* layouts[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+				for (uint8_t stream = 0; stream < key.m_numStreams; ++stream)
+				{
+					layouts[stream] = &key.m_layouts[stream];
+				}
+
+				const uint32_t hash = getPipelineHash(key.m_state, key.m_stencil, key.m_numStreams, layouts, program, key.m_numInstanceData, renderPass);
+
+				if (VK_NULL_HANDLE != m_pipelineStateCache.find(hash)
+				||  m_pipelineCompilePending.end() != m_pipelineCompilePending.find(hash) )
+				{
+					continue;
+				}
+
+				PipelineCompileJobVK* job = BX_NEW(g_allocator, PipelineCompileJobVK);
+				fillGraphicsPipeline(job->m_gpci, key.m_state, key.m_stencil, key.m_numStreams, layouts, program, key.m_numInstanceData, renderPass, VkSampleCountFlagBits(desc.m_samples) );
+				job->m_program  = _program;
+				job->m_hash     = hash;
+				job->m_keyIndex = ii;
+				job->m_keyTime  = m_pipelineKeyTime[ii];
+				job->m_cpuTime  = 0;
+				job->m_result   = VK_NOT_READY;
+				job->m_pipeline = VK_NULL_HANDLE;
+
+				if (!async)
+				{
+					pipelineCompileExecute(job);
+					pipelineCompileFinish(job);
+					continue;
+				}
+
+				m_pipelineCompilePending.insert(hash);
+
+				{
+					bx::MutexScope lock(m_pipelineCompileLock);
+					m_pipelineCompileQueue.push_back(job);
+				}
+
+				++numJobs;
+			}
+
+			if (0 < numJobs)
+			{
+				{
+					// Start with pipelines that took longest to create when
+					// they were recorded, so they don't end up last.
+					bx::MutexScope lock(m_pipelineCompileLock);
+					bx::quickSort(
+						  &m_pipelineCompileQueue[0]
+						, uint32_t(m_pipelineCompileQueue.size() )
+						, sizeof(PipelineCompileJobVK*)
+						, [](const void* _lhs, const void* _rhs) -> int32_t {
+							const PipelineCompileJobVK* lhs = *(const PipelineCompileJobVK**)_lhs;
+							const PipelineCompileJobVK* rhs = *(const PipelineCompileJobVK**)_rhs;
+							return lhs->m_keyTime > rhs->m_keyTime ? -1 : lhs->m_keyTime < rhs->m_keyTime ? 1 : 0;
+						});
+				}
+
+				m_pipelineCompileSem.post(numJobs);
+			}
+		}
+
+		static int32_t pipelineCompileThread(bx::Thread* /*_self*/, void* _userData)
+		{
+			BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - Pipeline Compile Thread");
+
+			RendererContextVK* ctx = (RendererContextVK*)_userData;
+
+			for (;;)
+			{
+				ctx->m_pipelineCompileSem.wait();
+
+				if (ctx->m_pipelineCompileExit)
+				{
+					break;
+				}
+
+				PipelineCompileJobVK* job = NULL;
+
+				{
+					bx::MutexScope lock(ctx->m_pipelineCompileLock);
+
+					// Queue might be already emptied by cancel or wait on
+					// render thread, in which case there is nothing to do.
+					if (!ctx->m_pipelineCompileQueue.empty() )
+					{
+						job = ctx->m_pipelineCompileQueue.front();
+						ctx->m_pipelineCompileQueue.erase(ctx->m_pipelineCompileQueue.begin() );
+						ctx->m_pipelineCompileActive = job;
+					}
+				}
+
+				if (NULL != job)
+				{
+					ctx->pipelineCompileExecute(job);
+
+					bx::MutexScope lock(ctx->m_pipelineCompileLock);
+					ctx->m_pipelineCompileDone.push_back(job);
+					ctx->m_pipelineCompileActive = NULL;
+				}
+			}
+
+			return bx::kExitSuccess;
+		}
+
+		void pipelineCompileExecute(PipelineCompileJobVK* _job)
+		{
+			const int64_t timeBegin = bx::getHPCounter();
+			_job->m_result = vkCreateGraphicsPipelines(
+				  m_device
+				, m_pipelineCache
+				, 1
+				, &_job->m_gpci.m_graphicsPipeline
+				, m_allocatorCb
+				, &_job->m_pipeline
+				);
+			_job->m_cpuTime = bx::getHPCounter() - timeBegin;
+		}
+
+		void pipelineCompileFinish(PipelineCompileJobVK* _job)
+		{
+			m_pipelineCompilePending.erase(_job->m_hash);
+
+			if (VK_SUCCESS == _job->m_result)
+			{
+				m_pipelineStateCache.add(_job->m_hash, _job->m_pipeline);
+				m_pipelineCacheDirty      = true;
+				m_pipelineCacheIdleFrames = 0;
+
+				m_pipelineKeyTime[_job->m_keyIndex] = toMicroseconds(_job->m_cpuTime);
+				m_pipelineStats.add(
+					  bx::hash<bx::HashMurmur2A>(&m_pipelineKeys[_job->m_keyIndex], sizeof(PipelineKeyVK) )
+					, _job->m_cpuTime
+					, true
+					);
+			}
+			else
+			{
+				BX_TRACE("Pipeline precompile error: vkCreateGraphicsPipelines failed %d: %s.", _job->m_result, getName(_job->m_result) );
+			}
+
+			bx::deleteObject(g_allocator, _job);
+		}
+
+		void pipelineCompileCollect()
+		{
+			if (m_pipelineCompilePending.empty() )
+			{
+				return;
+			}
+
+			bx::MutexScope lock(m_pipelineCompileLock);
+
+			for (uint32_t ii = 0, num = uint32_t(m_pipelineCompileDone.size() ); ii < num; ++ii)
+			{
+				pipelineCompileFinish(m_pipelineCompileDone[ii]);
+			}
+
+			m_pipelineCompileDone.clear();
+		}
+
+		void pipelineCompileWait(uint32_t _hash)
+		{
+			BGFX_PROFILER_SCOPE("RendererContextVK::pipelineCompileWait", kColorResource);
+
+			PipelineCompileJobVK* job = NULL;
+
+			{
+				bx::MutexScope lock(m_pipelineCompileLock);
+
+				for (PipelineCompileJobArray::iterator it = m_pipelineCompileQueue.begin(), itEnd = m_pipelineCompileQueue.end(); it != itEnd; ++it)
+				{
+					if (_hash == (*it)->m_hash)
+					{
+						job = *it;
+						m_pipelineCompileQueue.erase(it);
+						break;
+					}
+				}
+			}
+
+			if (NULL != job)
+			{
+				// Not picked up by compile thread yet, compile it right away
+				// instead of waiting for the rest of the queue.
+				pipelineCompileExecute(job);
+				pipelineCompileFinish(job);
+				return;
+			}
+
+			for (;;)
+			{
+				pipelineCompileCollect();
+
+				if (m_pipelineCompilePending.end() == m_pipelineCompilePending.find(_hash) )
+				{
+					break;
+				}
+
+				bx::yield();
+			}
+		}
+
+		void pipelineCompileWaitAll()
+		{
+			BGFX_PROFILER_SCOPE("RendererContextVK::pipelineCompileWaitAll", kColorResource);
+
+			while (!m_pipelineCompilePending.empty() )
+			{
+				PipelineCompileJobVK* job = NULL;
+
+				{
+					bx::MutexScope lock(m_pipelineCompileLock);
+
+					if (!m_pipelineCompileQueue.empty() )
+					{
+						job = m_pipelineCompileQueue.front();
+						m_pipelineCompileQueue.erase(m_pipelineCompileQueue.begin() );
+					}
+				}
+
+				// Help compile thread while waiting.
+				if (NULL != job)
+				{
+					pipelineCompileExecute(job);
+					pipelineCompileFinish(job);
+				}
+				else
+				{
+					pipelineCompileCollect();
+
+					if (!m_pipelineCompilePending.empty() )
+					{
+						bx::yield();
+					}
+				}
+			}
+		}
+
+		void pipelineCompileCancel(ProgramHandle _program)
+		{
+			if (m_pipelineCompilePending.empty() )
+			{
+				return;
+			}
+
+			bool active;
+
+			{
+				bx::MutexScope lock(m_pipelineCompileLock);
+
+				for (uint32_t ii = 0; ii < m_pipelineCompileQueue.size();)
+				{
+					PipelineCompileJobVK* job = m_pipelineCompileQueue[ii];
+
+					if (!isValid(_program)
+					||  _program.idx == job->m_program.idx)
+					{
+						m_pipelineCompileQueue.erase(m_pipelineCompileQueue.begin() + ii);
+						m_pipelineCompilePending.erase(job->m_hash);
+						bx::deleteObject(g_allocator, job);
+					}
+					else
+					{
+						++ii;
+					}
+				}
+
+				active = NULL != m_pipelineCompileActive;
+			}
+
+			// Job in flight references program's shader modules and pipeline
+			// layout, wait for it before they are destroyed.
+			while (active)
+			{
+				bx::yield();
+
+				bx::MutexScope lock(m_pipelineCompileLock);
+				active = NULL != m_pipelineCompileActive;
+			}
+
+			pipelineCompileCollect();
+		}
+
+		void invalidateDescriptorSetCache()
+		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_descriptorSetCache); ++ii)
+			{
+				m_descriptorSetCache[ii].invalidate();
+			}
+		}
+
+		void invalidateDescriptorSetCache(const BufferVK& _buffer)
+		{
+			// Only storage buffers can be bound through descriptor sets, vertex
+			// and index buffers used just for drawing are never referenced.
+			if (0 != (_buffer.m_flags & (BGFX_BUFFER_COMPUTE_READ_WRITE|BGFX_BUFFER_DRAW_INDIRECT) ) )
+			{
+				invalidateDescriptorSetCache();
+			}
+		}
+
 		VkDescriptorSet getDescriptorSet(const ProgramVK& program, const RenderBind& renderBind, const ScratchBufferVK& scratchBuffer, const float _palette[][4])
 		{
-			VkDescriptorSet descriptorSet;
+			const uint32_t vsize = program.m_vsh->m_size;
+			const uint32_t fsize = NULL != program.m_fsh ? program.m_fsh->m_size : 0;
+
+			// Descriptor sets reference frame's scratch buffer, and are cached per
+			// frame in flight. Uniform data offsets are passed as dynamic offsets.
+			StateCacheT<VkDescriptorSet>& descriptorSetCache = m_descriptorSetCache[m_cmd.m_currentFrameInFlight];
+
+			bx::HashMurmur2A hash;
+			hash.begin();
+			hash.add(uint32_t(&program - m_program) );
+			hash.add(program.m_descriptorSetLayout);
+			hash.add(renderBind.m_bind, sizeof(renderBind.m_bind) );
+			hash.add(vsize);
+			hash.add(fsize);
+			hash.add(NULL != _palette);
+			const uint32_t hashKey = hash.end();
+
+			VkDescriptorSet descriptorSet = descriptorSetCache.find(hashKey);
+
+			if (VK_NULL_HANDLE != descriptorSet)
+			{
+				++m_descriptorSetCacheHits;
+				return descriptorSet;
+			}
+
+			++m_descriptorSetCacheMisses;
+
+			if (MAX_CACHED_DESCRIPTOR_SETS <= descriptorSetCache.getCount() )
+			{
+				descriptorSetCache.invalidate();
+			}
 
 			VkDescriptorSetAllocateInfo dsai;
 			dsai.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
@@ -3996,9 +4705,6 @@ VK_IMPORT_DEVICE
 				}
 			}
 
-			const uint32_t vsize = program.m_vsh->m_size;
-			const uint32_t fsize = NULL != program.m_fsh ? program.m_fsh->m_size : 0;
-
 			if (vsize > 0)
 			{
 				bufferInfo[bufferCount].buffer = scratchBuffer.m_buffer;
@@ -4041,8 +4747,7 @@ VK_IMPORT_DEVICE
 
 			vkUpdateDescriptorSets(m_device, wdsCount, wds, 0, NULL);
 
-			VkDescriptorSet temp = descriptorSet;
-			release(temp);
+			descriptorSetCache.add(hashKey, descriptorSet);
 
 			return descriptorSet;
 		}
@@ -4564,7 +5269,33 @@ VK_IMPORT_DEVICE
 		StateCacheT<VkRenderPass> m_renderPassCache;
 		StateCacheT<VkSampler> m_samplerCache;
 		StateCacheT<uint32_t> m_samplerBorderColorCache;
-		StateCacheLru<VkImageView, 1024> m_imageViewCache;
+		StateCacheLru<VkImageView, MAX_CACHED_IMAGE_VIEWS> m_imageViewCache;
+		StateCacheT<VkDescriptorSet> m_descriptorSetCache[BGFX_CONFIG_MAX_FRAME_LATENCY];
+		float m_descriptorSetPalette[BGFX_CONFIG_MAX_COLOR_PALETTE][4];
+		uint32_t m_descriptorSetCacheHits;
+		uint32_t m_descriptorSetCacheMisses;
+
+		typedef stl::vector<stl::pair<VkRenderPass, RenderPassDescVK> > RenderPassDescArray;
+		RenderPassDescArray m_renderPassDesc;
+
+		typedef stl::unordered_map<uint32_t, uint32_t> PipelineKeyMap;
+		stl::vector<PipelineKeyVK> m_pipelineKeys;
+		stl::vector<uint32_t> m_pipelineKeyTime;
+		PipelineKeyMap m_pipelineKeyMap;
+		PipelineStatsCollector m_pipelineStats;
+		bool m_pipelineReplay;
+		bool m_pipelineCacheDirty;
+		uint32_t m_pipelineCacheIdleFrames;
+
+		typedef stl::vector<PipelineCompileJobVK*> PipelineCompileJobArray;
+		PipelineCompileJobArray m_pipelineCompileQueue;
+		PipelineCompileJobArray m_pipelineCompileDone;
+		PipelineCompileJobVK* m_pipelineCompileActive;
+		stl::unordered_set<uint32_t> m_pipelineCompilePending;
+		bx::Thread    m_pipelineCompileThread;
+		bx::Semaphore m_pipelineCompileSem;
+		bx::Mutex     m_pipelineCompileLock;
+		bool          m_pipelineCompileExit;
 
 		Resolution m_resolution;
 		float m_maxAnisotropy;
@@ -8455,6 +9186,34 @@ VK_DESTROY
 
 		_render->sort();
 
+		if (0 != bx::memCmp(m_descriptorSetPalette, _render->m_colorPalette, sizeof(m_descriptorSetPalette) ) )
+		{
+			// Cached descriptor sets might reference border color samplers
+			// created from previous palette.
+			bx::memCopy(m_descriptorSetPalette, _render->m_colorPalette, sizeof(m_descriptorSetPalette) );
+			invalidateDescriptorSetCache();
+		}
+
+		m_descriptorSetCacheHits   = 0;
+		m_descriptorSetCacheMisses = 0;
+
+		if (m_pipelineReplay)
+		{
+			pipelineCompileWaitAll();
+			m_pipelineReplay = false;
+		}
+		else
+		{
+			pipelineCompileCollect();
+		}
+
+		if (0 != BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_SAVE_FRAMES
+		&&  m_pipelineCacheDirty
+		&&  ++m_pipelineCacheIdleFrames >= BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_SAVE_FRAMES)
+		{
+			savePipelineCache();
+		}
+
 		RenderDraw currentState;
 		currentState.clear();
 		currentState.m_stateFlags = BGFX_STATE_NONE;
@@ -9326,6 +10085,8 @@ VK_DESTROY
 		perfStats.gpuMemoryMax  = gpuMemoryAvailable;
 		perfStats.gpuMemoryUsed = gpuMemoryUsed;
 
+		m_pipelineStats.flush(_render);
+
 		if (_render->m_debug & (BGFX_DEBUG_IFH|BGFX_DEBUG_STATS) )
 		{
 			BGFX_VK_PROFILER_BEGIN_LITERAL("debugstats", kColorFrame);
@@ -9443,6 +10204,13 @@ VK_DESTROY
 					, m_descriptorSetLayoutCache.getCount()
 					, descriptorSetCount
 					);
+				tvm.printf(10, pos++, 0x8b, " DS cache: %6d hit, %6d miss "
+					, m_descriptorSetCacheHits
+					, m_descriptorSetCacheMisses
+					);
+				tvm.printf(10, pos++, 0x8b, " PSO precompile: %6d pending "
+					, uint32_t(m_pipelineCompilePending.size() )
+					);
 				pos++;
 
 				double captureMs = double(captureElapsed)*toMs;
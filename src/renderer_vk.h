@@ -372,6 +372,64 @@ VK_DESTROY_FUNC(DescriptorSet);
 		HashMap m_hashMap;
 	};
 
+	struct RenderPassDescVK
+	{
+		VkFormat           m_formats[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+		VkImageAspectFlags m_aspects[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+		bool               m_resolve[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+		uint32_t           m_samples;
+		uint8_t            m_num;
+		bool               m_hasResolve;
+	};
+
+	// Everything needed to recreate graphics pipeline in another run, stored
+	// in pipeline cache blob. Must be cleared before filling since it's hashed
+	// and serialized as is.
+	struct PipelineKeyVK
+	{
+		uint64_t         m_state;
+		uint64_t         m_stencil;
+		uint32_t         m_vshHash;
+		uint32_t         m_fshHash;
+		VertexLayout     m_layouts[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+		RenderPassDescVK m_renderPass;
+		uint8_t          m_numStreams;
+		uint8_t          m_numInstanceData;
+	};
+
+	// Graphics pipeline create info with all the state it points to, so that
+	// it can be handed to another thread.
+	struct GraphicsPipelineCreateInfoVK
+	{
+		VkPipelineColorBlendAttachmentState    m_blendAttachmentState[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+		VkPipelineColorBlendStateCreateInfo    m_colorBlendState;
+		VkPipelineInputAssemblyStateCreateInfo m_inputAssemblyState;
+		VkPipelineRasterizationStateCreateInfo m_rasterizationState;
+		VkPipelineRasterizationConservativeStateCreateInfoEXT m_conservativeRasterizationState;
+		VkPipelineRasterizationLineStateCreateInfoEXT m_lineRasterizationState;
+		VkPipelineDepthStencilStateCreateInfo  m_depthStencilState;
+		VkVertexInputBindingDescription        m_inputBinding[BGFX_CONFIG_MAX_VERTEX_STREAMS + 1];
+		VkVertexInputAttributeDescription      m_inputAttrib[Attrib::Count + BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT];
+		VkPipelineVertexInputStateCreateInfo   m_vertexInputState;
+		VkPipelineDynamicStateCreateInfo       m_dynamicState;
+		VkPipelineShaderStageCreateInfo        m_shaderStages[2];
+		VkPipelineViewportStateCreateInfo      m_viewportState;
+		VkPipelineMultisampleStateCreateInfo   m_multisampleState;
+		VkGraphicsPipelineCreateInfo           m_graphicsPipeline;
+	};
+
+	struct PipelineCompileJobVK
+	{
+		GraphicsPipelineCreateInfoVK m_gpci;
+		ProgramHandle m_program;
+		uint32_t      m_hash;
+		uint32_t      m_keyIndex;
+		uint32_t      m_keyTime;
+		int64_t       m_cpuTime;
+		VkResult      m_result;
+		VkPipeline    m_pipeline;
+	};
+
 	struct StagingBufferVK
 	{
 		VkBuffer m_buffer;
@@ -5,6 +5,7 @@
 
 #include <bx/debug.h>
 #include <bx/hash.h>
+#include <bx/mutex.h>
 #include <bx/readerwriter.h>
 #include <bx/sort.h>
 #include <bx/string.h>
@@ -625,83 +626,367 @@ namespace bgfx
 		}
 	}
 
-	void vertexConvert(const VertexLayout& _destLayout, void* _destData, const VertexLayout& _srcLayout, const void* _srcData, uint32_t _num)
+	// Vertex conversion kernels. Each kernel handles one attribute type and
+	// component count combination for batch of vertices, so that per vertex
+	// work is straight-line code without decoding attribute or switching on
+	// its type. Conversion formulas match vertexUnpack / vertexPack.
+	//
+	// Unpack kernels write 4 floats per vertex (missing components are zero),
+	// and pack kernels read floats with arbitrary stride, so that pack can read
+	// directly from float source data when no unpack is necessary.
+	typedef void (*VertexUnpackFn)(float* _dst, const uint8_t* _src, uint32_t _srcStride, uint32_t _num);
+	typedef void (*VertexPackFn)(uint8_t* _dst, uint32_t _dstStride, const uint8_t* _src, uint32_t _srcStride, uint32_t _num);
+
+	template<uint8_t NumT, bool AsIntT>
+	static void vertexUnpackUint8(float* _dst, const uint8_t* _src, uint32_t _srcStride, uint32_t _num)
 	{
-		if (_destLayout.m_hash == _srcLayout.m_hash)
+		for (uint32_t ii = 0; ii < _num; ++ii, _dst += 4, _src += _srcStride)
 		{
-			bx::memCopy(_destData, _srcData, _srcLayout.getSize(_num) );
-			return;
+			for (uint32_t jj = 0; jj < 4; ++jj)
+			{
+				_dst[jj] = jj >= NumT ? 0.0f
+					: AsIntT ? (float(_src[jj]) - 128.0f)*1.0f/127.0f
+					:          float(_src[jj])*1.0f/255.0f
+					;
+			}
 		}
+	}
 
-		struct ConvertOp
+	template<uint8_t NumT, bool AsIntT>
+	static void vertexUnpackUint10(float* _dst, const uint8_t* _src, uint32_t _srcStride, uint32_t _num)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii, _dst += 4, _src += _srcStride)
 		{
-			Attrib::Enum attr;
-			uint32_t src;
-			uint32_t dest;
-			uint32_t size;
-		};
+			uint32_t packed = *(const uint32_t*)_src;
 
-		ConvertOp convertOp[Attrib::Count];
-		uint32_t numOps = 0;
+			for (uint32_t jj = 0; jj < 4; ++jj, packed >>= 10)
+			{
+				_dst[jj] = jj >= bx::min<uint8_t>(NumT, 3) ? 0.0f
+					: AsIntT ? (float(packed & 0x3ff) - 512.0f)*1.0f/511.0f
+					:          float(packed & 0x3ff)*1.0f/1023.0f
+					;
+			}
+		}
+	}
 
-		const uint8_t* src = (const uint8_t*)_srcData;
-		uint32_t srcStride = _srcLayout.getStride();
+	template<uint8_t NumT, bool AsIntT>
+	static void vertexUnpackInt16(float* _dst, const uint8_t* _src, uint32_t _srcStride, uint32_t _num)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii, _dst += 4, _src += _srcStride)
+		{
+			const int16_t* packed = (const int16_t*)_src;
 
-		uint8_t* dest       = (uint8_t*)_destData;
-		uint32_t destStride = _destLayout.getStride();
+			for (uint32_t jj = 0; jj < 4; ++jj)
+			{
+				_dst[jj] = jj >= NumT ? 0.0f
+					: AsIntT ? float(packed[jj])*1.0f/32767.0f
+					:          (float(packed[jj]) + 32768.0f)*1.0f/65535.0f
+					;
+			}
+		}
+	}
+
+	template<uint8_t NumT, bool AsIntT>
+	static void vertexUnpackHalf(float* _dst, const uint8_t* _src, uint32_t _srcStride, uint32_t _num)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii, _dst += 4, _src += _srcStride)
+		{
+			const uint16_t* packed = (const uint16_t*)_src;
+
+			for (uint32_t jj = 0; jj < 4; ++jj)
+			{
+				_dst[jj] = jj < NumT ? bx::halfToFloat(packed[jj]) : 0.0f;
+			}
+		}
+	}
+
+	template<uint8_t NumT, bool AsIntT>
+	static void vertexUnpackFloat(float* _dst, const uint8_t* _src, uint32_t _srcStride, uint32_t _num)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii, _dst += 4, _src += _srcStride)
+		{
+			const float* input = (const float*)_src;
+
+			for (uint32_t jj = 0; jj < 4; ++jj)
+			{
+				_dst[jj] = jj < NumT ? input[jj] : 0.0f;
+			}
+		}
+	}
+
+	template<uint8_t NumT, bool AsIntT>
+	static void vertexPackUint8(uint8_t* _dst, uint32_t _dstStride, const uint8_t* _src, uint32_t _srcStride, uint32_t _num)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii, _dst += _dstStride, _src += _srcStride)
+		{
+			const float* input = (const float*)_src;
+
+			for (uint32_t jj = 0; jj < NumT; ++jj)
+			{
+				_dst[jj] = AsIntT
+					? uint8_t(input[jj] * 127.0f + 128.0f)
+					: uint8_t(input[jj] * 255.0f)
+					;
+			}
+		}
+	}
 
-		for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
+	template<uint8_t NumT, bool AsIntT>
+	static void vertexPackUint10(uint8_t* _dst, uint32_t _dstStride, const uint8_t* _src, uint32_t _srcStride, uint32_t _num)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii, _dst += _dstStride, _src += _srcStride)
 		{
-			Attrib::Enum attr = (Attrib::Enum)ii;
+			const float* input = (const float*)_src;
 
-			if (_destLayout.has(attr) )
+			uint32_t packed = 0;
+			for (uint32_t jj = 0; jj < bx::min<uint8_t>(NumT, 3); ++jj)
 			{
-				ConvertOp& cop = convertOp[numOps];
-				cop.attr = attr;
-				cop.dest = _destLayout.getOffset(attr);
+				packed <<= 10;
+				packed |= AsIntT
+					? uint32_t(input[jj] * 511.0f + 512.0f)
+					: uint32_t(input[jj] * 1023.0f)
+					;
+			}
+
+			*(uint32_t*)_dst = packed;
+		}
+	}
+
+	template<uint8_t NumT, bool AsIntT>
+	static void vertexPackInt16(uint8_t* _dst, uint32_t _dstStride, const uint8_t* _src, uint32_t _srcStride, uint32_t _num)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii, _dst += _dstStride, _src += _srcStride)
+		{
+			const float* input  = (const float*)_src;
+			int16_t*     packed = (int16_t*)_dst;
+
+			for (uint32_t jj = 0; jj < NumT; ++jj)
+			{
+				packed[jj] = AsIntT
+					? int16_t(input[jj] * 32767.0f)
+					: int16_t(input[jj] * 65535.0f - 32768.0f)
+					;
+			}
+		}
+	}
+
+	template<uint8_t NumT, bool AsIntT>
+	static void vertexPackHalf(uint8_t* _dst, uint32_t _dstStride, const uint8_t* _src, uint32_t _srcStride, uint32_t _num)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii, _dst += _dstStride, _src += _srcStride)
+		{
+			const float* input  = (const float*)_src;
+			uint16_t*    packed = (uint16_t*)_dst;
+
+			for (uint32_t jj = 0; jj < NumT; ++jj)
+			{
+				packed[jj] = bx::halfFromFloat(input[jj]);
+			}
+		}
+	}
+
+	template<uint8_t NumT, bool AsIntT>
+	static void vertexPackFloat(uint8_t* _dst, uint32_t _dstStride, const uint8_t* _src, uint32_t _srcStride, uint32_t _num)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii, _dst += _dstStride, _src += _srcStride)
+		{
+			const float* input  = (const float*)_src;
+			float*       output = (float*)_dst;
+
+			for (uint32_t jj = 0; jj < NumT; ++jj)
+			{
+				output[jj] = input[jj];
+			}
+		}
+	}
+
+#define VERTEX_KERNEL_AS_INT(_kernel, _asInt) \
+		{ _kernel<1, _asInt>, _kernel<2, _asInt>, _kernel<3, _asInt>, _kernel<4, _asInt> }
+
+#define VERTEX_KERNEL(_kernel) \
+		{ VERTEX_KERNEL_AS_INT(_kernel, false), VERTEX_KERNEL_AS_INT(_kernel, true) }
+
+	static const VertexUnpackFn s_vertexUnpackFn[AttribType::Count][2][4] =
+	{
+		VERTEX_KERNEL(vertexUnpackUint8),
+		VERTEX_KERNEL(vertexUnpackUint10),
+		VERTEX_KERNEL(vertexUnpackInt16),
+		VERTEX_KERNEL(vertexUnpackHalf),
+		VERTEX_KERNEL(vertexUnpackFloat),
+	};
+
+	static const VertexPackFn s_vertexPackFn[AttribType::Count][2][4] =
+	{
+		VERTEX_KERNEL(vertexPackUint8),
+		VERTEX_KERNEL(vertexPackUint10),
+		VERTEX_KERNEL(vertexPackInt16),
+		VERTEX_KERNEL(vertexPackHalf),
+		VERTEX_KERNEL(vertexPackFloat),
+	};
+
+#undef VERTEX_KERNEL
+#undef VERTEX_KERNEL_AS_INT
+
+	// Conversion plan for pair of vertex layouts. Attributes that are the same in
+	// both layouts are copied, attributes missing in source are zeroed, and the
+	// rest is converted with unpack / pack kernels. Unpack is skipped when source
+	// is float with at least as many components as destination.
+	struct VertexConvertPlan
+	{
+		struct Op
+		{
+			VertexUnpackFn unpack;
+			VertexPackFn   pack;
+			uint16_t src;
+			uint16_t dest;
+			uint16_t size;
+		};
+
+		void compile(const VertexLayout& _destLayout, const VertexLayout& _srcLayout)
+		{
+			destHash   = _destLayout.m_hash;
+			srcHash    = _srcLayout.m_hash;
+			numCopy    = 0;
+			numZero    = 0;
+			numConvert = 0;
+
+			for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
+			{
+				const Attrib::Enum attr = Attrib::Enum(ii);
+
+				if (!_destLayout.has(attr) )
+				{
+					continue;
+				}
 
 				uint8_t num;
 				AttribType::Enum type;
 				bool normalized;
 				bool asInt;
 				_destLayout.decode(attr, num, type, normalized, asInt);
-				cop.size = (*s_attribTypeSize[0])[type][num-1];
 
-				if (_srcLayout.has(attr) )
+				Op op;
+				op.unpack = NULL;
+				op.pack   = s_vertexPackFn[type][asInt][num-1];
+				op.src    = 0;
+				op.dest   = _destLayout.getOffset(attr);
+				op.size   = (*s_attribTypeSize[0])[type][num-1];
+
+				if (!_srcLayout.has(attr) )
 				{
-					cop.src = _srcLayout.getOffset(attr);
+					zero[numZero++] = op;
+					continue;
+				}
 
-					if (_destLayout.m_attributes[attr] == _srcLayout.m_attributes[attr])
-					{
-						bx::memCopy(dest + cop.dest, destStride, src + cop.src, srcStride, cop.size, _num);
-					}
-					else
-					{
-						++numOps;
-					}
+				op.src = _srcLayout.getOffset(attr);
+
+				if (_destLayout.m_attributes[attr] == _srcLayout.m_attributes[attr])
+				{
+					copy[numCopy++] = op;
+					continue;
 				}
-				else
+
+				uint8_t srcNum;
+				AttribType::Enum srcType;
+				_srcLayout.decode(attr, srcNum, srcType, normalized, asInt);
+
+				if (AttribType::Float != srcType
+				||  srcNum < num)
 				{
-					bx::memSet(dest + cop.dest, destStride, 0, cop.size, _num);
+					op.unpack = s_vertexUnpackFn[srcType][asInt][srcNum-1];
 				}
+
+				convert[numConvert++] = op;
 			}
 		}
 
-		if (0 < numOps)
+		uint32_t destHash;
+		uint32_t srcHash;
+		Op       copy[Attrib::Count];
+		Op       zero[Attrib::Count];
+		Op       convert[Attrib::Count];
+		uint8_t  numCopy;
+		uint8_t  numZero;
+		uint8_t  numConvert;
+	};
+
+	static bx::Mutex         s_vertexConvertPlanMutex;
+	static VertexConvertPlan s_vertexConvertPlan[16];
+
+	static void getVertexConvertPlan(VertexConvertPlan& _outPlan, const VertexLayout& _destLayout, const VertexLayout& _srcLayout)
+	{
+		const uint32_t idx = (_srcLayout.m_hash ^ (_destLayout.m_hash*31) ) % BX_COUNTOF(s_vertexConvertPlan);
+
+		bx::MutexScope scope(s_vertexConvertPlanMutex);
+
+		VertexConvertPlan& plan = s_vertexConvertPlan[idx];
+
+		if (plan.destHash != _destLayout.m_hash
+		||  plan.srcHash  != _srcLayout.m_hash)
+		{
+			plan.compile(_destLayout, _srcLayout);
+		}
+
+		_outPlan = plan;
+	}
+
+	void vertexConvert(const VertexLayout& _destLayout, void* _destData, const VertexLayout& _srcLayout, const void* _srcData, uint32_t _num)
+	{
+		if (_destLayout.m_hash == _srcLayout.m_hash)
 		{
-			float unpacked[4];
+			bx::memCopy(_destData, _srcData, _srcLayout.getSize(_num) );
+			return;
+		}
 
-			for (uint32_t ii = 0; ii < _num; ++ii)
+		VertexConvertPlan plan;
+		getVertexConvertPlan(plan, _destLayout, _srcLayout);
+
+		const uint8_t* src = (const uint8_t*)_srcData;
+		uint32_t srcStride = _srcLayout.getStride();
+
+		uint8_t* dest       = (uint8_t*)_destData;
+		uint32_t destStride = _destLayout.getStride();
+
+		for (uint32_t ii = 0; ii < plan.numCopy; ++ii)
+		{
+			const VertexConvertPlan::Op& op = plan.copy[ii];
+			bx::memCopy(dest + op.dest, destStride, src + op.src, srcStride, op.size, _num);
+		}
+
+		for (uint32_t ii = 0; ii < plan.numZero; ++ii)
+		{
+			const VertexConvertPlan::Op& op = plan.zero[ii];
+			bx::memSet(dest + op.dest, destStride, 0, op.size, _num);
+		}
+
+		if (0 < plan.numConvert)
+		{
+			// Vertices are converted in batches, all attributes of a batch are
+			// converted while vertex data of batch is still in cache.
+			constexpr uint32_t kBatchSize = 64;
+			float unpacked[kBatchSize*4];
+
+			for (uint32_t ii = 0; ii < _num; ii += kBatchSize)
 			{
-				for (uint32_t jj = 0; jj < numOps; ++jj)
+				const uint32_t num = bx::min<uint32_t>(kBatchSize, _num - ii);
+
+				for (uint32_t jj = 0; jj < plan.numConvert; ++jj)
 				{
-					const ConvertOp& cop = convertOp[jj];
-					vertexUnpack(unpacked, cop.attr, _srcLayout, src);
-					vertexPack(unpacked, true, cop.attr, _destLayout, dest);
+					const VertexConvertPlan::Op& op = plan.convert[jj];
+
+					if (NULL == op.unpack)
+					{
+						op.pack(dest + op.dest, destStride, src + op.src, srcStride, num);
+					}
+					else
+					{
+						op.unpack(unpacked, src + op.src, srcStride, num);
+						op.pack(dest + op.dest, destStride, (const uint8_t*)unpacked, 4*sizeof(float), num);
+					}
 				}
 
-				src  += srcStride;
-				dest += destStride;
+				src  += num*srcStride;
+				dest += num*destStride;
 			}
 		}
 	}
@@ -714,104 +999,268 @@ namespace bgfx
 		return xx*xx + yy*yy + zz*zz;
 	}
 
-	template<typename IndexT>
-	static IndexT weldVerticesRef(IndexT* _output, const VertexLayout& _layout, const void* _data, uint32_t _num, float _epsilon)
+	// Vertex welding with spatial hash. Positions are quantized into cells that are
+	// twice epsilon in size, so vertices closer than epsilon are either in the same
+	// cell, or in one of the neighbour cells on the side of cell half where vertex
+	// is, which is at most 8 cells to probe. Only unique vertices are inserted into
+	// hash table, and each vertex is welded to the first unique vertex within
+	// epsilon, which is the same result as brute force O(n^2) search, but in
+	// linear time. Vertices with non-finite position are never welded.
+	struct VertexWeld
 	{
-		// Brute force slow vertex welding...
-		const float epsilonSq = _epsilon*_epsilon;
-
-		uint32_t numVertices = 0;
-		bx::memSet(_output, 0xff, _num*sizeof(IndexT) );
+		VertexWeld(const VertexLayout& _layout, const void* _data, float _epsilon, uint8_t _flags)
+			: m_layout(_layout)
+			, m_data(_data)
+			, m_epsilon(bx::max(_epsilon, 0.0f) )
+			, m_epsilonSq(m_epsilon*m_epsilon)
+			, m_invCellSize(0.0f < m_epsilon ? 0.5/double(m_epsilon) : 0.0)
+			, m_allAttributes(0 != (_flags & BGFX_WELD_ALL_ATTRIBUTES) )
+		{
+		}
 
-		for (uint32_t ii = 0; ii < _num; ++ii)
+		void cell(int64_t _outCell[3], int64_t _outSide[3], const float _pos[3]) const
 		{
-			if (IndexT(-1) != _output[ii])
+			for (uint32_t ii = 0; ii < 3; ++ii)
 			{
-				continue;
-			}
+				if (0.0f < m_epsilon)
+				{
+					// Clamp so that huge positions with tiny epsilon still convert
+					// to integer, they only end up sharing edge cell.
+					const double  value = bx::clamp<double>(double(_pos[ii])*m_invCellSize, -4.0e18, 4.0e18);
+					const int64_t trunc = int64_t(value);
+					_outCell[ii] = double(trunc) > value ? trunc-1 : trunc;
+					_outSide[ii] = value - double(_outCell[ii]) < 0.5 ? -1 : 1;
+				}
+				else
+				{
+					// -0.0 and 0.0 compare equal, hash them into the same cell.
+					const float value = 0.0f == _pos[ii] ? 0.0f : _pos[ii];
 
-			_output[ii] = (IndexT)ii;
-			++numVertices;
+					uint32_t bits;
+					bx::memCopy(&bits, &value, sizeof(uint32_t) );
+					_outCell[ii] = bits;
+					_outSide[ii] = 0;
+				}
+			}
+		}
 
-			float pos[4];
-			vertexUnpack(pos, Attrib::Position, _layout, _data, ii);
+		static uint32_t hashCell(const int64_t _cell[3])
+		{
+			const uint64_t hash = 0
+				^ uint64_t(_cell[0])*UINT64_C(73856093)
+				^ uint64_t(_cell[1])*UINT64_C(19349663)
+				^ uint64_t(_cell[2])*UINT64_C(83492791)
+				;
+			return uint32_t(hash ^ (hash>>32) );
+		}
 
-			for (uint32_t jj = 0; jj < _num; ++jj)
+		bool isEqual(const float _a[4], const float _b[4], uint32_t _num) const
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii)
 			{
-				if (IndexT(-1) != _output[jj])
+				if (bx::abs(_a[ii] - _b[ii]) > m_epsilon)
 				{
-					continue;
+					return false;
 				}
+			}
 
-				float test[4];
-				vertexUnpack(test, Attrib::Position, _layout, _data, jj);
+			return true;
+		}
 
-				if (sqLength(test, pos) < epsilonSq)
+		bool isSame(const float* _pos, uint32_t _aa, uint32_t _bb) const
+		{
+			const float* aa = &_pos[size_t(_aa)*4];
+			const float* bb = &_pos[size_t(_bb)*4];
+
+			if (0.0f < m_epsilon
+				? sqLength(aa, bb) >= m_epsilonSq
+				: !isEqual(aa, bb, 3) )
+			{
+				return false;
+			}
+
+			if (m_allAttributes)
+			{
+				for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
 				{
-					_output[jj] = IndexT(ii);
+					const Attrib::Enum attr = Attrib::Enum(ii);
+
+					if (Attrib::Position == attr
+					||  !m_layout.has(attr) )
+					{
+						continue;
+					}
+
+					uint8_t num;
+					AttribType::Enum type;
+					bool normalized;
+					bool asInt;
+					m_layout.decode(attr, num, type, normalized, asInt);
+
+					float va[4];
+					float vb[4];
+					vertexUnpack(va, attr, m_layout, m_data, _aa);
+					vertexUnpack(vb, attr, m_layout, m_data, _bb);
+
+					if (!isEqual(va, vb, num) )
+					{
+						return false;
+					}
 				}
 			}
+
+			return true;
 		}
 
-		return IndexT(numVertices);
-	}
+		const VertexLayout& m_layout;
+		const void* m_data;
+		float  m_epsilon;
+		float  m_epsilonSq;
+		double m_invCellSize;
+		bool   m_allAttributes;
+	};
 
 	template<typename IndexT>
-	static IndexT weldVertices(IndexT* _output, const VertexLayout& _layout, const void* _data, uint32_t _num, float _epsilon, bx::AllocatorI* _allocator)
+	static IndexT weldVertices(IndexT* _output, void* _dstData, const VertexLayout& _layout, const void* _data, uint32_t _num, float _epsilon, uint8_t _flags, bx::AllocatorI* _allocator)
 	{
-		const uint32_t hashSize = bx::uint32_nextpow2(_num);
+		if (0 == _num)
+		{
+			return 0;
+		}
+
+		const VertexWeld weld(_layout, _data, _epsilon, _flags);
+
+		const uint32_t hashSize = bx::uint32_nextpow2(bx::min(_num, UINT32_C(1)<<31) );
 		const uint32_t hashMask = hashSize-1;
-		const float epsilonSq = _epsilon*_epsilon;
 
-		uint32_t numVertices = 0;
+		const size_t size = sizeof(uint32_t)*(size_t(hashSize) + _num) + 4*sizeof(float)*size_t(_num);
+		uint32_t* hashTable = (uint32_t*)bx::alloc(_allocator, size);
+		uint32_t* next      = hashTable + hashSize;
+		float*    pos       = (float*)(next + _num);
+		bx::memSet(hashTable, 0xff, sizeof(uint32_t)*hashSize);
 
-		const uint32_t size = sizeof(IndexT)*(hashSize + _num);
-		IndexT* hashTable = (IndexT*)bx::alloc(_allocator, size);
-		bx::memSet(hashTable, 0xff, size);
+		// Unpack all positions upfront with vertex convert kernels.
+		if (_layout.has(Attrib::Position) )
+		{
+			uint8_t num;
+			AttribType::Enum type;
+			bool normalized;
+			bool asInt;
+			_layout.decode(Attrib::Position, num, type, normalized, asInt);
+
+			s_vertexUnpackFn[type][asInt][num-1](
+				  pos
+				, (const uint8_t*)_data + _layout.getOffset(Attrib::Position)
+				, _layout.getStride()
+				, _num
+				);
+		}
+		else
+		{
+			bx::memSet(pos, 0, 4*sizeof(float)*size_t(_num) );
+		}
 
-		IndexT* next = hashTable + hashSize;
+		const uint32_t numProbes = 0.0f < weld.m_epsilon ? 8 : 1;
+
+		uint32_t numVertices = 0;
 
 		for (uint32_t ii = 0; ii < _num; ++ii)
 		{
-			float pos[4];
-			vertexUnpack(pos, Attrib::Position, _layout, _data, ii);
-			uint32_t hashValue = bx::hash<bx::HashMurmur2A>(pos, 3*sizeof(float) ) & hashMask;
+			const float* vpos = &pos[size_t(ii)*4];
 
-			IndexT offset = hashTable[hashValue];
-			for (; IndexT(-1) != offset; offset = next[offset])
+			if (!bx::isFinite(vpos[0])
+			||  !bx::isFinite(vpos[1])
+			||  !bx::isFinite(vpos[2]) )
 			{
-				float test[4];
-				vertexUnpack(test, Attrib::Position, _layout, _data, _output[offset]);
+				// Not inserted into hash table, nothing can be within epsilon.
+				next[ii] = UINT32_MAX;
+				_output[ii] = IndexT(ii);
+				numVertices++;
+				continue;
+			}
+
+			int64_t cell[3];
+			int64_t side[3];
+			weld.cell(cell, side, vpos);
+
+			uint32_t found = UINT32_MAX;
 
-				if (sqLength(test, pos) < epsilonSq)
+			for (uint32_t probe = 0; probe < numProbes; ++probe)
+			{
+				const int64_t test[3] =
+				{
+					cell[0] + ( (probe>>0)&1 ? side[0] : 0),
+					cell[1] + ( (probe>>1)&1 ? side[1] : 0),
+					cell[2] + ( (probe>>2)&1 ? side[2] : 0),
+				};
+				const uint32_t hashValue = VertexWeld::hashCell(test) & hashMask;
+
+				for (uint32_t offset = hashTable[hashValue]; UINT32_MAX != offset; offset = next[offset])
 				{
-					_output[ii] = _output[offset];
-					break;
+					if (offset < found
+					&&  weld.isSame(pos, ii, offset) )
+					{
+						found = offset;
+					}
 				}
 			}
 
-			if (IndexT(-1) == offset)
+			if (UINT32_MAX == found)
 			{
-				_output[ii] = IndexT(ii);
+				const uint32_t hashValue = VertexWeld::hashCell(cell) & hashMask;
 				next[ii] = hashTable[hashValue];
-				hashTable[hashValue] = IndexT(ii);
+				hashTable[hashValue] = ii;
+
+				_output[ii] = IndexT(ii);
 				numVertices++;
 			}
+			else
+			{
+				_output[ii] = IndexT(found);
+			}
 		}
 
 		bx::free(_allocator, hashTable);
 
+		if (NULL != _dstData)
+		{
+			// Unique vertices are compacted in order of first occurrence, and
+			// remapping table is updated in place to point into compacted data.
+			const uint32_t stride = _layout.getStride();
+			const uint8_t* src = (const uint8_t*)_data;
+			uint8_t* dst = (uint8_t*)_dstData;
+
+			uint32_t numCompacted = 0;
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				if (IndexT(ii) == _output[ii])
+				{
+					bx::memCopy(&dst[size_t(numCompacted)*stride], &src[size_t(ii)*stride], stride);
+					_output[ii] = IndexT(numCompacted++);
+				}
+				else
+				{
+					_output[ii] = _output[_output[ii] ];
+				}
+			}
+		}
+
 		return IndexT(numVertices);
 	}
 
 	uint32_t weldVertices(void* _output, const VertexLayout& _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, bx::AllocatorI* _allocator)
+	{
+		return weldVertices(_output, NULL, _layout, _data, _num, _index32, _epsilon, BGFX_WELD_NONE, _allocator);
+	}
+
+	uint32_t weldVertices(void* _output, void* _dstData, const VertexLayout& _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, uint8_t _flags, bx::AllocatorI* _allocator)
 	{
 		if (_index32)
 		{
-			return weldVertices( (uint32_t*)_output, _layout, _data, _num, _epsilon, _allocator);
+			return weldVertices( (uint32_t*)_output, _dstData, _layout, _data, _num, _epsilon, _flags, _allocator);
 		}
 
-		return weldVertices( (uint16_t*)_output, _layout, _data, _num, _epsilon, _allocator);
+		return weldVertices( (uint16_t*)_output, _dstData, _layout, _data, _num, _epsilon, _flags, _allocator);
 	}
 
 } // namespace bgfx
@@ -41,6 +41,9 @@ namespace bgfx
 	///
 	uint32_t weldVertices(void* _output, const VertexLayout& _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, bx::AllocatorI* _allocator);
 
+	///
+	uint32_t weldVertices(void* _output, void* _dstData, const VertexLayout& _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, uint8_t _flags, bx::AllocatorI* _allocator);
+
 } // namespace bgfx
 
 #endif // BGFX_VERTEXDECL_H_HEADER_GUARD
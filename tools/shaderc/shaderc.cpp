@@ -5,7 +5,12 @@
 
 #include "shaderc.h"
 #include <bx/commandline.h>
+#include <bx/cpu.h>
 #include <bx/filepath.h>
+#include <bx/thread.h>
+#include <bx/timer.h>
+
+#include <thread>
 
 #define MAX_TAGS 256
 extern "C"
@@ -17,6 +22,9 @@ extern "C"
 #define BGFX_CHUNK_MAGIC_CSH BX_MAKEFOURCC('C', 'S', 'H', BGFX_SHADER_BIN_VERSION)
 #define BGFX_CHUNK_MAGIC_FSH BX_MAKEFOURCC('F', 'S', 'H', BGFX_SHADER_BIN_VERSION)
 #define BGFX_CHUNK_MAGIC_VSH BX_MAKEFOURCC('V', 'S', 'H', BGFX_SHADER_BIN_VERSION)
+#define BGFX_CHUNK_MAGIC_SHV BX_MAKEFOURCC('S', 'H', 'V', 1)
+
+#define BGFX_SHADERC_MAX_VARIANTS 4096
 
 #define BGFX_SHADERC_VERSION_MAJOR 1
 #define BGFX_SHADERC_VERSION_MINOR 18
@@ -383,6 +391,7 @@ namespace bgfx
 		, keepIntermediate(false)
 		, optimize(false)
 		, optimizationLevel(3)
+		, fileCache(NULL)
 	{
 	}
 
@@ -394,6 +403,7 @@ namespace bgfx
 			"\t  profile: %s\n"
 			"\t  inputFile: %s\n"
 			"\t  outputFile: %s\n"
+			"\t  cacheDir: %s\n"
 			"\t  disasm: %s\n"
 			"\t  raw: %s\n"
 			"\t  preprocessOnly: %s\n"
@@ -414,6 +424,7 @@ namespace bgfx
 			, profile.c_str()
 			, inputFilePath.c_str()
 			, outputFilePath.c_str()
+			, cacheDir.c_str()
 			, disasm ? "true" : "false"
 			, raw ? "true" : "false"
 			, preprocessOnly ? "true" : "false"
@@ -644,7 +655,8 @@ namespace bgfx
 				m_size = (uint32_t)bx::read(&reader, m_data, m_size, bx::ErrorAssert{});
 				bx::close(&reader);
 
-				if (m_data[0] == '\xef'
+				if (3 <= m_size
+				&&  m_data[0] == '\xef'
 				&&  m_data[1] == '\xbb'
 				&&  m_data[2] == '\xbf')
 				{
@@ -671,6 +683,64 @@ namespace bgfx
 		uint32_t m_size;
 	};
 
+	// Source files loaded once, and shared between all shaders compiled by
+	// the same process (batch mode compiles the same input, varying.def.sc
+	// and #include files for multiple profiles).
+	class FileCache
+	{
+	public:
+		FileCache()
+		{
+		}
+
+		~FileCache()
+		{
+			for (FileMap::iterator it = m_files.begin(), itEnd = m_files.end(); it != itEnd; ++it)
+			{
+				delete it->second;
+			}
+		}
+
+		const File* load(const char* _filePath)
+		{
+			bx::MutexScope lock(m_mutex);
+
+			FileMap::const_iterator it = m_files.find(_filePath);
+			if (it != m_files.end() )
+			{
+				return it->second;
+			}
+
+			File* file = new File;
+			file->load(_filePath);
+			m_files.insert(std::make_pair(std::string(_filePath), file) );
+
+			return file;
+		}
+
+	private:
+		typedef std::unordered_map<std::string, File*> FileMap;
+		FileMap m_files;
+		bx::Mutex m_mutex;
+	};
+
+	class StringWriter : public bx::WriterI
+	{
+	public:
+		virtual ~StringWriter()
+		{
+		}
+
+		virtual int32_t write(const void* _data, int32_t _size, bx::Error* _err) override
+		{
+			BX_UNUSED(_err);
+			m_str.append( (const char*)_data, _size);
+			return _size;
+		}
+
+		std::string m_str;
+	};
+
 	char* strInsert(char* _str, const char* _insert)
 	{
 		uint32_t len = bx::strLen(_insert);
@@ -750,16 +820,24 @@ namespace bgfx
 
 	struct Preprocessor
 	{
-		Preprocessor(const char* _filePath, bool _essl, bx::WriterI* _messageWriter)
+		Preprocessor(const char* _filePath, bool _essl, FileCache* _fileCache, bx::WriterI* _messageWriter)
 			: m_tagptr(m_tags)
 			, m_scratchPos(0)
 			, m_fgetsPos(0)
+			, m_fileCache(_fileCache)
 			, m_messageWriter(_messageWriter)
 		{
 			m_tagptr->tag = FPPTAG_USERDATA;
 			m_tagptr->data = this;
 			m_tagptr++;
 
+			if (NULL != _fileCache)
+			{
+				m_tagptr->tag = FPPTAG_FILEOPENFUNC;
+				m_tagptr->data = (void*)fppFileOpen;
+				m_tagptr++;
+			}
+
 			m_tagptr->tag = FPPTAG_DEPENDS;
 			m_tagptr->data = (void*)fppDepends;
 			m_tagptr++;
@@ -909,6 +987,32 @@ namespace bgfx
 			return thisClass->fgets(_buffer, _size);
 		}
 
+		// Include files are read through file cache, so files included by
+		// many shaders are loaded only once, and missing files in include
+		// search path are looked up only once.
+		static FILE* fppFileOpen(char* _fileName, char* _mode, void* _userData)
+		{
+			Preprocessor* thisClass = (Preprocessor*)_userData;
+			const File* file = thisClass->m_fileCache->load(_fileName);
+
+			if (NULL == file->getData() )
+			{
+				return NULL;
+			}
+
+#if BX_PLATFORM_WINDOWS
+			// No fmemopen on Windows, only missing files are skipped.
+			return fopen(_fileName, _mode);
+#else
+			if (0 == file->getSize() )
+			{
+				return fopen(_fileName, _mode);
+			}
+
+			return fmemopen(const_cast<char*>(file->getData() ), file->getSize(), _mode);
+#endif // BX_PLATFORM_WINDOWS
+		}
+
 		static void fppOutput(int _ch, void* _userData)
 		{
 			Preprocessor* thisClass = (Preprocessor*)_userData;
@@ -941,6 +1045,7 @@ namespace bgfx
 		char m_scratch[16<<10];
 		uint32_t m_scratchPos;
 		uint32_t m_fgetsPos;
+		FileCache* m_fileCache;
 		bx::WriterI* m_messageWriter;
 	};
 
@@ -1036,6 +1141,7 @@ namespace bgfx
 
 		bx::printf(
 			  "Usage: shaderc -f <in> -o <out> --type <v/f/c> --platform <platform>\n"
+			  "       shaderc --batch <manifest> [-j <num>]\n"
 
 			  "\n"
 			  "Options:\n"
@@ -1083,8 +1189,24 @@ namespace bgfx
 			  "      --raw                     Do not process shader. No preprocessor, and no glsl-optimizer. (GLSL only)\n"
 			  "      --type <type>             Shader type. Can be 'vertex', 'fragment, or 'compute'.\n"
 			  "      --varyingdef <file path>  varying.def.sc's file path.\n"
+			  "      --cache <dir path>        Store compiled shaders in cache directory, and skip compiling shaders\n"
+			  "                                when preprocessed code and options didn't change.\n"
+			  "      --variants <axes>         Compile all permutations of keyword axes into single variant archive.\n"
+			  "                                Axes are separated by ';', keywords within axis by ','. Axis with single\n"
+			  "                                keyword toggles it on and off, and '_' stands for no keyword.\n"
+			  "                                Example: --variants \"SHADOW;FOG;LIGHT_POINT,LIGHT_SPOT,_\"\n"
 			  "      --verbose                 Be verbose.\n"
 
+			  "\n"
+			  "Batch mode:\n"
+
+			  "\n"
+			  "      --batch <file path>       Compile all shaders listed in manifest file. Each line in manifest\n"
+			  "                                contains options for one shader, as they would be passed to shaderc.\n"
+			  "                                Empty lines and lines starting with '#' are ignored.\n"
+			  "  -j <num>                      Number of compile threads, also used for --variants outside of batch\n"
+			  "                                mode. Defaults to number of CPU cores.\n"
+
 			  "\n"
 			  "(Vulkan, DirectX and Metal):\n"
 
@@ -1111,7 +1233,185 @@ namespace bgfx
 		return word;
 	}
 
-	bool compileShader(const char* _varying, const char* _comment, char* _shader, uint32_t _shaderLen, const Options& _options, bx::WriterI* _shaderWriter, bx::WriterI* _messageWriter)
+	#define SHADERC_CACHE_MAGIC BX_MAKEFOURCC('S', 'C', 'C', 1)
+
+	struct CacheHeader
+	{
+		uint32_t magic;
+		uint32_t size;
+		uint32_t hash;
+	};
+
+	typedef std::unordered_map<std::string, std::string> CompiledMap;
+
+	/// Shaders compiled by single compileVariants call, shared between its
+	/// worker threads.
+	struct CompiledShaders
+	{
+		bx::Mutex   mutex;
+		CompiledMap map;
+	};
+
+	static uint32_t s_cacheHits;
+	static uint32_t s_cacheMisses;
+
+	typedef bool (*CompileFn)(const Options& _options, uint32_t _version, const std::string& _code, bx::WriterI* _writer, bx::WriterI* _messages);
+
+	static void cacheFileName(char* _out, int32_t _max, const char* _backend, const Options& _options, uint32_t _version, const std::string& _code)
+	{
+		uint32_t hash[2];
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(hash); ++ii)
+		{
+			bx::HashMurmur2A murmur;
+			murmur.begin(ii);
+			murmur.add(uint32_t(BGFX_SHADERC_VERSION_MAJOR) );
+			murmur.add(uint32_t(BGFX_SHADERC_VERSION_MINOR) );
+			murmur.add(uint32_t(BGFX_API_VERSION) );
+			murmur.add(uint32_t(BGFX_SHADER_BIN_VERSION) );
+			murmur.add(_backend, bx::strLen(_backend) );
+			murmur.add(_version);
+			murmur.add(_options.shaderType);
+			murmur.add(_options.platform.c_str(), uint32_t(_options.platform.size() ) );
+			murmur.add(_options.profile.c_str(),  uint32_t(_options.profile.size() ) );
+			murmur.add(_options.debugInformation);
+			murmur.add(_options.avoidFlowControl);
+			murmur.add(_options.noPreshader);
+			murmur.add(_options.partialPrecision);
+			murmur.add(_options.preferFlowControl);
+			murmur.add(_options.backwardsCompatibility);
+			murmur.add(_options.warningsAreErrors);
+			murmur.add(_options.optimize);
+			murmur.add(_options.optimizationLevel);
+			murmur.add(_code.c_str(), uint32_t(_code.size() ) );
+			hash[ii] = murmur.end();
+		}
+
+		bx::snprintf(_out, _max, "%08x%08x.bin", hash[0], hash[1]);
+	}
+
+	/// Compiles shader with backend compiler, or looks up compiled shader by
+	/// hash of preprocessed code and options. When _compiled is specified,
+	/// shaders are kept in it, so permutations that preprocess to identical
+	/// code are compiled only once. When cache directory is specified
+	/// compiled shaders are stored on disk too. Disassembly and intermediate
+	/// files are produced only by backend compilers, so cache is bypassed
+	/// when they're requested.
+	static bool compileCached(const char* _backend, CompileFn _fn, const Options& _options, uint32_t _version, const std::string& _code, bx::WriterI* _shaderWriter, bx::WriterI* _messageWriter, CompiledShaders* _compiled)
+	{
+		const bool diskCache = !_options.cacheDir.empty();
+
+		if ( (!diskCache && NULL == _compiled)
+		||  _options.disasm
+		||  _options.keepIntermediate)
+		{
+			return _fn(_options, _version, _code, _shaderWriter, _messageWriter, _compiled);
+		}
+
+		char fileName[32];
+		cacheFileName(fileName, BX_COUNTOF(fileName), _backend, _options, _version, _code);
+
+		bx::ErrorAssert err;
+
+		if (NULL != _compiled)
+		{
+			bx::MutexScope lock(_compiled->mutex);
+
+			CompiledMap::const_iterator it = _compiled->map.find(fileName);
+			if (it != _compiled->map.end() )
+			{
+				bx::write(_shaderWriter, it->second.c_str(), int32_t(it->second.size() ), &err);
+				return true;
+			}
+		}
+
+		bx::FilePath filePath(_options.cacheDir.c_str() );
+		filePath.join(fileName);
+
+		if (diskCache)
+		{
+			File cached;
+			cached.load(filePath);
+
+			CacheHeader header;
+			if (NULL != cached.getData()
+			&&  sizeof(header) <= cached.getSize() )
+			{
+				bx::memCopy(&header, cached.getData(), sizeof(header) );
+
+				const char* payload = cached.getData() + sizeof(header);
+
+				// File is ignored if it's truncated or written partially by
+				// another shaderc process at the same time.
+				if (SHADERC_CACHE_MAGIC == header.magic
+				&&  header.size == cached.getSize() - sizeof(header)
+				&&  header.hash == bx::hash<bx::HashMurmur2A>(payload, header.size) )
+				{
+					bx::write(_shaderWriter, payload, int32_t(header.size), &err);
+					bx::atomicFetchAndAdd<uint32_t>(&s_cacheHits, 1);
+
+					if (NULL != _compiled)
+					{
+						bx::MutexScope lock(_compiled->mutex);
+						_compiled->map[fileName].assign(payload, header.size);
+					}
+
+					return true;
+				}
+			}
+
+			bx::atomicFetchAndAdd<uint32_t>(&s_cacheMisses, 1);
+		}
+
+		StringWriter writer;
+		if (!_fn(_options, _version, _code, &writer, _messageWriter) )
+		{
+			return false;
+		}
+
+		bx::write(_shaderWriter, writer.m_str.c_str(), int32_t(writer.m_str.size() ), &err);
+
+		if (NULL != _compiled)
+		{
+			bx::MutexScope lock(_compiled->mutex);
+			_compiled->map[fileName] = writer.m_str;
+		}
+
+		if (diskCache)
+		{
+			CacheHeader header;
+			header.magic = SHADERC_CACHE_MAGIC;
+			header.size  = uint32_t(writer.m_str.size() );
+			header.hash  = bx::hash<bx::HashMurmur2A>(writer.m_str.c_str(), header.size);
+
+			bx::makeAll(_options.cacheDir.c_str() );
+
+			bx::FileWriter fw;
+			if (bx::open(&fw, filePath) )
+			{
+				bx::Error writeErr;
+				bx::write(&fw, header, &writeErr);
+				bx::write(&fw, writer.m_str.c_str(), int32_t(header.size), &writeErr);
+				bx::close(&fw);
+			}
+			else
+			{
+				writef(_messageWriter, "Unable to write shader cache file '%s'.\n", filePath.getCPtr() );
+			}
+		}
+
+		return true;
+	}
+
+	static void printCacheStats()
+	{
+		if (g_verbose)
+		{
+			bx::printf("Shader cache: %d hits, %d misses.\n", s_cacheHits, s_cacheMisses);
+		}
+	}
+
+	bool compileShader(const char* _varying, const char* _comment, char* _shader, uint32_t _shaderLen, const Options& _options, bx::WriterI* _shaderWriter, bx::WriterI* _messageWriter, CompiledShaders* _compiled = NULL)
 	{
 		bx::ErrorAssert messageErr;
 
@@ -1143,7 +1443,7 @@ namespace bgfx
 
 		const Profile* profile = &s_profiles[profileId];
 
-		Preprocessor preprocessor(_options.inputFilePath.c_str(), profile->lang == ShadingLang::ESSL, _messageWriter);
+		Preprocessor preprocessor(_options.inputFilePath.c_str(), profile->lang == ShadingLang::ESSL, _options.fileCache, _messageWriter);
 
 		for (size_t ii = 0; ii < _options.includeDirs.size(); ++ii)
 		{
@@ -1553,19 +1853,19 @@ namespace bgfx
 			}
 			else if (profile->lang == ShadingLang::Metal)
 			{
-				compiled = compileMetalShader(_options, profile->id, input, _shaderWriter, _messageWriter);
+				compiled = compileCached("metal", compileMetalShader, _options, profile->id, input, _shaderWriter, _messageWriter, _compiled);
 			}
 			else if (profile->lang == ShadingLang::SpirV)
 			{
-				compiled = compileSPIRVShader(_options, profile->id, input, _shaderWriter, _messageWriter);
+				compiled = compileCached("spirv", compileSPIRVShader, _options, profile->id, input, _shaderWriter, _messageWriter, _compiled);
 			}
 			else if (profile->lang == ShadingLang::PSSL)
 			{
-				compiled = compilePSSLShader(_options, 0, input, _shaderWriter, _messageWriter);
+				compiled = compileCached("pssl", compilePSSLShader, _options, 0, input, _shaderWriter, _messageWriter, _compiled);
 			}
 			else
 			{
-				compiled = compileHLSLShader(_options, profile->id, input, _shaderWriter, _messageWriter);
+				compiled = compileCached("hlsl", compileHLSLShader, _options, profile->id, input, _shaderWriter, _messageWriter, _compiled);
 			}
 		}
 		else if ('c' == _options.shaderType) // Compute
@@ -1710,19 +2010,19 @@ namespace bgfx
 
 							if (profile->lang == ShadingLang::Metal)
 							{
-								compiled = compileMetalShader(_options, profile->id, code, _shaderWriter, _messageWriter);
+								compiled = compileCached("metal", compileMetalShader, _options, profile->id, code, _shaderWriter, _messageWriter, _compiled);
 							}
 							else if (profile->lang == ShadingLang::SpirV)
 							{
-								compiled = compileSPIRVShader(_options, profile->id, code, _shaderWriter, _messageWriter);
+								compiled = compileCached("spirv", compileSPIRVShader, _options, profile->id, code, _shaderWriter, _messageWriter, _compiled);
 							}
 							else if (profile->lang == ShadingLang::PSSL)
 							{
-								compiled = compilePSSLShader(_options, 0, code, _shaderWriter, _messageWriter);
+								compiled = compileCached("pssl", compilePSSLShader, _options, 0, code, _shaderWriter, _messageWriter, _compiled);
 							}
 							else
 							{
-								compiled = compileHLSLShader(_options, profile->id, code, _shaderWriter, _messageWriter);
+								compiled = compileCached("hlsl", compileHLSLShader, _options, profile->id, code, _shaderWriter, _messageWriter, _compiled);
 							}
 						}
 					}
@@ -2597,7 +2897,7 @@ namespace bgfx
 									glsl_profile |= 0x80000000;
 								}
 
-								compiled = compileGLSLShader(_options, glsl_profile, code, _shaderWriter, _messageWriter);
+								compiled = compileCached("glsl", compileGLSLShader, _options, glsl_profile, code, _shaderWriter, _messageWriter, _compiled);
 							}
 						}
 						else
@@ -2607,19 +2907,19 @@ namespace bgfx
 
 							if (profile->lang == ShadingLang::Metal)
 							{
-								compiled = compileMetalShader(_options, profile->id, code, _shaderWriter, _messageWriter);
+								compiled = compileCached("metal", compileMetalShader, _options, profile->id, code, _shaderWriter, _messageWriter, _compiled);
 							}
 							else if (profile->lang == ShadingLang::SpirV)
 							{
-								compiled = compileSPIRVShader(_options, profile->id, code, _shaderWriter, _messageWriter);
+								compiled = compileCached("spirv", compileSPIRVShader, _options, profile->id, code, _shaderWriter, _messageWriter, _compiled);
 							}
 							else if (profile->lang == ShadingLang::PSSL)
 							{
-								compiled = compilePSSLShader(_options, 0, code, _shaderWriter, _messageWriter);
+								compiled = compileCached("pssl", compilePSSLShader, _options, 0, code, _shaderWriter, _messageWriter, _compiled);
 							}
 							else
 							{
-								compiled = compileHLSLShader(_options, profile->id, code, _shaderWriter, _messageWriter);
+								compiled = compileCached("hlsl", compileHLSLShader, _options, profile->id, code, _shaderWriter, _messageWriter, _compiled);
 							}
 						}
 					}
@@ -2646,60 +2946,345 @@ namespace bgfx
 		return compiled;
 	}
 
-	int compileShader(int _argc, const char* _argv[])
+	struct VariantContext
 	{
-		bx::CommandLine cmdLine(_argc, _argv);
+		const char* varying;
+		const char* comment;
+		const char* shader;
+		uint32_t shaderLen;
+		const Options* options;
+
+		std::vector<std::string> keywords;
+		std::vector<uint32_t> masks;
+		std::vector<std::string> binaries;
+		std::vector<std::string> messages;
+		std::vector<uint8_t> compiled;
+		CompiledShaders shaders;
+		uint32_t next;
+	};
 
-		if (cmdLine.hasArg('v', "version") )
+	static bool parseVariantAxes(const char* _axes, std::vector<std::string>& _keywords, std::vector<uint32_t>& _masks, bx::WriterI* _messageWriter)
+	{
+		_masks.push_back(0);
+
+		const std::string axes(_axes);
+		for (size_t start = 0; start <= axes.size();)
 		{
-			bx::printf(
-				  "shaderc, bgfx shader compiler tool, version %d.%d.%d.\n"
-				, BGFX_SHADERC_VERSION_MAJOR
-				, BGFX_SHADERC_VERSION_MINOR
-				, BGFX_API_VERSION
-				);
-			return bx::kExitSuccess;
+			size_t end = axes.find(';', start);
+			end = std::string::npos == end ? axes.size() : end;
+
+			const std::string axis = axes.substr(start, end-start);
+			start = end+1;
+
+			std::vector<uint32_t> choices;
+
+			for (size_t kwStart = 0; kwStart <= axis.size();)
+			{
+				size_t kwEnd = axis.find(',', kwStart);
+				kwEnd = std::string::npos == kwEnd ? axis.size() : kwEnd;
+
+				const bx::StringView trimmed = bx::strTrimSpace(bx::StringView(&axis[kwStart], &axis[kwEnd]) );
+				const std::string keyword(trimmed.getPtr(), trimmed.getTerm() );
+				kwStart = kwEnd+1;
+
+				if (keyword.empty() )
+				{
+					continue;
+				}
+
+				if ("_" == keyword)
+				{
+					choices.push_back(0);
+					continue;
+				}
+
+				if (UINT8_MAX < keyword.size() )
+				{
+					writef(_messageWriter, "Variant keyword '%s' is too long, maximum length is %d.\n", keyword.c_str(), UINT8_MAX);
+					return false;
+				}
+
+				if (_keywords.end() != std::find(_keywords.begin(), _keywords.end(), keyword) )
+				{
+					writef(_messageWriter, "Variant keyword '%s' is specified more than once.\n", keyword.c_str() );
+					return false;
+				}
+
+				if (32 <= _keywords.size() )
+				{
+					writef(_messageWriter, "Too many variant keywords, maximum is 32.\n");
+					return false;
+				}
+
+				choices.push_back(UINT32_C(1) << _keywords.size() );
+				_keywords.push_back(keyword);
+			}
+
+			if (choices.empty() )
+			{
+				continue;
+			}
+
+			// Axis with single keyword toggles it on and off.
+			if (1 == choices.size()
+			&&  0 != choices[0])
+			{
+				choices.insert(choices.begin(), 0);
+			}
+
+			std::vector<uint32_t> masks;
+			masks.reserve(_masks.size()*choices.size() );
+
+			for (size_t ii = 0; ii < _masks.size(); ++ii)
+			{
+				for (size_t jj = 0; jj < choices.size(); ++jj)
+				{
+					masks.push_back(_masks[ii] | choices[jj]);
+				}
+			}
+
+			_masks.swap(masks);
+
+			if (BGFX_SHADERC_MAX_VARIANTS < _masks.size() )
+			{
+				writef(_messageWriter, "Too many variant permutations, maximum is %d.\n", BGFX_SHADERC_MAX_VARIANTS);
+				return false;
+			}
 		}
 
-		if (cmdLine.hasArg('h', "help") )
+		return true;
+	}
+
+	static int32_t variantThreadFunc(bx::Thread* _thread, void* _userData)
+	{
+		BX_UNUSED(_thread);
+
+		VariantContext& ctx = *(VariantContext*)_userData;
+		const uint32_t numVariants = uint32_t(ctx.masks.size() );
+
+		for (uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&ctx.next, 1)
+			; idx < numVariants
+			; idx = bx::atomicFetchAndAdd<uint32_t>(&ctx.next, 1)
+			)
 		{
-			help();
-			return bx::kExitFailure;
+			const uint32_t mask = ctx.masks[idx];
+
+			Options options = *ctx.options;
+			options.depends = false;
+
+			for (uint32_t ii = 0, num = uint32_t(ctx.keywords.size() ); ii < num; ++ii)
+			{
+				if (0 != (mask & (UINT32_C(1) << ii) ) )
+				{
+					options.defines.push_back(ctx.keywords[ii]);
+				}
+			}
+
+			// Shader compiler takes ownership of source, and expects padding
+			// after it.
+			const uint32_t padding = 16384;
+			char* data = new char[ctx.shaderLen+padding];
+			bx::memCopy(data, ctx.shader, ctx.shaderLen+1);
+			bx::memSet(&data[ctx.shaderLen+1], 0, padding-1);
+
+			StringWriter shaderWriter;
+			StringWriter messageWriter;
+			ctx.compiled[idx] = compileShader(ctx.varying, ctx.comment, data, ctx.shaderLen, options, &shaderWriter, &messageWriter, &ctx.shaders);
+
+			ctx.binaries[idx].swap(shaderWriter.m_str);
+			ctx.messages[idx].swap(messageWriter.m_str);
 		}
 
-		g_verbose = cmdLine.hasArg("verbose");
+		return bx::kExitSuccess;
+	}
+
+	/// Compiles all permutations of keyword axes, and writes variant archive:
+	///
+	///   uint32_t magic;                     // BGFX_CHUNK_MAGIC_SHV
+	///   uint8_t  numKeywords;               // Keyword bit in mask is keyword index.
+	///   { uint8_t len; char name[len]; }    // [numKeywords]
+	///   uint16_t numVariants;               // Sorted by mask.
+	///   { uint32_t mask; uint16_t binary; } // [numVariants]
+	///   uint16_t numBinaries;
+	///   { uint32_t offset; uint32_t size; } // [numBinaries], offset from start of binary data.
+	///   Binary data, each binary is regular compiled shader.
+	///
+	/// Permutations that preprocess to identical code are compiled once, and
+	/// share the same binary. Archive is read by ShaderVariants in
+	/// examples/common/bgfx_utils.h.
+	static bool compileVariants(const char* _axes, uint32_t _numThreads, const char* _varying, const char* _comment, char* _shader, uint32_t _shaderLen, const Options& _options, bx::WriterI* _shaderWriter, bx::WriterI* _messageWriter)
+	{
+		VariantContext ctx;
+		ctx.varying   = _varying;
+		ctx.comment   = _comment;
+		ctx.shader    = _shader;
+		ctx.shaderLen = _shaderLen;
+		ctx.options   = &_options;
+		ctx.next      = 0;
 
-		const char* filePath = cmdLine.findOption('f');
-		if (NULL == filePath)
+		if (!parseVariantAxes(_axes, ctx.keywords, ctx.masks, _messageWriter) )
 		{
-			help("Shader file name must be specified.");
-			return bx::kExitFailure;
+			delete [] _shader;
+			return false;
 		}
 
-		bool consoleOut = cmdLine.hasArg("stdout");
-		const char* outFilePath = cmdLine.findOption('o');
-		if (NULL == outFilePath
-		&&  !consoleOut)
+		std::sort(ctx.masks.begin(), ctx.masks.end() );
+
+		const uint32_t numVariants = uint32_t(ctx.masks.size() );
+		ctx.binaries.resize(numVariants);
+		ctx.messages.resize(numVariants);
+		ctx.compiled.resize(numVariants, 0);
+
+		const uint32_t numThreads = bx::clamp<uint32_t>(_numThreads, 1, numVariants);
+
+		if (1 == numThreads)
 		{
-			help("Output file name must be specified or use \"--stdout\" to output to stdout.");
-			return bx::kExitFailure;
+			variantThreadFunc(NULL, &ctx);
 		}
+		else
+		{
+			bx::Thread* threads = new bx::Thread[numThreads];
+
+			for (uint32_t ii = 0; ii < numThreads; ++ii)
+			{
+				threads[ii].init(variantThreadFunc, &ctx, 0, "shaderc variant");
+			}
 
-		const char* type = cmdLine.findOption('\0', "type");
-		if (NULL == type)
+			for (uint32_t ii = 0; ii < numThreads; ++ii)
+			{
+				threads[ii].shutdown();
+			}
+
+			delete [] threads;
+		}
+
+		delete [] _shader;
+
+		bool compiled = true;
+
+		for (uint32_t ii = 0; ii < numVariants; ++ii)
 		{
-			help("Must specify shader type.");
-			return bx::kExitFailure;
+			if (!ctx.messages[ii].empty()
+			||  !ctx.compiled[ii])
+			{
+				std::string defines;
+				for (uint32_t jj = 0, num = uint32_t(ctx.keywords.size() ); jj < num; ++jj)
+				{
+					if (0 != (ctx.masks[ii] & (UINT32_C(1) << jj) ) )
+					{
+						defines += defines.empty() ? "" : ";";
+						defines += ctx.keywords[jj];
+					}
+				}
+
+				writef(_messageWriter, "Variant \"%s\":\n%s", defines.c_str(), ctx.messages[ii].c_str() );
+			}
+
+			compiled &= 0 != ctx.compiled[ii];
+		}
+
+		if (!compiled)
+		{
+			return false;
+		}
+
+		typedef std::unordered_map<std::string, uint16_t> BinaryMap;
+		BinaryMap binaryMap;
+		std::vector<uint16_t> binaryIndex(numVariants);
+		std::vector<uint32_t> unique;
+
+		for (uint32_t ii = 0; ii < numVariants; ++ii)
+		{
+			std::pair<BinaryMap::iterator, bool> result = binaryMap.insert(std::make_pair(ctx.binaries[ii], uint16_t(unique.size() ) ) );
+			if (result.second)
+			{
+				unique.push_back(ii);
+			}
+
+			binaryIndex[ii] = result.first->second;
+		}
+
+		if (g_verbose)
+		{
+			writef(_messageWriter, "Variants: %d permutations, %d unique binaries.\n", numVariants, uint32_t(unique.size() ) );
+		}
+
+		bx::ErrorAssert err;
+
+		bx::write(_shaderWriter, BGFX_CHUNK_MAGIC_SHV, &err);
+
+		bx::write(_shaderWriter, uint8_t(ctx.keywords.size() ), &err);
+		for (uint32_t ii = 0, num = uint32_t(ctx.keywords.size() ); ii < num; ++ii)
+		{
+			const std::string& keyword = ctx.keywords[ii];
+			const uint8_t len = uint8_t(keyword.size() );
+			bx::write(_shaderWriter, len, &err);
+			bx::write(_shaderWriter, keyword.c_str(), len, &err);
+		}
+
+		bx::write(_shaderWriter, uint16_t(numVariants), &err);
+		for (uint32_t ii = 0; ii < numVariants; ++ii)
+		{
+			bx::write(_shaderWriter, ctx.masks[ii], &err);
+			bx::write(_shaderWriter, binaryIndex[ii], &err);
 		}
 
+		bx::write(_shaderWriter, uint16_t(unique.size() ), &err);
+		uint32_t offset = 0;
+		for (uint32_t ii = 0, num = uint32_t(unique.size() ); ii < num; ++ii)
+		{
+			const uint32_t size = uint32_t(ctx.binaries[unique[ii] ].size() );
+			bx::write(_shaderWriter, offset, &err);
+			bx::write(_shaderWriter, size, &err);
+			offset += size;
+		}
+
+		for (uint32_t ii = 0, num = uint32_t(unique.size() ); ii < num; ++ii)
+		{
+			const std::string& binary = ctx.binaries[unique[ii] ];
+			bx::write(_shaderWriter, binary.c_str(), int32_t(binary.size() ), &err);
+		}
+
+		return true;
+	}
+
+	static const char* checkRequiredOptions(const bx::CommandLine& _cmdLine)
+	{
+		if (NULL == _cmdLine.findOption('f') )
+		{
+			return "Shader file name must be specified.";
+		}
+
+		if (NULL == _cmdLine.findOption('o')
+		&&  !_cmdLine.hasArg("stdout") )
+		{
+			return "Output file name must be specified or use \"--stdout\" to output to stdout.";
+		}
+
+		if (NULL == _cmdLine.findOption('\0', "type") )
+		{
+			return "Must specify shader type.";
+		}
+
+		return NULL;
+	}
+
+	static bool compileShader(const bx::CommandLine& _cmdLine, FileCache& _fileCache, uint32_t _numThreads, bx::WriterI* _messageWriter)
+	{
+		const char* filePath = _cmdLine.findOption('f');
+		bool consoleOut = _cmdLine.hasArg("stdout");
+		const char* outFilePath = _cmdLine.findOption('o');
+		const char* type = _cmdLine.findOption('\0', "type");
+
 		Options options;
 		options.inputFilePath = filePath;
 		options.outputFilePath = consoleOut ? "" : outFilePath;
 		options.shaderType = bx::toLower(type[0]);
 
-		options.disasm = cmdLine.hasArg('\0', "disasm");
+		options.disasm = _cmdLine.hasArg('\0', "disasm");
+		options.fileCache = &_fileCache;
 
-		const char* platform = cmdLine.findOption('\0', "platform");
+		const char* platform = _cmdLine.findOption('\0', "platform");
 		if (NULL == platform)
 		{
 			platform = "";
@@ -2707,9 +3292,9 @@ namespace bgfx
 
 		options.platform = platform;
 
-		options.raw = cmdLine.hasArg('\0', "raw");
+		options.raw = _cmdLine.hasArg('\0', "raw");
 
-		const char* profile = cmdLine.findOption('p', "profile");
+		const char* profile = _cmdLine.findOption('p', "profile");
 
 		if ( NULL != profile)
 		{
@@ -2717,17 +3302,17 @@ namespace bgfx
 		}
 
 		{
-			options.debugInformation       = cmdLine.hasArg('\0', "debug");
-			options.avoidFlowControl       = cmdLine.hasArg('\0', "avoid-flow-control");
-			options.noPreshader            = cmdLine.hasArg('\0', "no-preshader");
-			options.partialPrecision       = cmdLine.hasArg('\0', "partial-precision");
-			options.preferFlowControl      = cmdLine.hasArg('\0', "prefer-flow-control");
-			options.backwardsCompatibility = cmdLine.hasArg('\0', "backwards-compatibility");
-			options.warningsAreErrors      = cmdLine.hasArg('\0', "Werror");
-			options.keepIntermediate       = cmdLine.hasArg('\0', "keep-intermediate");
+			options.debugInformation       = _cmdLine.hasArg('\0', "debug");
+			options.avoidFlowControl       = _cmdLine.hasArg('\0', "avoid-flow-control");
+			options.noPreshader            = _cmdLine.hasArg('\0', "no-preshader");
+			options.partialPrecision       = _cmdLine.hasArg('\0', "partial-precision");
+			options.preferFlowControl      = _cmdLine.hasArg('\0', "prefer-flow-control");
+			options.backwardsCompatibility = _cmdLine.hasArg('\0', "backwards-compatibility");
+			options.warningsAreErrors      = _cmdLine.hasArg('\0', "Werror");
+			options.keepIntermediate       = _cmdLine.hasArg('\0', "keep-intermediate");
 
 			uint32_t optimization = 3;
-			if (cmdLine.hasArg(optimization, 'O') )
+			if (_cmdLine.hasArg(optimization, 'O') )
 			{
 				options.optimize = true;
 				options.optimizationLevel = optimization;
@@ -2735,9 +3320,9 @@ namespace bgfx
 		}
 
 		bx::StringView bin2c;
-		if (cmdLine.hasArg("bin2c") )
+		if (_cmdLine.hasArg("bin2c") )
 		{
-			const char* bin2cArg = cmdLine.findOption("bin2c");
+			const char* bin2cArg = _cmdLine.findOption("bin2c");
 			if (NULL != bin2cArg)
 			{
 				bin2c.set(bin2cArg);
@@ -2768,9 +3353,15 @@ namespace bgfx
 			}
 		}
 
-		options.depends = cmdLine.hasArg("depends");
-		options.preprocessOnly = cmdLine.hasArg("preprocess");
-		const char* includeDir = cmdLine.findOption('i');
+		const char* cacheDir = _cmdLine.findOption("cache");
+		if (NULL != cacheDir)
+		{
+			options.cacheDir = cacheDir;
+		}
+
+		options.depends = _cmdLine.hasArg("depends");
+		options.preprocessOnly = _cmdLine.hasArg("preprocess");
+		const char* includeDir = _cmdLine.findOption('i');
 
 		BX_TRACE("depends: %d", options.depends);
 		BX_TRACE("preprocessOnly: %d", options.preprocessOnly);
@@ -2779,7 +3370,7 @@ namespace bgfx
 		for (int ii = 1; NULL != includeDir; ++ii)
 		{
 			options.includeDirs.push_back(includeDir);
-			includeDir = cmdLine.findOption(ii, 'i');
+			includeDir = _cmdLine.findOption(ii, 'i');
 		}
 
 		std::string dir;
@@ -2791,7 +3382,7 @@ namespace bgfx
 			options.includeDirs.push_back(dir);
 		}
 
-		const char* defines = cmdLine.findOption("define");
+		const char* defines = _cmdLine.findOption("define");
 		while (NULL != defines
 		&&    '\0'  != *defines)
 		{
@@ -2803,31 +3394,29 @@ namespace bgfx
 		}
 
 		std::string commandLineComment = "// shaderc command line:\n//";
-		for (int32_t ii = 0, num = cmdLine.getNum(); ii < num; ++ii)
+		for (int32_t ii = 0, num = _cmdLine.getNum(); ii < num; ++ii)
 		{
 			commandLineComment += " ";
-			commandLineComment += cmdLine.get(ii);
+			commandLineComment += _cmdLine.get(ii);
 		}
 		commandLineComment += "\n\n";
 
 		bool compiled = false;
 
-		bx::FileReader reader;
-		if (!bx::open(&reader, filePath) )
+		const File* input = _fileCache.load(filePath);
+		if (NULL == input->getData() )
 		{
-			bx::printf("Unable to open file '%s'.\n", filePath);
+			writef(_messageWriter, "Unable to open file '%s'.\n", filePath);
 		}
 		else
 		{
 			const char* varying = NULL;
-			File attribdef;
 
 			if ('c' != options.shaderType)
 			{
 				std::string defaultVarying = dir + "varying.def.sc";
-				const char* varyingdef = cmdLine.findOption("varyingdef", defaultVarying.c_str() );
-				attribdef.load(varyingdef);
-				varying = attribdef.getData();
+				const char* varyingdef = _cmdLine.findOption("varyingdef", defaultVarying.c_str() );
+				varying = _fileCache.load(varyingdef)->getData();
 
 				if (NULL     != varying
 				&&  *varying != '\0')
@@ -2836,23 +3425,17 @@ namespace bgfx
 				}
 				else
 				{
-					bx::printf("ERROR: Failed to parse varying def file: \"%s\" No input/output semantics will be generated in the code!\n", varyingdef);
+					writef(_messageWriter, "ERROR: Failed to parse varying def file: \"%s\" No input/output semantics will be generated in the code!\n", varyingdef);
 				}
 			}
 
-			int32_t size = (int32_t)bx::getSize(&reader);
+			// UTF-8 BOM is already trimmed by File::load. Shader compiler
+			// takes ownership of data, so cached file must be copied.
+			int32_t size = (int32_t)input->getSize();
 			const int32_t total = size + 16384;
 			char* data = new char[total];
-			size = bx::read(&reader, data, size, bx::ErrorAssert{});
-
-			// Trim UTF-8 BOM
-			if (data[0] == '\xef'
-			&&  data[1] == '\xbb'
-			&&  data[2] == '\xbf')
-			{
-				bx::memMove(data, &data[3], size-3);
-				size -= 3;
-			}
+			bx::memCopy(data, input->getData(), size);
+			data[size] = '\0';
 
 			const char ch = data[0];
 			if (false // https://en.wikipedia.org/wiki/Byte_order_mark#Byte_order_marks_by_encoding
@@ -2867,15 +3450,15 @@ namespace bgfx
 			||  '\xff' == ch
 			   )
 			{
-				bx::printf("Shader input file has unsupported BOM.\n");
-				return bx::kExitFailure;
+				writef(_messageWriter, "Shader input file has unsupported BOM.\n");
+				delete [] data;
+				return false;
 			}
 
 			// Compiler generates "error X3000: syntax error: unexpected end of file"
 			// if input doesn't have empty line at EOF.
 			data[size] = '\n';
 			bx::memSet(&data[size+1], 0, total-size-1);
-			bx::close(&reader);
 
 			{
 				bx::FileWriter* writer = NULL;
@@ -2893,20 +3476,42 @@ namespace bgfx
 
 					if (!bx::open(writer, outFilePath) )
 					{
-						bx::printf("Unable to open output file '%s'.\n", outFilePath);
-						return bx::kExitFailure;
+						writef(_messageWriter, "Unable to open output file '%s'.\n", outFilePath);
+						delete writer;
+						delete [] data;
+						return false;
 					}
 				}
 
-				compiled = compileShader(
-						  varying
-						, commandLineComment.c_str()
-						, data
-						, size
-						, options
-						, consoleOut ? bx::getStdOut() : writer
-						, bx::getStdOut()
-						);
+				const char* variants = _cmdLine.findOption("variants");
+				if (NULL != variants)
+				{
+					_cmdLine.hasArg(_numThreads, 'j');
+
+					compiled = compileVariants(
+							  variants
+							, _numThreads
+							, varying
+							, commandLineComment.c_str()
+							, data
+							, size
+							, options
+							, consoleOut ? bx::getStdOut() : writer
+							, _messageWriter
+							);
+				}
+				else
+				{
+					compiled = compileShader(
+							  varying
+							, commandLineComment.c_str()
+							, data
+							, size
+							, options
+							, consoleOut ? bx::getStdOut() : writer
+							, _messageWriter
+							);
+				}
 
 				if (!consoleOut)
 				{
@@ -2918,13 +3523,236 @@ namespace bgfx
 
 		if (compiled)
 		{
-			return bx::kExitSuccess;
+			return true;
 		}
 
 		bx::remove(outFilePath);
 
-		bx::printf("Failed to build shader.\n");
-		return bx::kExitFailure;
+		writef(_messageWriter, "Failed to build shader.\n");
+		return false;
+	}
+
+	struct BatchJob
+	{
+		std::string line;
+		uint32_t lineNum;
+		bool compiled;
+		int64_t time;
+		std::string messages;
+	};
+
+	struct BatchContext
+	{
+		std::vector<BatchJob> jobs;
+		FileCache fileCache;
+		uint32_t next;
+	};
+
+	static int32_t batchThreadFunc(bx::Thread* _thread, void* _userData)
+	{
+		BX_UNUSED(_thread);
+
+		BatchContext& ctx = *(BatchContext*)_userData;
+		const uint32_t numJobs = uint32_t(ctx.jobs.size() );
+
+		for (uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&ctx.next, 1)
+			; idx < numJobs
+			; idx = bx::atomicFetchAndAdd<uint32_t>(&ctx.next, 1)
+			)
+		{
+			BatchJob& job = ctx.jobs[idx];
+
+			const int64_t start = bx::getHPCounter();
+
+			StringWriter messageWriter;
+
+			std::string line = job.line;
+			line.push_back('\0');
+
+			char buffer[4096];
+			uint32_t len = sizeof(buffer);
+			int32_t argc = 1;
+			const char* argv[128] = { "shaderc" };
+			bx::tokenizeCommandLine(line.c_str(), buffer, len, argc, &argv[1], BX_COUNTOF(argv)-1, '\n');
+			argc += 1;
+
+			bx::CommandLine cmdLine(argc, argv);
+
+			const char* err = checkRequiredOptions(cmdLine);
+			if (NULL != err)
+			{
+				writef(&messageWriter, "Error: %s\n", err);
+				job.compiled = false;
+			}
+			else
+			{
+				// Batch jobs already run in parallel, variants of each job
+				// are compiled on the job's thread.
+				job.compiled = compileShader(cmdLine, ctx.fileCache, 1, &messageWriter);
+			}
+
+			job.time     = bx::getHPCounter() - start;
+			job.messages = messageWriter.m_str;
+		}
+
+		return bx::kExitSuccess;
+	}
+
+	static int compileBatch(const char* _manifestPath, const bx::CommandLine& _cmdLine)
+	{
+		File manifest;
+		manifest.load(_manifestPath);
+
+		if (NULL == manifest.getData() )
+		{
+			bx::printf("Unable to open batch manifest file '%s'.\n", _manifestPath);
+			return bx::kExitFailure;
+		}
+
+		BatchContext ctx;
+		ctx.next = 0;
+
+		uint32_t lineNum = 0;
+		for (bx::LineReader lr(manifest.getData() ); !lr.isDone();)
+		{
+			const bx::StringView line = bx::strTrimSpace(lr.next() );
+			++lineNum;
+
+			if (line.isEmpty()
+			||  '#' == line.getPtr()[0])
+			{
+				continue;
+			}
+
+			BatchJob job;
+			job.line.assign(line.getPtr(), line.getTerm() );
+			job.lineNum  = lineNum;
+			job.compiled = false;
+			job.time     = 0;
+			ctx.jobs.push_back(job);
+		}
+
+		const uint32_t numJobs = uint32_t(ctx.jobs.size() );
+		if (0 == numJobs)
+		{
+			bx::printf("Batch manifest file '%s' doesn't contain any shaders.\n", _manifestPath);
+			return bx::kExitSuccess;
+		}
+
+		uint32_t numThreads = std::thread::hardware_concurrency();
+		_cmdLine.hasArg(numThreads, 'j');
+		numThreads = bx::clamp<uint32_t>(numThreads, 1, numJobs);
+
+		const int64_t start = bx::getHPCounter();
+
+		if (1 == numThreads)
+		{
+			batchThreadFunc(NULL, &ctx);
+		}
+		else
+		{
+			bx::Thread* threads = new bx::Thread[numThreads];
+
+			for (uint32_t ii = 0; ii < numThreads; ++ii)
+			{
+				threads[ii].init(batchThreadFunc, &ctx, 0, "shaderc batch");
+			}
+
+			for (uint32_t ii = 0; ii < numThreads; ++ii)
+			{
+				threads[ii].shutdown();
+			}
+
+			delete [] threads;
+		}
+
+		const double toMs = 1000.0/double(bx::getHPFrequency() );
+		const double total = double(bx::getHPCounter() - start)*toMs;
+
+		uint32_t numFailed = 0;
+		for (uint32_t ii = 0; ii < numJobs; ++ii)
+		{
+			const BatchJob& job = ctx.jobs[ii];
+
+			if (!job.compiled)
+			{
+				++numFailed;
+			}
+
+			bx::printf("%s:%d: %s %8.3f [ms] %s\n"
+				, _manifestPath
+				, job.lineNum
+				, job.compiled ? "  ok" : "FAIL"
+				, double(job.time)*toMs
+				, job.line.c_str()
+				);
+
+			if (!job.messages.empty() )
+			{
+				bx::printf("%s", job.messages.c_str() );
+			}
+		}
+
+		bx::printf("Compiled %d shaders, %d failed, %d threads, %0.3f [ms].\n"
+			, numJobs - numFailed
+			, numFailed
+			, numThreads
+			, total
+			);
+
+		printCacheStats();
+
+		return 0 == numFailed
+			? bx::kExitSuccess
+			: bx::kExitFailure
+			;
+	}
+
+	int compileShader(int _argc, const char* _argv[])
+	{
+		bx::CommandLine cmdLine(_argc, _argv);
+
+		if (cmdLine.hasArg('v', "version") )
+		{
+			bx::printf(
+				  "shaderc, bgfx shader compiler tool, version %d.%d.%d.\n"
+				, BGFX_SHADERC_VERSION_MAJOR
+				, BGFX_SHADERC_VERSION_MINOR
+				, BGFX_API_VERSION
+				);
+			return bx::kExitSuccess;
+		}
+
+		if (cmdLine.hasArg('h', "help") )
+		{
+			help();
+			return bx::kExitFailure;
+		}
+
+		g_verbose = cmdLine.hasArg("verbose");
+
+		const char* batch = cmdLine.findOption("batch");
+		if (NULL != batch)
+		{
+			return compileBatch(batch, cmdLine);
+		}
+
+		const char* err = checkRequiredOptions(cmdLine);
+		if (NULL != err)
+		{
+			help(err);
+			return bx::kExitFailure;
+		}
+
+		FileCache fileCache;
+		const bool compiled = compileShader(cmdLine, fileCache, std::thread::hardware_concurrency(), bx::getStdOut() );
+
+		printCacheStats();
+
+		return compiled
+			? bx::kExitSuccess
+			: bx::kExitFailure
+			;
 	}
 
 } // namespace bgfx
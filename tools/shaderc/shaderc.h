@@ -23,6 +23,7 @@ namespace bgfx
 #include <bx/string.h>
 #include <bx/hash.h>
 #include <bx/file.h>
+#include <bx/mutex.h>
 #include "../../src/vertexlayout.h"
 
 #include <string.h>
@@ -74,6 +75,8 @@ namespace bgfx
 		uint16_t texFormat;
 	};
 
+	class FileCache;
+
 	struct Options
 	{
 		Options();
@@ -86,6 +89,7 @@ namespace bgfx
 
 		std::string	inputFilePath;
 		std::string	outputFilePath;
+		std::string	cacheDir;
 
 		std::vector<std::string> includeDirs;
 		std::vector<std::string> defines;
@@ -108,6 +112,8 @@ namespace bgfx
 
 		bool optimize;
 		uint32_t optimizationLevel;
+
+		FileCache* fileCache;
 	};
 
 	typedef std::vector<Uniform> UniformArray;
@@ -8,6 +8,10 @@
 
 namespace bgfx { namespace glsl
 {
+	// glsl-optimizer releases global type and builtin function tables on
+	// cleanup, it can't be used from multiple threads at the same time.
+	static bx::Mutex s_mutex;
+
 	static bool compile(const Options& _options, uint32_t _version, const std::string& _code, bx::WriterI* _shaderWriter, bx::WriterI* _messageWriter)
 	{
 		bx::ErrorAssert messageErr;
@@ -398,6 +402,7 @@ namespace bgfx { namespace glsl
 
 	bool compileGLSLShader(const Options& _options, uint32_t _version, const std::string& _code, bx::WriterI* _shaderWriter, bx::WriterI* _messageWriter)
 	{
+		bx::MutexScope lock(glsl::s_mutex);
 		return glsl::compile(_options, _version, _code, _shaderWriter, _messageWriter);
 	}
 
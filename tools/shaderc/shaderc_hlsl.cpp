@@ -79,11 +79,23 @@ namespace bgfx { namespace hlsl
 
 	static const D3DCompiler* s_compiler;
 	static void* s_d3dcompilerdll;
+	static uint32_t s_refCount;
+	static bx::Mutex s_mutex;
 
 	const D3DCompiler* load(bx::WriterI* _messageWriter)
 	{
 		bx::Error messageErr;
 
+		// Shaders can be compiled from multiple threads in batch mode. Compiler
+		// is loaded by first, and unloaded by last user.
+		bx::MutexScope lock(s_mutex);
+
+		if (0 < s_refCount)
+		{
+			++s_refCount;
+			return s_compiler;
+		}
+
 		for (uint32_t ii = 0; ii < BX_COUNTOF(s_d3dcompiler); ++ii)
 		{
 			const D3DCompiler* compiler = &s_d3dcompiler[ii];
@@ -114,6 +126,9 @@ namespace bgfx { namespace hlsl
 				BX_TRACE("Loaded %s compiler (%s).", compiler->fileName, filePath);
 			}
 
+			s_compiler = compiler;
+			++s_refCount;
+
 			return compiler;
 		}
 
@@ -123,7 +138,15 @@ namespace bgfx { namespace hlsl
 
 	void unload()
 	{
-		bx::dlclose(s_d3dcompilerdll);
+		bx::MutexScope lock(s_mutex);
+
+		if (0 < s_refCount
+		&&  0 == --s_refCount)
+		{
+			bx::dlclose(s_d3dcompilerdll);
+			s_d3dcompilerdll = NULL;
+			s_compiler       = NULL;
+		}
 	}
 
 	struct CTHeader
@@ -575,7 +598,7 @@ namespace bgfx { namespace hlsl
 		profileAndType[0] = (_options.shaderType == 'f') ? 'p' : _options.shaderType;
 		bx::strCat(profileAndType, BX_COUNTOF(profileAndType), profile);
 
-		s_compiler = load(_messageWriter);
+		load(_messageWriter);
 
 		bool result = false;
 		bool debug = _options.debugInformation;